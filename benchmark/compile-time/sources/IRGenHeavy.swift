@@ -0,0 +1,140 @@
+//===--- IRGenHeavy.swift -------------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Many small types, each with metadata, value witnesses and a handful of
+// methods. Compile time here is dominated by IRGen and the LLVM pipeline
+// rather than by the frontend phases.
+
+struct Event1 { var timestamp: Int; var payload: Int }
+struct Event2 { var timestamp: Int; var payload: Double }
+struct Event3 { var timestamp: Int; var payload: String }
+struct Event4 { var timestamp: Int; var payload: Bool }
+struct Event5 { var timestamp: Int; var payload: [Int] }
+struct Event6 { var timestamp: Int; var payload: (Int, Int) }
+struct Event7 { var timestamp: Int; var payload: Int? }
+struct Event8 { var timestamp: Int; var payload: [String: Int] }
+
+enum Message {
+  case event1(Event1)
+  case event2(Event2)
+  case event3(Event3)
+  case event4(Event4)
+  case event5(Event5)
+  case event6(Event6)
+  case event7(Event7)
+  case event8(Event8)
+
+  var timestamp: Int {
+    switch self {
+    case .event1(let e): return e.timestamp
+    case .event2(let e): return e.timestamp
+    case .event3(let e): return e.timestamp
+    case .event4(let e): return e.timestamp
+    case .event5(let e): return e.timestamp
+    case .event6(let e): return e.timestamp
+    case .event7(let e): return e.timestamp
+    case .event8(let e): return e.timestamp
+    }
+  }
+}
+
+final class Node1 { var next: Node1?; var value = 0 }
+final class Node2 { var next: Node2?; var value = 0.0 }
+final class Node3 { var next: Node3?; var value = "" }
+final class Node4 { var next: Node4?; var value = false }
+final class Node5 { var next: Node5?; var value: [Int] = [] }
+final class Node6 { var next: Node6?; var value: Int? = nil }
+final class Node7 { var next: Node7?; var value: (Int, Int) = (0, 0) }
+final class Node8 { var next: Node8?; var value: [String] = [] }
+
+func chain1(_ n: Int) -> Node1 {
+  let head = Node1()
+  var tail = head
+  for i in 0..<n {
+    let node = Node1()
+    node.value = i
+    tail.next = node
+    tail = node
+  }
+  return head
+}
+
+func chain2(_ n: Int) -> Node2 {
+  let head = Node2()
+  var tail = head
+  for i in 0..<n {
+    let node = Node2()
+    node.value = Double(i)
+    tail.next = node
+    tail = node
+  }
+  return head
+}
+
+func chain3(_ n: Int) -> Node3 {
+  let head = Node3()
+  var tail = head
+  for i in 0..<n {
+    let node = Node3()
+    node.value = "\(i)"
+    tail.next = node
+    tail = node
+  }
+  return head
+}
+
+func chain4(_ n: Int) -> Node4 {
+  let head = Node4()
+  var tail = head
+  for i in 0..<n {
+    let node = Node4()
+    node.value = i % 2 == 0
+    tail.next = node
+    tail = node
+  }
+  return head
+}
+
+func makeMessages(_ n: Int) -> [Message] {
+  var messages: [Message] = []
+  messages.reserveCapacity(n * 8)
+  for i in 0..<n {
+    messages.append(.event1(Event1(timestamp: i, payload: i)))
+    messages.append(.event2(Event2(timestamp: i, payload: Double(i))))
+    messages.append(.event3(Event3(timestamp: i, payload: "\(i)")))
+    messages.append(.event4(Event4(timestamp: i, payload: i % 2 == 0)))
+    messages.append(.event5(Event5(timestamp: i, payload: [i, i, i])))
+    messages.append(.event6(Event6(timestamp: i, payload: (i, i))))
+    messages.append(.event7(Event7(timestamp: i, payload: i)))
+    messages.append(.event8(Event8(timestamp: i, payload: ["key": i])))
+  }
+  return messages
+}
+
+func latestTimestamp(_ messages: [Message]) -> Int {
+  var latest = Int.min
+  for message in messages {
+    latest = max(latest, message.timestamp)
+  }
+  return latest
+}
+
+func lengths(_ messages: [Message]) -> [Int] {
+  return messages.map { message -> Int in
+    switch message {
+    case .event3(let e): return e.payload.count
+    case .event5(let e): return e.payload.count
+    case .event8(let e): return e.payload.count
+    default: return 0
+    }
+  }
+}
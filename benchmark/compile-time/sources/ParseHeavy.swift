@@ -0,0 +1,205 @@
+//===--- ParseHeavy.swift -------------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Declaration- and literal-heavy code. Compile time here is dominated by
+// parsing and the type checking of many simple declarations.
+
+struct Color {
+  var red: Double
+  var green: Double
+  var blue: Double
+  var alpha: Double
+}
+
+let palette: [String: Color] = [
+  "black": Color(red: 0.00, green: 0.00, blue: 0.00, alpha: 1.0),
+  "white": Color(red: 1.00, green: 1.00, blue: 1.00, alpha: 1.0),
+  "red": Color(red: 1.00, green: 0.00, blue: 0.00, alpha: 1.0),
+  "green": Color(red: 0.00, green: 1.00, blue: 0.00, alpha: 1.0),
+  "blue": Color(red: 0.00, green: 0.00, blue: 1.00, alpha: 1.0),
+  "cyan": Color(red: 0.00, green: 1.00, blue: 1.00, alpha: 1.0),
+  "magenta": Color(red: 1.00, green: 0.00, blue: 1.00, alpha: 1.0),
+  "yellow": Color(red: 1.00, green: 1.00, blue: 0.00, alpha: 1.0),
+  "orange": Color(red: 1.00, green: 0.50, blue: 0.00, alpha: 1.0),
+  "purple": Color(red: 0.50, green: 0.00, blue: 0.50, alpha: 1.0),
+  "gray25": Color(red: 0.25, green: 0.25, blue: 0.25, alpha: 1.0),
+  "gray50": Color(red: 0.50, green: 0.50, blue: 0.50, alpha: 1.0),
+  "gray75": Color(red: 0.75, green: 0.75, blue: 0.75, alpha: 1.0),
+  "maroon": Color(red: 0.50, green: 0.00, blue: 0.00, alpha: 1.0),
+  "olive": Color(red: 0.50, green: 0.50, blue: 0.00, alpha: 1.0),
+  "navy": Color(red: 0.00, green: 0.00, blue: 0.50, alpha: 1.0),
+  "teal": Color(red: 0.00, green: 0.50, blue: 0.50, alpha: 1.0),
+  "silver": Color(red: 0.75, green: 0.75, blue: 0.75, alpha: 1.0),
+  "crimson": Color(red: 0.86, green: 0.08, blue: 0.24, alpha: 1.0),
+  "coral": Color(red: 1.00, green: 0.50, blue: 0.31, alpha: 1.0),
+]
+
+let wordFrequencies: [(String, Int)] = [
+  ("the", 23135851162), ("of", 13151942776), ("and", 12997637966),
+  ("to", 12136980858), ("a", 9081174698), ("in", 8469404971),
+  ("for", 5933321709), ("is", 4705743816), ("on", 3750423199),
+  ("that", 3400031103), ("by", 3350048871), ("this", 3228469771),
+  ("with", 3183110675), ("i", 3086225277), ("you", 2996181025),
+  ("it", 2813163874), ("not", 2633487141), ("or", 2590739907),
+  ("be", 2398724162), ("are", 2393614870), ("from", 2275595356),
+  ("at", 2272272772), ("as", 2247431740), ("your", 2062066547),
+  ("all", 2022459848), ("have", 1564202750), ("new", 1551258643),
+  ("more", 1544771673), ("an", 1518266684), ("was", 1483428678),
+  ("we", 1390661912), ("will", 1356293641), ("home", 1276852170),
+  ("can", 1242323499), ("us", 1229112622), ("about", 1226734006),
+  ("if", 1134987907), ("page", 1082121730), ("my", 1059793441),
+  ("has", 1046319984), ("search", 1024093118), ("free", 1014107316),
+]
+
+enum HTTPStatus: Int {
+  case `continue` = 100
+  case switchingProtocols = 101
+  case ok = 200
+  case created = 201
+  case accepted = 202
+  case nonAuthoritativeInformation = 203
+  case noContent = 204
+  case resetContent = 205
+  case partialContent = 206
+  case multipleChoices = 300
+  case movedPermanently = 301
+  case found = 302
+  case seeOther = 303
+  case notModified = 304
+  case useProxy = 305
+  case temporaryRedirect = 307
+  case badRequest = 400
+  case unauthorized = 401
+  case paymentRequired = 402
+  case forbidden = 403
+  case notFound = 404
+  case methodNotAllowed = 405
+  case notAcceptable = 406
+  case proxyAuthenticationRequired = 407
+  case requestTimeout = 408
+  case conflict = 409
+  case gone = 410
+  case lengthRequired = 411
+  case preconditionFailed = 412
+  case payloadTooLarge = 413
+  case uriTooLong = 414
+  case unsupportedMediaType = 415
+  case rangeNotSatisfiable = 416
+  case expectationFailed = 417
+  case upgradeRequired = 426
+  case internalServerError = 500
+  case notImplemented = 501
+  case badGateway = 502
+  case serviceUnavailable = 503
+  case gatewayTimeout = 504
+  case httpVersionNotSupported = 505
+
+  var reasonPhrase: String {
+    switch self {
+    case .continue: return "Continue"
+    case .switchingProtocols: return "Switching Protocols"
+    case .ok: return "OK"
+    case .created: return "Created"
+    case .accepted: return "Accepted"
+    case .nonAuthoritativeInformation: return "Non-Authoritative Information"
+    case .noContent: return "No Content"
+    case .resetContent: return "Reset Content"
+    case .partialContent: return "Partial Content"
+    case .multipleChoices: return "Multiple Choices"
+    case .movedPermanently: return "Moved Permanently"
+    case .found: return "Found"
+    case .seeOther: return "See Other"
+    case .notModified: return "Not Modified"
+    case .useProxy: return "Use Proxy"
+    case .temporaryRedirect: return "Temporary Redirect"
+    case .badRequest: return "Bad Request"
+    case .unauthorized: return "Unauthorized"
+    case .paymentRequired: return "Payment Required"
+    case .forbidden: return "Forbidden"
+    case .notFound: return "Not Found"
+    case .methodNotAllowed: return "Method Not Allowed"
+    case .notAcceptable: return "Not Acceptable"
+    case .proxyAuthenticationRequired: return "Proxy Authentication Required"
+    case .requestTimeout: return "Request Timeout"
+    case .conflict: return "Conflict"
+    case .gone: return "Gone"
+    case .lengthRequired: return "Length Required"
+    case .preconditionFailed: return "Precondition Failed"
+    case .payloadTooLarge: return "Payload Too Large"
+    case .uriTooLong: return "URI Too Long"
+    case .unsupportedMediaType: return "Unsupported Media Type"
+    case .rangeNotSatisfiable: return "Range Not Satisfiable"
+    case .expectationFailed: return "Expectation Failed"
+    case .upgradeRequired: return "Upgrade Required"
+    case .internalServerError: return "Internal Server Error"
+    case .notImplemented: return "Not Implemented"
+    case .badGateway: return "Bad Gateway"
+    case .serviceUnavailable: return "Service Unavailable"
+    case .gatewayTimeout: return "Gateway Timeout"
+    case .httpVersionNotSupported: return "HTTP Version Not Supported"
+    }
+  }
+
+  var isError: Bool { return rawValue >= 400 }
+  var isRedirect: Bool { return rawValue >= 300 && rawValue < 400 }
+  var isSuccess: Bool { return rawValue >= 200 && rawValue < 300 }
+}
+
+struct Locale {
+  let identifier: String
+  let languageName: String
+  let decimalSeparator: String
+  let groupingSeparator: String
+  let usesMetricSystem: Bool
+}
+
+let locales: [Locale] = [
+  Locale(identifier: "en_US", languageName: "English", decimalSeparator: ".",
+         groupingSeparator: ",", usesMetricSystem: false),
+  Locale(identifier: "en_GB", languageName: "English", decimalSeparator: ".",
+         groupingSeparator: ",", usesMetricSystem: true),
+  Locale(identifier: "fr_FR", languageName: "français", decimalSeparator: ",",
+         groupingSeparator: " ", usesMetricSystem: true),
+  Locale(identifier: "de_DE", languageName: "Deutsch", decimalSeparator: ",",
+         groupingSeparator: ".", usesMetricSystem: true),
+  Locale(identifier: "it_IT", languageName: "italiano", decimalSeparator: ",",
+         groupingSeparator: ".", usesMetricSystem: true),
+  Locale(identifier: "es_ES", languageName: "español", decimalSeparator: ",",
+         groupingSeparator: ".", usesMetricSystem: true),
+  Locale(identifier: "pt_BR", languageName: "português", decimalSeparator: ",",
+         groupingSeparator: ".", usesMetricSystem: true),
+  Locale(identifier: "ja_JP", languageName: "日本語", decimalSeparator: ".",
+         groupingSeparator: ",", usesMetricSystem: true),
+  Locale(identifier: "zh_CN", languageName: "中文", decimalSeparator: ".",
+         groupingSeparator: ",", usesMetricSystem: true),
+  Locale(identifier: "ko_KR", languageName: "한국어", decimalSeparator: ".",
+         groupingSeparator: ",", usesMetricSystem: true),
+  Locale(identifier: "ru_RU", languageName: "русский", decimalSeparator: ",",
+         groupingSeparator: " ", usesMetricSystem: true),
+  Locale(identifier: "ar_SA", languageName: "العربية", decimalSeparator: "٫",
+         groupingSeparator: "٬", usesMetricSystem: true),
+]
+
+func lookupColor(_ name: String) -> Color? {
+  return palette[name]
+}
+
+func frequency(of word: String) -> Int {
+  for (candidate, count) in wordFrequencies where candidate == word {
+    return count
+  }
+  return 0
+}
+
+func localesUsingComma() -> [Locale] {
+  return locales.filter { $0.decimalSeparator == "," }
+}
@@ -0,0 +1,110 @@
+//===--- SILOptHeavy.swift ------------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Many small concrete functions calling through generic wrappers. Under
+// -O, compile time here is dominated by SIL optimization: generic
+// specialization, inlining and the passes that clean up after them.
+
+protocol Accumulator {
+  associatedtype Value
+  mutating func combine(_ value: Value)
+  var result: Value { get }
+}
+
+struct SumAccumulator: Accumulator {
+  var result = 0
+  mutating func combine(_ value: Int) { result &+= value }
+}
+
+struct ProductAccumulator: Accumulator {
+  var result = 1
+  mutating func combine(_ value: Int) { result &*= value }
+}
+
+struct MaxAccumulator: Accumulator {
+  var result = Int.min
+  mutating func combine(_ value: Int) { result = max(result, value) }
+}
+
+struct MinAccumulator: Accumulator {
+  var result = Int.max
+  mutating func combine(_ value: Int) { result = min(result, value) }
+}
+
+struct CountAccumulator: Accumulator {
+  var result = 0
+  mutating func combine(_ value: Int) { result &+= value == 0 ? 0 : 1 }
+}
+
+func accumulate<A: Accumulator>(
+  _ values: [A.Value], into accumulator: A
+) -> A.Value {
+  var accumulator = accumulator
+  for value in values {
+    accumulator.combine(value)
+  }
+  return accumulator.result
+}
+
+func twice<A: Accumulator>(_ values: [A.Value], _ accumulator: A) -> A.Value
+    where A.Value == Int {
+  return accumulate(values, into: accumulator)
+    &+ accumulate(values.reversed(), into: accumulator)
+}
+
+func summarize(_ values: [Int]) -> (Int, Int, Int, Int, Int) {
+  return (accumulate(values, into: SumAccumulator()),
+          accumulate(values, into: ProductAccumulator()),
+          accumulate(values, into: MaxAccumulator()),
+          accumulate(values, into: MinAccumulator()),
+          accumulate(values, into: CountAccumulator()))
+}
+
+func summarizeTwice(_ values: [Int]) -> (Int, Int, Int, Int, Int) {
+  return (twice(values, SumAccumulator()),
+          twice(values, ProductAccumulator()),
+          twice(values, MaxAccumulator()),
+          twice(values, MinAccumulator()),
+          twice(values, CountAccumulator()))
+}
+
+func scale1(_ x: Int) -> Int { return x &* 2 }
+func scale2(_ x: Int) -> Int { return scale1(x) &+ 1 }
+func scale3(_ x: Int) -> Int { return scale2(x) &* 3 }
+func scale4(_ x: Int) -> Int { return scale3(x) &- 2 }
+func scale5(_ x: Int) -> Int { return scale4(x) &* 5 }
+func scale6(_ x: Int) -> Int { return scale5(x) &+ 7 }
+func scale7(_ x: Int) -> Int { return scale6(x) &* 11 }
+func scale8(_ x: Int) -> Int { return scale7(x) &- 13 }
+
+func scaleChain(_ values: [Int]) -> [Int] {
+  return values.map(scale8)
+}
+
+func applyAll(_ x: Int) -> Int {
+  let functions = [scale1, scale2, scale3, scale4,
+                   scale5, scale6, scale7, scale8]
+  var result = x
+  for function in functions {
+    result = function(result)
+  }
+  return result
+}
+
+func foldEverything(_ values: [Int]) -> Int {
+  let (sum, product, maximum, minimum, nonZero) = summarize(values)
+  let (sum2, product2, maximum2, minimum2, nonZero2) =
+    summarizeTwice(scaleChain(values))
+  return sum &+ product &+ maximum &+ minimum &+ nonZero
+    &+ sum2 &+ product2 &+ maximum2 &+ minimum2 &+ nonZero2
+    &+ applyAll(values.count)
+}
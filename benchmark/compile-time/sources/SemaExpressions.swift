@@ -0,0 +1,110 @@
+//===--- SemaExpressions.swift --------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Closure- and operator-heavy expressions. Compile time here is dominated
+// by expression type inference: overloaded operators, literals that need
+// defaulting, and closures whose parameter types must be deduced.
+
+struct Vector {
+  var x: Double
+  var y: Double
+  var z: Double
+
+  static func + (lhs: Vector, rhs: Vector) -> Vector {
+    return Vector(x: lhs.x + rhs.x, y: lhs.y + rhs.y, z: lhs.z + rhs.z)
+  }
+
+  static func - (lhs: Vector, rhs: Vector) -> Vector {
+    return Vector(x: lhs.x - rhs.x, y: lhs.y - rhs.y, z: lhs.z - rhs.z)
+  }
+
+  static func * (lhs: Vector, rhs: Double) -> Vector {
+    return Vector(x: lhs.x * rhs, y: lhs.y * rhs, z: lhs.z * rhs)
+  }
+
+  static func * (lhs: Double, rhs: Vector) -> Vector {
+    return rhs * lhs
+  }
+
+  func dot(_ other: Vector) -> Double {
+    return x * other.x + y * other.y + z * other.z
+  }
+}
+
+func reflect(_ incident: Vector, around normal: Vector) -> Vector {
+  return incident - 2.0 * incident.dot(normal) * normal
+}
+
+func interpolate(_ a: Vector, _ b: Vector, _ t: Double) -> Vector {
+  return a * (1.0 - t) + b * t
+}
+
+func simulate(steps: Int) -> Vector {
+  let gravity = Vector(x: 0.0, y: -9.81, z: 0.0)
+  var position = Vector(x: 0.0, y: 100.0, z: 0.0)
+  var velocity = Vector(x: 3.0, y: 0.0, z: 1.0)
+  let dt = 1.0 / 60.0
+  for _ in 0..<steps {
+    velocity = velocity + gravity * dt
+    position = position + velocity * dt + gravity * (0.5 * dt * dt)
+  }
+  return position
+}
+
+func pipeline(_ values: [Int]) -> [String] {
+  return values
+    .filter { $0 % 3 != 0 }
+    .map { $0 * $0 + 2 * $0 + 1 }
+    .sorted { abs($0 - 100) < abs($1 - 100) }
+    .prefix(10)
+    .map { "value: \($0)" }
+}
+
+func statistics(_ samples: [Double]) -> (mean: Double, variance: Double) {
+  let mean = samples.reduce(0, +) / Double(samples.count)
+  let variance = samples
+    .map { ($0 - mean) * ($0 - mean) }
+    .reduce(0, +) / Double(samples.count - 1)
+  return (mean: mean, variance: variance)
+}
+
+func grouped(_ words: [String]) -> [Int: [String]] {
+  return words.reduce(into: [Int: [String]]()) { result, word in
+    result[word.count, default: []].append(word)
+  }
+}
+
+func polynomial(_ x: Double) -> Double {
+  return 1.0 + x * (0.5 + x * (0.25 + x * (0.125 + x * 0.0625)))
+    - x * x * (0.1 + x * 0.05)
+    + (x - 1.0) * (x + 1.0) * 0.01
+}
+
+func mixedArithmetic(_ n: Int) -> Double {
+  let a = Double(n) * 1.5 + 2.0
+  let b = Double(n + 1) / 3.0 - 1.0
+  let c = Double(n * n) * 0.25 + Double(n) * 0.5 + 0.75
+  return a * b + b * c + c * a - (a + b + c) / 3.0
+}
+
+func nestedClosures(_ matrix: [[Int]]) -> Int {
+  return matrix
+    .map { row in row.filter { $0 > 0 }.reduce(0, +) }
+    .enumerated()
+    .map { (index, sum) in sum * (index + 1) }
+    .reduce(0, +)
+}
+
+func tupleJuggling(_ pairs: [(String, Int)]) -> [(key: String, weight: Double)] {
+  let total = pairs.map { $0.1 }.reduce(0, +)
+  return pairs.map { (key: $0.0, weight: Double($0.1) / Double(total)) }
+}
@@ -0,0 +1,133 @@
+//===--- SemaGenerics.swift -----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Protocol hierarchies and nested generic calls. Compile time here is
+// dominated by generic signature building, conformance checking and
+// associated type inference.
+
+protocol Shape {
+  associatedtype Scalar: Comparable
+  var area: Scalar { get }
+}
+
+protocol Positioned: Shape {
+  var x: Scalar { get }
+  var y: Scalar { get }
+}
+
+protocol Bounded: Positioned {
+  var width: Scalar { get }
+  var height: Scalar { get }
+}
+
+struct Rectangle: Bounded {
+  var x: Double
+  var y: Double
+  var width: Double
+  var height: Double
+  var area: Double { return width * height }
+}
+
+struct Circle: Positioned {
+  var x: Double
+  var y: Double
+  var radius: Double
+  var area: Double { return 3.14159265358979 * radius * radius }
+}
+
+struct Annotated<Base: Shape>: Shape {
+  var base: Base
+  var label: String
+  var area: Base.Scalar { return base.area }
+}
+
+struct Translated<Base: Positioned>: Positioned {
+  var base: Base
+  var dx: Base.Scalar
+  var dy: Base.Scalar
+  var x: Base.Scalar { return base.x }
+  var y: Base.Scalar { return base.y }
+  var area: Base.Scalar { return base.area }
+}
+
+struct Pair<First: Shape, Second: Shape>
+    where First.Scalar == Second.Scalar {
+  var first: First
+  var second: Second
+}
+
+func larger<First, Second>(
+  _ pair: Pair<First, Second>
+) -> First.Scalar {
+  return max(pair.first.area, pair.second.area)
+}
+
+func annotate<S: Shape>(_ shape: S, label: String) -> Annotated<S> {
+  return Annotated(base: shape, label: label)
+}
+
+func translate<P: Positioned>(
+  _ shape: P, by dx: P.Scalar, _ dy: P.Scalar
+) -> Translated<P> {
+  return Translated(base: shape, dx: dx, dy: dy)
+}
+
+func totalArea<S: Sequence>(_ shapes: S) -> Double
+    where S.Element: Shape, S.Element.Scalar == Double {
+  var total = 0.0
+  for shape in shapes {
+    total += shape.area
+  }
+  return total
+}
+
+func describe<B: Bounded>(_ shape: B) -> String
+    where B.Scalar: CustomStringConvertible {
+  return "\(shape.width) x \(shape.height) at (\(shape.x), \(shape.y))"
+}
+
+func deepNesting() -> Double {
+  let rect = Rectangle(x: 0, y: 0, width: 4, height: 3)
+  let circle = Circle(x: 1, y: 1, radius: 2)
+
+  let nested = annotate(
+    translate(
+      annotate(
+        translate(
+          annotate(rect, label: "inner"),
+          by: 1.0, 2.0),
+        label: "middle"),
+      by: 3.0, 4.0),
+    label: "outer")
+
+  let pair = Pair(first: nested, second: annotate(circle, label: "disk"))
+  return larger(pair)
+}
+
+func mixedCollections() -> Double {
+  let rects = [
+    Rectangle(x: 0, y: 0, width: 1, height: 1),
+    Rectangle(x: 1, y: 1, width: 2, height: 2),
+    Rectangle(x: 2, y: 2, width: 3, height: 3),
+  ]
+  let translated = rects.map { translate($0, by: 0.5, 0.5) }
+  let annotated = translated.map { annotate($0, label: "moved") }
+  return totalArea(rects) + totalArea(translated) + totalArea(annotated)
+}
+
+func descriptions() -> [String] {
+  let rects = (0..<8).map {
+    Rectangle(x: Double($0), y: Double($0),
+              width: Double($0 + 1), height: Double($0 + 2))
+  }
+  return rects.map { describe(translate($0, by: 1.0, 1.0).base) }
+}
@@ -17,8 +17,68 @@ from __future__ import print_function
 
 import argparse
 import csv
+import json
 import sys
-from math import sqrt
+from math import erfc, sqrt
+
+# Two-sided significance level used to declare a change in performance
+# genuine. Samples smaller than MIN_SAMPLES_FOR_SIGNIFICANCE can't reach
+# it with the rank test, so such comparisons fall back to the
+# threshold-only classification.
+SIGNIFICANCE_LEVEL = 0.05
+MIN_SAMPLES_FOR_SIGNIFICANCE = 4
+
+
+def mann_whitney_p_value(xs, ys):
+    """Two-sided Mann-Whitney U test of the hypothesis that `xs` and `ys`
+    are drawn from the same distribution.
+
+    Returns the p-value from the normal approximation of U (with tie and
+    continuity corrections), or None when either sample is too small for
+    the approximation to be meaningful.
+    """
+    n1, n2 = len(xs), len(ys)
+    if min(n1, n2) < MIN_SAMPLES_FOR_SIGNIFICANCE:
+        return None
+    pooled = sorted([(x, 0) for x in xs] + [(y, 1) for y in ys])
+    n = n1 + n2
+    ranks = [0.0] * n
+    tie_correction = 0.0
+    i = 0
+    while i < n:  # assign average ranks to ties
+        j = i
+        while j + 1 < n and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1
+        ties = j - i + 1
+        tie_correction += ties ** 3 - ties
+        i = j + 1
+    rank_sum = sum(rank for (rank, (_, sample)) in zip(ranks, pooled)
+                   if sample == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2.0
+    u = min(u, n1 * n2 - u)
+    variance = (n1 * n2 / 12.0) * ((n + 1) - tie_correction / (n * (n - 1)))
+    if variance == 0:  # all pooled values are identical
+        return 1.0
+    z = (u - n1 * n2 / 2.0 + 0.5) / sqrt(variance)
+    return min(1.0, erfc(-z / sqrt(2)))
+
+
+def pairwise_delta_interval(xs, ys, z=1.96):
+    """95% confidence interval for the runtime change (%) between samples
+    `xs` (old) and `ys` (new), from the order statistics of all pairwise
+    new/old ratios; the offsets into the sorted ratios are the quantiles
+    of the U distribution (normal approximation), in the style of the
+    Hodges-Lehmann interval. Returns None when either sample is too small.
+    """
+    n1, n2 = len(xs), len(ys)
+    if min(n1, n2) < MIN_SAMPLES_FOR_SIGNIFICANCE:
+        return None
+    deltas = sorted(((y + 0.001) / (x + 0.001) - 1) * 100
+                    for x in xs for y in ys)
+    k = max(0, int(n1 * n2 / 2.0 - z * sqrt(n1 * n2 * (n1 + n2 + 1) / 12.0)))
+    return (deltas[k], deltas[len(deltas) - 1 - k])
 
 
 class PerformanceTestResult(object):
@@ -27,15 +87,15 @@ class PerformanceTestResult(object):
     (Benchmark_O, Benchmark_Onone, Benchmark_Osize or Benchmark_Driver).
 
     It depends on the log format emitted by the test driver in the form:
-    #,TEST,SAMPLES,MIN(μs),MAX(μs),MEAN(μs),SD(μs),MEDIAN(μs),MAX_RSS(B)
+    #,TEST,SAMPLES,MIN(μs),MAX(μs),MEAN(μs),SD(μs),MEDIAN(μs),MAX_RSS(B),ALLOCS
 
-    The last column, MAX_RSS, is emitted only for runs instrumented by the
-    Benchmark_Driver to measure rough memory use during the execution of the
-    benchmark.
+    The MAX_RSS and ALLOCS columns are emitted only for runs instrumented
+    to measure memory use during the execution of the benchmark (the
+    driver's --memory option or runs under the Benchmark_Driver).
     """
     def __init__(self, csv_row):
         """PerformanceTestResult instance is created from an iterable with
-        length of 8 or 9. (Like a row provided by the CSV parser.)
+        length of 8, 9 or 10. (Like a row provided by the CSV parser.)
         """
         # csv_row[0] is just an ordinal number of the test - skip that
         self.name = csv_row[1]          # Name of the performance test
@@ -48,8 +108,13 @@ class PerformanceTestResult(object):
         self.S_runtime = (0 if self.samples < 2 else
                           (sd * sd) * (self.samples - 1))
         self.median = int(csv_row[7])   # Median runtime (ms)
+        # Exact MIN from every independent run merged into this result;
+        # they are the independent samples used for significance testing.
+        self.independent_mins = [self.min]
         self.max_rss = (                # Maximum Resident Set Size (B)
             int(csv_row[8]) if len(csv_row) > 8 else None)
+        self.allocs = (                 # Runtime allocations per iteration
+            int(csv_row[9]) if len(csv_row) > 9 else None)
 
     def __repr__(self):
         return (
@@ -85,6 +150,7 @@ class PerformanceTestResult(object):
         The use case here is comparing tests results parsed from concatenated
         log files from multiple runs of benchmark driver.
         """
+        self.independent_mins.extend(r.independent_mins)
         self.min = min(self.min, r.min)
         self.max = max(self.max, r.max)
         # self.median = None # unclear what to do here
@@ -114,7 +180,10 @@ class PerformanceTestResult(object):
 
 class ResultComparison(object):
     """ResultComparison compares MINs from new and old PerformanceTestResult.
-    It computes speedup ratio and improvement delta (%).
+    It computes speedup ratio and improvement delta (%). When both results
+    were merged from enough independent runs, it also tests the change for
+    statistical significance (Mann-Whitney U on the per-run MINs) and
+    computes a confidence interval for the delta.
     """
     def __init__(self, old, new):
         self.old = old
@@ -137,6 +206,21 @@ class ResultComparison(object):
                        (new.min < old.min and old.min < new.max))
             else '')
 
+        self.p_value = mann_whitney_p_value(
+            old.independent_mins, new.independent_mins)
+        self.delta_interval = pairwise_delta_interval(
+            old.independent_mins, new.independent_mins)
+        # Classification into changed/unchanged; set by TestComparator
+        self.verdict = 'unchanged'
+
+    @property
+    def is_significant(self):
+        """Whether the change is statistically significant. With too few
+        independent runs to test, defaults to True so that the comparison
+        degrades to the threshold-only classification.
+        """
+        return self.p_value is None or self.p_value < SIGNIFICANCE_LEVEL
+
     # Column labels for header row in results table
     header = ('TEST', 'OLD', 'NEW', 'DELTA', 'SPEEDUP')
 
@@ -144,9 +228,11 @@ class ResultComparison(object):
         """Values property for display in results table comparisons
         in format: ('TEST', 'OLD', 'NEW', 'DELTA', 'SPEEDUP').
         """
+        delta = '{0:+.1f}%'.format(self.delta)
+        if self.delta_interval is not None:
+            delta += ' [{0:+.1f}%, {1:+.1f}%]'.format(*self.delta_interval)
         return (self.name,
-                str(self.old.min), str(self.new.min),
-                '{0:+.1f}%'.format(self.delta),
+                str(self.old.min), str(self.new.min), delta,
                 '{0:.2f}x{1}'.format(self.ratio, self.is_dubious))
 
 
@@ -155,7 +241,10 @@ class TestComparator(object):
     Then it determines which tests were `added`, `removed` and which can be
     compared. It then splits the `ResultComparison`s into 3 groups according to
     the `delta_threshold` by the change in performance: `increased`,
-    `descreased` and `unchanged`.
+    `descreased` and `unchanged`. When the logs hold enough independent
+    runs per test, a change must also be statistically significant to
+    count as increased or decreased; dubious threshold crossings stay in
+    `unchanged`.
 
     The lists of `added`, `removed` and `unchanged` tests are sorted
     alphabetically. The `increased` and `decreased` lists are sorted in
@@ -199,9 +288,11 @@ class TestComparator(object):
             return reduce(lambda x, y: x[not p(y)].append(y) or x, l, ([], []))
 
         decreased, not_decreased = partition(
-            comparisons, lambda c: c.ratio < (1 - delta_threshold))
+            comparisons,
+            lambda c: c.ratio < (1 - delta_threshold) and c.is_significant)
         increased, unchanged = partition(
-            not_decreased, lambda c: c.ratio > (1 + delta_threshold))
+            not_decreased,
+            lambda c: c.ratio > (1 + delta_threshold) and c.is_significant)
 
         # sorted partitions
         names = [c.name for c in comparisons]
@@ -213,12 +304,19 @@ class TestComparator(object):
         self.unchanged = [comparisons[c.name]
                           for c in sorted(unchanged, key=lambda c: c.name)]
 
+        for (verdict, group) in [('regressed', self.decreased),
+                                 ('improved', self.increased),
+                                 ('unchanged', self.unchanged)]:
+            for c in group:
+                c.verdict = verdict
+
 
 class ReportFormatter(object):
     """ReportFormatter formats the `PerformanceTestResult`s and
     `ResultComparison`s provided by `TestComparator` using their `header` and
     `values()` into report table. Supported formats are: `markdown` (used for
-    displaying benchmark results on GitHub), `git` and `html`.
+    displaying benchmark results on GitHub), `git`, `html` and `json`
+    (machine-readable verdicts for CI gates).
     """
     def __init__(self, comparator, old_branch, new_branch, changes_only):
         self.comparator = comparator
@@ -302,6 +400,39 @@ class ReportFormatter(object):
             table('Removed', self.comparator.removed, is_open=True)
         ])
 
+    def json(self):
+        """Machine-readable report: one entry per test with a `verdict` of
+        `regressed`, `improved`, `unchanged`, `added` or `removed`, plus
+        the p-value and delta confidence interval when the logs held
+        enough independent runs to compute them. Meant to be consumed by
+        CI gates that fail on any `regressed` verdict.
+        """
+        def comparison(c):
+            return {
+                'test': c.name,
+                'verdict': c.verdict,
+                'old_min': c.old.min,
+                'new_min': c.new.min,
+                'delta_pct': round(c.delta, 2),
+                'ratio': round(c.ratio, 2),
+                'samples': [len(c.old.independent_mins),
+                            len(c.new.independent_mins)],
+                'p_value': (round(c.p_value, 4)
+                            if c.p_value is not None else None),
+                'delta_ci_pct': ([round(d, 2) for d in c.delta_interval]
+                                 if c.delta_interval is not None else None),
+            }
+
+        def result(r, verdict):
+            return {'test': r.name, 'verdict': verdict, 'min': r.min}
+
+        tests = [comparison(c) for c in
+                 (self.comparator.decreased + self.comparator.increased +
+                  ([] if self.changes_only else self.comparator.unchanged))]
+        tests += [result(r, 'added') for r in self.comparator.added]
+        tests += [result(r, 'removed') for r in self.comparator.removed]
+        return json.dumps({'tests': tests}, indent=2, sort_keys=True)
+
     HTML = """
 <!DOCTYPE html>
 <html>
@@ -387,7 +518,7 @@ def parse_args(args):
                         help='New performance test suite (csv file)',
                         required=True)
     parser.add_argument('--format',
-                        choices=['markdown', 'git', 'html'],
+                        choices=['markdown', 'git', 'html', 'json'],
                         help='Output format. Default is markdown.',
                         default="markdown")
     parser.add_argument('--output', help='Output file name')
@@ -412,7 +543,8 @@ def main():
     formats = {
         'markdown': formatter.markdown,
         'git': formatter.git,
-        'html': formatter.html
+        'html': formatter.html,
+        'json': formatter.json
     }
 
     report = formats[args.format]()
@@ -13,6 +13,7 @@
 #
 # ===---------------------------------------------------------------------===//
 
+import json
 import os
 import shutil
 import sys
@@ -27,6 +28,8 @@ from compare_perf_tests import ReportFormatter
 from compare_perf_tests import ResultComparison
 from compare_perf_tests import TestComparator
 from compare_perf_tests import main
+from compare_perf_tests import mann_whitney_p_value
+from compare_perf_tests import pairwise_delta_interval
 from compare_perf_tests import parse_args
 
 
@@ -54,6 +57,11 @@ class TestPerformanceTestResult(unittest.TestCase):
         r = PerformanceTestResult(log_line.split(','))
         self.assertEquals(r.max_rss, 10510336)
 
+        log_line = '1,AngryPhonebook,1,12045,12045,12045,0,12045,10510336,25'
+        r = PerformanceTestResult(log_line.split(','))
+        self.assertEquals(r.max_rss, 10510336)
+        self.assertEquals(r.allocs, 25)
+
     def test_repr(self):
         log_line = '1,AngryPhonebook,20,10664,12933,11035,576,10884'
         r = PerformanceTestResult(log_line.split(','))
@@ -105,6 +113,31 @@ class TestPerformanceTestResult(unittest.TestCase):
         r.merge(results[3])
         self.assertEquals(as_tuple(r),
                           (11616, 12325, 12064, 322.29, 12045, 10510336))
+        # each merged run contributes its MIN as an independent sample
+        self.assertEquals(r.independent_mins, [12045, 12325, 11616, 12270])
+
+
+class TestRobustStatistics(unittest.TestCase):
+    def test_mann_whitney_p_value(self):
+        # clearly separated samples are significant
+        p = mann_whitney_p_value([100, 101, 102, 103, 104],
+                                 [200, 201, 202, 203, 204])
+        self.assertLess(p, 0.05)
+        # interleaved samples are not
+        p = mann_whitney_p_value([100, 105, 110, 115],
+                                 [102, 107, 112, 117])
+        self.assertGreater(p, 0.05)
+        # identical samples (all ties) are certainly not
+        self.assertEquals(mann_whitney_p_value([5] * 4, [5] * 4), 1.0)
+        # too few samples to test
+        self.assertIsNone(mann_whitney_p_value([1, 2, 3], [4, 5, 6]))
+
+    def test_pairwise_delta_interval(self):
+        lo, hi = pairwise_delta_interval([100, 101, 102, 103],
+                                         [110, 111, 112, 113])
+        self.assertAlmostEquals(lo, 7.77, places=2)
+        self.assertAlmostEquals(hi, 12.00, places=2)
+        self.assertIsNone(pairwise_delta_interval([1, 2, 3], [4, 5, 6]))
 
 
 class TestResultComparison(unittest.TestCase):
@@ -159,6 +192,37 @@ class TestResultComparison(unittest.TestCase):
             ('AngryPhonebook', '11616', '12325', '+6.1%', '0.94x')
         )
 
+    def test_significance(self):
+        def merged(times):
+            lines = ['1,Ackermann,1,{0},{0},{0},0,{0}'.format(t)
+                     for t in times]
+            results = map(PerformanceTestResult,
+                          [line.split(',') for line in lines])
+            r = results[0]
+            for other in results[1:]:
+                r.merge(other)
+            return r
+
+        # single runs on both sides: too few samples to test, fall back
+        # to the threshold-only classification
+        rc = ResultComparison(self.r1, self.r2)
+        self.assertIsNone(rc.p_value)
+        self.assertIsNone(rc.delta_interval)
+        self.assertTrue(rc.is_significant)
+
+        # a consistent shift across runs is significant
+        rc = ResultComparison(merged([100, 101, 102, 103]),
+                              merged([200, 202, 204, 206]))
+        self.assertLess(rc.p_value, 0.05)
+        self.assertTrue(rc.is_significant)
+        self.assertIn('[', rc.values()[3])  # DELTA column shows the CI
+
+        # overlapping noisy runs are not
+        rc = ResultComparison(merged([100, 101, 120, 121]),
+                              merged([110, 111, 130, 131]))
+        self.assertGreater(rc.p_value, 0.05)
+        self.assertFalse(rc.is_significant)
+
     def test_values_is_dubious(self):
         self.r2.max = self.r1.min + 1
         # new.min < old.min < new.max
@@ -230,6 +294,10 @@ class TestTestComparator(OldAndNewLog):
         self.assertEquals(names(tc.decreased), ['BitCount'])
         self.assertEquals(names(tc.added), ['TwoSum'])
         self.assertEquals(names(tc.removed), ['AnyHashableWithAClass'])
+        # comparisons carry machine-readable verdicts
+        self.assertEquals(tc.decreased[0].verdict, 'regressed')
+        self.assertEquals(tc.increased[0].verdict, 'improved')
+        self.assertEquals(tc.unchanged[0].verdict, 'unchanged')
         # other way around
         tc = TestComparator(new_log, old_log, 0.05)
         self.assertEquals(names(tc.unchanged), ['AngryPhonebook', 'Array2D'])
@@ -247,6 +315,26 @@ class TestTestComparator(OldAndNewLog):
         self.assertEquals(names(tc.increased), ['ByteSwap'])
         self.assertEquals(tc.decreased, [])
 
+    def test_insignificant_change_is_unchanged(self):
+        """With enough independent runs per test, a threshold crossing
+        that is not statistically significant stays in `unchanged`."""
+        def log(name, times):
+            return '\n'.join(
+                ['1,{0},1,{1},{1},{1},0,{1}'.format(name, t) for t in times]
+            ) + '\n'
+
+        # Noisy's merged MIN also moves by 10%, but its runs overlap;
+        # Slower's shift is consistent across runs.
+        old_log = self.write_temp_file('old_runs.log', (
+            log('Noisy', [100, 101, 120, 121]) +
+            log('Slower', [100, 101, 102, 103])))
+        new_log = self.write_temp_file('new_runs.log', (
+            log('Noisy', [110, 111, 130, 131]) +
+            log('Slower', [110, 111, 112, 113])))
+        tc = TestComparator(old_log, new_log, 0.05)
+        self.assertEquals([c.name for c in tc.decreased], ['Slower'])
+        self.assertEquals([c.name for c in tc.unchanged], ['Noisy'])
+
 
 class TestReportFormatter(OldAndNewLog):
     def setUp(self):
@@ -378,6 +466,22 @@ class TestReportFormatter(OldAndNewLog):
         self.assertNotIn('AngryPhonebook', git)
         self.assertNotIn('No Changes', html)
         self.assertNotIn('AngryPhonebook', html)
+        self.assertNotIn('AngryPhonebook', rf.json())
+
+    def test_json(self):
+        """JSON report contains a verdict for every test."""
+        report = json.loads(self.rf.json())
+        verdicts = dict((t['test'], t['verdict']) for t in report['tests'])
+        self.assertEquals(verdicts['BitCount'], 'regressed')
+        self.assertEquals(verdicts['ByteSwap'], 'improved')
+        self.assertEquals(verdicts['AngryPhonebook'], 'unchanged')
+        self.assertEquals(verdicts['TwoSum'], 'added')
+        self.assertEquals(verdicts['AnyHashableWithAClass'], 'removed')
+        bitcount = [t for t in report['tests']
+                    if t['test'] == 'BitCount'][0]
+        self.assertEquals(bitcount['old_min'], 3)
+        self.assertEquals(bitcount['new_min'], 9)
+        self.assertIsNone(bitcount['p_value'])  # a single run of each log
 
 
 class Test_parse_args(unittest.TestCase):
@@ -401,12 +505,14 @@ class Test_parse_args(unittest.TestCase):
             parse_args(self.required + ['--format', 'git']).format, 'git')
         self.assertEquals(
             parse_args(self.required + ['--format', 'html']).format, 'html')
+        self.assertEquals(
+            parse_args(self.required + ['--format', 'json']).format, 'json')
 
         with captured_output() as (_, err):
             self.assertRaises(SystemExit, parse_args,
                               self.required + ['--format', 'bogus'])
         self.assertIn("error: argument --format: invalid choice: 'bogus' "
-                      "(choose from 'markdown', 'git', 'html')",
+                      "(choose from 'markdown', 'git', 'html', 'json')",
                       err.getvalue())
 
     def test_delta_threshold_argument(self):
@@ -519,6 +625,13 @@ class Test_compare_perf_tests_main(OldAndNewLog):
         report_out, _ = self.execute_main_with_format('html')
         self.assert_report_contains(self.html, report_out)
 
+    def test_json(self):
+        """Writes JSON report with machine-readable verdicts to stdout."""
+        report_out, _ = self.execute_main_with_format('json')
+        report = json.loads(report_out)
+        verdicts = dict((t['test'], t['verdict']) for t in report['tests'])
+        self.assertEquals(verdicts['BitCount'], 'regressed')
+
     def test_html_output(self):
         """Writes HTML formatted report to stdout and `--output` file."""
         report_out, report_file = (
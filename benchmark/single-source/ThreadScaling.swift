@@ -0,0 +1,346 @@
+//===--- ThreadScaling.swift ----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// These benchmarks measure how runtime-critical operations scale across
+// threads. Each kernel performs a fixed total amount of work divided
+// evenly among 1, 2, 4, 8 or 16 threads, so with perfect scaling the
+// reported time stays flat as the thread count grows, and the family of
+// results forms a scaling curve. Regressions here usually point at atomic
+// reference counting or cache-line contention in the runtime rather than
+// at the code the kernels execute.
+
+import TestsUtils
+#if os(Linux)
+import Glibc
+#else
+import Darwin
+#endif
+
+public let ThreadScaling: [BenchmarkInfo] = [
+  BenchmarkInfo(name: "ThreadScalingArrayRead1",
+    runFunction: run_ThreadScalingArrayRead1,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingArrayRead2",
+    runFunction: run_ThreadScalingArrayRead2,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingArrayRead4",
+    runFunction: run_ThreadScalingArrayRead4,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingArrayRead8",
+    runFunction: run_ThreadScalingArrayRead8,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingArrayRead16",
+    runFunction: run_ThreadScalingArrayRead16,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingDictionaryRead1",
+    runFunction: run_ThreadScalingDictionaryRead1,
+    tags: [.validation, .runtime, .concurrency, .Dictionary]),
+  BenchmarkInfo(name: "ThreadScalingDictionaryRead2",
+    runFunction: run_ThreadScalingDictionaryRead2,
+    tags: [.validation, .runtime, .concurrency, .Dictionary]),
+  BenchmarkInfo(name: "ThreadScalingDictionaryRead4",
+    runFunction: run_ThreadScalingDictionaryRead4,
+    tags: [.validation, .runtime, .concurrency, .Dictionary]),
+  BenchmarkInfo(name: "ThreadScalingDictionaryRead8",
+    runFunction: run_ThreadScalingDictionaryRead8,
+    tags: [.validation, .runtime, .concurrency, .Dictionary]),
+  BenchmarkInfo(name: "ThreadScalingDictionaryRead16",
+    runFunction: run_ThreadScalingDictionaryRead16,
+    tags: [.validation, .runtime, .concurrency, .Dictionary]),
+  BenchmarkInfo(name: "ThreadScalingObjectHandoff1",
+    runFunction: run_ThreadScalingObjectHandoff1,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingObjectHandoff2",
+    runFunction: run_ThreadScalingObjectHandoff2,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingObjectHandoff4",
+    runFunction: run_ThreadScalingObjectHandoff4,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingObjectHandoff8",
+    runFunction: run_ThreadScalingObjectHandoff8,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+  BenchmarkInfo(name: "ThreadScalingObjectHandoff16",
+    runFunction: run_ThreadScalingObjectHandoff16,
+    tags: [.validation, .runtime, .concurrency, .refcount]),
+]
+
+// Minimal block-based pthread wrappers. The stdlib's private pthread
+// extras are not visible to the benchmarks, so the same context trick is
+// replicated here.
+
+final class ThreadBodyContext {
+  let body: () -> Void
+  init(_ body: @escaping () -> Void) { self.body = body }
+}
+
+func invokeThreadBody(
+  _ contextAsVoidPointer: UnsafeMutableRawPointer?
+) -> UnsafeMutableRawPointer? {
+  // The context is passed in +1; we're responsible for releasing it.
+  let context = Unmanaged<ThreadBodyContext>
+    .fromOpaque(contextAsVoidPointer!)
+    .takeRetainedValue()
+  context.body()
+  return nil
+}
+
+/// Run `body` on `numThreads` freshly created threads, passing each its
+/// thread index, and wait for all of them to finish.
+func runOnThreads(_ numThreads: Int, _ body: @escaping (Int) -> Void) {
+  var threads: [pthread_t] = []
+  threads.reserveCapacity(numThreads)
+  for t in 0..<numThreads {
+    let context = Unmanaged.passRetained(ThreadBodyContext { body(t) })
+      .toOpaque()
+#if os(Linux)
+    var thread = pthread_t()
+#else
+    var thread: pthread_t? = nil
+#endif
+    let rc = pthread_create(&thread, nil, { invokeThreadBody($0) }, context)
+    CheckResults(rc == 0)
+#if os(Linux)
+    threads.append(thread)
+#else
+    threads.append(thread!)
+#endif
+  }
+  for thread in threads {
+    pthread_join(thread, nil)
+  }
+}
+
+final class Element {
+  var value: Int
+  init(_ value: Int) { self.value = value }
+}
+
+let sharedElementCount = 1024
+
+/// A shared array of class instances. Reading an element retains and
+/// releases it, so concurrent readers contend on the element refcounts
+/// and on the array buffer's refcount.
+let sharedElements: [Element] = (0..<sharedElementCount).map { Element($0) }
+
+let sharedElementSum = sharedElementCount * (sharedElementCount - 1) / 2
+
+/// A shared dictionary. Every lookup retains and releases the shared
+/// hashed storage, which is where concurrent readers contend.
+let sharedDictionary: [Int: Int] = {
+  var dict = [Int: Int](minimumCapacity: sharedElementCount)
+  for i in 0..<sharedElementCount {
+    dict[i] = i &* 3
+  }
+  return dict
+}()
+
+/// Total passes over the shared data per benchmark iteration, split
+/// evenly among the threads.
+let totalPasses = 512
+
+/// Total object round trips per benchmark iteration, split evenly among
+/// the thread pairs.
+let totalHandoffs = 1024
+
+@inline(never)
+func sumElements(_ passes: Int) -> Int {
+  var sum = 0
+  for _ in 0..<passes {
+    for element in sharedElements {
+      sum &+= element.value
+    }
+  }
+  return sum
+}
+
+@inline(never)
+func sumLookups(_ passes: Int) -> Int {
+  var sum = 0
+  for _ in 0..<passes {
+    for key in 0..<sharedElementCount {
+      sum &+= sharedDictionary[key]!
+    }
+  }
+  return sum
+}
+
+/// Divide `passes * N` passes among `threads` threads running `kernel`
+/// and check the combined result.
+func runSharedReads(
+  _ threads: Int, _ N: Int, perPassSum: Int,
+  kernel: @escaping (Int) -> Int
+) {
+  let passesPerThread = totalPasses * N / threads
+  let partialSums = UnsafeMutablePointer<Int>.allocate(capacity: threads)
+  runOnThreads(threads) { t in
+    partialSums[t] = kernel(passesPerThread)
+  }
+  var sum = 0
+  for t in 0..<threads {
+    sum &+= partialSums[t]
+  }
+  partialSums.deallocate()
+  CheckResults(sum == perPassSum * passesPerThread * threads)
+}
+
+/// A one-object slot used to pass an instance between two threads.
+final class HandoffChannel {
+  private let mutex = UnsafeMutablePointer<pthread_mutex_t>.allocate(capacity: 1)
+  private let cond = UnsafeMutablePointer<pthread_cond_t>.allocate(capacity: 1)
+  private var slot: Element? = nil
+
+  init() {
+    pthread_mutex_init(mutex, nil)
+    pthread_cond_init(cond, nil)
+  }
+
+  deinit {
+    pthread_cond_destroy(cond)
+    pthread_mutex_destroy(mutex)
+    cond.deallocate()
+    mutex.deallocate()
+  }
+
+  func put(_ element: Element) {
+    pthread_mutex_lock(mutex)
+    while slot != nil {
+      pthread_cond_wait(cond, mutex)
+    }
+    slot = element
+    pthread_cond_signal(cond)
+    pthread_mutex_unlock(mutex)
+  }
+
+  func take() -> Element {
+    pthread_mutex_lock(mutex)
+    while slot == nil {
+      pthread_cond_wait(cond, mutex)
+    }
+    let element = slot!
+    slot = nil
+    pthread_cond_signal(cond)
+    pthread_mutex_unlock(mutex)
+    return element
+  }
+}
+
+/// Bounce objects between pairs of threads. The object's refcount and the
+/// channel state migrate between the two cores on every round trip. With
+/// one thread the same channel operations run without any cross-thread
+/// traffic, as a baseline.
+func runObjectHandoff(_ threads: Int, _ N: Int) {
+  if threads == 1 {
+    let channel = HandoffChannel()
+    var element = Element(42)
+    for _ in 0..<(totalHandoffs * N) {
+      channel.put(element)
+      element = channel.take()
+    }
+    CheckResults(element.value == 42)
+    return
+  }
+
+  let pairs = threads / 2
+  let handoffsPerPair = totalHandoffs * N / pairs
+  let forward = (0..<pairs).map { _ in HandoffChannel() }
+  let backward = (0..<pairs).map { _ in HandoffChannel() }
+  runOnThreads(threads) { t in
+    let pair = t / 2
+    if t % 2 == 0 {
+      var element = Element(t)
+      for _ in 0..<handoffsPerPair {
+        forward[pair].put(element)
+        element = backward[pair].take()
+      }
+      CheckResults(element.value == t)
+    } else {
+      for _ in 0..<handoffsPerPair {
+        backward[pair].put(forward[pair].take())
+      }
+    }
+  }
+}
+
+@inline(never)
+public func run_ThreadScalingArrayRead1(_ N: Int) {
+  runSharedReads(1, N, perPassSum: sharedElementSum, kernel: sumElements)
+}
+
+@inline(never)
+public func run_ThreadScalingArrayRead2(_ N: Int) {
+  runSharedReads(2, N, perPassSum: sharedElementSum, kernel: sumElements)
+}
+
+@inline(never)
+public func run_ThreadScalingArrayRead4(_ N: Int) {
+  runSharedReads(4, N, perPassSum: sharedElementSum, kernel: sumElements)
+}
+
+@inline(never)
+public func run_ThreadScalingArrayRead8(_ N: Int) {
+  runSharedReads(8, N, perPassSum: sharedElementSum, kernel: sumElements)
+}
+
+@inline(never)
+public func run_ThreadScalingArrayRead16(_ N: Int) {
+  runSharedReads(16, N, perPassSum: sharedElementSum, kernel: sumElements)
+}
+
+@inline(never)
+public func run_ThreadScalingDictionaryRead1(_ N: Int) {
+  runSharedReads(1, N, perPassSum: sharedElementSum &* 3, kernel: sumLookups)
+}
+
+@inline(never)
+public func run_ThreadScalingDictionaryRead2(_ N: Int) {
+  runSharedReads(2, N, perPassSum: sharedElementSum &* 3, kernel: sumLookups)
+}
+
+@inline(never)
+public func run_ThreadScalingDictionaryRead4(_ N: Int) {
+  runSharedReads(4, N, perPassSum: sharedElementSum &* 3, kernel: sumLookups)
+}
+
+@inline(never)
+public func run_ThreadScalingDictionaryRead8(_ N: Int) {
+  runSharedReads(8, N, perPassSum: sharedElementSum &* 3, kernel: sumLookups)
+}
+
+@inline(never)
+public func run_ThreadScalingDictionaryRead16(_ N: Int) {
+  runSharedReads(16, N, perPassSum: sharedElementSum &* 3, kernel: sumLookups)
+}
+
+@inline(never)
+public func run_ThreadScalingObjectHandoff1(_ N: Int) {
+  runObjectHandoff(1, N)
+}
+
+@inline(never)
+public func run_ThreadScalingObjectHandoff2(_ N: Int) {
+  runObjectHandoff(2, N)
+}
+
+@inline(never)
+public func run_ThreadScalingObjectHandoff4(_ N: Int) {
+  runObjectHandoff(4, N)
+}
+
+@inline(never)
+public func run_ThreadScalingObjectHandoff8(_ N: Int) {
+  runObjectHandoff(8, N)
+}
+
+@inline(never)
+public func run_ThreadScalingObjectHandoff16(_ N: Int) {
+  runObjectHandoff(16, N)
+}
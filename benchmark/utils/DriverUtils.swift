@@ -18,6 +18,15 @@ import Darwin
 
 import TestsUtils
 
+/// One reading of the hardware performance counters the harness samples.
+/// All values are raw event counts.
+struct PerfCounterValues {
+  var instructions: UInt64 = 0
+  var cycles: UInt64 = 0
+  var cacheMisses: UInt64 = 0
+  var branchMisses: UInt64 = 0
+}
+
 struct BenchResults {
   var delim: String  = ","
   var sampleCount: UInt64 = 0
@@ -27,6 +36,17 @@ struct BenchResults {
   var sd: UInt64 = 0
   var median: UInt64 = 0
 
+  /// Median per-iteration counter readings, if counters were measured.
+  var counters: PerfCounterValues? = nil
+
+  /// Increase in the process's peak resident set size over the run of the
+  /// benchmark, in bytes, if memory use was measured.
+  var maxRSS: UInt64? = nil
+
+  /// Number of swift_allocObject calls in one iteration of the benchmark,
+  /// if memory use was measured.
+  var allocations: UInt64? = nil
+
   init() {}
 
   init(delim: String, sampleCount: UInt64, min: UInt64, max: UInt64, mean: UInt64, sd: UInt64, median: UInt64) {
@@ -49,7 +69,20 @@ struct BenchResults {
 
 extension BenchResults : CustomStringConvertible {
   var description: String {
-     return "\(sampleCount)\(delim)\(min)\(delim)\(max)\(delim)\(mean)\(delim)\(sd)\(delim)\(median)"
+     var str = "\(sampleCount)\(delim)\(min)\(delim)\(max)\(delim)\(mean)\(delim)\(sd)\(delim)\(median)"
+     // Memory columns come first so that MAX_RSS stays at the column index
+     // the comparison scripts expect.
+     if let maxRSS = maxRSS {
+       str += "\(delim)\(maxRSS)"
+     }
+     if let allocations = allocations {
+       str += "\(delim)\(allocations)"
+     }
+     if let counters = counters {
+       str += "\(delim)\(counters.instructions)\(delim)\(counters.cycles)"
+       str += "\(delim)\(counters.cacheMisses)\(delim)\(counters.branchMisses)"
+     }
+     return str
   }
 }
 
@@ -125,6 +158,14 @@ struct TestConfig {
   /// Is verbose output enabled?
   var verbose: Bool = false
 
+  /// Should we also sample hardware performance counters (instructions
+  /// retired, cycles, cache misses, branch mispredicts) for each sample?
+  var measurePerfCounters: Bool = false
+
+  /// Should we report peak-RSS deltas and runtime allocation counts for
+  /// each benchmark?
+  var measureMemory: Bool = false
+
   /// After we run the tests, should the harness sleep to allow for utilities
   /// like leaks that require a PID to run on the test harness.
   var afterRunSleep: Int?
@@ -136,7 +177,7 @@ struct TestConfig {
     let validOptions = [
       "--iter-scale", "--num-samples", "--num-iters",
       "--verbose", "--delim", "--list", "--sleep",
-      "--tags", "--skip-tags"
+      "--tags", "--skip-tags", "--perf-counters", "--memory"
     ]
     let maybeBenchArgs: Arguments? = parseArgs(validOptions)
     if maybeBenchArgs == nil {
@@ -166,6 +207,14 @@ struct TestConfig {
       print("Verbose")
     }
 
+    if let _ = benchArgs.optionalArgsMap["--perf-counters"] {
+      measurePerfCounters = true
+    }
+
+    if let _ = benchArgs.optionalArgsMap["--memory"] {
+      measureMemory = true
+    }
+
     if let x = benchArgs.optionalArgsMap["--delim"] {
       if x.isEmpty { return .fail("--delim requires a value") }
       delim = x
@@ -304,6 +353,65 @@ func stopTrackingObjects(_: UnsafeMutableRawPointer) -> Int
 
 #endif
 
+// The runtime function counters interface of the standard library. These
+// entry points always exist, but the counters are only updated by standard
+// libraries built with assertions enabled.
+@_silgen_name("_swift_setGlobalRuntimeFunctionCountersMode")
+func setGlobalRuntimeFunctionCountersMode(_ mode: CInt) -> CInt
+@_silgen_name("_swift_getGlobalRuntimeFunctionCounters")
+func getGlobalRuntimeFunctionCounters(_ state: UnsafeMutableRawPointer) -> ()
+@_silgen_name("_swift_getNumRuntimeFunctionCounters")
+func getNumRuntimeFunctionCounters() -> UInt64
+@_silgen_name("_swift_getRuntimeFunctionNames")
+func getRuntimeFunctionNames() -> UnsafePointer<UnsafePointer<CChar>?>
+
+/// Return the current peak resident set size of this process, in bytes.
+func currentMaxRSS() -> UInt64 {
+  var u = rusage()
+  getrusage(RUSAGE_SELF, &u)
+#if os(Linux)
+  return UInt64(u.ru_maxrss) * 1024 // ru_maxrss is reported in kilobytes
+#else
+  return UInt64(u.ru_maxrss)
+#endif
+}
+
+/// Count the swift_allocObject calls made by one iteration of the
+/// benchmark. The counters are only updated by an assertions-enabled
+/// standard library; with a release standard library this reports 0.
+func countAllocations(_ test: Test) -> UInt64 {
+  let numCounters = Int(getNumRuntimeFunctionCounters())
+  let names = getRuntimeFunctionNames()
+  var allocIndex = -1
+  for i in 0..<numCounters {
+    if let name = names[i], String(cString: name) == "swift_allocObject" {
+      allocIndex = i
+      break
+    }
+  }
+  if allocIndex < 0 {
+    return 0
+  }
+
+  // The counter state is one 32-bit counter per tracked runtime function.
+  var before = [UInt32](repeating: 0, count: numCounters)
+  var after = [UInt32](repeating: 0, count: numCounters)
+
+  test.setUpFunction?()
+  let oldMode = setGlobalRuntimeFunctionCountersMode(1)
+  before.withUnsafeMutableBufferPointer {
+    getGlobalRuntimeFunctionCounters(UnsafeMutableRawPointer($0.baseAddress!))
+  }
+  test.runFunction(1)
+  after.withUnsafeMutableBufferPointer {
+    getGlobalRuntimeFunctionCounters(UnsafeMutableRawPointer($0.baseAddress!))
+  }
+  _ = setGlobalRuntimeFunctionCountersMode(oldMode)
+  test.tearDownFunction?()
+
+  return UInt64(after[allocIndex] &- before[allocIndex])
+}
+
 #if os(Linux)
 class Timer {
   typealias TimeT = timespec
@@ -341,18 +449,170 @@ class Timer {
 }
 #endif
 
+#if os(Linux)
+// The perf_event_open(2) and ioctl(2) entry points are variadic and
+// therefore not importable through the Glibc module; bind the symbols
+// directly instead.
+@_silgen_name("syscall")
+func _perf_event_syscall(_ number: CLong, _ attr: UnsafeMutableRawPointer,
+                         _ pid: CLong, _ cpu: CLong, _ groupFD: CLong,
+                         _ flags: CLong) -> CLong
+
+@_silgen_name("ioctl")
+func _perf_event_ioctl(_ fd: CInt, _ request: CUnsignedLong,
+                       _ arg: CLong) -> CInt
+
+/// Mirror of struct perf_event_attr from <linux/perf_event.h>
+/// (PERF_ATTR_SIZE_VER5). All fields are naturally aligned, so the Swift
+/// layout matches the C layout.
+struct PerfEventAttr {
+  var type: UInt32 = 0
+  var size: UInt32 = 112
+  var config: UInt64 = 0
+  var samplePeriodOrFreq: UInt64 = 0
+  var sampleType: UInt64 = 0
+  var readFormat: UInt64 = 0
+  var flags: UInt64 = 0
+  var wakeupEventsOrWatermark: UInt32 = 0
+  var bpType: UInt32 = 0
+  var bpAddrOrConfig1: UInt64 = 0
+  var bpLenOrConfig2: UInt64 = 0
+  var branchSampleType: UInt64 = 0
+  var sampleRegsUser: UInt64 = 0
+  var sampleStackUser: UInt32 = 0
+  var clockID: Int32 = 0
+  var sampleRegsIntr: UInt64 = 0
+  var auxWatermark: UInt32 = 0
+  var sampleMaxStack: UInt16 = 0
+  var reserved: UInt16 = 0
+}
+
+/// Samples hardware performance counters around a benchmark run using
+/// perf_event_open(2). Counting instructions retired and cycles alongside
+/// wall time lets us tell frequency-scaling and scheduler noise apart from
+/// real regressions; cache misses and branch mispredicts explain where
+/// regressions come from.
+class PerfCounters {
+  private static let sysPerfEventOpen: CLong = {
+#if arch(x86_64)
+    return 298
+#elseif arch(arm64)
+    return 241
+#elseif arch(powerpc64) || arch(powerpc64le)
+    return 319
+#elseif arch(s390x)
+    return 331
+#elseif arch(i386)
+    return 336
+#elseif arch(arm)
+    return 364
+#else
+    return -1
+#endif
+  }()
+
+  // PERF_COUNT_HW_* configs for the events we sample, in the order of the
+  // fields of PerfCounterValues.
+  private static let eventConfigs: [UInt64] = [
+    1, // PERF_COUNT_HW_INSTRUCTIONS
+    0, // PERF_COUNT_HW_CPU_CYCLES
+    3, // PERF_COUNT_HW_CACHE_MISSES
+    5, // PERF_COUNT_HW_BRANCH_MISSES
+  ]
+
+  // PERF_EVENT_IOC_{ENABLE,DISABLE,RESET}, applied to the whole event
+  // group via PERF_IOC_FLAG_GROUP.
+  private static let iocEnable: CUnsignedLong = 0x2400
+  private static let iocDisable: CUnsignedLong = 0x2401
+  private static let iocReset: CUnsignedLong = 0x2403
+  private static let iocFlagGroup: CLong = 1
+
+  /// One file descriptor per event; the first is the group leader, so all
+  /// four counters start and stop together.
+  private var fds: [CInt] = []
+
+  /// Fails when the kernel refuses the events, e.g. under a restrictive
+  /// perf_event_paranoid setting or on hardware without a PMU.
+  init?() {
+    if PerfCounters.sysPerfEventOpen < 0 { return nil }
+    for config in PerfCounters.eventConfigs {
+      var attr = PerfEventAttr()
+      attr.type = 0 // PERF_TYPE_HARDWARE
+      attr.config = config
+      // disabled | exclude_kernel | exclude_hv
+      attr.flags = 0x61
+      let groupFD = CLong(fds.first ?? -1)
+      let fd = withUnsafeMutablePointer(to: &attr) {
+        CInt(_perf_event_syscall(PerfCounters.sysPerfEventOpen,
+                                 UnsafeMutableRawPointer($0),
+                                 0, -1, groupFD, 0))
+      }
+      if fd < 0 {
+        for fd in fds { close(fd) }
+        return nil
+      }
+      fds.append(fd)
+    }
+  }
+
+  deinit {
+    for fd in fds { close(fd) }
+  }
+
+  func start() {
+    _ = _perf_event_ioctl(fds[0], PerfCounters.iocReset,
+                          PerfCounters.iocFlagGroup)
+    _ = _perf_event_ioctl(fds[0], PerfCounters.iocEnable,
+                          PerfCounters.iocFlagGroup)
+  }
+
+  func stop() -> PerfCounterValues {
+    _ = _perf_event_ioctl(fds[0], PerfCounters.iocDisable,
+                          PerfCounters.iocFlagGroup)
+    var counts = [UInt64](repeating: 0, count: fds.count)
+    for (i, fd) in fds.enumerated() {
+      var count: UInt64 = 0
+      if withUnsafeMutablePointer(to: &count, { read(fd, $0, 8) }) == 8 {
+        counts[i] = count
+      }
+    }
+    return PerfCounterValues(instructions: counts[0], cycles: counts[1],
+                             cacheMisses: counts[2], branchMisses: counts[3])
+  }
+}
+#else
+/// Hardware counter sampling needs the private kpc interfaces on Darwin,
+/// so the harness reports wall time only there.
+class PerfCounters {
+  init?() { return nil }
+  func start() {}
+  func stop() -> PerfCounterValues { return PerfCounterValues() }
+}
+#endif
+
 class SampleRunner {
   let timer = Timer()
+  let counters: PerfCounters?
+  var lastSampleCounters = PerfCounterValues()
+
+  init(measurePerfCounters: Bool) {
+    counters = measurePerfCounters ? PerfCounters() : nil
+  }
+
   func run(_ name: String, fn: (Int) -> Void, num_iters: UInt) -> UInt64 {
     // Start the timer.
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     var str = name
     startTrackingObjects(UnsafeMutableRawPointer(str._core.startASCII))
 #endif
+    counters?.start()
     let start_ticks = timer.getTime()
     fn(Int(num_iters))
     // Stop the timer.
     let end_ticks = timer.getTime()
+    if let counters = counters {
+      lastSampleCounters = counters.stop()
+    }
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     stopTrackingObjects(UnsafeMutableRawPointer(str._core.startASCII))
 #endif
@@ -365,12 +625,17 @@ class SampleRunner {
 /// Invoke the benchmark entry point and return the run time in milliseconds.
 func runBench(_ test: Test, _ c: TestConfig) -> BenchResults {
   var samples = [UInt64](repeating: 0, count: c.numSamples)
+  var instructions = [UInt64]()
+  var cycles = [UInt64]()
+  var cacheMisses = [UInt64]()
+  var branchMisses = [UInt64]()
 
   if c.verbose {
     print("Running \(test.name) for \(c.numSamples) samples.")
   }
 
-  let sampler = SampleRunner()
+  let sampler = SampleRunner(measurePerfCounters: c.measurePerfCounters)
+  let rssBefore = c.measureMemory ? currentMaxRSS() : 0
   for s in 0..<c.numSamples {
     let time_per_sample: UInt64 = 1_000_000_000 * UInt64(c.iterationScale)
 
@@ -410,14 +675,42 @@ func runBench(_ test: Test, _ c: TestConfig) -> BenchResults {
     if c.verbose {
       print("    Sample \(s),\(samples[s])")
     }
+    if sampler.counters != nil {
+      // Store per-iteration event counts, like the per-iteration time above.
+      let counts = sampler.lastSampleCounters
+      instructions.append(counts.instructions / UInt64(scale))
+      cycles.append(counts.cycles / UInt64(scale))
+      cacheMisses.append(counts.cacheMisses / UInt64(scale))
+      branchMisses.append(counts.branchMisses / UInt64(scale))
+      if c.verbose {
+        print("    Sample \(s) counters: \(instructions[s]) instrs,"
+          + " \(cycles[s]) cycles, \(cacheMisses[s]) cache misses,"
+          + " \(branchMisses[s]) branch misses")
+      }
+    }
   }
 
   let (mean, sd) = internalMeanSD(samples)
 
   // Return our benchmark results.
-  return BenchResults(delim: c.delim, sampleCount: UInt64(samples.count),
-                      min: samples.min()!, max: samples.max()!,
-                      mean: mean, sd: sd, median: internalMedian(samples))
+  var results = BenchResults(delim: c.delim, sampleCount: UInt64(samples.count),
+                             min: samples.min()!, max: samples.max()!,
+                             mean: mean, sd: sd, median: internalMedian(samples))
+  if sampler.counters != nil {
+    results.counters = PerfCounterValues(
+      instructions: internalMedian(instructions),
+      cycles: internalMedian(cycles),
+      cacheMisses: internalMedian(cacheMisses),
+      branchMisses: internalMedian(branchMisses))
+  }
+  if c.measureMemory {
+    results.maxRSS = currentMaxRSS() - rssBefore
+    // Count allocations in a separate, untimed run: tracking the global
+    // counters takes a lock on every tracked runtime call and would
+    // distort the timed samples.
+    results.allocations = countAllocations(test)
+  }
+  return results
 }
 
 func printRunInfo(_ c: TestConfig) {
@@ -429,6 +722,12 @@ func printRunInfo(_ c: TestConfig) {
     if c.fixedNumIters != 0 {
       print("FixedIters: \(c.fixedNumIters)")
     }
+    if c.measurePerfCounters {
+      print("PerfCounters: true")
+    }
+    if c.measureMemory {
+      print("Memory: true")
+    }
     print("Tests Filter: \(c.filters)")
     print("Tests to run: ", terminator: "")
     for t in c.tests {
@@ -442,7 +741,21 @@ func printRunInfo(_ c: TestConfig) {
 
 func runBenchmarks(_ c: TestConfig) {
   let units = "us"
-  print("#\(c.delim)TEST\(c.delim)SAMPLES\(c.delim)MIN(\(units))\(c.delim)MAX(\(units))\(c.delim)MEAN(\(units))\(c.delim)SD(\(units))\(c.delim)MEDIAN(\(units))")
+  var header = "#\(c.delim)TEST\(c.delim)SAMPLES\(c.delim)MIN(\(units))\(c.delim)MAX(\(units))\(c.delim)MEAN(\(units))\(c.delim)SD(\(units))\(c.delim)MEDIAN(\(units))"
+  if c.measureMemory {
+    header += "\(c.delim)MAX_RSS(B)\(c.delim)ALLOCS"
+  }
+  if c.measurePerfCounters {
+    if PerfCounters() == nil {
+      print("Warning: hardware performance counters are unavailable;"
+        + " reporting time only.")
+    } else {
+      // Median per-iteration event counts.
+      header += "\(c.delim)INSTRS\(c.delim)CYCLES"
+      header += "\(c.delim)CACHE_MISS\(c.delim)BRANCH_MISS"
+    }
+  }
+  print(header)
   var sumBenchResults = BenchResults()
   sumBenchResults.sampleCount = 0
 
@@ -117,6 +117,7 @@ import StringWalk
 import Substring
 import Suffix
 import SuperChars
+import ThreadScaling
 import TwoSum
 import TypeFlood
 import UTF8Decode
@@ -238,6 +239,7 @@ registerBenchmark(StringWalk)
 registerBenchmark(SubstringTest)
 registerBenchmark(Suffix)
 registerBenchmark(SuperChars)
+registerBenchmark(ThreadScaling)
 registerBenchmark(TwoSum)
 registerBenchmark(TypeFlood)
 registerBenchmark(UTF8Decode)
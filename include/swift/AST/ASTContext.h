@@ -20,6 +20,7 @@
 #include "llvm/Support/DataTypes.h"
 #include "swift/AST/ClangModuleLoader.h"
 #include "swift/AST/Identifier.h"
+#include "swift/AST/ProtocolConformanceRef.h"
 #include "swift/AST/SearchPathOptions.h"
 #include "swift/AST/SubstitutionList.h"
 #include "swift/AST/Type.h"
@@ -785,7 +786,79 @@ public:
 
   /// Record compiler-known protocol information in the AST.
   void recordKnownProtocols(ModuleDecl *Stdlib);
-  
+
+  /// \brief Retrieve a previously recorded answer for whether \p type
+  /// conforms to \p protocol when viewed from \p mod.
+  ///
+  /// \returns \c None if no answer has been recorded.  A recorded answer
+  /// may itself be \c None, capturing a negative lookup result.
+  Optional<Optional<ProtocolConformanceRef>>
+  getCachedConformsToProtocolResult(ModuleDecl *mod, Type type,
+                                    ProtocolDecl *protocol);
+
+  /// \brief Record the result of a module conformance lookup so that
+  /// later queries for the same (module, type, protocol) triple can skip
+  /// the search.  Results for types containing type variables are not
+  /// recorded.
+  void recordConformsToProtocolResult(ModuleDecl *mod, Type type,
+                                      ProtocolDecl *protocol,
+                                      Optional<ProtocolConformanceRef> result);
+
+  /// \brief Drop all recorded conformance lookup results, because a newly
+  /// bound extension may have introduced conformances that change
+  /// previously recorded answers.
+  void invalidateConformsToProtocolCache();
+
+  /// \brief Retrieve a previously recorded result of a qualified lookup
+  /// for \p name into \p importedModule as seen from \p importingModule.
+  ///
+  /// \returns true and appends the recorded declarations to \p decls on a
+  /// hit; returns false if no current answer has been recorded.
+  bool getCachedImportedModuleLookupResult(ModuleDecl *importingModule,
+                                           ModuleDecl *importedModule,
+                                           DeclName name,
+                                           SmallVectorImpl<ValueDecl *> &decls);
+
+  /// \brief Record the result of a qualified lookup into an imported
+  /// module.  Entries are implicitly invalidated when the generation
+  /// count changes, i.e. whenever new modules are loaded.
+  void recordImportedModuleLookupResult(ModuleDecl *importingModule,
+                                        ModuleDecl *importedModule,
+                                        DeclName name,
+                                        ArrayRef<ValueDecl *> decls);
+
+  /// \brief Retrieve the memoized contextually-canonical form of \p type
+  /// within \p sig, as recorded by \c recordCanonicalTypeInContext.
+  ///
+  /// \returns a null type if no form has been recorded.
+  CanType getCachedCanonicalTypeInContext(GenericSignature *sig, CanType type);
+
+  /// \brief Memoize the contextually-canonical form of \p type within
+  /// \p sig.  A signature's canonicalization answers never change once
+  /// its generic signature builder has been built, so entries are never
+  /// invalidated.
+  void recordCanonicalTypeInContext(GenericSignature *sig, CanType type,
+                                    CanType canonical);
+
+  /// \brief Release memoization caches that only pay for themselves while
+  /// the type checker is running.
+  ///
+  /// Everything released here is recomputed on demand, so this is safe to
+  /// call once SIL generation is complete to reduce the memory held across
+  /// IR generation.  Uniqued types, decls and generic environments are
+  /// untouched, since their pointer identity is still relied upon.
+  void releaseTypeCheckerCaches();
+
+  /// \brief Record the structural fingerprint computed for \p decl while
+  /// parsing, a hash of the source text the declaration covers.
+  void recordDeclFingerprint(const Decl *decl, uint64_t fingerprint);
+
+  /// \brief Retrieve the structural fingerprint recorded for \p decl.
+  ///
+  /// \returns \c None if no fingerprint was recorded, e.g. for declarations
+  /// that were not parsed from source.
+  Optional<uint64_t> getDeclFingerprint(const Decl *decl) const;
+
   /// Get the lazy data for the given declaration.
   ///
   /// \param lazyLoader If non-null, the lazy loader to use when creating the
@@ -273,7 +273,11 @@ public:
   }
 
   /// To sanitize a malformed utf8 string to a well-formed one.
-  static std::string sanitizeUtf8(StringRef Text);
+  ///
+  /// Returns \p Text unchanged when it is already well-formed; otherwise
+  /// the sanitized copy is built in \p Buffer and the result points into it.
+  static StringRef sanitizeUtf8(StringRef Text,
+                                llvm::SmallVectorImpl<char> &Buffer);
   static ValueDecl* findConformancesWithDocComment(ValueDecl *VD);
 
 private:
@@ -184,6 +184,14 @@ class ASTScope {
       ///
       /// This accommodates the expansion of source files.
       mutable unsigned nextElement;
+
+      /// The innermost scope found by the most recent call to
+      /// \c findInnermostEnclosingScope.
+      ///
+      /// Consecutive unqualified lookups are usually issued at the same or
+      /// nearby source locations, so the next search starts from here and
+      /// walks up rather than descending from the root each time.
+      mutable const ASTScope *lastInnermostScope;
     } sourceFile;
 
     /// A type declaration, for \c kind == ASTScopeKind::TypeDecl.
@@ -333,6 +341,7 @@ class ASTScope {
       : ASTScope(ASTScopeKind::SourceFile, nullptr) {
     this->sourceFile.file = sourceFile;
     this->sourceFile.nextElement = nextElement;
+    this->sourceFile.lastInnermostScope = nullptr;
   }
 
   /// Constructor that initializes a preexpanded node.
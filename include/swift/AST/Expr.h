@@ -260,6 +260,12 @@ protected:
     StringEncoding : 1
   );
 
+  SWIFT_INLINE_BITFIELD_FULL(InterpolatedStringLiteralExpr, LiteralExpr, 32,
+    : NumPadBits,
+    /// # of segments stored after the InterpolatedStringLiteralExpr.
+    NumSegments : 32
+  );
+
   SWIFT_INLINE_BITFIELD_FULL(ObjectLiteralExpr, LiteralExpr, 3+1+1+16,
     LitKind : 3,
     /// Whether the ObjectLiteralExpr also has source locations for the argument
@@ -942,20 +948,35 @@ public:
 /// \code
 /// "[\(min)..\(max)]"
 /// \endcode
-class InterpolatedStringLiteralExpr : public LiteralExpr {
+class InterpolatedStringLiteralExpr final : public LiteralExpr,
+    private llvm::TrailingObjects<InterpolatedStringLiteralExpr, Expr *> {
+  friend TrailingObjects;
+
   /// Points at the beginning quote.
   SourceLoc Loc;
-  MutableArrayRef<Expr *> Segments;
   Expr *SemanticExpr;
-  
-public:
-  InterpolatedStringLiteralExpr(SourceLoc Loc, MutableArrayRef<Expr *> Segments)
+
+  InterpolatedStringLiteralExpr(SourceLoc Loc, ArrayRef<Expr *> Segments)
     : LiteralExpr(ExprKind::InterpolatedStringLiteral, /*Implicit=*/false),
-      Loc(Loc), Segments(Segments), SemanticExpr() { }
-  
-  MutableArrayRef<Expr *> getSegments() { return Segments; }
-  ArrayRef<Expr *> getSegments() const { return Segments; }
-  
+      Loc(Loc), SemanticExpr() {
+    Bits.InterpolatedStringLiteralExpr.NumSegments = Segments.size();
+    std::uninitialized_copy(Segments.begin(), Segments.end(),
+                            getTrailingObjects<Expr *>());
+  }
+
+public:
+  static InterpolatedStringLiteralExpr *create(ASTContext &ctx, SourceLoc loc,
+                                               ArrayRef<Expr *> segments);
+
+  MutableArrayRef<Expr *> getSegments() {
+    return {getTrailingObjects<Expr *>(),
+            Bits.InterpolatedStringLiteralExpr.NumSegments};
+  }
+  ArrayRef<Expr *> getSegments() const {
+    return {getTrailingObjects<Expr *>(),
+            Bits.InterpolatedStringLiteralExpr.NumSegments};
+  }
+
   /// \brief Retrieve the expression that actually evaluates the resulting
   /// string, typically with a series of '+' operations.
   Expr *getSemanticExpr() const { return SemanticExpr; }
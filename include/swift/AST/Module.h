@@ -1052,6 +1052,22 @@ public:
   /// Set the root refinement context for the file.
   void setTypeRefinementContext(TypeRefinementContext *TRC);
 
+  /// A (name, fingerprint) pair for a named top-level declaration.
+  using DeclFingerprint = std::pair<StringRef, uint64_t>;
+
+  /// Collect the structural fingerprints recorded during parsing for this
+  /// file's named top-level declarations.
+  void getDeclFingerprints(
+      SmallVectorImpl<DeclFingerprint> &fingerprints) const;
+
+  /// Given fingerprint lists from two versions of a file, collect the names
+  /// whose declarations were added, removed, or structurally changed.
+  ///
+  /// The returned names point into the given fingerprint lists.
+  static void diffDeclFingerprints(ArrayRef<DeclFingerprint> oldFingerprints,
+                                   ArrayRef<DeclFingerprint> newFingerprints,
+                                   SmallVectorImpl<StringRef> &changedNames);
+
   void recordInterfaceToken(StringRef token) {
     assert(!token.empty());
     InterfaceHash.update(token);
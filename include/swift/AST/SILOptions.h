@@ -119,6 +119,19 @@ public:
   /// Don't generate code using partial_apply in SIL generation.
   bool DisableSILPartialApply = false;
 
+  /// In whole-module builds, delay SILGen of explicit functions that cannot
+  /// be referenced from outside the module until they are first referenced.
+  ///
+  /// Note that functions that are never referenced are never emitted, so
+  /// their bodies do not receive SIL-level diagnostics; this is why the
+  /// option is opt-in.
+  bool EnableOnDemandSILGen = false;
+
+  /// Serialize the bodies of small public functions into the module file so
+  /// that the optimizer can inline them into client modules. Only functions
+  /// which reference nothing but public symbols and types are eligible.
+  bool EnableCrossModuleSerialization = false;
+
   /// The name of the SIL outputfile if compiled with SIL debugging (-gsil).
   std::string SILOutputFileNameForDebugging;
 
@@ -467,6 +467,28 @@ public:
     return *this;
   }
 
+  /// Exclusive-or a bit-vector of the same size into this vector.
+  ClusteredBitVector &operator^=(const ClusteredBitVector &other) {
+    assert(size() == other.size());
+
+    // If the other vector is all-clear, this is a no-op.
+    if (other.isInlineAndAllClear())
+      return *this;
+
+    // If this vector is all-clear, we just copy the other.
+    if (isInlineAndAllClear()) {
+      return (*this = other);
+    }
+
+    // Otherwise, ^= the chunks pairwise.
+    auto chunks = getChunks();
+    auto oi = other.getChunksPtr();
+    for (auto i = chunks.begin(), e = chunks.end(); i != e; ++i, ++oi) {
+      *i ^= *oi;
+    }
+    return *this;
+  }
+
   /// Set bit i.
   void setBit(size_t i) {
     assert(i < size());
@@ -47,7 +47,11 @@ protected:
   llvm::SmallVector<WordReplacement, 8> SubstWordsInIdent;
 
   /// Substitutions, except identifier substitutions.
-  llvm::DenseMap<const void *, unsigned> Substitutions;
+  ///
+  /// The inline bucket storage covers the common case without a heap
+  /// allocation: manglers are constructed fresh for each mangling
+  /// operation, and IRGen performs tens of thousands of them per module.
+  llvm::SmallDenseMap<const void *, unsigned, 16> Substitutions;
 
   /// Identifier substitutions.
   llvm::StringMap<unsigned> StringSubstitutions;
@@ -39,6 +39,7 @@
 #include "swift/Basic/type_traits.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/PointerIntPair.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <iterator>
@@ -132,6 +133,19 @@ private:
     }
   };
 
+  /// Nodes live in a slab allocator: the map never deletes individual
+  /// nodes (there is no erase operation), so whole-map teardown can just
+  /// drop the slabs, and nodes end up packed in creation order, which
+  /// tracks descent order and keeps prefix walks cache-friendly.
+  llvm::SpecificBumpPtrAllocator<Node> NodeAllocator;
+
+  Node *allocateNode() {
+    return ::new (NodeAllocator.Allocate()) Node();
+  }
+  Node *allocateNode(const Node &other) {
+    return ::new (NodeAllocator.Allocate()) Node(other);
+  }
+
   /// Splits a node in two.  The second part must always be non-empty.
   ///
   ///   ref -> cur 'abcdef' -> ...
@@ -145,12 +159,12 @@ private:
   ///   ref -> cur 'abcdefg' -> further 'hij'
   /// =>
   ///   ref -> cur 'abc' -> further 'defghij'
-  static Node *splitNode(Node **ref, size_t splitIndex) {
+  Node *splitNode(Node **ref, size_t splitIndex) {
     auto cur = *ref;
     assert(splitIndex < cur->KeyLength &&
            "split index would leave second node with empty key");
 
-    auto split = new Node();
+    auto split = allocateNode();
     split->Further = cur;
 
     // Move the sibling links of cur onto split unless we're giving split
@@ -288,7 +302,7 @@ private:
     // Otherwise, create nodes until we're out of lookup key.
     // TODO: balance the subtree when creating nodes to the left or right.
     do {
-      best = new Node();
+      best = allocateNode();
       *next = best;
       next = &best->Further;
 
@@ -301,41 +315,25 @@ private:
     return best;
   }
 
-  /// Delete all the nodes in a subtree.
-  static void deleteTree(Node *root) {
-    if (!root) return;
-
-    SmallVector<Node *, 8> stack;
-    auto pushChildrenAndDelete = [&](Node *node) {
-      if (node->Left) stack.push_back(node->Left);
-      if (node->Right) stack.push_back(node->Right);
-      if (node->Further) stack.push_back(node->Further);
-      delete node;
-    };
-    pushChildrenAndDelete(root);
-    while (!stack.empty()) {
-      pushChildrenAndDelete(stack.pop_back_val());
-    }
-  }
-
-  /// Copy all the nodes in a subtree.
-  static Node *cloneTree(Node *root) {
+  /// Copy all the nodes in a subtree into this map's allocator.
+  Node *cloneTree(const Node *root) {
     if (!root) return nullptr;
 
+    Node *rootCopy = const_cast<Node *>(root);
     SmallVector<Node **, 8> stack;
     auto copyAndPushChildren = [&](Node **ptr) {
       assert(*ptr);
-      Node *copy = new Node(**ptr);
+      Node *copy = allocateNode(**ptr);
       *ptr = copy;
       if (copy->Left) stack.push_back(&copy->Left);
       if (copy->Right) stack.push_back(&copy->Right);
       if (copy->Further) stack.push_back(&copy->Further);
     };
-    copyAndEnqueueChildren(&root);
+    copyAndPushChildren(&rootCopy);
     while (!stack.empty()) {
-      copyAndEnqueueChildren(stack.pop_back_val());
+      copyAndPushChildren(stack.pop_back_val());
     }
-    return root;
+    return rootCopy;
   }
 
   Node *Root = nullptr;
@@ -344,24 +342,23 @@ public:
   PrefixMap() {}
 
   PrefixMap(const PrefixMap &other) : Root(cloneTree(other.Root)) {}
-  PrefixMap(PrefixMap &&other) : Root(other.Root) {
+  PrefixMap(PrefixMap &&other)
+      : NodeAllocator(std::move(other.NodeAllocator)), Root(other.Root) {
     other.Root = nullptr;
   }
   PrefixMap &operator=(const PrefixMap &other) {
-    deleteTree(Root);
+    NodeAllocator = llvm::SpecificBumpPtrAllocator<Node>();
     Root = cloneTree(other.Root);
     return *this;
   }
   PrefixMap &operator=(PrefixMap &&other) {
-    deleteTree(Root);
+    NodeAllocator = std::move(other.NodeAllocator);
     Root = other.Root;
     other.Root = nullptr;
     return *this;
   }
 
-  ~PrefixMap() {
-    deleteTree(Root);
-  }
+  ~PrefixMap() = default;
 
   /// Are there any entries in this map?
   bool empty() const {
@@ -574,7 +571,7 @@ public:
 
   /// Remove all entries in the map.
   void clear() {
-    deleteTree(Root);
+    NodeAllocator = llvm::SpecificBumpPtrAllocator<Node>();
     Root = nullptr;
   }
 
@@ -14,10 +14,12 @@
 #define SWIFT_BASIC_SOURCEMANAGER_H
 
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
+#include <vector>
 
 namespace swift {
 
@@ -42,6 +44,11 @@ class SourceManager {
   std::map<const char *, VirtualFile> VirtualFiles;
   mutable std::pair<const char *, const VirtualFile*> CachedVFile = {nullptr, nullptr};
 
+  /// For each buffer that has been queried, the sorted offsets of the starts
+  /// of its lines, built on first use. Buffers are immutable once added, so
+  /// entries never need invalidating.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> LineStartOffsets;
+
 public:
   llvm::SourceMgr &getLLVMSourceMgr() {
     return LLVMSourceMgr;
@@ -180,24 +187,14 @@ public:
   ///
   /// This respects #line directives.
   std::pair<unsigned, unsigned>
-  getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const {
-    assert(Loc.isValid());
-    int LineOffset = getLineOffset(Loc);
-    int l, c;
-    std::tie(l, c) = LLVMSourceMgr.getLineAndColumn(Loc.Value, BufferID);
-    assert(LineOffset+l > 0 && "bogus line offset");
-    return { LineOffset + l, c };
-  }
+  getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const;
 
   /// Returns the real line number for a source location.
   ///
   /// If \p BufferID is provided, \p Loc must come from that source buffer.
   ///
   /// This does not respect #line directives.
-  unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const {
-    assert(Loc.isValid());
-    return LLVMSourceMgr.FindLineNumber(Loc.Value, BufferID);
-  }
+  unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const;
 
   StringRef getEntireTextForBuffer(unsigned BufferID) const;
 
@@ -225,6 +222,10 @@ public:
 private:
   const VirtualFile *getVirtualFile(SourceLoc Loc) const;
 
+  /// Returns the sorted offsets of the line starts in the given buffer,
+  /// computing and caching them on first use.
+  ArrayRef<unsigned> getLineStartOffsets(unsigned BufferID) const;
+
   int getLineOffset(SourceLoc Loc) const {
     if (auto VFile = getVirtualFile(Loc))
       return VFile->LineOffset;
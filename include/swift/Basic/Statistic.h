@@ -104,11 +104,22 @@ public:
     SourceRange SourceRange;
   };
 
+  /// A begin or end event for a FrontendStatsTracer scope, for emission in
+  /// Chrome's trace-event format.
+  struct ChromeTraceEvent
+  {
+    uint64_t TimeUSec;
+    bool IsBegin;
+    StringRef EventName;
+    SourceRange SourceRange;
+  };
+
 private:
   bool currentProcessExitStatusSet;
   int currentProcessExitStatus;
   SmallString<128> StatsFilename;
   SmallString<128> TraceFilename;
+  SmallString<128> ChromeTraceFilename;
   llvm::TimeRecord StartedTime;
   std::unique_ptr<llvm::NamedRegionTimer> Timer;
   SourceManager *SourceMgr;
@@ -116,6 +127,10 @@ private:
   std::unique_ptr<AlwaysOnFrontendCounters> FrontendCounters;
   std::unique_ptr<AlwaysOnFrontendCounters> LastTracedFrontendCounters;
   std::vector<FrontendStatsEvent> FrontendStatsEvents;
+  bool ChromeTracing;
+  std::vector<ChromeTraceEvent> ChromeTraceEvents;
+  uint64_t TracerSampleRate;
+  uint64_t TracerSampleCount;
   std::unique_ptr<AlwaysOnFrontendRecursiveSharedTimers>
       FrontendRecursiveSharedTimers;
 
@@ -126,7 +141,8 @@ private:
                        StringRef AuxName,
                        StringRef Directory,
                        SourceManager *SM,
-                       bool TraceEvents);
+                       bool TraceEvents,
+                       bool ChromeTraceEvents);
 public:
   UnifiedStatsReporter(StringRef ProgramName,
                        StringRef ModuleName,
@@ -136,13 +152,21 @@ public:
                        StringRef OptType,
                        StringRef Directory,
                        SourceManager *SM=nullptr,
-                       bool TraceEvents=false);
+                       bool TraceEvents=false,
+                       bool ChromeTraceEvents=false);
   ~UnifiedStatsReporter();
 
   AlwaysOnDriverCounters &getDriverCounters();
   AlwaysOnFrontendCounters &getFrontendCounters();
   AlwaysOnFrontendRecursiveSharedTimers &getFrontendRecursiveSharedTimers();
   void noteCurrentProcessExitStatus(int);
+
+  /// Record only one in \p N tracer scopes; the rest get inert tracers. The
+  /// always-on counters are unaffected, but counter changes made during an
+  /// unrecorded scope are attributed to the enclosing or next recorded one.
+  /// 0 or 1 records every scope.
+  void setTracerSampleRate(uint64_t N);
+
   FrontendStatsTracer getStatsTracer(StringRef N,
                                      SourceRange const &R);
   void saveAnyFrontendStatsEvents(FrontendStatsTracer const& T,
@@ -15,9 +15,11 @@
 
 #include "swift/Basic/LLVM.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/Program.h"
 
+#include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -38,21 +40,47 @@ enum class TaskFinishedResponse {
   StopExecution,
 };
 
+/// \brief Resource usage measured for a finished task, on platforms where it
+/// can be measured.
+struct TaskStatistics {
+  /// The peak resident set size in bytes, or 0 if unknown.
+  uint64_t PeakMemoryUsage = 0;
+
+  /// Time spent executing in user mode, in microseconds.
+  uint64_t UserTimeUsec = 0;
+
+  /// Time spent executing in kernel mode, in microseconds.
+  uint64_t SystemTimeUsec = 0;
+};
+
 /// \brief A class encapsulating the execution of multiple tasks in parallel.
 class TaskQueue {
+protected:
   /// Tasks which have not begun execution.
-  std::queue<std::unique_ptr<Task>> QueuedTasks;
+  std::deque<std::unique_ptr<Task>> QueuedTasks;
 
   /// The number of tasks to execute in parallel.
   unsigned NumberOfParallelTasks;
 
+  /// An approximate limit, in bytes, on the combined estimated memory usage
+  /// of the tasks executing at any one time. If 0, admission is limited only
+  /// by \c NumberOfParallelTasks. Best effort; a task whose estimate is
+  /// wrong can still exceed the budget.
+  uint64_t MemoryBudget;
+
+  /// The resource usage observed for each completed task, on platforms where
+  /// that can be measured.
+  llvm::DenseMap<ProcessId, TaskStatistics> FinishedTaskStats;
+
 public:
   /// \brief Create a new TaskQueue instance.
   ///
   /// \param NumberOfParallelTasks indicates the number of tasks which should
   /// be run in parallel. If 0, the TaskQueue will choose the most appropriate
   /// number of parallel tasks for the current system.
-  TaskQueue(unsigned NumberOfParallelTasks = 0);
+  /// \param MemoryBudget if nonzero, an approximate limit in bytes on the
+  /// combined estimated memory usage of concurrently executing tasks.
+  TaskQueue(unsigned NumberOfParallelTasks = 0, uint64_t MemoryBudget = 0);
   virtual ~TaskQueue();
 
   // TODO: remove once -Wdocumentation stops warning for \param, \returns on
@@ -131,9 +159,18 @@ public:
   /// must be null-terminated. If empty, inherits the parent's environment.
   /// \param Context an optional context which will be associated with the task
   /// \param SeparateErrors Controls whether error output is reported separately
+  /// \param EstimatedMemoryUsage the expected peak memory usage of the task in
+  /// bytes, used for admission control when a memory budget is set. 0 means
+  /// unknown; such tasks are charged an equal share of the budget.
+  /// \param EstimatedCost an estimate of how long the task will run, in
+  /// arbitrary units; only relative magnitudes matter. Among the tasks
+  /// eligible to run, the one with the largest cost is started first. 0 means
+  /// unknown; such tasks are assumed to be expensive.
   virtual void addTask(const char *ExecPath, ArrayRef<const char *> Args,
                        ArrayRef<const char *> Env = llvm::None,
-                       void *Context = nullptr, bool SeparateErrors = false);
+                       void *Context = nullptr, bool SeparateErrors = false,
+                       uint64_t EstimatedMemoryUsage = 0,
+                       uint64_t EstimatedCost = 0);
 
   /// \brief Synchronously executes the tasks in the TaskQueue.
   ///
@@ -153,6 +190,18 @@ public:
   bool hasRemainingTasks() {
     return !QueuedTasks.empty();
   }
+
+  /// \returns the peak resident set size, in bytes, observed for the task
+  /// which executed with the given process ID, or 0 if it was not measured.
+  uint64_t getPeakMemoryUsage(ProcessId Pid) const {
+    return FinishedTaskStats.lookup(Pid).PeakMemoryUsage;
+  }
+
+  /// \returns the resource usage observed for the task which executed with
+  /// the given process ID. Fields which were not measured are 0.
+  TaskStatistics getTaskStatistics(ProcessId Pid) const {
+    return FinishedTaskStats.lookup(Pid);
+  }
 };
 
 /// \brief A class which simulates execution of tasks with behavior similar to
@@ -182,7 +231,9 @@ public:
 
   virtual void addTask(const char *ExecPath, ArrayRef<const char *> Args,
                        ArrayRef<const char *> Env = llvm::None,
-                       void *Context = nullptr, bool SeparateErrors = false);
+                       void *Context = nullptr, bool SeparateErrors = false,
+                       uint64_t EstimatedMemoryUsage = 0,
+                       uint64_t EstimatedCost = 0);
 
   virtual bool
   execute(TaskBeganCallback Began = TaskBeganCallback(),
@@ -305,6 +305,13 @@ public:
   DeclName importName(const clang::NamedDecl *D,
                       clang::DeclarationName givenName);
 
+  /// Returns the path of a PCH for the configured bridging header, building
+  /// it under -pch-output-dir if no valid one exists yet. The filename is
+  /// keyed by the Swift invocation hash and the Clang module hash, so every
+  /// frontend job of a build session (and of later sessions, as long as
+  /// nothing the header depends on changes) loads the same PCH instead of
+  /// re-parsing the header. Returns None if no PCH can be used, in which
+  /// case the header is imported textually.
   Optional<std::string>
   getOrCreatePCH(const ClangImporterOptions &ImporterOptions,
                  StringRef SwiftPCHHash);
@@ -23,6 +23,7 @@
 #include <string>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include "llvm/ADT/StringRef.h"
 
 namespace llvm {
@@ -235,6 +236,7 @@ inline bool isMangledName(llvm::StringRef MangledName) {
 bool isSwiftSymbol(const char *mangledName);
 
 class Demangler;
+class NodeInterningCache;
 
 /// The demangler context.
 ///
@@ -255,6 +257,7 @@ class Demangler;
 ///
 class Context {
   Demangler *D;
+  NodeInterningCache *Cache = nullptr;
 
   friend class Node;
 
@@ -329,6 +332,52 @@ public:
   /// The memory which is used for nodes is not freed but recycled for the next
   /// demangling operation.
   void clear();
+
+  /// Memoize symbol demangling through \p Cache, or detach the current cache
+  /// if \p Cache is null.
+  ///
+  /// While a cache is attached, demangleSymbolAsNode and
+  /// demangleSymbolAsString return trees owned by the cache instead of by
+  /// this context; those trees survive clear() and the destruction of the
+  /// context. Several contexts - including contexts on different threads -
+  /// may share one cache.
+  void setInterningCache(NodeInterningCache *Cache);
+};
+
+/// A thread-safe cache of demangled node trees, keyed by the hash of the
+/// mangled name.
+///
+/// Clients which demangle the same symbols over and over again (e.g. crash
+/// symbolication) can attach one cache to their contexts to demangle each
+/// distinct symbol only once. The cache owns the trees it hands out: they are
+/// immutable, live until the cache is destructed, and may be read from
+/// multiple threads concurrently. Callers must not mutate a cached tree.
+///
+/// The memory used for cached trees is never recycled, so a cache is only
+/// appropriate for a bounded set of hot symbols.
+class NodeInterningCache {
+  struct Implementation;
+  Implementation *Impl;
+
+public:
+  NodeInterningCache();
+
+  ~NodeInterningCache();
+
+  NodeInterningCache(const NodeInterningCache &) = delete;
+  NodeInterningCache &operator=(const NodeInterningCache &) = delete;
+
+  /// Returns the cached parse tree for \p MangledName, demangling it and
+  /// inserting it into the cache on a miss.
+  ///
+  /// \returns A parse tree for the demangled string - or a null pointer
+  /// on failure. Failures are cached as well, so repeated lookups of a
+  /// non-demanglable name do not re-run the demangler.
+  NodePointer getOrDemangleSymbolAsNode(llvm::StringRef MangledName);
+
+  /// Returns the number of mangled names in the cache, including names which
+  /// failed to demangle.
+  size_t size() const;
 };
 
 /// Standalone utility function to demangle the given symbol as string.
@@ -342,6 +391,24 @@ std::string
 demangleSymbolAsString(const char *mangledName, size_t mangledNameLength,
                        const DemangleOptions &options = DemangleOptions());
 
+/// Standalone utility function to demangle the given symbol into the
+/// caller-provided fixed-size \p OutputBuffer, as a NUL-terminated string.
+///
+/// Node allocation uses a stack-allocated arena and the output is written
+/// directly into \p OutputBuffer, so as long as the demangled tree fits into
+/// the arena this function does not allocate memory at all. This makes it
+/// usable for in-process backtrace symbolication from a signal handler
+/// (exceptionally large symbols can still overflow the arena into malloc).
+/// If \p MangledName cannot be demangled, it is copied to the output
+/// unchanged, mirroring the std::string overloads.
+///
+/// \returns The number of bytes written, not counting the terminating NUL
+/// (at most \p OutputBufferSize - 1); names which do not fit are truncated.
+size_t
+demangleSymbolAsString(llvm::StringRef MangledName, char *OutputBuffer,
+                       size_t OutputBufferSize,
+                       const DemangleOptions &options = DemangleOptions());
+
 /// Standalone utility function to demangle the given symbol as string.
 ///
 /// If performance is an issue when demangling multiple symbols,
@@ -422,6 +489,41 @@ void mangleIdentifier(const char *data, size_t length,
 /// This should always round-trip perfectly with demangleSymbolAsNode.
 std::string mangleNode(const NodePointer &root);
 
+/// A reusable context for the remangler.
+///
+/// mangleNode() pays for a fresh output buffer, substitution table and node
+/// factory on every call. Clients which mangle overlapping trees repeatedly
+/// (IRGen and TBDGen remangle the same generic signatures over and over) can
+/// route their calls through one of these instead: the remangling machinery
+/// is reused across calls, and the mangled string of every distinct tree is
+/// cached under a deep structural hash, so mangling a tree a second time is
+/// a lookup and a copy.
+///
+/// The cache grows with the number of distinct trees and is never pruned;
+/// it is not thread-safe.
+class RemanglingCache {
+  struct Implementation;
+  Implementation *Impl;
+
+public:
+  RemanglingCache();
+
+  ~RemanglingCache();
+
+  RemanglingCache(const RemanglingCache &) = delete;
+  RemanglingCache &operator=(const RemanglingCache &) = delete;
+
+  /// Remangles \p Root like the global mangleNode(), returning the cached
+  /// string if an equal tree was mangled through this cache before.
+  ///
+  /// The cache copies what it needs of \p Root, so the tree may be
+  /// deallocated after the call.
+  std::string mangleNode(NodePointer Root);
+
+  /// Returns the number of distinct trees in the cache.
+  size_t size() const;
+};
+
 /// Remangle in the old mangling scheme.
 ///
 /// This is only used for objc-runtime names and should be removed as soon as
@@ -444,18 +546,41 @@ std::string mangleNodeOld(const NodePointer &root);
 std::string nodeToString(NodePointer Root,
                          const DemangleOptions &Options = DemangleOptions());
 
-/// A class for printing to a std::string.
+/// Transform the node structure into a NUL-terminated string in the
+/// caller-provided fixed-size \p OutputBuffer.
+///
+/// Unlike the std::string overload, this never allocates memory for the
+/// output; names which do not fit into the buffer are truncated.
+///
+/// \returns The number of bytes written, not counting the terminating NUL
+/// (at most \p OutputBufferSize - 1).
+size_t nodeToString(NodePointer Root, char *OutputBuffer,
+                    size_t OutputBufferSize,
+                    const DemangleOptions &Options = DemangleOptions());
+
+/// A class for printing to a std::string or to a caller-provided fixed-size
+/// buffer.
 class DemanglerPrinter {
 public:
   DemanglerPrinter() = default;
 
+  /// Creates a printer which writes into the fixed-size \p Buffer of
+  /// \p Size bytes instead of into a heap-allocated string.
+  ///
+  /// Output which does not fit into the buffer is dropped; isTruncated()
+  /// tells whether that happened. Such a printer never allocates memory,
+  /// which makes it usable in contexts where malloc must be avoided, e.g.
+  /// signal handlers.
+  DemanglerPrinter(char *Buffer, size_t Size)
+      : FixedBuffer(Buffer), FixedCapacity(Size) {}
+
   DemanglerPrinter &operator<<(llvm::StringRef Value) & {
-    Stream.append(Value.data(), Value.size());
+    append(Value.data(), Value.size());
     return *this;
   }
-  
+
   DemanglerPrinter &operator<<(char c) & {
-    Stream.push_back(c);
+    append(&c, 1);
     return *this;
   }
   DemanglerPrinter &operator<<(unsigned long long n) &;
@@ -478,17 +603,52 @@ public:
     return std::move(*this << std::forward<T>(x));
   }
   
-  std::string &&str() && { return std::move(Stream); }
+  std::string &&str() && {
+    assert(!FixedBuffer && "printer writes to a fixed buffer");
+    return std::move(Stream);
+  }
 
-  llvm::StringRef getStringRef() const { return Stream; }
+  llvm::StringRef getStringRef() const {
+    if (FixedBuffer)
+      return llvm::StringRef(FixedBuffer, FixedSize);
+    return Stream;
+  }
 
   /// Shrinks the buffer.
   void resetSize(size_t toPos) {
+    if (FixedBuffer) {
+      assert(toPos <= FixedSize);
+      FixedSize = toPos;
+      return;
+    }
     assert(toPos <= Stream.size());
     Stream.resize(toPos);
   }
+
+  /// Returns true if output was dropped because it did not fit into a
+  /// fixed-size buffer.
+  bool isTruncated() const { return Truncated; }
+
 private:
+  void append(const char *Data, size_t NumBytes) {
+    if (!FixedBuffer) {
+      Stream.append(Data, NumBytes);
+      return;
+    }
+    size_t Space = FixedCapacity - FixedSize;
+    if (NumBytes > Space) {
+      NumBytes = Space;
+      Truncated = true;
+    }
+    memcpy(FixedBuffer + FixedSize, Data, NumBytes);
+    FixedSize += NumBytes;
+  }
+
   std::string Stream;
+  char *FixedBuffer = nullptr;
+  size_t FixedCapacity = 0;
+  size_t FixedSize = 0;
+  bool Truncated = false;
 };
 
 /// Returns a the node kind \p k as string.
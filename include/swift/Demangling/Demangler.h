@@ -56,6 +56,14 @@ class NodeFactory {
   /// The head of the single-linked slab list.
   Slab *CurrentSlab = nullptr;
 
+  /// Caller-provided memory used before any slab is malloced.
+  ///
+  /// See providePreallocatedMemory.
+  char *BorrowedMemory = nullptr;
+
+  /// The size of BorrowedMemory.
+  size_t BorrowedSize = 0;
+
   /// The size of the previously allocated slab.
   ///
   /// The slab size can only grow, even clear() does not reset the slab size.
@@ -86,7 +94,24 @@ public:
   }
   
   virtual void clear();
-  
+
+  /// Provides pre-allocated memory, e.g. memory on the stack.
+  ///
+  /// The provided memory is used before any slab is malloced, so as long as
+  /// all demangled trees fit into \p Size bytes, the factory does not call
+  /// malloc at all. It is only legal to call this before anything is
+  /// allocated with the factory. The memory is borrowed: the factory never
+  /// frees it and the caller must keep it alive as long as the factory (and
+  /// the trees created with it) are in use.
+  void providePreallocatedMemory(char *Memory, size_t Size) {
+    assert(!CurrentSlab && CurPtr == End &&
+           "memory must be provided before allocating");
+    BorrowedMemory = Memory;
+    BorrowedSize = Size;
+    CurPtr = Memory;
+    End = Memory + Size;
+  }
+
   /// Allocates an object of type T or an array of objects of type T.
   template<typename T> T *Allocate(size_t NumObjects = 1) {
     size_t ObjectSize = NumObjects * sizeof(T);
@@ -495,7 +520,22 @@ public:
   /// Demangler or with a call of clear().
   NodePointer demangleType(StringRef MangledName);
 };
-  
+
+/// A demangler which uses stack space for its initial memory.
+///
+/// The \p Size parameter specifies the size of the stack space. As long as
+/// the demangled tree fits into it, demangling does not malloc, which makes
+/// this class usable in contexts where the heap must be avoided, e.g. when
+/// symbolicating a backtrace from a signal handler.
+template <size_t Size> class StackAllocatedDemangler : public Demangler {
+  char StackSpace[Size];
+
+public:
+  StackAllocatedDemangler() {
+    providePreallocatedMemory(StackSpace, Size);
+  }
+};
+
 NodePointer demangleOldSymbolAsNode(StringRef MangledName,
                                     NodeFactory &Factory);
 } // end namespace Demangle
@@ -137,9 +137,28 @@ public:
     Status status = UpToDate;
     llvm::sys::TimePoint<> previousModTime;
 
+    /// The peak memory usage, in bytes, observed when this input was last
+    /// compiled, or 0 if unknown. Used to schedule jobs against a memory
+    /// budget.
+    uint64_t previousPeakMemory = 0;
+
+    /// How long it took to compile this input last time, in nanoseconds, or
+    /// 0 if unknown. Used to schedule long-running jobs first.
+    uint64_t previousCompileDuration = 0;
+
+    /// A hash of this input's contents when it was last compiled, or 0 if
+    /// unknown. Consulted when the modification time has changed, so that
+    /// touched-but-identical files don't trigger rebuilds.
+    uint64_t previousContentHash = 0;
+
     InputInfo() = default;
-    InputInfo(Status stat, llvm::sys::TimePoint<> time)
-        : status(stat), previousModTime(time) {}
+    InputInfo(Status stat, llvm::sys::TimePoint<> time,
+              uint64_t peakMemory = 0, uint64_t compileDuration = 0,
+              uint64_t contentHash = 0)
+        : status(stat), previousModTime(time),
+          previousPeakMemory(peakMemory),
+          previousCompileDuration(compileDuration),
+          previousContentHash(contentHash) {}
 
     static InputInfo makeNewlyAdded() {
       return InputInfo(Status::NewlyAdded, llvm::sys::TimePoint<>::max());
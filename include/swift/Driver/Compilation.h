@@ -125,6 +125,12 @@ private:
   /// parallel.
   unsigned NumberOfParallelCommands;
 
+  /// An approximate limit, in bytes, on the combined estimated memory usage
+  /// of the commands running in parallel, or 0 for no limit.
+  ///
+  /// \sa sys::TaskQueue
+  uint64_t MemoryBudget = 0;
+
   /// Indicates whether this Compilation should use skip execution of
   /// subtasks during performJobs() by using a dummy TaskQueue.
   ///
@@ -158,6 +164,12 @@ private:
   /// detail than ShowIncrementalBuildDecisions.
   bool ShowJobLifecycle = false;
 
+  /// When true, the dependency graph may use per-declaration fingerprints
+  /// to narrow incremental cascades. Experimental and off by default.
+  ///
+  /// \sa DependencyGraphImpl::enableFingerprintCascades
+  bool EnableFingerprintCascades = false;
+
   /// When true, some frontend job has requested permission to pass
   /// -emit-loaded-module-trace, so no other job needs to do it.
   bool PassedEmitLoadedModuleTraceToFrontendJob = false;
@@ -239,6 +251,10 @@ public:
     ShowJobLifecycle = value;
   }
 
+  void setEnableFingerprintCascades(bool value = true) {
+    EnableFingerprintCascades = value;
+  }
+
   void setCompilationRecordPath(StringRef path) {
     assert(CompilationRecordPath.empty() && "already set");
     CompilationRecordPath = path;
@@ -248,6 +264,10 @@ public:
     LastBuildTime = time;
   }
 
+  void setMemoryBudget(uint64_t bytes) {
+    MemoryBudget = bytes;
+  }
+
   /// Requests the path to a file containing all input source files. This can
   /// be shared across jobs.
   ///
@@ -133,8 +133,37 @@ private:
   /// \sa SourceFile::getInterfaceHash
   llvm::DenseMap<const void *, std::string> InterfaceHashes;
 
+  /// The per-declaration fingerprints for each node, aggregated by the names
+  /// used in the node's "provides" sets.
+  ///
+  /// \sa SourceFile::getDeclFingerprints
+  llvm::DenseMap<const void *, llvm::StringMap<uint64_t>> DeclFingerprints;
+
+  /// For nodes whose dependency files have been reloaded after an initial
+  /// load, the names whose fingerprints were added, removed, or changed in
+  /// the most recent reload. An entry with an empty set means the reload
+  /// proved that no declaration changed; no entry at all means there is no
+  /// fingerprint information and every provided name must be treated as
+  /// changed.
+  llvm::DenseMap<const void *, llvm::StringSet<>> ChangedFingerprintNames;
+
+  /// Whether markTransitive may use the fingerprint diff to filter the
+  /// starting node's cascade. Off by default: dependency tracking attributes
+  /// a lookup to the file containing the lookup context, so a primary that
+  /// uses a type does not record edges on same-file helpers of that type.
+  /// The full-file cascade covers that gap; the filtered one does not, which
+  /// makes filtering unsound until the attribution gap is closed.
+  ///
+  /// \sa Options.td driver_enable_fingerprint_cascades
+  bool FilterCascadesByFingerprints = false;
+
   LoadResult loadFromBuffer(const void *node, llvm::MemoryBuffer &buffer);
 
+  /// Diff newly-loaded fingerprints against the previous load of \p node,
+  /// updating \c DeclFingerprints and \c ChangedFingerprintNames.
+  void updateDeclFingerprints(const void *node, bool sawFingerprints,
+                              llvm::StringMap<uint64_t> newFingerprints);
+
   // FIXME: We should be able to use llvm::mapped_iterator for this, but
   // StringMapConstIterator isn't quite an InputIterator (no ->).
   class StringSetIterator {
@@ -187,6 +216,13 @@ protected:
   }
 
 public:
+  /// Opt in to narrowing cascades with per-declaration fingerprints.
+  ///
+  /// \sa FilterCascadesByFingerprints
+  void enableFingerprintCascades() {
+    FilterCascadesByFingerprints = true;
+  }
+
   llvm::iterator_range<StringSetIterator> getExternalDependencies() const {
     return llvm::make_range(StringSetIterator(ExternalDependencies.begin()),
                             StringSetIterator(ExternalDependencies.end()));
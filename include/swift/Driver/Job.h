@@ -120,6 +120,18 @@ private:
   /// The modification time of the main input file, if any.
   llvm::sys::TimePoint<> InputModTime = llvm::sys::TimePoint<>::max();
 
+  /// A hash of the main input file's contents, or 0 if it has not been
+  /// computed.
+  uint64_t InputContentHash = 0;
+
+  /// The estimated peak memory usage of this job in bytes, from the previous
+  /// build's measurement, or 0 if unknown.
+  uint64_t EstimatedMemoryUsage = 0;
+
+  /// The estimated duration of this job in nanoseconds, from the previous
+  /// build's measurement, or 0 if unknown.
+  uint64_t EstimatedDuration = 0;
+
 public:
   Job(const JobAction &Source,
       SmallVectorImpl<const Job *> &&Inputs,
@@ -160,6 +172,30 @@ public:
     return InputModTime;
   }
 
+  void setInputContentHash(uint64_t hash) {
+    InputContentHash = hash;
+  }
+
+  uint64_t getInputContentHash() const {
+    return InputContentHash;
+  }
+
+  void setEstimatedMemoryUsage(uint64_t bytes) {
+    EstimatedMemoryUsage = bytes;
+  }
+
+  uint64_t getEstimatedMemoryUsage() const {
+    return EstimatedMemoryUsage;
+  }
+
+  void setEstimatedDuration(uint64_t nanoseconds) {
+    EstimatedDuration = nanoseconds;
+  }
+
+  uint64_t getEstimatedDuration() const {
+    return EstimatedDuration;
+  }
+
   ArrayRef<std::pair<const char *, const char *>> getExtraEnvironment() const {
     return ExtraEnvironment;
   }
@@ -34,8 +34,15 @@ using swift::sys::ProcessId;
 void emitBeganMessage(raw_ostream &os, const Job &Cmd, ProcessId Pid);
 
 /// \brief Emits a "finished" message to the given stream.
+///
+/// \param WallTimeUsec the task's wall time in microseconds, or 0 if it was
+/// not measured.
+/// \param Stats the task's resource usage; fields which were not measured
+/// are 0 and are omitted from the message.
 void emitFinishedMessage(raw_ostream &os, const Job &Cmd, ProcessId Pid,
-                         int ExitStatus, StringRef Output);
+                         int ExitStatus, StringRef Output,
+                         uint64_t WallTimeUsec = 0,
+                         sys::TaskStatistics Stats = sys::TaskStatistics());
 
 /// \brief Emits a "signalled" message to the given stream.
 void emitSignalledMessage(raw_ostream &os, const Job &Cmd, ProcessId Pid,
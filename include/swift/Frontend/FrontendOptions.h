@@ -297,6 +297,12 @@ public:
   /// The path to which we should store indexing data, if any.
   std::string IndexStorePath;
 
+  /// If non-empty, the directory of a compilation cache. Outputs of an
+  /// invocation are stored there keyed by a hash of the arguments, the input
+  /// contents and the contents of all tracked dependencies, and identical
+  /// invocations are satisfied from the cache without compiling.
+  std::string CompilationCachePath;
+
   /// Emit index data for imported serialized swift system modules.
   bool IndexSystemModules = false;
 
@@ -369,6 +375,13 @@ public:
   /// debugger to use.
   bool AlwaysSerializeDebuggingOptions = false;
 
+  /// If set, all input source buffers are lexed in parallel on a thread pool
+  /// before the (still serial) parse of the module begins.  This overlaps
+  /// page-in, UTF-8 validation, and token scanning of every file; full
+  /// parallel AST construction additionally requires a thread-safe
+  /// ASTContext and remains future work.
+  bool EnableParallelPrelexing = false;
+
   /// If set, dumps wall time taken to check each function body to llvm::errs().
   bool DebugTimeFunctionBodies = false;
 
@@ -387,6 +400,14 @@ public:
   /// Trace changes to stats to files in StatsOutputDir.
   bool TraceStats = false;
 
+  /// Write stats tracer scopes to a file in StatsOutputDir in Chrome's
+  /// trace-event format.
+  bool ChromeTraceStats = false;
+
+  /// Record only one in this many stats tracer scopes, keeping tracing cheap
+  /// enough to leave enabled. 0 or 1 records every scope.
+  unsigned TraceStatsSampleRate = 0;
+
   /// If true, serialization encodes an extra lookup table for use in module-
   /// merging when emitting partial modules (the per-file modules in a non-WMO
   /// build).
@@ -440,6 +461,13 @@ public:
   /// instrumentation that has a high runtime performance impact.
   bool PlaygroundHighPerformance = false;
 
+  /// When non-zero, restricts the playground transformation to top-level
+  /// declarations overlapping this 1-based, inclusive line range. Used by
+  /// notebook-style clients to instrument only the edited region instead
+  /// of the whole file.
+  unsigned PlaygroundRegionStart = 0;
+  unsigned PlaygroundRegionEnd = 0;
+
   /// Indicates whether standard help should be shown.
   bool PrintHelp = false;
 
@@ -17,6 +17,7 @@
 #include "swift/Basic/ThreadSafeRefCounted.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/Support/Chrono.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include <system_error>
 
 namespace swift {
@@ -56,6 +57,12 @@ public:
   struct Value : public llvm::ThreadSafeRefCountedBase<Value> {
     llvm::sys::TimePoint<> ModuleModificationTime;
     CodeCompletionResultSink Sink;
+
+    /// The (memory-mapped) cache file these results were deserialized from,
+    /// if any. Strings in \c Sink point directly into this buffer, so cold
+    /// loads don't copy the string table and concurrent consumers of the
+    /// same cache file share the clean mapped pages.
+    std::unique_ptr<llvm::MemoryBuffer> SourceBuffer;
   };
   using ValueRefCntPtr = llvm::IntrusiveRefCntPtr<Value>;
 
@@ -44,6 +44,22 @@ class AlwaysDelayedCallbacks : public DelayedParsingCallbacks {
   }
 };
 
+/// \brief Callbacks that skip all bodies outright.
+///
+/// The parser still brace-matches over each body so that the skeleton of the
+/// file is correct, but no per-body state is recorded for later
+/// materialization.  This is appropriate for non-primary files in
+/// primary-file compilation, where Sema only ever needs declaration
+/// signatures and the bodies would otherwise never be revisited.
+class AlwaysSkipBodiesCallbacks : public DelayedParsingCallbacks {
+  bool shouldDelayFunctionBodyParsing(Parser &TheParser,
+                                      AbstractFunctionDecl *AFD,
+                                      const DeclAttributes &Attrs,
+                                      SourceRange BodyRange) override {
+    return false;
+  }
+};
+
 /// \brief Implementation of callbacks that guide the parser in delayed
 /// parsing for code completion.
 class CodeCompleteDelayedCallbacks : public DelayedParsingCallbacks {
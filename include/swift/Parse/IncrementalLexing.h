@@ -0,0 +1,63 @@
+//===--- IncrementalLexing.h - Relexing of edited buffers -------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines an API for updating a token stream after a single
+//  textual edit without re-lexing the entire buffer.  Lexing in Swift is
+//  stateless between tokens, so tokens before and after the edited region
+//  can be reused verbatim; only the region the edit can influence is lexed
+//  again.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_PARSE_INCREMENTALLEXING_H
+#define SWIFT_PARSE_INCREMENTALLEXING_H
+
+#include "swift/Basic/LLVM.h"
+#include "swift/Parse/Token.h"
+#include <vector>
+
+namespace swift {
+  class LangOptions;
+  class SourceManager;
+
+/// A single contiguous textual edit to a source buffer: \c RemovedLength
+/// bytes at \c Offset were replaced by \c InsertedLength new bytes.
+struct SourceEdit {
+  unsigned Offset;
+  unsigned RemovedLength;
+  unsigned InsertedLength;
+};
+
+/// Produce the token stream for \p NewBufferID, which holds the result of
+/// applying \p Edit to the buffer whose contents were \p OldBufferText and
+/// whose tokens were \p OldTokens.
+///
+/// Tokens that end before the edit are reused directly; tokens after the
+/// edit are reused with their text re-pointed into the new buffer as soon
+/// as the relexer reaches a position that corresponds to an old token
+/// boundary.  Only the affected region in between is lexed again, so the
+/// cost is proportional to the extent of the edit's influence rather than
+/// to the buffer size.
+///
+/// \p KeepComments must match the setting used to produce \p OldTokens
+/// (see \c swift::tokenize).
+std::vector<Token> relexTokensAfterEdit(const LangOptions &LangOpts,
+                                        const SourceManager &SM,
+                                        unsigned NewBufferID,
+                                        ArrayRef<Token> OldTokens,
+                                        StringRef OldBufferText,
+                                        SourceEdit Edit,
+                                        bool KeepComments = true);
+
+} // end namespace swift
+
+#endif // SWIFT_PARSE_INCREMENTALLEXING_H
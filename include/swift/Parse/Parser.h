@@ -692,6 +692,10 @@ public:
 
   bool parseTopLevel();
 
+  /// Record a structural fingerprint for the given declaration by hashing
+  /// the source text it covers.
+  void recordDeclFingerprint(Decl *D);
+
   /// Flags that control the parsing of declarations.
   enum ParseDeclFlags {
     PD_Default              = 0,
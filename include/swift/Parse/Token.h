@@ -256,6 +256,12 @@ public:
     return CommentLength != 0;
   }
 
+  /// Return the raw length of the comment that precedes the token, without
+  /// trimming surrounding whitespace.
+  unsigned getCommentLength() const {
+    return CommentLength;
+  }
+
   CharSourceRange getCommentRange() const {
     if (CommentLength == 0)
       return CharSourceRange(SourceLoc(llvm::SMLoc::getFromPointer(Text.begin())),
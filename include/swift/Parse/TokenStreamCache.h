@@ -0,0 +1,80 @@
+//===--- TokenStreamCache.h - Content-hash-keyed token cache ----*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines a process-wide cache of lexed token streams keyed by
+//  the content hash of the source buffer.  Tokens are stored in an
+//  offset-based form that carries no pointers into any particular buffer,
+//  so a cached stream can be rehydrated against any buffer with identical
+//  contents -- including a buffer registered with a different
+//  SourceManager, as happens when successive requests in one session
+//  re-open the same unchanged file.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_PARSE_TOKENSTREAMCACHE_H
+#define SWIFT_PARSE_TOKENSTREAMCACHE_H
+
+#include "swift/Basic/LLVM.h"
+#include "swift/Parse/Token.h"
+#include "llvm/ADT/DenseMap.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace swift {
+  class LangOptions;
+  class SourceManager;
+
+/// A cache of full-buffer token streams keyed by buffer content hash.
+///
+/// Only whole-buffer lexes with default tokenization parameters are cached;
+/// subrange or split-token requests always go to the lexer.
+class TokenStreamCache {
+public:
+  /// Return the tokens for the given buffer, lexing it if its contents have
+  /// not been seen before.  The returned tokens point into the buffer
+  /// registered with \p SM.
+  std::vector<Token> getTokens(const LangOptions &LangOpts,
+                               const SourceManager &SM, unsigned BufferID,
+                               bool KeepComments);
+
+  /// Drop all cached streams.
+  void clear();
+
+  /// The shared per-process cache instance.
+  static TokenStreamCache &getGlobalCache();
+
+private:
+  /// A token with its text replaced by (offset, length) into the buffer.
+  struct CachedToken {
+    unsigned Offset;
+    unsigned Length;
+    tok Kind;
+    unsigned CommentLength : 27;
+    unsigned AtStartOfLine : 1;
+    unsigned EscapedIdentifier : 1;
+    unsigned MultilineString : 1;
+  };
+
+  struct CachedStream {
+    /// Guards against (unlikely) hash collisions.
+    size_t BufferSize;
+    std::vector<CachedToken> Tokens;
+  };
+
+  std::mutex Mutex;
+  llvm::DenseMap<uint64_t, std::unique_ptr<CachedStream>> Streams;
+};
+
+} // end namespace swift
+
+#endif // SWIFT_PARSE_TOKENSTREAMCACHE_H
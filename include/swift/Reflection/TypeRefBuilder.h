@@ -168,6 +168,18 @@ private:
   std::unordered_map<TypeRefID, const TypeRef *,
                      TypeRefID::Hash, TypeRefID::Equal> AssociatedTypeCache;
 
+  /// Index of field descriptors by mangled type name, built lazily from the
+  /// field sections of all registered images. Whole-section scans per query
+  /// do not scale; with the index, each image's field section is walked once
+  /// and lookups become hash lookups.
+  std::unordered_map<std::string,
+                     std::pair<const FieldDescriptor *, uintptr_t>>
+      FieldTypeInfoCache;
+
+  /// Number of leading entries of \c ReflectionInfos whose field sections
+  /// have already been indexed into \c FieldTypeInfoCache.
+  size_t IndexedFieldInfos = 0;
+
   TypeConverter TC;
   MetadataSourceBuilder MSB;
 
@@ -208,6 +208,12 @@ public:
                                      remote::RemoteAddress optMetadataAddress,
                                      StringRef memberName);
 
+  /// Drop all cached lookup results. Successful resolutions and member
+  /// offsets are cached across calls, so this must be invoked whenever
+  /// images are loaded into (or unloaded from) the remote process, since
+  /// cached addresses and layouts may no longer be valid.
+  void clearCaches();
+
   /// Given a heap object, resolve its heap metadata.
   Result<remote::RemoteAddress>
   getHeapMetadataForObject(remote::RemoteAddress address);
@@ -71,6 +71,24 @@ HeapObject *(*SWIFT_CC(RegisterPreservingCC) _swift_allocObject)(
                                               size_t requiredSize,
                                               size_t requiredAlignmentMask);
 
+/// Allocates many objects of the same layout at once, e.g. for loaders that
+/// build large object graphs in a burst. Each object's header is initialized
+/// exactly as swift_allocObject would, and each object is independently
+/// deallocatable through the normal deallocation paths.
+///
+/// \param metadata - the objects' metadata, stored in each header
+/// \param requiredSize - the required size of each allocation,
+///   including the header
+/// \param requiredAlignmentMask - the required alignment of each allocation;
+///   always one less than a power of 2 that's at least alignof(void*)
+/// \param objects - filled with \p count object pointers; never null
+SWIFT_RUNTIME_EXPORT
+void swift_allocObjects(HeapMetadata const *metadata,
+                        size_t requiredSize,
+                        size_t requiredAlignmentMask,
+                        HeapObject **objects,
+                        size_t count);
+
 /// Initializes the object header of a stack allocated object.
 ///
 /// \param metadata - the object's metadata which is stored in the header
@@ -137,6 +155,13 @@ SWIFT_RT_ENTRY_VISIBILITY
 void *swift_slowAlloc(size_t bytes, size_t alignMask)
      SWIFT_CC(RegisterPreservingCC);
 
+// Allocate many blocks of the same size at once. Fills in \p ptrs with
+// \p count non-null pointers, each individually deallocatable with
+// swift_slowDealloc. Never fails.
+SWIFT_RUNTIME_EXPORT
+void swift_slowAllocBatch(size_t bytes, size_t alignMask,
+                          void **ptrs, size_t count);
+
 
 // If the caller cannot promise to zero the object during destruction,
 // then call these corresponding APIs:
@@ -291,6 +316,29 @@ SWIFT_RUNTIME_EXPORT
 void (*SWIFT_CC(RegisterPreservingCC)
                      _swift_nonatomic_release_n)(HeapObject *object, uint32_t n);
 
+/// Enter biased reference counting mode: swift_retain, swift_release and
+/// their _n variants use non-atomic operations on the refcount word.
+///
+/// The caller promises that the process is effectively single-threaded: no
+/// other thread retains, releases, or deallocates Swift objects while the
+/// mode is active. Single-threaded request handlers and similar processes
+/// can use this to avoid paying for atomic reference counting they do not
+/// need.
+///
+/// Call swift_disableBiasedRefCounting() before the promise stops holding.
+SWIFT_RUNTIME_EXPORT
+void swift_enableBiasedRefCounting();
+
+/// Leave biased reference counting mode and return to atomic reference
+/// counting.
+///
+/// This must happen before another thread can touch any Swift object, e.g.
+/// before the calling thread spawns workers or hands objects to an existing
+/// thread. The thread creation or hand-off then orders the earlier
+/// non-atomic refcount updates before any other thread's atomic ones.
+SWIFT_RUNTIME_EXPORT
+void swift_disableBiasedRefCounting();
+
 // Refcounting observation hooks for memory tools. Don't use these.
 SWIFT_RUNTIME_EXPORT
 size_t swift_retainCount(HeapObject *object);
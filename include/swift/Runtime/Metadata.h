@@ -2780,6 +2780,25 @@ swift_getGenericMetadata(GenericMetadata *pattern,
                          const void *arguments)
     SWIFT_CC(RegisterPreservingCC);
 
+/// \brief Fetch a uniqued metadata object for a generic nominal type and
+/// fill a caller-owned inline cache with the result.
+///
+/// \p inlineCache points to a pointer-sized slot emitted by IRGen next to a
+/// generic metadata accessor. On the first call through a given slot, the
+/// runtime publishes an immutable entry of the form
+/// { metadata, arguments[0..NumKeyArguments] } into it (with a release
+/// store, so a reader which observes the entry observes its contents). The
+/// accessor checks the slot inline before calling into the runtime, which
+/// makes the steady-state monomorphic case a few loads and compares; callers
+/// whose arguments keep changing simply never hit and fall through to the
+/// global metadata cache via this function.
+SWIFT_RT_ENTRY_VISIBILITY
+const Metadata *
+swift_getGenericMetadataCached(GenericMetadata *pattern,
+                               const void *arguments,
+                               const void **inlineCache)
+    SWIFT_CC(RegisterPreservingCC);
+
 // Callback to allocate a generic class metadata object.
 SWIFT_RUNTIME_EXPORT
 ClassMetadata *
@@ -34,6 +34,13 @@ extern template void Calculate<SILDomTree, swift::SILFunction>(
     SILDomTree &DT, swift::SILFunction &F);
 extern template void Calculate<SILPostDomTree, swift::SILFunction>(
     SILPostDomTree &DT, swift::SILFunction &F);
+
+extern template void InsertEdge<SILDomTree>(SILDomTree &DT,
+                                            swift::SILBasicBlock *From,
+                                            swift::SILBasicBlock *To);
+extern template void DeleteEdge<SILDomTree>(SILDomTree &DT,
+                                            swift::SILBasicBlock *From,
+                                            swift::SILBasicBlock *To);
 } // namespace DomTreeBuilder
 } // namespace llvm
 
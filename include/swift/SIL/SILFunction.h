@@ -295,6 +295,16 @@ public:
       BB.dropAllReferences();
   }
 
+  /// Drop the body of the function, freeing its basic blocks and
+  /// instructions, while keeping the declaration itself (name, type,
+  /// linkage) valid. The function reads as an external declaration
+  /// afterwards. IRGen uses this to return SIL memory to the system once
+  /// a function has been lowered to LLVM IR.
+  void clearBody() {
+    dropAllReferences();
+    getBlocks().clear();
+  }
+
   /// Notify that this function was inlined. This implies that it is still
   /// needed for debug info generation, even if it is removed afterwards.
   void setInlined() {
@@ -104,8 +104,10 @@ private:
 
   /// AliasAnalysis value cache.
   ///
-  /// The alias() method uses this map to cache queries.
-  llvm::DenseMap<AliasKeyTy, AliasResult> AliasCache;
+  /// The alias() method uses this map to cache queries. The bool records
+  /// whether the result was derived using escape analysis, i.e. whether it
+  /// embeds facts about functions other than the one being queried.
+  llvm::DenseMap<AliasKeyTy, std::pair<AliasResult, bool>> AliasCache;
 
   using MemoryBehavior = SILInstruction::MemoryBehavior;
   /// MemoryBehavior value cache.
@@ -127,6 +129,33 @@ private:
   /// because doing so could give rise to collisions in the other cache.
   ValueEnumerator<SILNode*> MemoryBehaviorNodeToIndex;
 
+  /// The cache keys recorded for values of each function. Lets the
+  /// invalidation of one function drop only that function's entries instead
+  /// of flushing the caches for the whole module.
+  llvm::DenseMap<SILFunction *, llvm::SmallVector<AliasKeyTy, 8>>
+      AliasCacheKeysByFunction;
+  llvm::DenseMap<SILFunction *, llvm::SmallVector<MemBehaviorKeyTy, 8>>
+      MemBehaviorCacheKeysByFunction;
+
+  /// Cache keys whose results embed facts about other functions (escape
+  /// analysis connection graphs, side-effect summaries). These cannot be
+  /// attributed to a single function and are flushed on any invalidation.
+  llvm::SmallVector<AliasKeyTy, 8> InterproceduralAliasKeys;
+  llvm::SmallVector<MemBehaviorKeyTy, 8> InterproceduralMemBehaviorKeys;
+
+  /// True if the currently running alias query has consulted escape
+  /// analysis. Set by aliasInner, consumed by alias() when it records the
+  /// cache entry for the query.
+  bool LastQueryUsedEscapeAnalysis = false;
+
+  /// Record the cache key of a completed query for later invalidation.
+  void recordAliasCacheKey(AliasKeyTy Key, SILValue V1, SILValue V2);
+  void recordMemBehaviorCacheKey(MemBehaviorKeyTy Key, SILInstruction *Inst);
+
+  /// Remove the cache entries of \p F together with all interprocedurally
+  /// derived entries.
+  void invalidateFunction(SILFunction *F);
+
   AliasResult aliasAddressProjection(SILValue V1, SILValue V2,
                                      SILValue O1, SILValue O2);
 
@@ -272,11 +301,15 @@ public:
   virtual void invalidate() override {
     AliasCache.clear();
     MemoryBehaviorCache.clear();
+    AliasCacheKeysByFunction.clear();
+    MemBehaviorCacheKeysByFunction.clear();
+    InterproceduralAliasKeys.clear();
+    InterproceduralMemBehaviorKeys.clear();
   }
 
-  virtual void invalidate(SILFunction *,
+  virtual void invalidate(SILFunction *F,
                           SILAnalysis::InvalidationKind K) override {
-    invalidate();
+    invalidateFunction(F);
   }
 
   /// Notify the analysis about a newly created function.
@@ -284,7 +317,9 @@ public:
 
   /// Notify the analysis about a function which will be deleted from the
   /// module.
-  virtual void notifyDeleteFunction(SILFunction *F) override { }
+  virtual void notifyDeleteFunction(SILFunction *F) override {
+    invalidateFunction(F);
+  }
 
   virtual void invalidateFunctionTables() override { }
 };
@@ -24,6 +24,8 @@
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/Support/Allocator.h"
 
+#include <vector>
+
 namespace swift {
 class ClassDecl;
 class SILFunction;
@@ -48,9 +50,8 @@ public:
   CalleeList(SILFunction *F) : CalleeFunctions(F), IsIncomplete(false) {}
 
   /// Constructor for arbitrary lists of callees.
-  CalleeList(llvm::SmallVectorImpl<SILFunction *> &List, bool IsIncomplete)
-      : CalleeFunctions(llvm::makeArrayRef(List.begin(), List.end())),
-        IsIncomplete(IsIncomplete) {}
+  CalleeList(ArrayRef<SILFunction *> List, bool IsIncomplete)
+      : CalleeFunctions(List), IsIncomplete(IsIncomplete) {}
 
   /// Return an iterator for the beginning of the list.
   ArrayRef<SILFunction *>::iterator begin() const {
@@ -79,19 +80,37 @@ class CalleeCache {
   typedef llvm::DenseMap<SILDeclRef, CalleesAndCanCallUnknown>
       CacheType;
 
+  /// A packed callee list: a slice of FlatCallees plus the bit recording
+  /// whether the method can also be called from code we cannot see.
+  struct CalleeSlice {
+    unsigned Offset;
+    unsigned Size : 31;
+    unsigned CanCallUnknown : 1;
+  };
+
   SILModule &M;
 
-  // Allocator for the SmallVectors that we will be allocating.
+  // Allocator for the SmallVectors built up while scanning the vtables and
+  // witness tables. Emptied once the lists are packed.
   llvm::SpecificBumpPtrAllocator<Callees> Allocator;
 
-  // The cache of precomputed callee lists for function decls appearing
-  // in class virtual dispatch tables and witness tables.
+  // Scratch cache used while scanning the tables; emptied by
+  // packCallees() once construction is done.
   CacheType TheCache;
 
+  // All computed callee lists laid out back-to-back. Clients like the
+  // bottom-up function order iterate many lists in a row, so keeping them
+  // in one contiguous block avoids chasing per-list allocations.
+  std::vector<SILFunction *> FlatCallees;
+
+  // Maps each method to its slice of FlatCallees.
+  llvm::DenseMap<SILDeclRef, CalleeSlice> PackedCache;
+
 public:
   CalleeCache(SILModule &M) : M(M) {
     computeMethodCallees();
     sortAndUniqueCallees();
+    packCallees();
   }
 
   ~CalleeCache() {
@@ -108,6 +127,7 @@ public:
 private:
   void enumerateFunctionsInModule();
   void sortAndUniqueCallees();
+  void packCallees();
   CalleesAndCanCallUnknown &getOrCreateCalleesForMethod(SILDeclRef Decl);
   void computeClassMethodCalleesForClass(ClassDecl *CD);
   void computeClassMethodCallees(ClassDecl *CD, SILDeclRef Method);
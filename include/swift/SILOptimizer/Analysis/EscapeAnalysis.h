@@ -621,8 +621,8 @@ private:
 
     /// The summary graph for the function. It is used when computing the
     /// connection graph of caller functions.
-    /// This graph is _not_ be invalidated on invalidation. It is only updated
-    /// when explicitly calling recompute().
+    /// It is cleared together with the connection graph on invalidation and
+    /// re-derived by recompute().
     ConnectionGraph SummaryGraph;
 
     /// If true, at least one of the callee graphs has changed. We have to merge
@@ -630,6 +630,15 @@ private:
     bool NeedUpdateSummaryGraph = true;
 
     /// Clears the analysis data on invalidation.
+    ///
+    /// Note that the graphs cannot survive arbitrary function mutations:
+    /// delete notifications are the only incremental update channel, so
+    /// newly created instructions (projections, inlined callee bodies)
+    /// would be invisible to a retained graph. Retaining just the summary
+    /// graph is not sound either, because a pass can make a value escape
+    /// more than before and every caller's graph embeds the old summary.
+    /// Incremental instruction *deletion* is already handled, without
+    /// invalidation, by handleDeleteNotification().
     void clear() {
       Graph.clear();
       SummaryGraph.clear();
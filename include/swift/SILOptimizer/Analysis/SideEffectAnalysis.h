@@ -345,6 +345,13 @@ private:
                           FunctionOrder &BottomUpOrder,
                           int RecursionDepth);
 
+  /// Propagate the side-effects of \p FInfo to all callers which are
+  /// recomputed in the current update-cycle. Callers whose effects changed
+  /// and which the bottom-up scan cannot reach anymore are added to
+  /// \p WorkList.
+  void updateCallers(FunctionInfo *FInfo, FunctionOrder &BottomUpOrder,
+                     llvm::SmallVectorImpl<FunctionInfo *> &WorkList);
+
   /// Gets or creates FunctionEffects for \p F.
   FunctionInfo *getFunctionInfo(SILFunction *F) {
     FunctionInfo *&FInfo = Function2Info[F];
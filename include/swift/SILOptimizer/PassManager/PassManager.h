@@ -15,7 +15,9 @@
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
 #include <vector>
@@ -93,10 +95,27 @@ class SILPassManager {
   /// Set to true when a pass invalidates an analysis.
   bool CurrentPassHasInvalidated = false;
 
+  /// The functions the currently running module pass has reported as
+  /// changed, added or deleted. Used to scope post-pass verification in
+  /// +Asserts builds to the code that actually changed.
+  llvm::SmallPtrSet<SILFunction *, 16> FunctionsInvalidatedByCurrentPass;
+
+  /// Set when the currently running pass reports a change that cannot be
+  /// attributed to individual functions (e.g. vtable or witness table
+  /// updates); forces a full module verification afterwards.
+  bool CurrentPassInvalidatedModule = false;
+
   /// True if we need to stop running passes and restart again on the
   /// same function.
   bool RestartPipeline = false;
 
+  /// Scratch storage loaned to the currently running function pass for
+  /// short-lived worklists and operand snapshots. It is reset after each
+  /// pass run, so memory allocated from it must not outlive the pass
+  /// invocation; in exchange, steady-state runs of the pipeline stop
+  /// paying malloc for transient buffers.
+  llvm::BumpPtrAllocator ScratchArena;
+
   /// If true, passes are also run for functions which have
   /// OptimizationMode::NoOptimization.
   bool isMandatoryPipeline = false;
@@ -121,6 +140,11 @@ public:
 
   const SILOptions &getOptions() const;
 
+  /// \brief Returns the scratch arena the currently running pass may
+  /// allocate transient buffers from. The arena is reset when the pass
+  /// finishes running on a function.
+  llvm::BumpPtrAllocator &getScratchArena() { return ScratchArena; }
+
   /// \brief Searches for an analysis of type T in the list of registered
   /// analysis. If the analysis is not found, the program terminates.
   template<typename T>
@@ -156,6 +180,7 @@ public:
         AP->invalidate();
 
     CurrentPassHasInvalidated = true;
+    CurrentPassInvalidatedModule = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -174,6 +199,8 @@ public:
   void notifyAnalysisOfFunction(SILFunction *F) {
     for (auto AP : Analysis)
       AP->notifyAddFunction(F);
+
+    FunctionsInvalidatedByCurrentPass.insert(F);
   }
 
   /// \brief Broadcast the invalidation of the function to all analysis.
@@ -183,8 +210,9 @@ public:
     for (auto AP : Analysis)
       if (!AP->isLocked())
         AP->invalidate(F, K);
-    
+
     CurrentPassHasInvalidated = true;
+    FunctionsInvalidatedByCurrentPass.insert(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -198,6 +226,7 @@ public:
         AP->invalidateFunctionTables();
 
     CurrentPassHasInvalidated = true;
+    CurrentPassInvalidatedModule = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -209,8 +238,11 @@ public:
     for (auto AP : Analysis)
       if (!AP->isLocked())
         AP->notifyDeleteFunction(F);
-    
+
     CurrentPassHasInvalidated = true;
+    // The function is about to go away; drop any pending verification
+    // reference to it.
+    FunctionsInvalidatedByCurrentPass.erase(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
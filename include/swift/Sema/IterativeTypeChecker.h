@@ -22,6 +22,7 @@
 #include "swift/Sema/TypeCheckRequest.h"
 #include "swift/AST/DiagnosticEngine.h"
 #include "swift/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/STLExtras.h"
 
@@ -43,6 +44,11 @@ class IterativeTypeChecker {
   /// A stack of the currently-active requests.
   SmallVector<TypeCheckRequest, 4> ActiveRequests;
 
+  /// The number of active requests with a given hash value, used to skip
+  /// the linear cycle-detection scan of ActiveRequests when the request
+  /// cannot possibly be on the stack.
+  llvm::SmallDenseMap<size_t, unsigned, 8> ActiveRequestHashes;
+
   // Declare the is<request kind>Satisfied predicates,
   // enumerateDependenciesOf<request kind> functions, and
   // satisfy<request kind> functions.
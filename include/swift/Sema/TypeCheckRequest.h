@@ -21,6 +21,7 @@
 #include "swift/AST/Identifier.h"
 #include "swift/AST/Type.h"
 #include "swift/Basic/SourceLoc.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -176,6 +177,7 @@ public:
   Decl *getAnchor() const;
 
   friend bool operator==(const TypeCheckRequest &x, const TypeCheckRequest &y);
+  friend llvm::hash_code hash_value(const TypeCheckRequest &x);
 };
 
 /// A callback used to check whether a particular dependency of this
@@ -198,6 +200,10 @@ inline bool operator!=(const TypeCheckRequest &x, const TypeCheckRequest &y) {
   return !(x == y);
 }
 
+/// Compute a hash value for a type checking request, consistent with the
+/// equality predicate.
+llvm::hash_code hash_value(const TypeCheckRequest &x);
+
 }
 
 #endif /* SWIFT_SEMA_TYPE_CHECK_REQUEST_H */
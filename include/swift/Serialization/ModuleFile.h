@@ -368,6 +368,14 @@ private:
 
   llvm::DenseMap<const ValueDecl *, Identifier> PrivateDiscriminatorsByValue;
 
+  /// Caches the unfiltered results of the base-module lookup performed for
+  /// the first path piece of cross-references. Deserializing a generic-heavy
+  /// module resolves many cross-references which differ only in their later
+  /// path pieces, so the top-level walk is shared between them.
+  llvm::DenseMap<std::pair<ModuleDecl *, DeclBaseName>,
+                 std::vector<ValueDecl *>>
+      TopLevelXRefCache;
+
   TinyPtrVector<Decl *> ImportDecls;
 
   using DeclIDVector = SmallVector<serialization::DeclID, 4>;
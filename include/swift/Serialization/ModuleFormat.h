@@ -54,7 +54,7 @@ const uint16_t VERSION_MAJOR = 0;
 /// in source control, you should also update the comment to briefly
 /// describe what change you made. The content of this comment isn't important;
 /// it just ensures a conflict if two people change the module format.
-const uint16_t VERSION_MINOR = 391; // Last change: normal protocol conformance
+const uint16_t VERSION_MINOR = 392; // Last change: fixed-width offset blobs
 
 using DeclIDField = BCFixed<31>;
 
@@ -1553,7 +1553,7 @@ namespace index_block {
 
   using OffsetsLayout = BCGenericRecordLayout<
     RecordIDField, // record ID
-    BCArray<BitOffsetField>
+    BCBlob         // array of fixed-width little-endian offsets
   >;
 
   using DeclListLayout = BCGenericRecordLayout<
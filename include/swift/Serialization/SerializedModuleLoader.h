@@ -15,6 +15,8 @@
 
 #include "swift/AST/Module.h"
 #include "swift/AST/ModuleLoader.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/MemoryBuffer.h"
 
 namespace swift {
@@ -25,6 +27,11 @@ class SerializedModuleLoader : public ModuleLoader {
 private:
   ASTContext &Ctx;
   llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> MemoryBuffers;
+  /// Lazily populated listings of the directories probed during module
+  /// search, used to answer repeated lookups from memory instead of
+  /// issuing a stat or open syscall per probe. Almost all probes are
+  /// misses: every import is tried against every search path.
+  llvm::StringMap<llvm::StringSet<>> SearchPathListings;
   /// A { module, generation # } pair.
   using LoadedModulePair = std::pair<std::unique_ptr<ModuleFile>, unsigned>;
   std::vector<LoadedModulePair> LoadedModuleFiles;
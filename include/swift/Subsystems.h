@@ -26,6 +26,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Mutex.h"
 
+#include <functional>
 #include <memory>
 
 namespace llvm {
@@ -55,6 +56,7 @@ namespace swift {
   class PersistentParserState;
   class SerializationOptions;
   class SILOptions;
+  class SILFunction;
   class SILModule;
   class SILParserTUState;
   class SourceFile;
@@ -73,6 +75,13 @@ namespace swift {
 
     explicit SILParserState(SILModule *M);
     ~SILParserState();
+
+    /// Install a callback that receives each sil function as soon as its
+    /// body has been completely parsed.  This enables streaming consumption
+    /// of large .sil inputs: a client can run function passes (and release
+    /// per-function resources) while the parser continues with the rest of
+    /// the module, instead of waiting for the module to finish.
+    void setFunctionParsedCallback(std::function<void(SILFunction *)> Fn);
   };
 
   /// @{
@@ -143,7 +152,15 @@ namespace swift {
   ///
   /// \param HighPerformance True if the playground transform should omit
   /// instrumentation that has a high runtime performance impact.
-  void performPlaygroundTransform(SourceFile &SF, bool HighPerformance);
+  ///
+  /// \param RegionStartLine If non-zero, only top-level declarations
+  /// overlapping the 1-based, inclusive line range
+  /// [RegionStartLine, RegionEndLine] are instrumented; everything else is
+  /// left untouched so re-running an edited region costs time proportional
+  /// to the region, not the file.
+  void performPlaygroundTransform(SourceFile &SF, bool HighPerformance,
+                                  unsigned RegionStartLine = 0,
+                                  unsigned RegionEndLine = 0);
   
   /// Once parsing and name-binding are complete this optionally walks the ASTs
   /// to add calls to externally provided functions that simulate
@@ -30,7 +30,7 @@
 
 /// Minor version changes when new APIs are added in ABI- and source-compatible
 /// way.
-#define SWIFT_REFLECTION_VERSION_MINOR 0
+#define SWIFT_REFLECTION_VERSION_MINOR 1
 
 #ifdef __cplusplus
 extern "C" {
@@ -130,6 +130,25 @@ swift_reflection_childOfInstance(SwiftReflectionContextRef ContextRef,
                                  uintptr_t Object,
                                  unsigned Index);
 
+/// Resolves type references and layout information for a list of heap
+/// objects in one call.
+///
+/// When walking a large heap this is substantially cheaper than calling
+/// swift_reflection_typeRefForInstance() and
+/// swift_reflection_infoForInstance() per object: each object's metadata
+/// pointer is read exactly once, and type resolution and layout lowering
+/// run once per distinct metadata rather than once per object.
+///
+/// \param Objects an array of Count object addresses.
+/// \param OutInfos an array of Count results, filled in the order of
+///   Objects. Entries for objects whose metadata cannot be read or
+///   resolved get a zero TypeRef and a SWIFT_UNKNOWN layout.
+void
+swift_reflection_infoForInstances(SwiftReflectionContextRef ContextRef,
+                                  const uintptr_t *Objects,
+                                  size_t Count,
+                                  swift_instanceinfo_t *OutInfos);
+
 /// Returns the number of generic arguments of a typeref.
 unsigned
 swift_reflection_genericArgumentCountOfTypeRef(swift_typeref_t OpaqueTypeRef);
@@ -140,6 +140,16 @@ typedef struct swift_childinfo {
   swift_typeref_t TR;
 } swift_childinfo_t;
 
+/// \brief The result of a bulk instance query for one heap object.
+typedef struct swift_instanceinfo {
+  /// The object's type reference, or 0 if its metadata could not be read
+  /// or resolved.
+  swift_typeref_t TypeRef;
+
+  /// The object's layout information.
+  swift_typeinfo_t TypeInfo;
+} swift_instanceinfo_t;
+
 /// \brief An opaque pointer to a context which maintains state and
 /// caching of reflection structure for heap instances.
 typedef struct SwiftReflectionContext *SwiftReflectionContextRef;
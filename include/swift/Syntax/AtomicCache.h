@@ -13,7 +13,7 @@
 #ifndef SWIFT_SYNTAX_ATOMICCACHE_H
 #define SWIFT_SYNTAX_ATOMICCACHE_H
 
-#include <functional>
+#include <atomic>
 #include "swift/Syntax/References.h"
 
 namespace swift {
@@ -37,12 +37,18 @@ public:
   AtomicCache() {}
 
   /// Gets the value inside the cache, or creates it atomically using the
-  /// provided lambda if it doesn't already exist.
-  RC<T> getOrCreate(std::function<RC<T> ()> Create) const {
+  /// provided lambda if it doesn't already exist. Concurrent callers are
+  /// safe: at most one of the created values is cached, and the rest are
+  /// discarded. The hit path is a single acquire load, so a cached tree
+  /// can be traversed from many threads without contention.
+  template <typename Fn>
+  RC<T> getOrCreate(Fn &&Create) const {
     auto &Ptr = *reinterpret_cast<std::atomic<uintptr_t> *>(&Storage);
 
-    // If an atomic load gets an initialized value, then return Storage.
-    if (Ptr) {
+    // If an acquiring load gets an initialized value, then return Storage.
+    // The acquire pairs with the release below, so the pointee's
+    // construction is visible.
+    if (Ptr.load(std::memory_order_acquire)) {
       return Storage;
     }
 
@@ -56,9 +62,12 @@ public:
     auto Data = Create();
 
     // Try to swap in raw pointer value.
-    // If we won, then leave the RefCount == 1.
+    // If we won, then leave the RefCount == 1. Publishing with release
+    // ordering makes the new value's construction visible to the acquire
+    // load above; on failure the acquire makes the winner's value visible.
     if (Ptr.compare_exchange_strong(Expected,
-          reinterpret_cast<uintptr_t>(Data.get()))) {
+          reinterpret_cast<uintptr_t>(Data.get()),
+          std::memory_order_release, std::memory_order_acquire)) {
       Data.resetWithoutRelease();
     }
 
@@ -27,6 +27,7 @@
 #include "swift/Syntax/Syntax.h"
 #include "swift/Syntax/TokenKinds.h"
 #include "swift/Syntax/Trivia.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace swift {
 namespace syntax {
@@ -197,6 +198,27 @@ public:
   }
 };
 
+/// A content-addressed cache of token nodes.
+///
+/// Source files are dominated by repeated tokens - keywords, punctuation and
+/// common identifiers carrying identical trivia - and `RawTokenSyntax` is
+/// strictly immutable, so tokens with the same content can share one node.
+/// The cache is keyed by the full content of the token (kind, text, leading
+/// and trailing trivia); only novel content allocates.
+///
+/// Only present tokens are cached; missing tokens are rare enough not to
+/// matter.
+class RawTokenSyntaxCache {
+  llvm::DenseMap<unsigned, llvm::SmallVector<RC<RawTokenSyntax>, 2>> Nodes;
+
+public:
+  /// Return a present token with the given content, reusing a previously
+  /// created node whose content matches.
+  RC<RawTokenSyntax> getToken(tok TokenKind, OwnedString Text,
+                              const Trivia &LeadingTrivia,
+                              const Trivia &TrailingTrivia);
+};
+
 } // end namespace syntax
 } // end namespace swift
 
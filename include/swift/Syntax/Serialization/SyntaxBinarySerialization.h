@@ -0,0 +1,216 @@
+//===--- SyntaxBinarySerialization.h - Binary Syntax Serialization -*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This file provides the serialization of RawSyntax trees to a compact
+// binary format, as an alternative to the JSON serialization in
+// SyntaxSerialization.h for consumers that materialize many trees.
+//
+// The format is a deduplicated string table followed by flat node records:
+//
+//   "SSBT"                      4-byte magic
+//   version                     u32, currently 1
+//   string table size           u32, in bytes
+//   node count                  u32
+//   <string table>              strings stored once, each as a u32 byte
+//                               length followed by the bytes; a "string ref"
+//                               elsewhere is the byte offset of the length
+//                               within the table
+//   <node records>              emitted in post-order; children precede
+//                               their parent and are referenced by index,
+//                               so the root is the last record
+//
+// A node record is a sequence of u32 fields. Every record starts with a
+// string ref for the syntax kind name and a presence flag (0 = Present,
+// 1 = Missing). Token records ("Token" kind) continue with a string ref
+// for the token kind name, a string ref for the token text, and the
+// leading and trailing trivia, each as a u32 piece count followed by
+// per-piece pairs of a trivia kind string ref and either a repeat count
+// or a string ref for the piece's text. Layout records continue with a
+// u32 child count followed by the child node indices.
+//
+// Kinds are identified by the same names the JSON serialization uses
+// (e.g. "FunctionCallExpr", "kw_struct", "Space") rather than by numeric
+// enum values, since the C++ and Swift enums are generated independently
+// and their numbering is not a stable contract. All integers are
+// little-endian.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
+#define SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H
+
+#include "swift/Syntax/RawSyntax.h"
+#include "swift/Syntax/RawTokenSyntax.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace swift {
+namespace syntax {
+
+/// Serializes RawSyntax trees to the binary format described above. The
+/// matching reader lives in the SwiftSyntax bindings
+/// (tools/SwiftSyntax/SyntaxBinaryDecoder.swift).
+class SyntaxBinaryWriter {
+  static const uint32_t FormatVersion = 1;
+
+  /// The string table; strings are appended once, length-prefixed.
+  llvm::SmallString<256> StringData;
+
+  /// Offsets of already-interned strings within \c StringData.
+  llvm::StringMap<uint32_t> StringOffsets;
+
+  /// The concatenated node records.
+  llvm::SmallString<256> NodeData;
+
+  /// Number of node records emitted so far; doubles as the index of the
+  /// next record.
+  uint32_t NodeCount = 0;
+
+  static void appendU32(llvm::SmallVectorImpl<char> &Buffer, uint32_t Value) {
+    char Bytes[4];
+    llvm::support::endian::write32le(Bytes, Value);
+    Buffer.append(Bytes, Bytes + 4);
+  }
+
+  static void writeU32(llvm::raw_ostream &OS, uint32_t Value) {
+    char Bytes[4];
+    llvm::support::endian::write32le(Bytes, Value);
+    OS.write(Bytes, 4);
+  }
+
+  /// Intern \p Str and return its string ref.
+  uint32_t addString(StringRef Str) {
+    auto Inserted = StringOffsets.insert(
+        {Str, static_cast<uint32_t>(StringData.size())});
+    if (Inserted.second) {
+      appendU32(StringData, Str.size());
+      StringData.append(Str);
+    }
+    return Inserted.first->second;
+  }
+
+  uint32_t addKindName(SyntaxKind Kind) {
+    llvm::SmallString<32> Name;
+    llvm::raw_svector_ostream NameOS(Name);
+    dumpSyntaxKind(NameOS, Kind);
+    return addString(Name.str());
+  }
+
+  /// The token kind names here must stay in sync with the JSON
+  /// serialization traits for swift::tok.
+  static StringRef getTokenKindName(tok Kind) {
+    switch (Kind) {
+#define LITERAL(X) case tok::X: return #X;
+#define MISC(X) case tok::X: return #X;
+#define KEYWORD(X) case tok::kw_##X: return "kw_" #X;
+#define PUNCTUATOR(X, Y) case tok::X: return #X;
+#define POUND_KEYWORD(X) case tok::pound_##X: return "pound_" #X;
+#include "swift/Syntax/TokenKinds.def"
+    case tok::NUM_TOKENS:
+      break;
+    }
+    llvm_unreachable("Unhandled token kind");
+  }
+
+  /// The trivia kind names here must stay in sync with the JSON
+  /// serialization traits for TriviaKind.
+  static StringRef getTriviaKindName(TriviaKind Kind) {
+    switch (Kind) {
+    case TriviaKind::Space: return "Space";
+    case TriviaKind::Tab: return "Tab";
+    case TriviaKind::VerticalTab: return "VerticalTab";
+    case TriviaKind::Formfeed: return "Formfeed";
+    case TriviaKind::Newline: return "Newline";
+    case TriviaKind::CarriageReturn: return "CarriageReturn";
+    case TriviaKind::CarriageReturnLineFeed: return "CarriageReturnLineFeed";
+    case TriviaKind::LineComment: return "LineComment";
+    case TriviaKind::BlockComment: return "BlockComment";
+    case TriviaKind::DocLineComment: return "DocLineComment";
+    case TriviaKind::DocBlockComment: return "DocBlockComment";
+    case TriviaKind::Backtick: return "Backtick";
+    case TriviaKind::GarbageText: return "GarbageText";
+    }
+    llvm_unreachable("Unhandled trivia kind");
+  }
+
+  void addTrivia(const Trivia &T) {
+    appendU32(NodeData, T.Pieces.size());
+    for (const TriviaPiece &Piece : T) {
+      appendU32(NodeData, addString(getTriviaKindName(Piece.Kind)));
+      switch (Piece.Kind) {
+      case TriviaKind::Space:
+      case TriviaKind::Tab:
+      case TriviaKind::VerticalTab:
+      case TriviaKind::Formfeed:
+      case TriviaKind::Newline:
+      case TriviaKind::CarriageReturn:
+      case TriviaKind::CarriageReturnLineFeed:
+      case TriviaKind::Backtick:
+        appendU32(NodeData, Piece.Count);
+        break;
+      case TriviaKind::LineComment:
+      case TriviaKind::BlockComment:
+      case TriviaKind::DocLineComment:
+      case TriviaKind::DocBlockComment:
+      case TriviaKind::GarbageText:
+        appendU32(NodeData, addString(Piece.Text.str()));
+        break;
+      }
+    }
+  }
+
+  /// Emit the record for \p Node, after the records for its children, and
+  /// return its node index.
+  uint32_t addNode(const RC<RawSyntax> &Node) {
+    if (Node->isToken()) {
+      auto Tok = cast<RawTokenSyntax>(Node);
+      appendU32(NodeData, addKindName(SyntaxKind::Token));
+      appendU32(NodeData, Tok->isMissing() ? 1 : 0);
+      appendU32(NodeData, addString(getTokenKindName(Tok->getTokenKind())));
+      appendU32(NodeData, addString(Tok->getText()));
+      addTrivia(Tok->LeadingTrivia);
+      addTrivia(Tok->TrailingTrivia);
+      return NodeCount++;
+    }
+
+    // Emit the children first so the parent record can reference them.
+    llvm::SmallVector<uint32_t, 8> Children;
+    for (const RC<RawSyntax> &Child : Node->Layout)
+      Children.push_back(addNode(Child));
+
+    appendU32(NodeData, addKindName(Node->Kind));
+    appendU32(NodeData, Node->isMissing() ? 1 : 0);
+    appendU32(NodeData, Children.size());
+    for (uint32_t Child : Children)
+      appendU32(NodeData, Child);
+    return NodeCount++;
+  }
+
+public:
+  /// Serialize the tree rooted at \p Root to \p OS.
+  void write(const RC<RawSyntax> &Root, llvm::raw_ostream &OS) {
+    addNode(Root);
+    OS.write("SSBT", 4);
+    writeU32(OS, FormatVersion);
+    writeU32(OS, StringData.size());
+    writeU32(OS, NodeCount);
+    OS.write(StringData.data(), StringData.size());
+    OS.write(NodeData.data(), NodeData.size());
+  }
+};
+
+} // end namespace syntax
+} // end namespace swift
+
+#endif /* SWIFT_SYNTAX_SERIALIZATION_SYNTAXBINARYSERIALIZATION_H */
@@ -24,6 +24,7 @@ class Token;
 
 namespace syntax {
 struct RawTokenSyntax;
+class RawTokenSyntaxCache;
 struct RawSyntax;
 enum class SyntaxKind;
 
@@ -82,8 +83,9 @@ class SyntaxParsingContext {
   // Reference to the
   SyntaxParsingContext *&CtxtHolder;
 
-  // Collected parts.
-  std::vector<RC<RawSyntax>> Parts;
+  // Collected parts.  Contexts are short-lived and typically accumulate only
+  // a handful of parts, so keep them inline rather than on the heap.
+  llvm::SmallVector<RC<RawSyntax>, 8> Parts;
 
   // Operation on destruction.
   AccumulationMode Mode = AccumulationMode::NotSet;
@@ -101,6 +103,10 @@ class SyntaxParsingContext {
   // If false, context does nothing.
   bool Enabled;
 
+  // Content-addressed cache of token nodes, allocated by the root context and
+  // shared down the whole context stack so repeated tokens reuse one node.
+  RawTokenSyntaxCache *TokenCache;
+
   /// Create a syntax node using the tail \c N elements of collected parts and
   /// replace those parts with the single result.
   void createNodeInPlace(SyntaxKind Kind, size_t N);
@@ -112,7 +118,7 @@ public:
   /// Designated constructor for child context.
   SyntaxParsingContext(SyntaxParsingContext *&CtxtHolder)
       : Parent(CtxtHolder), CtxtHolder(CtxtHolder),
-        Enabled(Parent->isEnabled()) {
+        Enabled(Parent->isEnabled()), TokenCache(Parent->TokenCache) {
     assert(CtxtHolder->isTopOfContextStack() &&
            "SyntaxParsingContext cannot have multiple children");
     CtxtHolder = this;
@@ -80,6 +80,8 @@
 #define SWIFT_SYNTAX_TRIVIA_H
 
 #include "swift/Basic/OwnedString.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <vector>
@@ -268,6 +270,11 @@ public:
   /// Print this piece of trivia to the provided output stream.
   void print(llvm::raw_ostream &OS) const;
 
+  /// Return a hash of this piece's content, for interning token nodes.
+  llvm::hash_code hash() const {
+    return llvm::hash_combine(static_cast<unsigned>(Kind), Count, Text.str());
+  }
+
   bool operator==(const TriviaPiece &Other) const {
     return Kind == Other.Kind &&
            Count == Other.Count &&
@@ -279,7 +286,9 @@ public:
   }
 };
 
-using TriviaList = std::vector<TriviaPiece>;
+/// Most tokens carry at most one piece of leading and one piece of trailing
+/// trivia; keep that common case inline to avoid a heap allocation per token.
+using TriviaList = llvm::SmallVector<TriviaPiece, 1>;
 
 /// A collection of leading or trailing trivia. This is the main data structure
 /// for thinking about trivia.
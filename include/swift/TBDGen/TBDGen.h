@@ -14,6 +14,7 @@
 
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
+#include <string>
 
 namespace llvm {
 class raw_ostream;
@@ -28,6 +29,14 @@ void enumeratePublicSymbols(FileUnit *module, llvm::StringSet<> &symbols,
 void enumeratePublicSymbols(ModuleDecl *module, llvm::StringSet<> &symbols,
                             bool hasMultipleIGMs);
 
+/// Computes a hash of the parts of the module's AST that determine its
+/// exported symbol list: the decls visible outside the module, their names
+/// and types, and ABI-affecting attributes. The hash is conservative - it
+/// may change for edits that leave the symbols alone, but it changes
+/// whenever the symbols could - so callers can reuse a previously emitted
+/// TBD file when the hash matches without enumerating any symbols.
+std::string getAPISurfaceHash(ModuleDecl *M);
+
 void writeTBDFile(ModuleDecl *M, llvm::raw_ostream &os, bool hasMultipleIGMs,
                   llvm::StringRef installName);
 
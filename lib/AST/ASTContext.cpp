@@ -279,6 +279,33 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
   llvm::DenseMap<const AssociatedTypeDecl *, ArrayRef<AssociatedTypeDecl *>>
     AssociatedTypeOverrides;
 
+  /// \brief Cached results of module conformance lookups, including
+  /// negative answers.  Cleared whenever an extension is bound, since a
+  /// new extension can introduce conformances that change prior answers.
+  llvm::DenseMap<std::pair<TypeBase *, std::pair<ModuleDecl *, ProtocolDecl *>>,
+                 Optional<ProtocolConformanceRef>>
+    ConformsToCache;
+
+  /// \brief Memoized results of
+  /// \c GenericSignature::getCanonicalTypeInContext, keyed by signature
+  /// and canonical input type.
+  llvm::DenseMap<std::pair<GenericSignature *, TypeBase *>, CanType>
+    CanonicalTypesInContext;
+
+  /// \brief Structural fingerprints recorded for declarations during
+  /// parsing, used to detect which declarations changed between two
+  /// versions of a file.
+  llvm::DenseMap<const Decl *, uint64_t> DeclFingerprints;
+
+  /// \brief Memoized results of qualified name lookups into imported
+  /// modules, keyed by (importing module, imported module) and name.
+  /// Each entry records the generation it was computed in; entries from
+  /// older generations are discarded, since loading another module can
+  /// make more of an existing module's declarations visible.
+  llvm::DenseMap<std::pair<std::pair<ModuleDecl *, ModuleDecl *>, DeclName>,
+                 std::pair<unsigned, std::vector<ValueDecl *>>>
+    ImportedModuleLookupCache;
+
   /// \brief Structure that captures data that is segregated into different
   /// arenas.
   struct Arena {
@@ -300,9 +327,9 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
     llvm::DenseMap<std::pair<Type, void*>, DependentMemberType *>
       DependentMemberTypes;
     llvm::DenseMap<Type, DynamicSelfType *> DynamicSelfTypes;
-    llvm::FoldingSet<EnumType> EnumTypes;
-    llvm::FoldingSet<StructType> StructTypes;
-    llvm::FoldingSet<ClassType> ClassTypes;
+    llvm::DenseMap<std::pair<EnumDecl*, TypeBase*>, EnumType*> EnumTypes;
+    llvm::DenseMap<std::pair<StructDecl*, TypeBase*>, StructType*> StructTypes;
+    llvm::DenseMap<std::pair<ClassDecl*, TypeBase*>, ClassType*> ClassTypes;
     llvm::FoldingSet<UnboundGenericType> UnboundGenericTypes;
     llvm::FoldingSet<BoundGenericType> BoundGenericTypes;
     llvm::FoldingSet<ProtocolType> ProtocolTypes;
@@ -409,7 +436,10 @@ FOR_KNOWN_FOUNDATION_TYPES(CACHE_FOUNDATION_DECL)
 };
 
 ASTContext::Implementation::Implementation()
- : IdentifierTable(Allocator) {}
+ // Even small compilations intern thousands of identifiers; start the table
+ // large enough that it does not rehash several times while the standard
+ // library loads.
+ : IdentifierTable(4096, Allocator) {}
 ASTContext::Implementation::~Implementation() {
   for (auto &cleanup : Cleanups)
     cleanup();
@@ -1772,6 +1802,14 @@ ASTContext::getModule(ArrayRef<std::pair<Identifier, SourceLoc>> ModulePath) {
     return M;
 
   auto moduleID = ModulePath[0];
+
+  // Every file of a module resolves its imports independently, so a module
+  // that cannot be loaded is asked for once per importing file. Don't re-run
+  // the module loaders (and their search path scans) for a top-level module
+  // we already failed to load.
+  if (ModulePath.size() == 1 && FailedModuleImportNames.count(moduleID.first))
+    return nullptr;
+
   for (auto &importer : Impl.ModuleLoaders) {
     if (ModuleDecl *M = importer->loadModule(moduleID.second, ModulePath)) {
       if (ModulePath.size() == 1 &&
@@ -1782,6 +1820,9 @@ ASTContext::getModule(ArrayRef<std::pair<Identifier, SourceLoc>> ModulePath) {
     }
   }
 
+  if (ModulePath.size() == 1)
+    FailedModuleImportNames.insert(moduleID.first);
+
   return nullptr;
 }
 
@@ -2003,6 +2044,104 @@ ASTContext::getInheritedConformance(Type type, ProtocolConformance *inherited) {
   return result;
 }
 
+Optional<Optional<ProtocolConformanceRef>>
+ASTContext::getCachedConformsToProtocolResult(ModuleDecl *mod, Type type,
+                                              ProtocolDecl *protocol) {
+  auto key = std::make_pair(type->getCanonicalType().getPointer(),
+                            std::make_pair(mod, protocol));
+  auto known = Impl.ConformsToCache.find(key);
+  if (known == Impl.ConformsToCache.end())
+    return None;
+
+  return known->second;
+}
+
+void ASTContext::recordConformsToProtocolResult(
+    ModuleDecl *mod, Type type, ProtocolDecl *protocol,
+    Optional<ProtocolConformanceRef> result) {
+  // Types involving type variables live in the constraint solver's
+  // arena; never let them outlive it.
+  if (type->hasTypeVariable())
+    return;
+
+  auto key = std::make_pair(type->getCanonicalType().getPointer(),
+                            std::make_pair(mod, protocol));
+  Impl.ConformsToCache[key] = result;
+}
+
+void ASTContext::invalidateConformsToProtocolCache() {
+  Impl.ConformsToCache.clear();
+}
+
+CanType ASTContext::getCachedCanonicalTypeInContext(GenericSignature *sig,
+                                                    CanType type) {
+  return Impl.CanonicalTypesInContext.lookup({sig, type.getPointer()});
+}
+
+void ASTContext::recordCanonicalTypeInContext(GenericSignature *sig,
+                                              CanType type,
+                                              CanType canonical) {
+  Impl.CanonicalTypesInContext[{sig, type.getPointer()}] = canonical;
+}
+
+bool ASTContext::getCachedImportedModuleLookupResult(
+    ModuleDecl *importingModule, ModuleDecl *importedModule, DeclName name,
+    SmallVectorImpl<ValueDecl *> &decls) {
+  auto key = std::make_pair(std::make_pair(importingModule, importedModule),
+                            name);
+  auto known = Impl.ImportedModuleLookupCache.find(key);
+  if (known == Impl.ImportedModuleLookupCache.end())
+    return false;
+
+  // Loading another module can make more declarations visible in a module
+  // we already answered for; treat entries from older generations as
+  // misses.
+  if (known->second.first != CurrentGeneration) {
+    Impl.ImportedModuleLookupCache.erase(known);
+    return false;
+  }
+
+  decls.append(known->second.second.begin(), known->second.second.end());
+  return true;
+}
+
+void ASTContext::recordImportedModuleLookupResult(ModuleDecl *importingModule,
+                                                  ModuleDecl *importedModule,
+                                                  DeclName name,
+                                                  ArrayRef<ValueDecl *> decls) {
+  auto key = std::make_pair(std::make_pair(importingModule, importedModule),
+                            name);
+  auto &entry = Impl.ImportedModuleLookupCache[key];
+  entry.first = CurrentGeneration;
+  entry.second.assign(decls.begin(), decls.end());
+}
+
+void ASTContext::recordDeclFingerprint(const Decl *decl, uint64_t fingerprint) {
+  Impl.DeclFingerprints[decl] = fingerprint;
+}
+
+Optional<uint64_t> ASTContext::getDeclFingerprint(const Decl *decl) const {
+  auto known = Impl.DeclFingerprints.find(decl);
+  if (known == Impl.DeclFingerprints.end())
+    return None;
+
+  return known->second;
+}
+
+void ASTContext::releaseTypeCheckerCaches() {
+  // Conformance lookup and contextual canonicalization answers are pure
+  // memoization over uniqued structures; dropping them only costs
+  // recomputation for the few queries IRGen still issues.
+  Impl.ConformsToCache.shrink_and_clear();
+  Impl.CanonicalTypesInContext.shrink_and_clear();
+  Impl.ImportedModuleLookupCache.shrink_and_clear();
+
+  // Generic signature builders and canonical generic environments are
+  // deliberately retained: recreating an environment would mint fresh
+  // archetypes that no longer compare equal to the ones already embedded
+  // in SIL.
+}
+
 LazyContextData *ASTContext::getOrCreateLazyContextData(
                                                 const DeclContext *dc,
                                                 LazyMemberLoader *lazyLoader) {
@@ -3047,6 +3186,12 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
     return ParenType::get(C, Fields[0].getRawType(),
                           Fields[0].getParameterFlags());
 
+  // The empty tuple is requested often enough that hashing it into the
+  // uniquing table each time is measurable; it is created once when the
+  // ASTContext is set up.
+  if (Fields.empty() && C.TheEmptyTupleType)
+    return C.TheEmptyTupleType;
+
   RecursiveTypeProperties properties;
   bool hasInOut = false;
   for (const TupleTypeElt &Elt : Fields) {
@@ -3340,26 +3485,14 @@ EnumType::EnumType(EnumDecl *TheDecl, Type Parent, const ASTContext &C,
   : NominalType(TypeKind::Enum, &C, TheDecl, Parent, properties) { }
 
 EnumType *EnumType::get(EnumDecl *D, Type Parent, const ASTContext &C) {
-  llvm::FoldingSetNodeID id;
-  EnumType::Profile(id, D, Parent);
-
   RecursiveTypeProperties properties;
   if (Parent) properties |= Parent->getRecursiveProperties();
   auto arena = getArena(properties);
 
-  void *insertPos = nullptr;
-  if (auto enumTy
-        = C.Impl.getArena(arena).EnumTypes.FindNodeOrInsertPos(id, insertPos))
-    return enumTy;
-
-  auto enumTy = new (C, arena) EnumType(D, Parent, C, properties);
-  C.Impl.getArena(arena).EnumTypes.InsertNode(enumTy, insertPos);
-  return enumTy;
-}
+  auto &entry = C.Impl.getArena(arena).EnumTypes[{D, Parent.getPointer()}];
+  if (entry) return entry;
 
-void EnumType::Profile(llvm::FoldingSetNodeID &ID, EnumDecl *D, Type Parent) {
-  ID.AddPointer(D);
-  ID.AddPointer(Parent.getPointer());
+  return entry = new (C, arena) EnumType(D, Parent, C, properties);
 }
 
 StructType::StructType(StructDecl *TheDecl, Type Parent, const ASTContext &C,
@@ -3367,26 +3500,14 @@ StructType::StructType(StructDecl *TheDecl, Type Parent, const ASTContext &C,
   : NominalType(TypeKind::Struct, &C, TheDecl, Parent, properties) { }
 
 StructType *StructType::get(StructDecl *D, Type Parent, const ASTContext &C) {
-  llvm::FoldingSetNodeID id;
-  StructType::Profile(id, D, Parent);
-
   RecursiveTypeProperties properties;
   if (Parent) properties |= Parent->getRecursiveProperties();
   auto arena = getArena(properties);
 
-  void *insertPos = nullptr;
-  if (auto structTy
-        = C.Impl.getArena(arena).StructTypes.FindNodeOrInsertPos(id, insertPos))
-    return structTy;
-
-  auto structTy = new (C, arena) StructType(D, Parent, C, properties);
-  C.Impl.getArena(arena).StructTypes.InsertNode(structTy, insertPos);
-  return structTy;
-}
+  auto &entry = C.Impl.getArena(arena).StructTypes[{D, Parent.getPointer()}];
+  if (entry) return entry;
 
-void StructType::Profile(llvm::FoldingSetNodeID &ID, StructDecl *D, Type Parent) {
-  ID.AddPointer(D);
-  ID.AddPointer(Parent.getPointer());
+  return entry = new (C, arena) StructType(D, Parent, C, properties);
 }
 
 ClassType::ClassType(ClassDecl *TheDecl, Type Parent, const ASTContext &C,
@@ -3394,26 +3515,14 @@ ClassType::ClassType(ClassDecl *TheDecl, Type Parent, const ASTContext &C,
   : NominalType(TypeKind::Class, &C, TheDecl, Parent, properties) { }
 
 ClassType *ClassType::get(ClassDecl *D, Type Parent, const ASTContext &C) {
-  llvm::FoldingSetNodeID id;
-  ClassType::Profile(id, D, Parent);
-
   RecursiveTypeProperties properties;
   if (Parent) properties |= Parent->getRecursiveProperties();
   auto arena = getArena(properties);
 
-  void *insertPos = nullptr;
-  if (auto classTy
-        = C.Impl.getArena(arena).ClassTypes.FindNodeOrInsertPos(id, insertPos))
-    return classTy;
-
-  auto classTy = new (C, arena) ClassType(D, Parent, C, properties);
-  C.Impl.getArena(arena).ClassTypes.InsertNode(classTy, insertPos);
-  return classTy;
-}
+  auto &entry = C.Impl.getArena(arena).ClassTypes[{D, Parent.getPointer()}];
+  if (entry) return entry;
 
-void ClassType::Profile(llvm::FoldingSetNodeID &ID, ClassDecl *D, Type Parent) {
-  ID.AddPointer(D);
-  ID.AddPointer(Parent.getPointer());
+  return entry = new (C, arena) ClassType(D, Parent, C, properties);
 }
 
 ProtocolCompositionType *
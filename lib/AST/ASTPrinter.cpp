@@ -83,29 +83,43 @@ bool TypeTransformContext::isPrintingSynthesizedExtension() const {
   return Nominal != nullptr;
 }
 
-std::string ASTPrinter::sanitizeUtf8(StringRef Text) {
-  llvm::SmallString<256> Builder;
-  Builder.reserve(Text.size());
+StringRef ASTPrinter::sanitizeUtf8(StringRef Text,
+                                   llvm::SmallVectorImpl<char> &Buffer) {
   const llvm::UTF8* Data = reinterpret_cast<const llvm::UTF8*>(Text.begin());
   const llvm::UTF8* End = reinterpret_cast<const llvm::UTF8*>(Text.end());
+
+  // Almost all text is already well-formed; scan for the first bad sequence
+  // before copying anything.
+  while (Data < End) {
+    auto Step = llvm::getNumBytesForUTF8(*Data);
+    if (Data + Step > End || !llvm::isLegalUTF8Sequence(Data, Data + Step))
+      break;
+    Data += Step;
+  }
+  if (Data == End)
+    return Text;
+
+  Buffer.clear();
+  Buffer.reserve(Text.size());
+  Buffer.append(Text.begin(), reinterpret_cast<const char *>(Data));
   StringRef Replacement = u8"\ufffd";
   while (Data < End) {
     auto Step = llvm::getNumBytesForUTF8(*Data);
     if (Data + Step > End) {
-      Builder.append(Replacement);
+      Buffer.append(Replacement.begin(), Replacement.end());
       break;
     }
 
     if (llvm::isLegalUTF8Sequence(Data, Data + Step)) {
-      Builder.append(Data, Data + Step);
+      Buffer.append(Data, Data + Step);
     } else {
 
       // If malformed, add replacement characters.
-      Builder.append(Replacement);
+      Buffer.append(Replacement.begin(), Replacement.end());
     }
     Data += Step;
   }
-  return Builder.str();
+  return StringRef(Buffer.data(), Buffer.size());
 }
 
 ValueDecl* ASTPrinter::findConformancesWithDocComment(ValueDecl *VD) {
@@ -129,11 +143,12 @@ ValueDecl* ASTPrinter::findConformancesWithDocComment(ValueDecl *VD) {
 void ASTPrinter::anchor() {}
 
 void ASTPrinter::printIndent() {
-  llvm::SmallString<16> Str;
-  for (unsigned i = 0; i != CurrentIndentation; ++i)
-    Str += ' ';
-
-  printText(Str);
+  static const char Spaces[] = "                                ";
+  for (unsigned n = CurrentIndentation; n; ) {
+    unsigned chunk = std::min(n, unsigned(sizeof(Spaces) - 1));
+    printText(StringRef(Spaces, chunk));
+    n -= chunk;
+  }
 }
 
 void ASTPrinter::printTextImpl(StringRef Text) {
@@ -360,8 +375,9 @@ class PrintAST : public ASTVisitor<PrintAST> {
         RC->getRawText(ClangContext.getSourceManager()).rtrim("\n\r");
     trimLeadingWhitespaceFromLines(RawText, WhitespaceToTrim, Lines);
 
+    llvm::SmallString<256> SanitizedLine;
     for (auto Line : Lines) {
-      Printer << ASTPrinter::sanitizeUtf8(Line);
+      Printer << ASTPrinter::sanitizeUtf8(Line, SanitizedLine);
       Printer.printNewline();
     }
   }
@@ -1623,9 +1623,15 @@ const ASTScope *ASTScope::findInnermostEnclosingScope(SourceLoc loc) const {
   ASTContext &ctx = getASTContext();
   SourceManager &sourceMgr = ctx.SourceMgr;
 
+  // Consecutive lookups tend to be issued at the same or nearby locations,
+  // so resume the search from wherever the last one ended up.
+  auto sourceFileScope = getSourceFileScope();
+  const ASTScope *searchNode = sourceFileScope->sourceFile.lastInnermostScope;
+  if (!searchNode)
+    searchNode = this;
+
   // Search up the tree to find the nearest parent that contains this source
   // location.
-  const ASTScope *searchNode = this;
   while (!sourceMgr.rangeContainsTokenLoc(searchNode->getSourceRange(), loc))
     searchNode = searchNode->getParent();
 
@@ -1659,6 +1665,7 @@ const ASTScope *ASTScope::findInnermostEnclosingScope(SourceLoc loc) const {
 
     // Otherwise, our current search node is the best we could find.
     assert(sourceMgr.rangeContainsTokenLoc(searchNode->getSourceRange(), loc));
+    sourceFileScope->sourceFile.lastInnermostScope = searchNode;
     return searchNode;
   };
 }
@@ -35,6 +35,7 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
+#include <cstdlib>
 #include <functional>
 #include <type_traits>
 using namespace swift;
@@ -3437,8 +3438,43 @@ public:
   };
 } // end anonymous namespace
 
+#if !(defined(NDEBUG) || defined(SWIFT_DISABLE_AST_VERIFIER))
+/// Returns the stride N for 1-in-N sampled verification, or 1 when the
+/// verifier should check everything.
+///
+/// Sampling is controlled by the SWIFT_AST_VERIFIER_SAMPLE_RATE environment
+/// variable so CI can keep the verifier enabled on large modules, where a
+/// full walk of every source file dominates +Asserts build time. Each run
+/// still verifies a deterministic slice of the module; unparseable or zero
+/// values fall back to full verification.
+static unsigned getASTVerifierSampleRate() {
+  static const unsigned rate = [] {
+    if (const char *env = ::getenv("SWIFT_AST_VERIFIER_SAMPLE_RATE")) {
+      unsigned value;
+      if (!StringRef(env).getAsInteger(10, value) && value > 0)
+        return value;
+    }
+    return 1u;
+  }();
+  return rate;
+}
+#endif
+
 void swift::verify(SourceFile &SF) {
 #if !(defined(NDEBUG) || defined(SWIFT_DISABLE_AST_VERIFIER))
+  unsigned sampleRate = getASTVerifierSampleRate();
+  if (sampleRate > 1) {
+    // Verify one in every N top-level decls. The starting offset is derived
+    // from the file name, so distinct files cover different residues and the
+    // sampled slice is stable across runs of the same compilation.
+    unsigned offset = llvm::hash_value(SF.getFilename()) % sampleRate;
+    unsigned index = 0;
+    for (auto *D : SF.Decls) {
+      if (index++ % sampleRate == offset)
+        verify(D);
+    }
+    return;
+  }
   Verifier verifier(SF, &SF);
   SF.walk(verifier);
 #endif
@@ -3456,6 +3492,13 @@ bool swift::shouldVerify(const Decl *D, const ASTContext &Context) {
     return true;
   }
 
+  unsigned sampleRate = getASTVerifierSampleRate();
+  if (sampleRate > 1) {
+    // In sampling mode, fully verify only one in every N named decls.
+    static unsigned counter = 0;
+    return ++counter % sampleRate == 0;
+  }
+
   return true;
 #else
   return false;
@@ -471,6 +471,10 @@ bool ConformanceLookupTable::addProtocol(ProtocolDecl *protocol, SourceLoc loc,
   ConformanceEntry *entry = new (ctx) ConformanceEntry(loc, protocol, source);
   conformanceEntries.push_back(entry);
 
+  // A new entry can imply conformances to protocols that previously had
+  // none, so cached negative lookup results are no longer trustworthy.
+  NegativeLookups.clear();
+
   // Record this as a conformance within the given declaration
   // context.
   AllConformances[dc].push_back(entry);
@@ -920,6 +924,13 @@ bool ConformanceLookupTable::lookupConformance(
   // Update to record all explicit and inherited conformances.
   updateLookupTable(nominal, ConformanceStage::Inherited, resolver);
 
+  // If this protocol already missed after full expansion and no new entry
+  // has been recorded since, there is nothing further to find. The update
+  // above records conformances from any newly-added extensions, which
+  // clears the cache, so a hit here cannot be stale.
+  if (NegativeLookups.count(protocol))
+    return false;
+
   // Look for conformances to this protocol.
   auto known = Conformances.find(protocol);
   if (known == Conformances.end()) {
@@ -928,8 +939,10 @@ bool ConformanceLookupTable::lookupConformance(
     known = Conformances.find(protocol);
 
     // We didn't find anything.
-    if (known == Conformances.end())
+    if (known == Conformances.end()) {
+      NegativeLookups.insert(protocol);
       return false;
+    }
   }
 
   // Resolve the conformances for this protocol.
@@ -27,6 +27,7 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include <unordered_map>
 
 namespace swift {
@@ -311,6 +312,15 @@ class ConformanceLookupTable {
   /// The conformance table.
   ConformanceTable Conformances;
 
+  /// Protocols that were looked up, fully expanded, and found to have no
+  /// conformance entries.
+  ///
+  /// Caching these negative results lets repeated queries for a protocol
+  /// the type does not conform to answer without re-walking the stages.
+  /// The cache is cleared whenever a new entry is recorded, since a newly
+  /// seen conformance can imply conformances to arbitrary other protocols.
+  llvm::SmallPtrSet<ProtocolDecl *, 4> NegativeLookups;
+
   typedef llvm::SmallVector<ProtocolDecl *, 2> ProtocolList;
 
   /// List of all of the protocols to which a given context declares
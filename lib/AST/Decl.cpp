@@ -2471,7 +2471,12 @@ ExtensionRange NominalTypeDecl::getExtensions() {
 void NominalTypeDecl::addExtension(ExtensionDecl *extension) {
   assert(!extension->NextExtension.getInt() && "Already added extension");
   extension->NextExtension.setInt(true);
-  
+
+  // The extension may declare conformances that change cached lookup
+  // answers.
+  getASTContext().invalidateConformsToProtocolCache();
+
+
   // First extension; set both first and last.
   if (!FirstExtension) {
     FirstExtension = extension;
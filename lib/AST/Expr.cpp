@@ -934,8 +934,8 @@ shallowCloneImpl(const StringLiteralExpr *E, ASTContext &Ctx,
 static LiteralExpr *
 shallowCloneImpl(const InterpolatedStringLiteralExpr *E, ASTContext &Ctx,
                  llvm::function_ref<Type(const Expr *)> getType) {
-  auto res = new (Ctx) InterpolatedStringLiteralExpr(E->getLoc(),
-                const_cast<InterpolatedStringLiteralExpr*>(E)->getSegments());
+  auto res = InterpolatedStringLiteralExpr::create(Ctx, E->getLoc(),
+                                                   E->getSegments());
   res->setSemanticExpr(E->getSemanticExpr());
   return res;
 }
@@ -1362,6 +1362,14 @@ InOutExpr::InOutExpr(SourceLoc operLoc, Expr *subExpr, Type baseType,
          baseType.isNull() ? baseType : InOutType::get(baseType)),
     SubExpr(subExpr), OperLoc(operLoc) {}
 
+InterpolatedStringLiteralExpr *
+InterpolatedStringLiteralExpr::create(ASTContext &ctx, SourceLoc loc,
+                                      ArrayRef<Expr *> segments) {
+  auto size = totalSizeToAlloc<Expr *>(segments.size());
+  auto mem = ctx.Allocate(size, alignof(InterpolatedStringLiteralExpr));
+  return ::new(mem) InterpolatedStringLiteralExpr(loc, segments);
+}
+
 SequenceExpr *SequenceExpr::create(ASTContext &ctx, ArrayRef<Expr*> elements) {
   assert(elements.size() & 1 && "even number of elements in sequence");
   void *Buffer = ctx.Allocate(sizeof(SequenceExpr) +
@@ -871,8 +871,17 @@ CanType GenericSignature::getCanonicalTypeInContext(Type type) {
   if (!type->hasTypeParameter())
     return CanType(type);
 
+  // This query is hot and highly repetitive, and the answer never
+  // changes once the signature's builder has been built, so memoize it
+  // on the ASTContext.
+  auto &ctx = getASTContext();
+  if (auto cached = ctx.getCachedCanonicalTypeInContext(this, CanType(type)))
+    return cached;
+
   auto &builder = *getGenericSignatureBuilder();
-  return getCanonicalTypeInContext(type, builder);
+  auto result = getCanonicalTypeInContext(type, builder);
+  ctx.recordCanonicalTypeInContext(this, CanType(type), result);
+  return result;
 }
 
 GenericEnvironment *CanGenericSignature::getGenericEnvironment() const {
@@ -43,6 +43,7 @@
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -559,6 +560,59 @@ void SourceFile::getLocalTypeDecls(SmallVectorImpl<TypeDecl*> &Results) const {
   Results.append(LocalTypeDecls.begin(), LocalTypeDecls.end());
 }
 
+void SourceFile::getDeclFingerprints(
+    SmallVectorImpl<DeclFingerprint> &fingerprints) const {
+  auto &ctx = getASTContext();
+  for (auto *D : Decls) {
+    auto *VD = dyn_cast<ValueDecl>(D);
+    if (!VD || !VD->hasName())
+      continue;
+
+    if (auto fingerprint = ctx.getDeclFingerprint(D))
+      fingerprints.push_back(
+          {VD->getBaseName().userFacingName(), *fingerprint});
+  }
+}
+
+void SourceFile::diffDeclFingerprints(
+    ArrayRef<DeclFingerprint> oldFingerprints,
+    ArrayRef<DeclFingerprint> newFingerprints,
+    SmallVectorImpl<StringRef> &changedNames) {
+  // Aggregate the fingerprints by name, so that a set of overloads sharing
+  // a base name is treated as changed whenever any of them changes.
+  // XOR keeps the aggregate independent of declaration order.
+  llvm::StringMap<uint64_t> oldByName;
+  for (const auto &entry : oldFingerprints)
+    oldByName[entry.first] ^= entry.second;
+
+  llvm::StringMap<uint64_t> newByName;
+  for (const auto &entry : newFingerprints)
+    newByName[entry.first] ^= entry.second;
+
+  // Report added and changed names, using the caller's storage for the
+  // names themselves.
+  llvm::StringSet<> reported;
+  for (const auto &entry : newFingerprints) {
+    if (!reported.insert(entry.first).second)
+      continue;
+
+    auto known = oldByName.find(entry.first);
+    if (known == oldByName.end() ||
+        known->second != newByName[entry.first])
+      changedNames.push_back(entry.first);
+  }
+
+  // Report removed names.
+  reported.clear();
+  for (const auto &entry : oldFingerprints) {
+    if (!reported.insert(entry.first).second)
+      continue;
+
+    if (!newByName.count(entry.first))
+      changedNames.push_back(entry.first);
+  }
+}
+
 void ModuleDecl::getDisplayDecls(SmallVectorImpl<Decl*> &Results) const {
   // FIXME: Should this do extra access control filtering?
   FORWARD(getDisplayDecls, (Results));
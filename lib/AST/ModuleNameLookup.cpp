@@ -263,6 +263,25 @@ void namelookup::lookupInModule(ModuleDecl *startModule,
                                 const DeclContext *moduleScopeContext,
                                 ArrayRef<ModuleDecl::ImportedModule> extraImports) {
   assert(moduleScopeContext && moduleScopeContext->isModuleScopeContext());
+  ASTContext &ctx = startModule->getASTContext();
+  ModuleDecl *importingModule = moduleScopeContext->getParentModule();
+
+  // Qualified lookups into another module are memoized per importing
+  // module: the answer cannot depend on which of its files asked (private
+  // declarations are never visible across modules, and @testable
+  // visibility is a property of the importing module), and it only
+  // changes when loading new modules makes more declarations visible,
+  // which the cache's generation check covers.
+  bool canCache = lookupKind == NLKind::QualifiedLookup &&
+                  resolutionKind == ResolutionKind::Overloadable &&
+                  topAccessPath.empty() && extraImports.empty() &&
+                  importingModule != startModule;
+  if (canCache &&
+      ctx.getCachedImportedModuleLookupResult(importingModule, startModule,
+                                              name, decls))
+    return;
+  size_t initialCount = decls.size();
+
   ModuleLookupCache cache;
   bool respectAccessControl = startModule->getASTContext().LangOpts
                                 .EnableAccessControl;
@@ -275,6 +294,11 @@ void namelookup::lookupInModule(ModuleDecl *startModule,
       module->lookupValue(path, name, lookupKind, localDecls);
     }
   );
+
+  if (canCache)
+    ctx.recordImportedModuleLookupResult(
+        importingModule, startModule, name,
+        llvm::makeArrayRef(decls).slice(initialCount));
 }
 
 void namelookup::lookupVisibleDeclsInModule(
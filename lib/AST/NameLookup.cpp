@@ -1024,6 +1024,14 @@ public:
     return Lookup.find(name);
   }
 
+  /// \brief Record that \p name has been looked up in the lazy member
+  /// tables, so that a subsequent miss on the same name can be answered
+  /// without consulting the loaders again. Does nothing if the name
+  /// already has an entry.
+  void addEmptyEntry(DeclName name) {
+    (void)Lookup[name];
+  }
+
   // \brief Mark all Decls in this table as not-resident in a table, drop
   // references to them. Should only be called when this was not fully-populated
   // from an IterableDeclContext.
@@ -1440,6 +1448,11 @@ TinyPtrVector<ValueDecl *> NominalTypeDecl::lookupDirect(
         populateLookupTableEntryFromExtensions(ctx, Table, this, name,
                                                ignoreNewExtensions)) {
       useNamedLazyMemberLoading = false;
+    } else {
+      // The lazy member tables have now been consulted for this name; make
+      // sure it has an entry — possibly an empty one — so that looking up
+      // the same missing name again does not go back to the loaders.
+      Table.addEmptyEntry(name);
     }
   }
 
@@ -22,15 +22,12 @@
 using namespace swift;
 
 ClusteredBitVector ClusteredBitVector::fromAPInt(const llvm::APInt &bits) {
-  // This is not a very efficient algorithm.
+  // This assumes that the chunk size is the same as APInt's.
   ClusteredBitVector result;
-  for (unsigned i = 0, e = bits.getBitWidth(); i != e; ++i) {
-    if (bits[i]) {
-      result.appendSetBits(1);
-    } else {
-      result.appendClearBits(1);
-    }
-  }
+  if (bits.getBitWidth() == 0)
+    return result;
+  result.reserve(bits.getBitWidth());
+  result.appendReserved(bits.getBitWidth(), bits.getRawData());
   return result;
 }
 
@@ -122,10 +119,33 @@ void ClusteredBitVector::appendConstantBitsReserved(size_t numBits,
   assert(LengthInBits + numBits <= getCapacityInBits());
   assert(numBits > 0);
 
+  // This is hot enough in IRGen's spare-bit mask computation to justify
+  // filling whole chunks directly instead of going through the generator
+  // version of appendReserved, which costs an indirect call per chunk.
   ChunkType pattern = (addOnes ? ~ChunkType(0) : ChunkType(0));
-  appendReserved(numBits, [=](size_t numBitsWanted) -> ChunkType {
-    return (pattern >> (ChunkSizeInBits - numBitsWanted));
-  });
+  auto offset = LengthInBits % ChunkSizeInBits;
+  ChunkType *nextChunk = &getChunksPtr()[LengthInBits / ChunkSizeInBits];
+  LengthInBits += numBits;
+
+  // If the current end of the vector is not a clean multiple of the chunk
+  // size, mix bits into the remainder of the last chunk. Its extra bits
+  // are guaranteed to be zero, so there is nothing to do for clear bits.
+  if (offset) {
+    auto claimedBits = std::min(numBits, size_t(ChunkSizeInBits - offset));
+    if (addOnes)
+      *nextChunk |= (((ChunkType(1) << claimedBits) - 1) << offset);
+    ++nextChunk;
+    numBits -= claimedBits;
+    if (numBits == 0) return;
+  }
+
+  // Fill the whole chunks in one go.
+  size_t wholeChunks = numBits / ChunkSizeInBits;
+  memset(nextChunk, addOnes ? 0xFF : 0, wholeChunks * sizeof(ChunkType));
+
+  // And finish off with a partial chunk, if necessary.
+  if (auto tailBits = numBits % ChunkSizeInBits)
+    nextChunk[wholeChunks] = (pattern >> (ChunkSizeInBits - tailBits));
 }
 
 void ClusteredBitVector::appendReserved(size_t numBits,
@@ -152,23 +152,36 @@ void Output::endBitSetScalar() {
   Stream << ']';
 }
 
+/// Returns true if the given byte must be escaped in a JSON string.
+///
+/// According to the JSON standard, the following characters must be escaped:
+///   - Quotation mark (U+0022)
+///   - Reverse solidus (U+005C)
+///   - Control characters (U+0000 to U+001F)
+///
+/// Since these are represented by a single byte in UTF8 (and will not be
+/// present in any multi-byte UTF8 representations), we can just inspect the
+/// value of each byte. Any other bytes present in the string can be emitted
+/// as-is, without any escaping.
+static bool mustEscape(unsigned char c) {
+  return c == '"' || c == '\\' || c == '/' || c <= '\x1F';
+}
+
 void Output::scalarString(StringRef &S, bool MustQuote) {
   if (MustQuote) {
     Stream << '"';
-    for (unsigned char c : S) {
-      // According to the JSON standard, the following characters must be
-      // escaped:
-      //   - Quotation mark (U+0022)
-      //   - Reverse solidus (U+005C)
-      //   - Control characters (U+0000 to U+001F)
-      // We need to check for these and escape them if present.
-      //
-      // Since these are represented by a single byte in UTF8 (and will not be
-      // present in any multi-byte UTF8 representations), we can just switch on
-      // the value of the current byte.
-      //
-      // Any other bytes present in the string should therefore be emitted
-      // as-is, without any escaping.
+    while (!S.empty()) {
+      // Emit the longest prefix that needs no escaping as a single write,
+      // rather than pushing the string through the stream byte by byte.
+      size_t i = 0;
+      while (i != S.size() && !mustEscape(S[i]))
+        ++i;
+      Stream << S.slice(0, i);
+      if (i == S.size())
+        break;
+
+      unsigned char c = S[i];
+      S = S.drop_front(i + 1);
       switch (c) {
       // First, check for characters for which JSON has custom escape sequences.
       case '"':
@@ -196,23 +209,15 @@ void Output::scalarString(StringRef &S, bool MustQuote) {
         Stream << '\\' << 't';
         break;
       default:
-        // Otherwise, check to see if the current byte is a control character.
-        if (c <= '\x1F') {
-          // Since we have a control character, we need to escape it using
-          // JSON's only valid escape sequence: \uxxxx (where x is a hex digit).
-
-          // The upper two digits for control characters are always 00.
-          Stream << "\\u00";
-
-          // Convert the current character into hexadecimal digits.
-          Stream << llvm::hexdigit((c >> 4) & 0xF);
-          Stream << llvm::hexdigit((c >> 0) & 0xF);
-        } else {
-          // This isn't a control character, so we don't need to escape it.
-          // As a result, emit it directly; if it's part of a multi-byte UTF8
-          // representation, all bytes will be emitted in this fashion.
-          Stream << c;
-        }
+        // We have some other control character, so we need to escape it using
+        // JSON's only valid escape sequence: \uxxxx (where x is a hex digit).
+
+        // The upper two digits for control characters are always 00.
+        Stream << "\\u00";
+
+        // Convert the current character into hexadecimal digits.
+        Stream << llvm::hexdigit((c >> 4) & 0xF);
+        Stream << llvm::hexdigit((c >> 0) & 0xF);
         break;
       }
     }
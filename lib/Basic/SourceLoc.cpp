@@ -15,6 +15,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 
 using namespace swift;
 
@@ -189,6 +190,49 @@ StringRef SourceManager::extractText(CharSourceRange Range,
                        Range.getByteLength());
 }
 
+ArrayRef<unsigned> SourceManager::getLineStartOffsets(unsigned BufferID) const {
+  auto known = LineStartOffsets.find(BufferID);
+  if (known != LineStartOffsets.end())
+    return known->second;
+
+  StringRef buffer = LLVMSourceMgr.getMemoryBuffer(BufferID)->getBuffer();
+  std::vector<unsigned> &offsets = LineStartOffsets[BufferID];
+  offsets.push_back(0);
+  for (size_t i = 0, e = buffer.size(); i != e; ++i)
+    if (buffer[i] == '\n')
+      offsets.push_back(i + 1);
+  return offsets;
+}
+
+std::pair<unsigned, unsigned>
+SourceManager::getLineAndColumn(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  int LineOffset = getLineOffset(Loc);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+  ArrayRef<unsigned> LineStarts = getLineStartOffsets(BufferID);
+  // The first line-start offset greater than Offset belongs to the next
+  // line, so the number of offsets up to and including the match is the
+  // 1-based line number.
+  auto NextLine =
+      std::upper_bound(LineStarts.begin(), LineStarts.end(), Offset);
+  unsigned Line = NextLine - LineStarts.begin();
+  unsigned Col = Offset - *(NextLine - 1) + 1;
+  assert(LineOffset + int(Line) > 0 && "bogus line offset");
+  return { LineOffset + Line, Col };
+}
+
+unsigned SourceManager::getLineNumber(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+  ArrayRef<unsigned> LineStarts = getLineStartOffsets(BufferID);
+  return std::upper_bound(LineStarts.begin(), LineStarts.end(), Offset) -
+         LineStarts.begin();
+}
+
 unsigned SourceManager::findBufferContainingLoc(SourceLoc Loc) const {
   assert(Loc.isValid());
   // Search the buffers back-to front, so later alias buffers are
@@ -298,29 +342,20 @@ llvm::Optional<unsigned> SourceManager::resolveFromLineCol(unsigned BufferId,
   if (Line == 0 || Col == 0) {
     return None;
   }
-  auto InputBuf = getLLVMSourceMgr().getMemoryBuffer(BufferId);
-  const char *Ptr = InputBuf->getBufferStart();
-  const char *End = InputBuf->getBufferEnd();
-  const char *LineStart = Ptr;
-  for (; Ptr < End; ++Ptr) {
-    if (*Ptr == '\n') {
-      --Line;
-      if (Line == 0)
-        break;
-      LineStart = Ptr+1;
-    }
-  }
-  if (Line != 0) {
+  ArrayRef<unsigned> LineStarts = getLineStartOffsets(BufferId);
+  // The requested line must be terminated by a newline, i.e. a start offset
+  // for the following line must exist.
+  if (Line >= LineStarts.size()) {
     return None;
   }
-  Ptr = LineStart;
-  for (; Ptr < End; ++Ptr) {
-    --Col;
-    if (Col == 0)
-      return Ptr - InputBuf->getBufferStart();
-    if (*Ptr == '\n')
-      break;
+  unsigned LineStart = LineStarts[Line - 1];
+  unsigned NewlineOffset = LineStarts[Line] - 1;
+  unsigned Offset = LineStart + (Col - 1);
+  // The column may point at any character in the line, including its
+  // terminating newline, but not past it.
+  if (Offset > NewlineOffset) {
+    return None;
   }
-  return None;
+  return Offset;
 }
 
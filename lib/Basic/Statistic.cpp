@@ -70,6 +70,12 @@ makeTraceFileName(StringRef ProgramName,
   return makeFileName("trace", ProgramName, AuxName, "csv");
 }
 
+static std::string
+makeChromeTraceFileName(StringRef ProgramName,
+                        StringRef AuxName) {
+  return makeFileName("chrometrace", ProgramName, AuxName, "json");
+}
+
 // LLVM's statistics-reporting machinery is sensitive to filenames containing
 // YAML-quote-requiring characters, which occur surprisingly often in the wild;
 // we only need a recognizable and likely-unique name for a target here, not an
@@ -126,7 +132,8 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            StringRef OptType,
                                            StringRef Directory,
                                            SourceManager *SM,
-                                           bool TraceEvents)
+                                           bool TraceEvents,
+                                           bool ChromeTraceEvents)
   : UnifiedStatsReporter(ProgramName,
                          auxName(ModuleName,
                                  InputName,
@@ -134,7 +141,7 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                  OutputType,
                                  OptType),
                          Directory,
-                         SM, TraceEvents)
+                         SM, TraceEvents, ChromeTraceEvents)
 {
 }
 
@@ -142,19 +149,26 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
                                            StringRef AuxName,
                                            StringRef Directory,
                                            SourceManager *SM,
-                                           bool TraceEvents)
+                                           bool TraceEvents,
+                                           bool ChromeTraceEvents)
   : currentProcessExitStatusSet(false),
     currentProcessExitStatus(EXIT_FAILURE),
     StatsFilename(Directory),
     TraceFilename(Directory),
+    ChromeTraceFilename(Directory),
     StartedTime(llvm::TimeRecord::getCurrentTime()),
     Timer(make_unique<NamedRegionTimer>(AuxName,
                                         "Building Target",
                                         ProgramName, "Running Program")),
-    SourceMgr(SM)
+    SourceMgr(SM),
+    ChromeTracing(ChromeTraceEvents),
+    TracerSampleRate(0),
+    TracerSampleCount(0)
 {
   path::append(StatsFilename, makeStatsFileName(ProgramName, AuxName));
   path::append(TraceFilename, makeTraceFileName(ProgramName, AuxName));
+  path::append(ChromeTraceFilename,
+               makeChromeTraceFileName(ProgramName, AuxName));
   EnableStatistics(/*PrintOnExit=*/false);
   SharedTimer::enableCompilationTimers();
   if (TraceEvents)
@@ -185,6 +199,11 @@ UnifiedStatsReporter::getFrontendRecursiveSharedTimers() {
   return *FrontendRecursiveSharedTimers;
 }
 
+void
+UnifiedStatsReporter::setTracerSampleRate(uint64_t N) {
+  TracerSampleRate = N;
+}
+
 void
 UnifiedStatsReporter::noteCurrentProcessExitStatus(int status) {
   assert(!currentProcessExitStatusSet);
@@ -297,12 +316,18 @@ UnifiedStatsReporter::FrontendStatsTracer
 UnifiedStatsReporter::getStatsTracer(StringRef N,
                                      SourceRange const &R)
 {
-  if (LastTracedFrontendCounters)
-    // Return live tracer object.
-    return FrontendStatsTracer(N, R, this);
-  else
+  if (!LastTracedFrontendCounters && !ChromeTracing)
     // Return inert tracer object.
     return FrontendStatsTracer();
+
+  // When sampling, most scopes get an inert tracer, skipping both timestamp
+  // reads and the counter scan on entry and exit. A skipped scope emits no
+  // events at all, so begin/end pairs stay matched.
+  if (TracerSampleRate > 1 && (TracerSampleCount++ % TracerSampleRate) != 0)
+    return FrontendStatsTracer();
+
+  // Return live tracer object.
+  return FrontendStatsTracer(N, R, this);
 }
 
 void
@@ -310,12 +335,17 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
     FrontendStatsTracer const& T,
     bool IsEntry)
 {
-  if (!LastTracedFrontendCounters)
+  if (!LastTracedFrontendCounters && !ChromeTracing)
     return;
   auto Now = llvm::TimeRecord::getCurrentTime();
   auto StartUS = uint64_t(1000000.0 * T.SavedTime.getProcessTime());
   auto NowUS = uint64_t(1000000.0 * Now.getProcessTime());
   auto LiveUS = IsEntry ? 0 : NowUS - StartUS;
+  if (ChromeTracing)
+    ChromeTraceEvents.emplace_back(
+        ChromeTraceEvent{NowUS, IsEntry, T.Name, T.Range});
+  if (!LastTracedFrontendCounters)
+    return;
   auto &C = getFrontendCounters();
 #define FRONTEND_STATISTIC(TY, NAME)                          \
   do {                                                        \
@@ -431,6 +461,37 @@ UnifiedStatsReporter::~UnifiedStatsReporter()
       tstream << '"' << '\n';
     }
   }
+
+  if (ChromeTracing) {
+    std::error_code EC;
+    raw_fd_ostream cstream(ChromeTraceFilename, EC, fs::F_Append | fs::F_Text);
+    if (EC) {
+      llvm::errs() << "Error opening -chrome-trace-stats-events file '"
+                   << ChromeTraceFilename << "' for writing\n";
+      return;
+    }
+    // Chrome's trace viewer (chrome://tracing) accepts a JSON array of
+    // events; "B" and "E" events pair up by nesting order within a thread.
+    // Timestamps are process time in microseconds, matching the CSV trace.
+    cstream << "[\n";
+    const char *delim = "";
+    for (auto const &E : ChromeTraceEvents) {
+      cstream << delim
+              << "{\"name\": \"" << E.EventName << "\","
+              << " \"cat\": \"swift\","
+              << " \"ph\": \"" << (E.IsBegin ? 'B' : 'E') << "\","
+              << " \"pid\": 1, \"tid\": 1,"
+              << " \"ts\": " << E.TimeUSec;
+      if (E.IsBegin && SourceMgr && E.SourceRange.isValid()) {
+        cstream << ", \"args\": {\"loc\": \"";
+        E.SourceRange.print(cstream, *SourceMgr, false);
+        cstream << "\"}";
+      }
+      cstream << "}";
+      delim = ",\n";
+    }
+    cstream << "\n]\n";
+  }
 }
 
 } // namespace swift
@@ -21,6 +21,7 @@
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Compiler.h"
 #include <algorithm>
@@ -45,27 +46,71 @@ bool swift::canBeMemberName(StringRef identifier) {
     .Default(true);
 }
 
-PrepositionKind swift::getPrepositionKind(StringRef word) {
+namespace {
+/// Classification of a dictionary word from PartsOfSpeech.def.
+enum class WordKind : uint8_t {
+  Verb,
+  Preposition,
+  DirectionalPreposition,
+};
+} // end anonymous namespace
+
+/// The words from PartsOfSpeech.def, hashed once per process. Word
+/// classification runs for every decl the Clang importer translates, so a
+/// scan of the whole table per query adds up over an SDK's worth of names.
+static const llvm::StringMap<WordKind> &getWordClassificationTable() {
+  static const llvm::StringMap<WordKind> table = [] {
+    llvm::StringMap<WordKind> result;
 #define DIRECTIONAL_PREPOSITION(Word)           \
-  if (word.equals_lower(#Word))                 \
-    return PK_Directional;
+    result[#Word] = WordKind::DirectionalPreposition;
 #define PREPOSITION(Word)                       \
-  if (word.equals_lower(#Word))                 \
-    return PK_Nondirectional;
+    result[#Word] = WordKind::Preposition;
+#define VERB(Word)                              \
+    result[#Word] = WordKind::Verb;
 #include "PartsOfSpeech.def"
+    return result;
+  }();
+  return table;
+}
+
+/// Look up a word in the classification table. The table entries are all
+/// lowercase; queries produced by camelCase splitting may not be.
+static Optional<WordKind> classifyWord(StringRef word) {
+  SmallString<16> lowercased;
+  for (char c : word)
+    lowercased.push_back(clang::toLowercase(c));
+  const auto &table = getWordClassificationTable();
+  auto known = table.find(lowercased);
+  if (known == table.end())
+    return None;
+  return known->second;
+}
+
+PrepositionKind swift::getPrepositionKind(StringRef word) {
+  if (auto kind = classifyWord(word)) {
+    switch (*kind) {
+    case WordKind::DirectionalPreposition:
+      return PK_Directional;
+    case WordKind::Preposition:
+      return PK_Nondirectional;
+    case WordKind::Verb:
+      break;
+    }
+  }
 
   return PK_None;
 }
 
 PartOfSpeech swift::getPartOfSpeech(StringRef word) {
-  // FIXME: This implementation is woefully inefficient.
-#define PREPOSITION(Word)                       \
-  if (word.equals_lower(#Word))                 \
-    return PartOfSpeech::Preposition;
-#define VERB(Word)                              \
-  if (word.equals_lower(#Word))                 \
-    return PartOfSpeech::Verb;
-#include "PartsOfSpeech.def"
+  if (auto kind = classifyWord(word)) {
+    switch (*kind) {
+    case WordKind::Preposition:
+    case WordKind::DirectionalPreposition:
+      return PartOfSpeech::Preposition;
+    case WordKind::Verb:
+      return PartOfSpeech::Verb;
+    }
+  }
 
   // Identify gerunds, which always end in "ing".
   if (word.endswith("ing") && word.size() > 4) {
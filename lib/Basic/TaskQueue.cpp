@@ -29,8 +29,9 @@ using namespace swift::sys;
 #include "Default/TaskQueue.inc"
 #endif
 
-TaskQueue::TaskQueue(unsigned NumberOfParallelTasks)
-  : NumberOfParallelTasks(NumberOfParallelTasks) {}
+TaskQueue::TaskQueue(unsigned NumberOfParallelTasks, uint64_t MemoryBudget)
+  : NumberOfParallelTasks(NumberOfParallelTasks),
+    MemoryBudget(MemoryBudget) {}
 
 TaskQueue::~TaskQueue() = default;
 
@@ -43,7 +44,13 @@ DummyTaskQueue::~DummyTaskQueue() = default;
 
 void DummyTaskQueue::addTask(const char *ExecPath, ArrayRef<const char *> Args,
                              ArrayRef<const char *> Env, void *Context,
-                             bool SeparateErrors) {
+                             bool SeparateErrors,
+                             uint64_t EstimatedMemoryUsage,
+                             uint64_t EstimatedCost) {
+  // This implementation of TaskQueue ignores EstimatedMemoryUsage and
+  // EstimatedCost.
+  (void)EstimatedMemoryUsage;
+  (void)EstimatedCost;
   QueuedTasks.emplace(std::unique_ptr<DummyTask>(
       new DummyTask(ExecPath, Args, Env, Context, SeparateErrors)));
 }
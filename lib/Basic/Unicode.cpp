@@ -13,6 +13,8 @@
 #include "swift/Basic/Unicode.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ConvertUTF.h"
+#include "llvm/Support/MathExtras.h"
+#include <cstring>
 
 using namespace swift;
 
@@ -36,6 +38,21 @@ StringRef swift::unicode::extractFirstExtendedGraphemeCluster(StringRef S) {
   if (S.empty())
     return StringRef();
 
+  // Fast path: an ASCII code point followed by another ASCII code point (or
+  // by the end of the string) always forms a cluster of its own, except for
+  // a CR followed by an LF. No ASCII code point is Prepend, Extend or
+  // SpacingMark, so nothing else in the rules can glue two of them together,
+  // and character-by-character iteration over ASCII text never transcodes or
+  // consults the property table. A non-ASCII successor might be a combining
+  // mark, so that case takes the general algorithm below.
+  unsigned char FirstByte = S[0];
+  if (FirstByte < 0x80 &&
+      (S.size() == 1 || static_cast<unsigned char>(S[1]) < 0x80)) {
+    if (FirstByte == '\r' && S.size() > 1 && S[1] == '\n')
+      return S.slice(0, 2);
+    return S.slice(0, 1);
+  }
+
   const llvm::UTF8 *SourceStart =
     reinterpret_cast<const llvm::UTF8 *>(S.data());
 
@@ -112,8 +129,10 @@ unsigned swift::unicode::extractFirstUnicodeScalar(StringRef S) {
   return Scalar;
 }
 
-uint64_t swift::unicode::getUTF16Length(StringRef Str) {
-  uint64_t Length;
+#ifndef NDEBUG
+/// The original transcoding implementation of getUTF16Length, kept around to
+/// cross-check the counting version in asserts builds.
+static uint64_t getUTF16LengthByTranscoding(StringRef Str) {
   // Transcode the string to UTF-16 to get its length.
   SmallVector<llvm::UTF16, 128> buffer(Str.size() + 1); // +1 for ending nulls.
   const llvm::UTF8 *fromPtr = (const llvm::UTF8 *) Str.data();
@@ -127,6 +146,58 @@ uint64_t swift::unicode::getUTF16Length(StringRef Str) {
   (void)Result;
 
   // The length of the transcoded string in UTF-16 code points.
-  Length = toPtr - &buffer[0];
+  return toPtr - &buffer[0];
+}
+#endif
+
+uint64_t swift::unicode::getUTF16Length(StringRef Str) {
+  // The length can be counted directly from the UTF-8 byte values: every
+  // lead byte produces one UTF-16 code unit, except a four-byte lead
+  // (U+10000 and above), which produces a surrogate pair; continuation
+  // bytes (0b10xxxxxx) produce none. This is called for every string
+  // literal lowered for a UTF-16 target, so count words at a time instead
+  // of transcoding into a temporary buffer.
+  uint64_t Length = 0;
+  const unsigned char *Ptr =
+      reinterpret_cast<const unsigned char *>(Str.data());
+  const unsigned char *End = Ptr + Str.size();
+
+  const uint64_t HighBits = 0x8080808080808080ULL;
+  auto countWord = [&Length, HighBits](uint64_t Word) {
+    // A byte is a continuation iff its top two bits are 10; a byte is a
+    // four-byte lead iff its top four bits are 1111 (values above 0xF4
+    // cannot occur in well-formed input).
+    uint64_t Continuations = Word & ~(Word << 1) & HighBits;
+    uint64_t FourByteLeads =
+        Word & (Word << 1) & (Word << 2) & (Word << 3) & HighBits;
+    Length += 8 - llvm::countPopulation(Continuations)
+                + llvm::countPopulation(FourByteLeads);
+  };
+
+  // Process 16 bytes per iteration, then mop up a remaining word.
+  for (; Ptr + 16 <= End; Ptr += 16) {
+    uint64_t Words[2];
+    memcpy(Words, Ptr, 16);
+    countWord(Words[0]);
+    countWord(Words[1]);
+  }
+  if (Ptr + 8 <= End) {
+    uint64_t Word;
+    memcpy(&Word, Ptr, 8);
+    countWord(Word);
+    Ptr += 8;
+  }
+
+  // And the byte-at-a-time tail.
+  for (; Ptr != End; ++Ptr) {
+    unsigned char Byte = *Ptr;
+    if ((Byte & 0xC0) != 0x80)
+      ++Length;
+    if (Byte >= 0xF0)
+      ++Length;
+  }
+
+  assert(Length == getUTF16LengthByTranscoding(Str) &&
+         "word-at-a-time UTF-16 length disagrees with transcoding");
   return Length;
 }
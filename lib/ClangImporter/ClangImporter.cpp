@@ -3290,6 +3290,25 @@ void ClangImporter::Implementation::lookupAllObjCMembers(
   }
 }
 
+bool ClangImporter::Implementation::hasGlobalsAsMembers(
+    const NominalTypeDecl *nominal, EffectiveClangContext context) {
+  // The answer can only change when another lookup table shows up, so cache
+  // it together with the number of tables consulted. (The bridging header's
+  // table is always present and is fully populated before member lookups
+  // begin, so it does not need to participate in the generation count.)
+  unsigned generation = LookupTables.size();
+  auto known = HasGlobalsAsMembersCache.find(nominal);
+  if (known != HasGlobalsAsMembersCache.end() &&
+      known->second.first == generation)
+    return known->second.second;
+
+  bool result = forEachLookupTable([&](SwiftLookupTable &table) -> bool {
+    return (table.lookupGlobalsAsMembers(context).size() > 0);
+  });
+  HasGlobalsAsMembersCache[nominal] = {generation, result};
+  return result;
+}
+
 Optional<TinyPtrVector<ValueDecl *>>
 ClangImporter::Implementation::loadNamedMembers(
     const IterableDeclContext *IDC, DeclBaseName N, uint64_t contextData) {
@@ -3319,10 +3338,7 @@ ClangImporter::Implementation::loadNamedMembers(
   // can support some of them lazily but the full set of idioms seems
   // prohibitively complex (also they're not stored in by-name lookup, for
   // reasons unclear).
-  if (forEachLookupTable([&](SwiftLookupTable &table) -> bool {
-        return (table.lookupGlobalsAsMembers(
-                  effectiveClangContext).size() > 0);
-      }))
+  if (hasGlobalsAsMembers(nominal, effectiveClangContext))
     return None;
 
   // There are 3 cases:
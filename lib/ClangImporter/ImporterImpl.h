@@ -375,6 +375,15 @@ public:
   llvm::DenseMap<std::pair<NominalTypeDecl *, const clang::Module *>,
                  ExtensionDecl *> extensionPoints;
 
+  /// \brief Caches whether any lookup table has globals-as-members mappings
+  /// for a given nominal type. Named lazy member loading has to bail out on
+  /// such types, and the scan over all of the tables is too expensive to
+  /// repeat for every member name. The unsigned value records how many
+  /// lookup tables were consulted; loading another Clang module invalidates
+  /// the entry.
+  llvm::DenseMap<const NominalTypeDecl *, std::pair<unsigned, bool>>
+    HasGlobalsAsMembersCache;
+
   /// \brief Typedefs that we should not be importing.  We should be importing
   /// underlying decls instead.
   llvm::DenseSet<const clang::Decl *> SuperfluousTypedefs;
@@ -1163,6 +1172,11 @@ private:
                                   SmallVectorImpl<Decl *> &members);
   void loadAllMembersIntoExtension(Decl *D, uint64_t extra);
 
+  /// Whether any lookup table has globals-as-members mappings for the given
+  /// nominal type, memoized in \c HasGlobalsAsMembersCache.
+  bool hasGlobalsAsMembers(const NominalTypeDecl *nominal,
+                           EffectiveClangContext context);
+
   /// Imports \p decl under \p nameVersion with the name \p newName, and adds
   /// it and its alternates to \p ext.
   ///
@@ -72,6 +72,10 @@ public:
 };
 
 /// Module file extension reader for the Swift lookup tables.
+///
+/// The reader does not copy any table data: it records pointers into the
+/// memory-mapped module file and answers \c lookup queries by probing the
+/// serialized on-disk hash tables in place.
 class SwiftLookupTableReader : public clang::ModuleFileExtensionReader {
   clang::ASTReader &Reader;
   clang::serialization::ModuleFile &ModuleFile;
@@ -280,6 +280,14 @@ const uint16_t SWIFT_LOOKUP_TABLE_VERSION_MINOR = 15; // Special names
 /// entities. This lookup table provides efficient access to the C
 /// entities based on their Swift names, and is used by the Clang
 /// importer to satisfy the Swift compiler's queries.
+///
+/// A lookup table attached to a Clang module file is not deserialized
+/// wholesale. Its serialized form is an on-disk hash table that lives in
+/// the memory-mapped module file and is probed in place through a
+/// \c SwiftLookupTableReader; the in-memory maps here only memoize the
+/// results for the specific names that have actually been queried,
+/// including negative results. Eager materialization of the whole table
+/// only happens on the dump/verification paths (\c deserializeAll).
 class SwiftLookupTable {
 public:
   /// The kind of context in which a name occurs.
@@ -17,6 +17,9 @@
 #include "swift/Demangling/Demangler.h"
 #include "swift/Demangling/ManglingMacros.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace swift {
 namespace Demangle {
 
@@ -35,7 +38,13 @@ void Context::clear() {
   D->clear();
 }
 
+void Context::setInterningCache(NodeInterningCache *NewCache) {
+  Cache = NewCache;
+}
+
 NodePointer Context::demangleSymbolAsNode(llvm::StringRef MangledName) {
+  if (Cache)
+    return Cache->getOrDemangleSymbolAsNode(MangledName);
   if (isMangledName(MangledName)) {
     return D->demangleSymbol(MangledName);
   }
@@ -162,6 +171,80 @@ bool Context::hasSwiftCallingConvention(llvm::StringRef MangledName) {
   return true;
 }
 
+//////////////////////////////////
+// NodeInterningCache           //
+//////////////////////////////////
+
+/// FNV-1a. We hash the name ourselves instead of letting the map hash a
+/// std::string key so that lookups don't need to materialize one.
+static uint64_t hashMangledName(llvm::StringRef MangledName) {
+  uint64_t Hash = 0xcbf29ce484222325ull;
+  for (unsigned char c : MangledName) {
+    Hash ^= c;
+    Hash *= 0x100000001b3ull;
+  }
+  return Hash;
+}
+
+struct NodeInterningCache::Implementation {
+  struct Entry {
+    /// The mangled name, copied into \c Dem so the entry doesn't reference
+    /// caller-owned memory.
+    StringRef Name;
+    /// The demangled tree, or null if the name failed to demangle.
+    NodePointer Root;
+  };
+
+  std::mutex Mutex;
+
+  /// Owns the cached trees and the copied key strings. Never cleared: cached
+  /// trees stay valid until the cache is destructed.
+  Demangler Dem;
+
+  /// Keyed by the hash of the mangled name; the name itself is compared on
+  /// lookup to guard against collisions.
+  std::unordered_multimap<uint64_t, Entry> Entries;
+};
+
+NodeInterningCache::NodeInterningCache() : Impl(new Implementation) {
+}
+
+NodeInterningCache::~NodeInterningCache() {
+  delete Impl;
+}
+
+NodePointer
+NodeInterningCache::getOrDemangleSymbolAsNode(llvm::StringRef MangledName) {
+  uint64_t Hash = hashMangledName(MangledName);
+  std::lock_guard<std::mutex> Lock(Impl->Mutex);
+  auto Known = Impl->Entries.equal_range(Hash);
+  for (auto I = Known.first; I != Known.second; ++I) {
+    if (I->second.Name == MangledName)
+      return I->second.Root;
+  }
+
+  // Copy the name into the factory first and demangle the copy, so that
+  // neither the entry nor the tree can end up referencing the caller's
+  // buffer.
+  bool IsNewMangling = isMangledName(MangledName);
+  StringRef Name = MangledName.copy(Impl->Dem);
+  NodePointer Root;
+  if (IsNewMangling)
+    Root = Impl->Dem.demangleSymbol(Name);
+  else
+    Root = demangleOldSymbolAsNode(Name, Impl->Dem);
+
+  // Cache failures as null entries: repeated lookups of non-Swift symbols
+  // shouldn't re-run the demangler (or grow the factory further).
+  Impl->Entries.emplace(Hash, Implementation::Entry{Name, Root});
+  return Root;
+}
+
+size_t NodeInterningCache::size() const {
+  std::lock_guard<std::mutex> Lock(Impl->Mutex);
+  return Impl->Entries.size();
+}
+
 //////////////////////////////////
 // Public utility functions     //
 //////////////////////////////////
@@ -174,6 +257,37 @@ std::string demangleSymbolAsString(const char *MangledName,
                                     Options);
 }
 
+size_t demangleSymbolAsString(llvm::StringRef MangledName, char *OutputBuffer,
+                              size_t OutputBufferSize,
+                              const DemangleOptions &Options) {
+  if (OutputBufferSize == 0)
+    return 0;
+
+  // The arena covers typical symbols; exceptionally large symbols overflow
+  // into malloced slabs (see NodeFactory::providePreallocatedMemory).
+  StackAllocatedDemangler<4096> Dem;
+  NodePointer Root;
+  if (isMangledName(MangledName))
+    Root = Dem.demangleSymbol(MangledName);
+  else
+    Root = demangleOldSymbolAsNode(MangledName, Dem);
+
+  if (Root) {
+    size_t Written =
+        nodeToString(Root, OutputBuffer, OutputBufferSize, Options);
+    if (Written != 0)
+      return Written;
+  }
+
+  // Not demanglable: copy the mangled name to the output unchanged.
+  size_t Written = MangledName.size();
+  if (Written > OutputBufferSize - 1)
+    Written = OutputBufferSize - 1;
+  memcpy(OutputBuffer, MangledName.data(), Written);
+  OutputBuffer[Written] = '\0';
+  return Written;
+}
+
 std::string demangleTypeAsString(const char *MangledName,
                                  size_t MangledNameLength,
                                  const DemangleOptions &Options) {
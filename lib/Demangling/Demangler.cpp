@@ -172,6 +172,14 @@ void NodeFactory::freeSlabs(Slab *slab) {
 }
   
 void NodeFactory::clear() {
+  if (BorrowedMemory) {
+    // Free any malloced overflow slabs and wind back to the borrowed memory.
+    freeSlabs(CurrentSlab);
+    CurrentSlab = nullptr;
+    CurPtr = BorrowedMemory;
+    End = BorrowedMemory + BorrowedSize;
+    return;
+  }
   if (CurrentSlab) {
     freeSlabs(CurrentSlab->Previous);
     
@@ -33,14 +33,12 @@ static void printer_unreachable(const char *Message) {
 DemanglerPrinter &DemanglerPrinter::operator<<(unsigned long long n) & {
   char buffer[32];
   snprintf(buffer, sizeof(buffer), "%llu", n);
-  Stream.append(buffer);
-  return *this;
+  return *this << StringRef(buffer);
 }
 DemanglerPrinter &DemanglerPrinter::operator<<(long long n) & {
   char buffer[32];
   snprintf(buffer, sizeof(buffer), "%lld",n);
-  Stream.append(buffer);
-  return *this;
+  return *this << StringRef(buffer);
 }
 
 std::string Demangle::archetypeName(Node::IndexType index,
@@ -166,12 +164,24 @@ private:
 
 public:
   NodePrinter(DemangleOptions options) : Options(options) {}
-  
+
+  /// Creates a printer which writes into the fixed-size \p OutputBuffer
+  /// instead of a heap-allocated string. See DemanglerPrinter.
+  NodePrinter(DemangleOptions options, char *OutputBuffer, size_t Size)
+      : Printer(OutputBuffer, Size), Options(options) {}
+
   std::string printRoot(NodePointer root) {
     print(root);
     return std::move(Printer).str();
   }
 
+  /// Prints into the fixed-size buffer the printer was created with and
+  /// returns the number of bytes written (at most the buffer size).
+  size_t printRootToBuffer(NodePointer root) {
+    print(root);
+    return Printer.getStringRef().size();
+  }
+
 private:  
   void printChildren(Node::iterator begin,
                      Node::iterator end,
@@ -1988,3 +1998,20 @@ std::string Demangle::nodeToString(NodePointer root,
 
   return NodePrinter(options).printRoot(root);
 }
+
+size_t Demangle::nodeToString(NodePointer root, char *outputBuffer,
+                              size_t outputBufferSize,
+                              const DemangleOptions &options) {
+  if (outputBufferSize == 0)
+    return 0;
+  if (!root) {
+    outputBuffer[0] = '\0';
+    return 0;
+  }
+
+  // Reserve one byte for the terminating NUL.
+  NodePrinter printer(options, outputBuffer, outputBufferSize - 1);
+  size_t written = printer.printRootToBuffer(root);
+  outputBuffer[written] = '\0';
+  return written;
+}
@@ -286,6 +286,16 @@ class Remangler {
 public:
   Remangler(DemanglerPrinter &Buffer) : Buffer(Buffer) {}
 
+  /// Resets all per-mangling state so the instance can be reused for another
+  /// tree. The containers keep their allocated capacity.
+  void clear() {
+    Words.clear();
+    SubstWordsInIdent.clear();
+    Substitutions.clear();
+    SubstMerging.clear();
+    Factory.clear();
+  }
+
   void mangle(Node *node) {
     switch (node->getKind()) {
 #define NODE(ID) case Node::Kind::ID: return mangle##ID(node);
@@ -1881,6 +1891,77 @@ std::string Demangle::mangleNode(const NodePointer &node) {
   return std::move(printer).str();
 }
 
+//////////////////////////////////
+// RemanglingCache              //
+//////////////////////////////////
+
+/// Copies \p node and all its children into \p Factory, so a cache key can
+/// outlive the caller's tree.
+static NodePointer deepCopyNode(NodePointer node, NodeFactory &Factory) {
+  NodePointer copy;
+  if (node->hasText())
+    copy = Factory.createNode(node->getKind(), node->getText());
+  else if (node->hasIndex())
+    copy = Factory.createNode(node->getKind(), node->getIndex());
+  else
+    copy = Factory.createNode(node->getKind());
+  for (NodePointer child : *node)
+    copy->addChild(deepCopyNode(child, Factory), Factory);
+  return copy;
+}
+
+struct RemanglingCache::Implementation {
+  /// The output buffer, reused (with its capacity) across manglings.
+  DemanglerPrinter Buffer;
+
+  /// The remangler, kept alive so its substitution table and factory retain
+  /// their allocations between calls. clear()ed before each mangling.
+  Remangler TheRemangler;
+
+  /// Owns the copied key trees.
+  NodeFactory KeyFactory;
+
+  /// Maps a deeply hashed/compared tree to its mangled string.
+  std::unordered_map<SubstitutionEntry, std::string,
+                     SubstitutionEntry::Hasher> Cache;
+
+  Implementation() : TheRemangler(Buffer) {}
+};
+
+RemanglingCache::RemanglingCache() : Impl(new Implementation) {
+}
+
+RemanglingCache::~RemanglingCache() {
+  delete Impl;
+}
+
+std::string RemanglingCache::mangleNode(NodePointer Root) {
+  if (!Root) return "";
+
+  SubstitutionEntry entry;
+  entry.setNode(Root, /*treatAsIdentifier*/ false);
+  auto it = Impl->Cache.find(entry);
+  if (it != Impl->Cache.end())
+    return it->second;
+
+  Impl->Buffer.resetSize(0);
+  Impl->TheRemangler.clear();
+  Impl->TheRemangler.mangle(Root);
+  std::string mangling = Impl->Buffer.getStringRef().str();
+
+  // The key must not reference the caller's tree, which may be deallocated
+  // after the call; re-key on a copy owned by the cache.
+  SubstitutionEntry key;
+  key.setNode(deepCopyNode(Root, Impl->KeyFactory),
+              /*treatAsIdentifier*/ false);
+  Impl->Cache.emplace(key, mangling);
+  return mangling;
+}
+
+size_t RemanglingCache::size() const {
+  return Impl->Cache.size();
+}
+
 bool Demangle::isSpecialized(Node *node) {
   switch (node->getKind()) {
     case Node::Kind::BoundGenericStructure:
@@ -162,6 +162,19 @@ namespace driver {
     /// TaskQueue for execution.
     std::unique_ptr<TaskQueue> TQ;
 
+    /// The peak memory usage, in bytes, measured for each job that ran, for
+    /// recording in the compilation record.
+    llvm::SmallDenseMap<const Job *, uint64_t, 16> MeasuredMemoryUsage;
+
+    /// When each currently-executing job began, for measuring how long it
+    /// ran.
+    llvm::SmallDenseMap<const Job *, std::chrono::steady_clock::time_point, 16>
+    CommandStartTimes;
+
+    /// How long each job that ran took, in nanoseconds, for recording in the
+    /// compilation record.
+    llvm::SmallDenseMap<const Job *, uint64_t, 16> MeasuredDurations;
+
     /// Cumulative result of PerformJobs(), accumulated from subprocesses.
     int Result = EXIT_SUCCESS;
 
@@ -224,7 +237,9 @@ namespace driver {
       if (Comp.ShowJobLifecycle)
         llvm::outs() << "Added to TaskQueue: " << LogJob(Cmd) << "\n";
       TQ->addTask(Cmd->getExecutable(), Cmd->getArguments(), llvm::None,
-                  (void *)Cmd);
+                  (void *)Cmd, /*SeparateErrors=*/false,
+                  Cmd->getEstimatedMemoryUsage(),
+                  Cmd->getEstimatedDuration());
     }
 
     /// When a task finishes, check other Jobs that may be blocked.
@@ -261,6 +276,8 @@ namespace driver {
       // TODO: properly handle task began.
       const Job *BeganCmd = (const Job *)Context;
 
+      CommandStartTimes[BeganCmd] = std::chrono::steady_clock::now();
+
       if (Comp.ShowDriverTimeCompilation) {
         llvm::SmallString<128> TimerName;
         llvm::raw_svector_ostream OS(TimerName);
@@ -384,10 +401,24 @@ namespace driver {
         DriverTimers[FinishedCmd]->stopTimer();
       }
 
+      if (uint64_t peakMemory = TQ->getPeakMemoryUsage(Pid))
+        MeasuredMemoryUsage[FinishedCmd] = peakMemory;
+
+      auto started = CommandStartTimes.find(FinishedCmd);
+      if (started != CommandStartTimes.end()) {
+        auto elapsed = std::chrono::steady_clock::now() - started->second;
+        MeasuredDurations[FinishedCmd] =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count();
+        CommandStartTimes.erase(started);
+      }
+
       if (Comp.Level == OutputLevel::Parseable) {
         // Parseable output was requested.
-        parseable_output::emitFinishedMessage(llvm::errs(), *FinishedCmd, Pid,
-                                              ReturnCode, Output);
+        parseable_output::emitFinishedMessage(
+            llvm::errs(), *FinishedCmd, Pid, ReturnCode, Output,
+            MeasuredDurations.lookup(FinishedCmd) / 1000,
+            TQ->getTaskStatistics(Pid));
       } else {
         // Otherwise, send the buffered output to stderr, though only if we
         // support getting buffered output.
@@ -485,9 +516,12 @@ namespace driver {
       if (Comp.SkipTaskExecution)
         TQ.reset(new DummyTaskQueue(Comp.NumberOfParallelCommands));
       else
-        TQ.reset(new TaskQueue(Comp.NumberOfParallelCommands));
+        TQ.reset(new TaskQueue(Comp.NumberOfParallelCommands,
+                               Comp.MemoryBudget));
       if (Comp.ShowIncrementalBuildDecisions || Comp.Stats)
         IncrementalTracer = &ActualIncrementalTracer;
+      if (Comp.EnableFingerprintCascades)
+        DepGraph.enableFingerprintCascades();
     }
 
     /// Schedule all jobs we can from the initial list provided by Compilation.
@@ -654,6 +688,11 @@ namespace driver {
           info.status = entry.second ?
             CompileJobAction::InputInfo::NeedsCascadingBuild :
             CompileJobAction::InputInfo::NeedsNonCascadingBuild;
+          // The job didn't run, so carry the previous build's measurements
+          // forward.
+          info.previousPeakMemory = entry.first->getEstimatedMemoryUsage();
+          info.previousCompileDuration = entry.first->getEstimatedDuration();
+          info.previousContentHash = entry.first->getInputContentHash();
           inputs[&inputFile->getInputArg()] = info;
         }
       }
@@ -671,6 +710,17 @@ namespace driver {
           CompileJobAction::InputInfo info;
           info.previousModTime = entry->getInputModTime();
           info.status = CompileJobAction::InputInfo::UpToDate;
+          // Prefer this build's measurements; skipped jobs carry the previous
+          // build's values forward.
+          auto measured = MeasuredMemoryUsage.find(entry);
+          info.previousPeakMemory = (measured != MeasuredMemoryUsage.end())
+            ? measured->second
+            : entry->getEstimatedMemoryUsage();
+          auto duration = MeasuredDurations.find(entry);
+          info.previousCompileDuration = (duration != MeasuredDurations.end())
+            ? duration->second
+            : entry->getEstimatedDuration();
+          info.previousContentHash = entry->getInputContentHash();
           inputs[&inputFile->getInputArg()] = info;
         }
       }
@@ -749,12 +799,22 @@ static void writeCompilationRecord(StringRef path, StringRef argsHash,
   }
 
   auto writeTimeValue = [](llvm::raw_ostream &out,
-                           llvm::sys::TimePoint<> time) {
+                           llvm::sys::TimePoint<> time,
+                           Optional<uint64_t> peakMemory = None,
+                           Optional<uint64_t> compileDuration = None,
+                           Optional<uint64_t> contentHash = None) {
     using namespace std::chrono;
     auto secs = time_point_cast<seconds>(time);
     time -= secs.time_since_epoch(); // remainder in nanoseconds
     out << "[" << secs.time_since_epoch().count()
-        << ", " << time.time_since_epoch().count() << "]";
+        << ", " << time.time_since_epoch().count();
+    if (peakMemory)
+      out << ", " << *peakMemory;
+    if (compileDuration)
+      out << ", " << *compileDuration;
+    if (contentHash)
+      out << ", " << *contentHash;
+    out << "]";
   };
 
   using compilation_record::TopLevelKey;
@@ -781,7 +841,10 @@ static void writeCompilationRecord(StringRef path, StringRef argsHash,
       out << Name << " ";
     }
 
-    writeTimeValue(out, entry.second.previousModTime);
+    writeTimeValue(out, entry.second.previousModTime,
+                   entry.second.previousPeakMemory,
+                   entry.second.previousCompileDuration,
+                   entry.second.previousContentHash);
     out << "\n";
   }
 }
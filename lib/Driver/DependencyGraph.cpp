@@ -13,6 +13,7 @@
 #include "swift/Basic/Statistic.h"
 #include "swift/Driver/DependencyGraph.h"
 #include "swift/Demangling/Demangle.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringSwitch.h"
@@ -50,15 +51,214 @@ using LoadResult = DependencyGraphImpl::LoadResult;
 using DependencyKind = DependencyGraphImpl::DependencyKind;
 using DependencyCallbackTy = LoadResult(StringRef, DependencyKind, bool);
 using InterfaceHashCallbackTy = LoadResult(StringRef);
+using FingerprintCallbackTy = LoadResult(StringRef, uint64_t);
+
+namespace {
+enum class DependencyDirection : bool {
+  Depends,
+  Provides
+};
+} // end anonymous namespace
+using KindPair = std::pair<DependencyKind, DependencyDirection>;
+
+static KindPair getDirectionAndKind(StringRef keyString) {
+  return llvm::StringSwitch<KindPair>(keyString)
+    .Case("depends-top-level",
+          std::make_pair(DependencyKind::TopLevelName,
+                         DependencyDirection::Depends))
+    .Case("depends-nominal",
+          std::make_pair(DependencyKind::NominalType,
+                         DependencyDirection::Depends))
+    .Case("depends-member",
+          std::make_pair(DependencyKind::NominalTypeMember,
+                         DependencyDirection::Depends))
+    .Case("depends-dynamic-lookup",
+          std::make_pair(DependencyKind::DynamicLookupName,
+                         DependencyDirection::Depends))
+    .Case("depends-external",
+          std::make_pair(DependencyKind::ExternalFile,
+                         DependencyDirection::Depends))
+    .Case("provides-top-level",
+          std::make_pair(DependencyKind::TopLevelName,
+                         DependencyDirection::Provides))
+    .Case("provides-nominal",
+          std::make_pair(DependencyKind::NominalType,
+                         DependencyDirection::Provides))
+    .Case("provides-member",
+          std::make_pair(DependencyKind::NominalTypeMember,
+                         DependencyDirection::Provides))
+    .Case("provides-dynamic-lookup",
+          std::make_pair(DependencyKind::DynamicLookupName,
+                         DependencyDirection::Provides))
+    .Default(std::make_pair(DependencyKind(),
+                            DependencyDirection::Depends));
+}
+
+/// Parses a double-quoted scalar at the start of \p line, consuming it.
+///
+/// Returns None if \p line does not start with one or if the scalar
+/// contains escape sequences; callers fall back to the general YAML parser
+/// in that case.
+static llvm::Optional<StringRef> parseQuotedScalarFast(StringRef &line) {
+  if (!line.startswith("\""))
+    return llvm::None;
+  line = line.drop_front();
+  size_t end = line.find_first_of("\"\\");
+  if (end == StringRef::npos || line[end] == '\\')
+    return llvm::None;
+  StringRef value = line.take_front(end);
+  line = line.drop_front(end + 1);
+  return value;
+}
+
+/// Parses \p buffer with a line scanner that understands exactly the shape
+/// the frontend's swiftdeps emitter produces: a block-style mapping of
+/// sequences whose entries are double-quoted scalars, optionally tagged
+/// !private. The general YAML parser dominates incremental-build driver
+/// startup, and machine-generated files never need it.
+///
+/// Returns None if the buffer does not match that shape (hand-written
+/// fixtures, flow-style sequences, escaped names). Any callbacks already
+/// invoked are idempotent, so the caller can safely reparse from the top
+/// with the general parser; \p partialResult accumulates results observed
+/// here because a reparse does not replay them (e.g. an interface-hash
+/// change is only reported once).
+static llvm::Optional<LoadResult>
+parseDependencyFileFast(llvm::MemoryBuffer &buffer, LoadResult &partialResult,
+                    llvm::function_ref<DependencyCallbackTy> providesCallback,
+                    llvm::function_ref<DependencyCallbackTy> dependsCallback,
+                    llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback,
+                    llvm::function_ref<FingerprintCallbackTy> fingerprintCallback) {
+  enum class SectionKind {
+    None,
+    Scalars,
+    Members,
+    Fingerprints
+  };
+  SectionKind section = SectionKind::None;
+  DependencyKind kind = {};
+  bool isDepends = false;
+
+  // Record an entry's result; returns true if it was a hard error.
+  auto updateResult = [&partialResult](LoadResult update) -> bool {
+    if (update == LoadResult::AffectsDownstream)
+      partialResult = LoadResult::AffectsDownstream;
+    return update == LoadResult::HadError;
+  };
+
+  StringRef data = buffer.getBuffer();
+  while (!data.empty()) {
+    StringRef line;
+    std::tie(line, data) = data.split('\n');
+    if (line.empty())
+      continue;
+
+    // Sequence entries.
+    if (line.startswith("- ")) {
+      line = line.drop_front(2);
+      bool isCascading = true;
+      if (line.startswith("!private ")) {
+        line = line.drop_front(strlen("!private "));
+        isCascading = false;
+      }
+
+      switch (section) {
+      case SectionKind::None:
+        return llvm::None;
+
+      case SectionKind::Scalars: {
+        auto name = parseQuotedScalarFast(line);
+        if (!name || !line.empty())
+          return llvm::None;
+        auto &callback = isDepends ? dependsCallback : providesCallback;
+        if (updateResult(callback(*name, kind, isCascading)))
+          return LoadResult::HadError;
+        break;
+      }
+
+      case SectionKind::Members:
+      case SectionKind::Fingerprints: {
+        // Both come in the form ["first", "second"].
+        if (!line.startswith("["))
+          return llvm::None;
+        line = line.drop_front();
+        auto first = parseQuotedScalarFast(line);
+        if (!first || !line.startswith(", "))
+          return llvm::None;
+        line = line.drop_front(2);
+        auto second = parseQuotedScalarFast(line);
+        if (!second || line != "]")
+          return llvm::None;
+
+        if (section == SectionKind::Fingerprints) {
+          if (!isCascading)
+            return llvm::None;
+          uint64_t fingerprint;
+          if (second->getAsInteger(16, fingerprint))
+            return llvm::None;
+          if (updateResult(fingerprintCallback(*first, fingerprint)))
+            return LoadResult::HadError;
+          break;
+        }
+
+        // Smash the type and member names together so we can continue using
+        // StringMap.
+        SmallString<64> appended;
+        appended += *first;
+        appended.push_back('\0');
+        appended += *second;
+
+        auto &callback = isDepends ? dependsCallback : providesCallback;
+        if (updateResult(callback(appended.str(), kind, isCascading)))
+          return LoadResult::HadError;
+        break;
+      }
+      }
+      continue;
+    }
+
+    // Otherwise this is a top-level key.
+    if (line.startswith("interface-hash: ")) {
+      line = line.drop_front(strlen("interface-hash: "));
+      auto hash = parseQuotedScalarFast(line);
+      if (!hash || !line.empty())
+        return llvm::None;
+      if (updateResult(interfaceHashCallback(*hash)))
+        return LoadResult::HadError;
+      section = SectionKind::None;
+      continue;
+    }
+
+    if (!line.endswith(":"))
+      return llvm::None;
+    StringRef keyString = line.drop_back();
+
+    if (keyString == "decl-fingerprints") {
+      section = SectionKind::Fingerprints;
+      continue;
+    }
+
+    KindPair dirAndKind = getDirectionAndKind(keyString);
+    if (dirAndKind.first == DependencyKind())
+      return llvm::None;
+    kind = dirAndKind.first;
+    isDepends = dirAndKind.second == DependencyDirection::Depends;
+    section = (kind == DependencyKind::NominalTypeMember
+                 ? SectionKind::Members
+                 : SectionKind::Scalars);
+  }
+
+  return partialResult;
+}
 
 static LoadResult
-parseDependencyFile(llvm::MemoryBuffer &buffer,
+parseDependencyFileYAML(llvm::MemoryBuffer &buffer,
                     llvm::function_ref<DependencyCallbackTy> providesCallback,
                     llvm::function_ref<DependencyCallbackTy> dependsCallback,
-                    llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback) {
+                    llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback,
+                    llvm::function_ref<FingerprintCallbackTy> fingerprintCallback) {
   namespace yaml = llvm::yaml;
 
-  // FIXME: Switch to a format other than YAML.
   llvm::SourceMgr SM;
   yaml::Stream stream(buffer.getMemBufferRef(), SM);
   auto I = stream.begin();
@@ -107,43 +307,43 @@ parseDependencyFile(llvm::MemoryBuffer &buffer,
       StringRef valueString = value->getValue(scratch);
       UPDATE_RESULT(interfaceHashCallback(valueString));
 
+    } else if (keyString == "decl-fingerprints") {
+      // Fingerprint entries come in the form ["providedName", "hexHash"].
+      auto *entries = dyn_cast<yaml::SequenceNode>(i->getValue());
+      if (!entries)
+        return LoadResult::HadError;
+
+      for (yaml::Node &rawEntry : *entries) {
+        auto *entry = dyn_cast<yaml::SequenceNode>(&rawEntry);
+        if (!entry)
+          return LoadResult::HadError;
+
+        auto iter = entry->begin();
+        auto *name = dyn_cast<yaml::ScalarNode>(&*iter);
+        if (!name)
+          return LoadResult::HadError;
+        ++iter;
+
+        auto *value = dyn_cast<yaml::ScalarNode>(&*iter);
+        if (!value)
+          return LoadResult::HadError;
+        ++iter;
+
+        // FIXME: LLVM's YAML support doesn't implement == correctly for end
+        // iterators.
+        assert(!(iter != entry->end()));
+
+        SmallString<16> valueScratch;
+        uint64_t fingerprint;
+        if (value->getValue(valueScratch).getAsInteger(16, fingerprint))
+          return LoadResult::HadError;
+
+        UPDATE_RESULT(fingerprintCallback(name->getValue(scratch),
+                                          fingerprint));
+      }
+
     } else {
-      enum class DependencyDirection : bool {
-        Depends,
-        Provides
-      };
-      using KindPair = std::pair<DependencyKind, DependencyDirection>;
-
-      KindPair dirAndKind = llvm::StringSwitch<KindPair>(key->getValue(scratch))
-        .Case("depends-top-level",
-              std::make_pair(DependencyKind::TopLevelName,
-                             DependencyDirection::Depends))
-        .Case("depends-nominal",
-              std::make_pair(DependencyKind::NominalType,
-                             DependencyDirection::Depends))
-        .Case("depends-member",
-              std::make_pair(DependencyKind::NominalTypeMember,
-                             DependencyDirection::Depends))
-        .Case("depends-dynamic-lookup",
-              std::make_pair(DependencyKind::DynamicLookupName,
-                             DependencyDirection::Depends))
-        .Case("depends-external",
-              std::make_pair(DependencyKind::ExternalFile,
-                             DependencyDirection::Depends))
-        .Case("provides-top-level",
-              std::make_pair(DependencyKind::TopLevelName,
-                             DependencyDirection::Provides))
-        .Case("provides-nominal",
-              std::make_pair(DependencyKind::NominalType,
-                             DependencyDirection::Provides))
-        .Case("provides-member",
-              std::make_pair(DependencyKind::NominalTypeMember,
-                             DependencyDirection::Provides))
-        .Case("provides-dynamic-lookup",
-              std::make_pair(DependencyKind::DynamicLookupName,
-                             DependencyDirection::Provides))
-        .Default(std::make_pair(DependencyKind(),
-                                DependencyDirection::Depends));
+      KindPair dirAndKind = getDirectionAndKind(key->getValue(scratch));
       if (dirAndKind.first == DependencyKind())
         return LoadResult::HadError;
 
@@ -208,6 +408,35 @@ parseDependencyFile(llvm::MemoryBuffer &buffer,
   return result;
 }
 
+static LoadResult
+parseDependencyFile(llvm::MemoryBuffer &buffer,
+                    llvm::function_ref<DependencyCallbackTy> providesCallback,
+                    llvm::function_ref<DependencyCallbackTy> dependsCallback,
+                    llvm::function_ref<InterfaceHashCallbackTy> interfaceHashCallback,
+                    llvm::function_ref<FingerprintCallbackTy> fingerprintCallback) {
+  // Machine-generated files take the fast path; anything it cannot digest
+  // is retried with the general YAML parser.
+  LoadResult partialResult = LoadResult::UpToDate;
+  if (auto fastResult = parseDependencyFileFast(buffer, partialResult,
+                                                providesCallback,
+                                                dependsCallback,
+                                                interfaceHashCallback,
+                                                fingerprintCallback))
+    return *fastResult;
+
+  LoadResult result = parseDependencyFileYAML(buffer, providesCallback,
+                                              dependsCallback,
+                                              interfaceHashCallback,
+                                              fingerprintCallback);
+  if (result == LoadResult::HadError)
+    return result;
+  // Results observed during the partial fast parse are not replayed (the
+  // callbacks are idempotent), so fold them in here.
+  if (partialResult == LoadResult::AffectsDownstream)
+    return partialResult;
+  return result;
+}
+
 LoadResult DependencyGraphImpl::loadFromPath(const void *node, StringRef path) {
   auto buffer = llvm::MemoryBuffer::getFile(path);
   if (!buffer)
@@ -287,8 +516,55 @@ LoadResult DependencyGraphImpl::loadFromBuffer(const void *node,
     return LoadResult::UpToDate;
   };
 
-  return parseDependencyFile(buffer, providesCallback, dependsCallback,
-                             interfaceHashCallback);
+  llvm::StringMap<uint64_t> newFingerprints;
+  bool sawFingerprints = false;
+  auto fingerprintCallback = [&](StringRef name,
+                                 uint64_t fingerprint) -> LoadResult {
+    sawFingerprints = true;
+    // Aggregate by name; several declarations can contribute to one name.
+    newFingerprints[name] ^= fingerprint;
+    return LoadResult::UpToDate;
+  };
+
+  auto result = parseDependencyFile(buffer, providesCallback, dependsCallback,
+                                    interfaceHashCallback, fingerprintCallback);
+  if (result != LoadResult::HadError)
+    updateDeclFingerprints(node, sawFingerprints, std::move(newFingerprints));
+  return result;
+}
+
+void DependencyGraphImpl::updateDeclFingerprints(
+    const void *node, bool sawFingerprints,
+    llvm::StringMap<uint64_t> newFingerprints) {
+  if (!sawFingerprints) {
+    // The dependency file was produced without fingerprints; forget any
+    // stale filtering information.
+    DeclFingerprints.erase(node);
+    ChangedFingerprintNames.erase(node);
+    return;
+  }
+
+  auto known = DeclFingerprints.find(node);
+  if (known == DeclFingerprints.end()) {
+    // Initial load; there is nothing to diff against, so marking has to
+    // treat every provided name as changed.
+    DeclFingerprints.insert({node, std::move(newFingerprints)});
+    ChangedFingerprintNames.erase(node);
+    return;
+  }
+
+  auto &changed = ChangedFingerprintNames[node];
+  changed.clear();
+  for (const auto &entry : newFingerprints) {
+    auto old = known->second.find(entry.getKey());
+    if (old == known->second.end() || old->second != entry.getValue())
+      changed.insert(entry.getKey());
+  }
+  for (const auto &entry : known->second) {
+    if (!newFingerprints.count(entry.getKey()))
+      changed.insert(entry.getKey());
+  }
+  known->second = std::move(newFingerprints);
 }
 
 void DependencyGraphImpl::markExternal(SmallVectorImpl<const void *> &visited,
@@ -323,13 +599,58 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
   SmallVector<WorklistEntry, 16> worklist;
   SmallPtrSet<const void *, 16> visitedSet;
 
+  // If the most recent reload of the starting node's dependency file recorded
+  // which declaration fingerprints actually changed, use that to avoid
+  // cascading through provided names whose declarations are unchanged. This
+  // only applies to the starting node: downstream nodes have not been
+  // recompiled yet, so there is no way of knowing which of their provides
+  // will change. It is also opt-in; see FilterCascadesByFingerprints for why
+  // it is not sound to enable by default yet.
+  const llvm::StringSet<> *changedNames = nullptr;
+  const llvm::StringMap<uint64_t> *fingerprints = nullptr;
+  if (FilterCascadesByFingerprints) {
+    auto changedIter = ChangedFingerprintNames.find(node);
+    if (changedIter != ChangedFingerprintNames.end()) {
+      changedNames = &changedIter->second;
+      fingerprints = &DeclFingerprints.find(node)->second;
+    }
+  }
+
+  auto nameIsUnchanged = [&](StringRef name) -> bool {
+    // A name that never received a fingerprint is conservatively treated as
+    // changed.
+    return fingerprints->count(name) && !changedNames->count(name);
+  };
+
+  auto providedIsUnchanged = [&](const ProvidesEntryTy &provided) -> bool {
+    if (!changedNames)
+      return false;
+    StringRef name = provided.name;
+    if (provided.kindMask.contains(DependencyKind::NominalTypeMember)) {
+      // Member entries are "type\0member"; both parts have to be unchanged.
+      // An empty member part is the "all non-private members" marker and
+      // only names the type.
+      size_t splitPoint = name.find('\0');
+      assert(splitPoint != StringRef::npos);
+      StringRef typePart = name.slice(0, splitPoint);
+      StringRef memberPart = name.substr(splitPoint + 1);
+      if (!nameIsUnchanged(typePart))
+        return false;
+      return memberPart.empty() || nameIsUnchanged(memberPart);
+    }
+    return nameIsUnchanged(name);
+  };
+
   auto addDependentsToWorklist = [&](const void *next,
-                                     ArrayRef<MarkTracerImpl::Entry> reason) {
+                                     ArrayRef<MarkTracerImpl::Entry> reason,
+                                     bool isStartingNode) {
     auto allProvided = Provides.find(next);
     if (allProvided == Provides.end())
       return;
 
     for (const auto &provided : allProvided->second) {
+      if (isStartingNode && providedIsUnchanged(provided))
+        continue;
       auto allDependents = Dependencies.find(provided.name);
       if (allDependents == Dependencies.end())
         continue;
@@ -377,7 +698,7 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
 
   // Always mark through the starting node, even if it's already marked.
   markIntransitive(node);
-  addDependentsToWorklist(node, {});
+  addDependentsToWorklist(node, {}, /*isStartingNode=*/true);
 
   while (!worklist.empty()) {
     auto next = worklist.pop_back_val();
@@ -389,7 +710,7 @@ DependencyGraphImpl::markTransitive(SmallVectorImpl<const void *> &visited,
       continue;
     }
 
-    addDependentsToWorklist(next.Node, next.Reason);
+    addDependentsToWorklist(next.Node, next.Reason, /*isStartingNode=*/false);
     if (!markIntransitive(next.Node))
       continue;
     record(next);
@@ -312,7 +312,10 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
   bool optionsMatch = true;
 
   auto readTimeValue = [&scratch](yaml::Node *node,
-                                  llvm::sys::TimePoint<> &timeValue) -> bool {
+                                  llvm::sys::TimePoint<> &timeValue,
+                                  uint64_t *peakMemory = nullptr,
+                                  uint64_t *compileDuration = nullptr,
+                                  uint64_t *contentHash = nullptr) -> bool {
     auto *seq = dyn_cast<yaml::SequenceNode>(node);
     if (!seq)
       return true;
@@ -340,8 +343,50 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
       return true;
 
     ++seqI;
-    if (seqI != seqE)
-      return true;
+    if (seqI != seqE) {
+      // If the caller is interested in peak memory, the sequence may carry an
+      // optional third element; records from older compilers omit it.
+      if (!peakMemory)
+        return true;
+
+      auto *peakMemoryRaw = dyn_cast<yaml::ScalarNode>(&*seqI);
+      if (!peakMemoryRaw)
+        return true;
+      if (peakMemoryRaw->getValue(scratch).getAsInteger(10, *peakMemory))
+        return true;
+
+      ++seqI;
+    }
+    if (seqI != seqE) {
+      // Likewise, an optional fourth element carries the previous compile
+      // duration in nanoseconds.
+      if (!compileDuration)
+        return true;
+
+      auto *durationRaw = dyn_cast<yaml::ScalarNode>(&*seqI);
+      if (!durationRaw)
+        return true;
+      if (durationRaw->getValue(scratch).getAsInteger(10, *compileDuration))
+        return true;
+
+      ++seqI;
+    }
+    if (seqI != seqE) {
+      // ...and an optional fifth element carries a hash of the input's
+      // contents.
+      if (!contentHash)
+        return true;
+
+      auto *contentHashRaw = dyn_cast<yaml::ScalarNode>(&*seqI);
+      if (!contentHashRaw)
+        return true;
+      if (contentHashRaw->getValue(scratch).getAsInteger(10, *contentHash))
+        return true;
+
+      ++seqI;
+      if (seqI != seqE)
+        return true;
+    }
 
     timeValue = llvm::sys::TimePoint<>(std::chrono::seconds(parsedSeconds));
     timeValue += std::chrono::nanoseconds(parsedNanoseconds);
@@ -420,11 +465,17 @@ static bool populateOutOfDateMap(InputInfoMap &map, StringRef argsHashStr,
           return true;
 
         llvm::sys::TimePoint<> timeValue;
-        if (readTimeValue(value, timeValue))
+        uint64_t peakMemory = 0;
+        uint64_t compileDuration = 0;
+        uint64_t contentHash = 0;
+        if (readTimeValue(value, timeValue, &peakMemory, &compileDuration,
+                          &contentHash))
           return true;
 
         auto inputName = key->getValue(scratch);
-        previousInputs[inputName] = { *previousBuildState, timeValue };
+        previousInputs[inputName] = { *previousBuildState, timeValue,
+                                      peakMemory, compileDuration,
+                                      contentHash };
       }
     }
   }
@@ -525,6 +576,8 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
     ArgList->hasArg(options::OPT_driver_show_incremental);
   bool ShowJobLifecycle =
     ArgList->hasArg(options::OPT_driver_show_job_lifecycle);
+  bool EnableFingerprintCascades =
+    ArgList->hasArg(options::OPT_driver_enable_fingerprint_cascades);
 
   bool Incremental = ArgList->hasArg(options::OPT_incremental);
   if (ArgList->hasArg(options::OPT_whole_module_optimization)) {
@@ -675,6 +728,17 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
     }
   }
 
+  uint64_t MemoryBudget = 0;
+  if (const Arg *A = ArgList->getLastArg(options::OPT_driver_memory_budget)) {
+    uint64_t budgetMB;
+    if (StringRef(A->getValue()).getAsInteger(10, budgetMB)) {
+      Diags.diagnose(SourceLoc(), diag::error_invalid_arg_value,
+                     A->getAsString(*ArgList), A->getValue());
+      return nullptr;
+    }
+    MemoryBudget = budgetMB * 1024 * 1024;
+  }
+
   OutputLevel Level = OutputLevel::Normal;
   if (const Arg *A = ArgList->getLastArg(options::OPT_v,
                                          options::OPT_parseable_output)) {
@@ -717,12 +781,18 @@ std::unique_ptr<Compilation> Driver::buildCompilation(
   if (ContinueBuildingAfterErrors)
     C->setContinueBuildingAfterErrors();
 
+  if (MemoryBudget != 0)
+    C->setMemoryBudget(MemoryBudget);
+
   if (ShowIncrementalBuildDecisions || ShowJobLifecycle)
     C->setShowsIncrementalBuildDecisions();
 
   if (ShowJobLifecycle)
     C->setShowJobLifecycle();
 
+  if (EnableFingerprintCascades)
+    C->setEnableFingerprintCascades();
+
   // This has to happen after building jobs, because otherwise we won't even
   // emit .swiftdeps files for the next build.
   if (rebuildEverything)
@@ -1943,11 +2013,28 @@ static void addDiagFileOutputForPersistentPCHAction(Compilation &C,
   }
 }
 
-/// If the file at \p input has not been modified since the last build (i.e. its
-/// mtime has not changed), adjust the Job's condition accordingly.
+/// Computes a hash of the contents of the file at \p path, or 0 if the file
+/// cannot be read.
+static uint64_t hashFileContents(StringRef path) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return 0;
+  llvm::MD5 hash;
+  hash.update((*buffer)->getBuffer());
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return result.low();
+}
+
+/// If the file at \p input has not been modified since the last build (i.e.
+/// its mtime has not changed, or its contents hash to the same value they did
+/// last time), adjust the Job's condition accordingly.
 static void
 handleCompileJobCondition(Job *J, CompileJobAction::InputInfo inputInfo,
                           StringRef input, bool alwaysRebuildDependents) {
+  J->setEstimatedMemoryUsage(inputInfo.previousPeakMemory);
+  J->setEstimatedDuration(inputInfo.previousCompileDuration);
+
   if (inputInfo.status == CompileJobAction::InputInfo::NewlyAdded) {
     J->setCondition(Job::Condition::NewlyAdded);
     return;
@@ -1960,8 +2047,23 @@ handleCompileJobCondition(Job *J, CompileJobAction::InputInfo inputInfo,
     hasValidModTime = true;
   }
 
+  bool inputUnchanged =
+      hasValidModTime && J->getInputModTime() == inputInfo.previousModTime;
+  if (inputUnchanged) {
+    // An identical modification time means we never read the file, so carry
+    // the previous hash forward.
+    J->setInputContentHash(inputInfo.previousContentHash);
+  } else {
+    // The modification time changed, but a checkout or a touch may have left
+    // the contents alone, and clock skew can move mtimes spuriously. Compare
+    // content hashes before declaring the input out of date.
+    uint64_t hash = hashFileContents(input);
+    J->setInputContentHash(hash);
+    inputUnchanged = hash != 0 && hash == inputInfo.previousContentHash;
+  }
+
   Job::Condition condition;
-  if (hasValidModTime && J->getInputModTime() == inputInfo.previousModTime) {
+  if (inputUnchanged) {
     switch (inputInfo.status) {
     case CompileJobAction::InputInfo::UpToDate:
       if (llvm::sys::fs::exists(J->getOutput().getPrimaryOutputFilename()))
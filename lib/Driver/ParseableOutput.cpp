@@ -187,15 +187,25 @@ public:
 
 class FinishedMessage : public TaskOutputMessage {
   int ExitStatus;
+  uint64_t WallTimeUsec;
+  sys::TaskStatistics Stats;
 public:
   FinishedMessage(const Job &Cmd, ProcessId Pid, StringRef Output,
-                  int ExitStatus) : TaskOutputMessage("finished", Cmd, Pid,
-                                                      Output),
-                                    ExitStatus(ExitStatus) {}
+                  int ExitStatus, uint64_t WallTimeUsec,
+                  sys::TaskStatistics Stats)
+      : TaskOutputMessage("finished", Cmd, Pid, Output),
+        ExitStatus(ExitStatus), WallTimeUsec(WallTimeUsec), Stats(Stats) {}
 
   void provideMapping(swift::json::Output &out) override {
     TaskOutputMessage::provideMapping(out);
     out.mapRequired("exit-status", ExitStatus);
+    // Resource usage is only emitted when it was measured; a missing key
+    // means the value is unknown on this platform.
+    out.mapOptional("wall-time-usec", WallTimeUsec, uint64_t(0));
+    out.mapOptional("user-time-usec", Stats.UserTimeUsec, uint64_t(0));
+    out.mapOptional("sys-time-usec", Stats.SystemTimeUsec, uint64_t(0));
+    out.mapOptional("max-resident-set-bytes", Stats.PeakMemoryUsage,
+                    uint64_t(0));
   }
 };
 
@@ -254,8 +264,10 @@ void parseable_output::emitBeganMessage(raw_ostream &os,
 
 void parseable_output::emitFinishedMessage(raw_ostream &os,
                                            const Job &Cmd, ProcessId Pid,
-                                           int ExitStatus, StringRef Output) {
-  FinishedMessage msg(Cmd, Pid, Output, ExitStatus);
+                                           int ExitStatus, StringRef Output,
+                                           uint64_t WallTimeUsec,
+                                           sys::TaskStatistics Stats) {
+  FinishedMessage msg(Cmd, Pid, Output, ExitStatus, WallTimeUsec, Stats);
   emitMessage(os, msg);
 }
 
@@ -330,6 +330,9 @@ bool FrontendArgsToOptionsConverter::convert() {
   if (const Arg *A = Args.getLastArg(OPT_index_store_path)) {
     Opts.IndexStorePath = A->getValue();
   }
+  if (const Arg *A = Args.getLastArg(OPT_compilation_cache_path)) {
+    Opts.CompilationCachePath = A->getValue();
+  }
   Opts.IndexSystemModules |= Args.hasArg(OPT_index_system_modules);
 
   Opts.EmitVerboseSIL |= Args.hasArg(OPT_emit_verbose_sil);
@@ -393,6 +396,7 @@ bool FrontendArgsToOptionsConverter::convert() {
   Opts.AlwaysSerializeDebuggingOptions |=
       Args.hasArg(OPT_serialize_debugging_options);
   Opts.EnableSourceImport |= Args.hasArg(OPT_enable_source_import);
+  Opts.EnableParallelPrelexing |= Args.hasArg(OPT_enable_parallel_prelexing);
   Opts.ImportUnderlyingModule |= Args.hasArg(OPT_import_underlying_module);
   Opts.EnableSerializationNestedTypeLookupTable &=
       !Args.hasArg(OPT_disable_serialization_nested_type_lookup_table);
@@ -446,6 +450,18 @@ void FrontendArgsToOptionsConverter::computeDebugTimeOptions() {
     if (Args.getLastArg(OPT_trace_stats_events)) {
       Opts.TraceStats = true;
     }
+    if (Args.getLastArg(OPT_chrome_trace_stats_events)) {
+      Opts.ChromeTraceStats = true;
+    }
+    if (const Arg *A = Args.getLastArg(OPT_trace_stats_sample_rate)) {
+      unsigned rate;
+      if (StringRef(A->getValue()).getAsInteger(10, rate)) {
+        Diags.diagnose(SourceLoc(), diag::error_invalid_arg_value,
+                       A->getAsString(Args), A->getValue());
+      } else {
+        Opts.TraceStatsSampleRate = rate;
+      }
+    }
   }
 }
 
@@ -490,6 +506,19 @@ void FrontendArgsToOptionsConverter::computePlaygroundOptions() {
     Opts.PlaygroundTransform = false;
   Opts.PlaygroundHighPerformance |=
       Args.hasArg(OPT_playground_high_performance);
+  if (const Arg *A = Args.getLastArg(OPT_playground_region)) {
+    StringRef firstPart, secondPart;
+    std::tie(firstPart, secondPart) = StringRef(A->getValue()).split(':');
+    unsigned start = 0, end = 0;
+    if (firstPart.getAsInteger(10, start) ||
+        secondPart.getAsInteger(10, end) || start == 0 || end < start) {
+      Diags.diagnose(SourceLoc(), diag::error_invalid_arg_value,
+                     A->getAsString(Args), A->getValue());
+    } else {
+      Opts.PlaygroundRegionStart = start;
+      Opts.PlaygroundRegionEnd = end;
+    }
+  }
 }
 
 void FrontendArgsToOptionsConverter::computeHelpOptions() {
@@ -1512,11 +1541,14 @@ static bool ParseSILArgs(SILOptions &Opts, ArgList &Args,
   Opts.DisableSILPartialApply |=
     Args.hasArg(OPT_disable_sil_partial_apply);
   Opts.EnableSILOwnership |= Args.hasArg(OPT_enable_sil_ownership);
+  Opts.EnableOnDemandSILGen |= Args.hasArg(OPT_enable_ondemand_silgen);
   Opts.AssumeUnqualifiedOwnershipWhenParsing
     |= Args.hasArg(OPT_assume_parsing_unqualified_ownership_sil);
   Opts.EnableMandatorySemanticARCOpts |=
       !Args.hasArg(OPT_disable_mandatory_semantic_arc_opts);
   Opts.EnableLargeLoadableTypes |= Args.hasArg(OPT_enable_large_loadable_types);
+  Opts.EnableCrossModuleSerialization |=
+      Args.hasArg(OPT_enable_cross_module_serialization);
   Opts.EnableGuaranteedNormalArguments |=
       Args.hasArg(OPT_enable_guaranteed_normal_arguments);
 
@@ -1699,6 +1731,9 @@ static bool ParseIRGenArgs(IRGenOptions &Opts, ArgList &Args,
 
   Opts.UseSwiftCall = Args.hasArg(OPT_enable_swiftcall);
 
+  Opts.EnableGenericMetadataInlineCaches |=
+    Args.hasArg(OPT_enable_generic_metadata_inline_caches);
+
   // This is set to true by default.
   Opts.UseIncrementalLLVMCodeGen &=
     !Args.hasArg(OPT_disable_incremental_llvm_codegeneration);
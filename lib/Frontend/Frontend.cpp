@@ -34,6 +34,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace swift;
 
@@ -61,14 +62,17 @@ void CompilerInstance::createSILModule() {
       Invocation.getFrontendOptions().Inputs.isWholeModule());
 }
 
-void CompilerInstance::setPrimarySourceFile(SourceFile *SF) {
+void CompilerInstance::recordPrimaryInputBuffer(unsigned BufID) {
+  PrimaryBufferIDs.insert(BufID);
+}
+
+void CompilerInstance::recordPrimarySourceFile(SourceFile *SF) {
   assert(SF);
   assert(MainModule && "main module not created yet");
-  assert(!PrimarySourceFile && "already has a primary source file");
-  assert(PrimaryBufferID == NO_SUCH_BUFFER || !SF->getBufferID().hasValue() ||
-         SF->getBufferID().getValue() == PrimaryBufferID);
-  PrimarySourceFile = SF;
-  PrimarySourceFile->setReferencedNameTracker(NameTracker);
+  assert(!SF->getBufferID().hasValue() ||
+         isPrimaryInput(SF->getBufferID().getValue()));
+  PrimarySourceFiles.push_back(SF);
+  SF->setReferencedNameTracker(NameTracker);
 }
 
 bool CompilerInstance::setup(const CompilerInvocation &Invok) {
@@ -186,9 +190,9 @@ bool CompilerInstance::setUpInputs() {
 
   // Set the primary file to the code-completion point if one exists.
   if (codeCompletionBufferID.hasValue() &&
-      *codeCompletionBufferID != PrimaryBufferID) {
-    assert(PrimaryBufferID == NO_SUCH_BUFFER && "re-setting PrimaryBufferID");
-    PrimaryBufferID = *codeCompletionBufferID;
+      !isPrimaryInput(*codeCompletionBufferID)) {
+    assert(PrimaryBufferIDs.empty() && "re-setting PrimaryBufferID");
+    recordPrimaryInputBuffer(*codeCompletionBufferID);
   }
 
   if (isInputSwift() && MainBufferID == NO_SUCH_BUFFER &&
@@ -214,8 +218,7 @@ bool CompilerInstance::setUpForInput(const InputFile &input) {
   }
 
   if (input.isPrimary()) {
-    assert(PrimaryBufferID == NO_SUCH_BUFFER && "re-setting PrimaryBufferID");
-    PrimaryBufferID = *bufferID;
+    recordPrimaryInputBuffer(*bufferID);
   }
   return false;
 }
@@ -496,8 +499,13 @@ CompilerInstance::computeDelayedParsingCallback(bool isPrimary) {
   if (Invocation.isCodeCompletion())
     return llvm::make_unique<CodeCompleteDelayedCallbacks>(
         SourceMgr.getCodeCompletionLoc());
-  if (!isPrimary)
-    return llvm::make_unique<AlwaysDelayedCallbacks>();
+  if (!isPrimary) {
+    // Outside of code completion, nothing ever materializes a delayed body
+    // in a non-primary file: Sema only needs signatures from those files.
+    // Skip the bodies outright so the parser does not record delayed-parsing
+    // state for every function of every non-primary file.
+    return llvm::make_unique<AlwaysSkipBodiesCallbacks>();
+  }
   return nullptr;
 }
 
@@ -587,7 +595,7 @@ void CompilerInstance::parseLibraryFile(
   addAdditionalInitialImportsTo(NextInput, implicitImports);
 
   auto *DelayedCB = SecondaryDelayedCB;
-  if (BufferID == PrimaryBufferID) {
+  if (isPrimaryInput(BufferID)) {
     DelayedCB = PrimaryDelayedCB;
   }
   if (isWholeModuleCompilation())
@@ -595,7 +603,7 @@ void CompilerInstance::parseLibraryFile(
 
   auto &Diags = NextInput->getASTContext().Diags;
   auto DidSuppressWarnings = Diags.getSuppressWarnings();
-  auto IsPrimary = isWholeModuleCompilation() || BufferID == PrimaryBufferID;
+  auto IsPrimary = isWholeModuleCompilation() || isPrimaryInput(BufferID);
   Diags.setSuppressWarnings(DidSuppressWarnings || !IsPrimary);
 
   bool Done;
@@ -629,6 +637,30 @@ OptionSet<TypeCheckingFlags> CompilerInstance::computeTypeCheckingOptions() {
   return TypeCheckOptions;
 }
 
+/// Lex every buffer in \p BufferIDs to EOF on a thread pool, discarding the
+/// tokens.  Lexing only reads the source buffer and LangOptions, so it is
+/// safe to run concurrently (diagnostics are suppressed by passing a null
+/// DiagnosticEngine; the serial parse that follows re-lexes and diagnoses).
+/// This overlaps page-in and token scanning of all files ahead of the
+/// serial per-file parse loop.
+static void prelexBuffersInParallel(ArrayRef<unsigned> BufferIDs,
+                                    const LangOptions &LangOpts,
+                                    const SourceManager &SourceMgr) {
+  SharedTimer timer("performSema-parallel-prelex");
+  llvm::ThreadPool Pool;
+  for (auto BufferID : BufferIDs) {
+    Pool.async([&LangOpts, &SourceMgr, BufferID] {
+      Lexer L(LangOpts, SourceMgr, BufferID, /*Diags=*/nullptr,
+              /*InSILMode=*/false);
+      Token Tok;
+      do {
+        L.lex(Tok);
+      } while (Tok.isNot(tok::eof));
+    });
+  }
+  Pool.wait();
+}
+
 bool CompilerInstance::parsePartialModulesAndLibraryFiles(
     const ImplicitImports &implicitImports,
     PersistentParserState &PersistentState,
@@ -636,6 +668,13 @@ bool CompilerInstance::parsePartialModulesAndLibraryFiles(
     DelayedParsingCallbacks *SecondaryDelayedCB) {
   SharedTimer timer("performSema-parsePartialModulesAndLibraryFiles");
   bool hadLoadError = false;
+
+  if (Invocation.getFrontendOptions().EnableParallelPrelexing &&
+      InputSourceCodeBufferIDs.size() > 1) {
+    prelexBuffersInParallel(InputSourceCodeBufferIDs,
+                            Invocation.getLangOptions(), SourceMgr);
+  }
+
   // Parse all the partial modules first.
   for (auto &PM : PartialModules) {
     assert(PM.ModuleBuffer);
@@ -661,7 +700,7 @@ void CompilerInstance::parseAndTypeCheckMainFile(
   SharedTimer timer(
       "performSema-checkTypesWhileParsingMain-parseAndTypeCheckMainFile");
   bool mainIsPrimary =
-      (isWholeModuleCompilation() || MainBufferID == PrimaryBufferID);
+      (isWholeModuleCompilation() || isPrimaryInput(MainBufferID));
 
   SourceFile &MainFile =
       MainModule->getMainSourceFile(Invocation.getSourceFileKind());
@@ -704,7 +743,9 @@ void CompilerInstance::parseAndTypeCheckMainFile(
   if (mainIsPrimary && !Context->hadError() &&
       Invocation.getFrontendOptions().PlaygroundTransform)
     performPlaygroundTransform(
-        MainFile, Invocation.getFrontendOptions().PlaygroundHighPerformance);
+        MainFile, Invocation.getFrontendOptions().PlaygroundHighPerformance,
+        Invocation.getFrontendOptions().PlaygroundRegionStart,
+        Invocation.getFrontendOptions().PlaygroundRegionEnd);
   if (!mainIsPrimary) {
     performNameBinding(MainFile);
   }
@@ -724,7 +765,8 @@ void CompilerInstance::forEachFileToTypeCheck(
   if (isWholeModuleCompilation()) {
     forEachSourceFileIn(MainModule, [&](SourceFile &SF) { fn(SF); });
   } else {
-    fn(*PrimarySourceFile);
+    for (SourceFile *SF : PrimarySourceFiles)
+      fn(*SF);
   }
 }
 
@@ -746,8 +788,8 @@ SourceFile *CompilerInstance::createSourceFileForMainModule(
       SourceFile(*mainModule, fileKind, bufferID, importKind, keepSyntaxInfo);
   MainModule->addFile(*inputFile);
 
-  if (bufferID && *bufferID == PrimaryBufferID)
-    setPrimarySourceFile(inputFile);
+  if (bufferID && isPrimaryInput(*bufferID))
+    recordPrimarySourceFile(inputFile);
 
   return inputFile;
 }
@@ -813,6 +855,6 @@ void CompilerInstance::freeContextAndSIL() {
   TheSILModule.reset();
   MainModule = nullptr;
   SML = nullptr;
-  PrimarySourceFile = nullptr;
+  PrimarySourceFiles.clear();
 }
 
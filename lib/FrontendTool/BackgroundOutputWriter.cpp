@@ -0,0 +1,67 @@
+//===--- BackgroundOutputWriter.cpp - Overlapped output writing -----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "BackgroundOutputWriter.h"
+
+#include "swift/AST/DiagnosticEngine.h"
+#include "swift/AST/DiagnosticsCommon.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace swift;
+
+void BackgroundOutputWriter::scheduleWrite(llvm::StringRef path,
+                                           std::string contents,
+                                           llvm::sys::fs::OpenFlags flags) {
+  assert(!Writer.joinable() && "already started writing");
+  Writes.push_back({path, std::move(contents), flags, std::error_code()});
+}
+
+void BackgroundOutputWriter::performWrites() {
+  for (auto &write : Writes) {
+    std::error_code EC;
+    llvm::raw_fd_ostream out(write.Path, EC, write.Flags);
+    if (EC) {
+      write.Result = EC;
+      continue;
+    }
+    out << write.Contents;
+    out.close();
+    if (out.has_error()) {
+      write.Result = out.error();
+      out.clear_error();
+    }
+  }
+}
+
+void BackgroundOutputWriter::start() {
+  assert(!Writer.joinable() && "already started writing");
+  if (!Writes.empty())
+    Writer = std::thread([this] { performWrites(); });
+}
+
+void BackgroundOutputWriter::flush() {
+  if (Flushed)
+    return;
+  Flushed = true;
+
+  if (Writer.joinable())
+    Writer.join();
+  else
+    performWrites();
+
+  for (auto &write : Writes) {
+    if (!write.Result)
+      continue;
+    Diags.diagnose(SourceLoc(), diag::error_opening_output, write.Path,
+                   write.Result.message());
+  }
+}
@@ -0,0 +1,72 @@
+//===--- BackgroundOutputWriter.h - Overlapped output writing ---*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_FRONTENDTOOL_BACKGROUNDOUTPUTWRITER_H
+#define SWIFT_FRONTENDTOOL_BACKGROUNDOUTPUTWRITER_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace swift {
+class DiagnosticEngine;
+
+/// Writes supplementary frontend outputs on a background thread.
+///
+/// The emitters compose each output into an in-memory buffer on the main
+/// thread and schedule it here, so the filesystem writes overlap with the
+/// SIL and IRGen work that follows instead of adding their latency to the
+/// tail of the job. The worker thread never touches compiler state;
+/// failures are recorded and diagnosed on the main thread when the writer
+/// is flushed.
+class BackgroundOutputWriter {
+  struct Write {
+    std::string Path;
+    std::string Contents;
+    llvm::sys::fs::OpenFlags Flags;
+    std::error_code Result;
+  };
+
+  DiagnosticEngine &Diags;
+  std::vector<Write> Writes;
+  std::thread Writer;
+  bool Flushed = false;
+
+  void performWrites();
+
+public:
+  explicit BackgroundOutputWriter(DiagnosticEngine &diags) : Diags(diags) {}
+  ~BackgroundOutputWriter() { flush(); }
+
+  BackgroundOutputWriter(const BackgroundOutputWriter &) = delete;
+  BackgroundOutputWriter &operator=(const BackgroundOutputWriter &) = delete;
+
+  /// Schedules \p contents to be written to \p path. Only valid before
+  /// start() has been called.
+  void scheduleWrite(llvm::StringRef path, std::string contents,
+                     llvm::sys::fs::OpenFlags flags = llvm::sys::fs::F_None);
+
+  /// Starts writing the scheduled outputs on a background thread.
+  void start();
+
+  /// Waits for all scheduled writes to finish and diagnoses any failures.
+  /// If start() was never reached, performs the writes synchronously.
+  /// Safe to call more than once; the destructor calls it implicitly.
+  void flush();
+};
+
+} // end namespace swift
+
+#endif
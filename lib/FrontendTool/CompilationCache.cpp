@@ -0,0 +1,251 @@
+//===--- CompilationCache.cpp - Reuse outputs of identical invocations ----===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A content-addressed cache for frontend outputs. An invocation is keyed by
+// a hash of its arguments and the contents of its input files. Because the
+// full set of files the compilation reads (imported swiftmodules, bridging
+// and clang headers, ...) is only known after compiling, each cache entry
+// also records the dependencies observed by the DependencyTracker together
+// with their content hashes; an entry is only replayed if every recorded
+// dependency still has the recorded contents.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CompilationCache.h"
+#include "swift/AST/ModuleLoader.h"
+#include "swift/Basic/Version.h"
+#include "swift/Frontend/Frontend.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace swift;
+
+/// Returns the hex digest of the contents of the file at \p path, or an
+/// empty string if the file cannot be read.
+static std::string hashOfFileContents(StringRef path) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return std::string();
+  llvm::MD5 hash;
+  hash.update((*buffer)->getBuffer());
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::SmallString<32> digest;
+  llvm::MD5::stringifyResult(result, digest);
+  return digest.str().str();
+}
+
+/// Collects every output file the invocation writes, in a fixed order
+/// shared by the store and replay paths.
+static void collectOutputPaths(const FrontendOptions &opts,
+                               SmallVectorImpl<std::string> &paths) {
+  for (const std::string &output : opts.OutputFilenames)
+    paths.push_back(output);
+  for (const std::string &path :
+       {opts.ModuleOutputPath, opts.ModuleDocOutputPath,
+        opts.ObjCHeaderOutputPath, opts.DependenciesFilePath,
+        opts.ReferenceDependenciesFilePath, opts.LoadedModuleTracePath,
+        opts.TBDPath}) {
+    if (!path.empty())
+      paths.push_back(path);
+  }
+}
+
+bool swift::supportsCompilationCaching(const CompilerInvocation &Invocation) {
+  const FrontendOptions &opts = Invocation.getFrontendOptions();
+  if (opts.CompilationCachePath.empty())
+    return false;
+
+  // Only cache invocations which do nothing but read the inputs and write
+  // the output files collected by collectOutputPaths.
+  switch (opts.RequestedAction) {
+  case FrontendOptions::ActionType::EmitObject:
+  case FrontendOptions::ActionType::EmitBC:
+  case FrontendOptions::ActionType::EmitModuleOnly:
+  case FrontendOptions::ActionType::MergeModules:
+    break;
+  default:
+    return false;
+  }
+
+  if (opts.Inputs.isReadingFromStdin() || !opts.Inputs.hasInputs())
+    return false;
+
+  // Serialized diagnostics and fix-its are written by diagnostic consumers
+  // which run on a cache hit as well, so they cannot be replayed.
+  if (!opts.SerializedDiagnosticsPath.empty() ||
+      !opts.FixitsOutputPath.empty())
+    return false;
+
+  SmallVector<std::string, 8> outputs;
+  collectOutputPaths(opts, outputs);
+  if (outputs.empty())
+    return false;
+  for (const std::string &output : outputs) {
+    if (output == "-")
+      return false;
+  }
+  return true;
+}
+
+/// Computes the cache key for the invocation: a hash of the compiler
+/// version, all frontend arguments, and the contents of all input files.
+/// Returns an empty string if an input cannot be read.
+static std::string computeCacheKey(const FrontendOptions &opts,
+                                   ArrayRef<const char *> Args) {
+  llvm::MD5 hash;
+  // Entries must not outlive the toolchain that produced them; a compiler
+  // upgrade would otherwise replay objects built by the old compiler.
+  hash.update(version::getSwiftFullVersion());
+  hash.update(StringRef("\0", 1));
+  for (const char *arg : Args) {
+    hash.update(StringRef(arg));
+    hash.update(StringRef("\0", 1));
+  }
+  for (const std::string &input : opts.Inputs.getInputFilenames()) {
+    auto buffer = llvm::MemoryBuffer::getFile(input);
+    if (!buffer)
+      return std::string();
+    hash.update((*buffer)->getBuffer());
+    hash.update(StringRef("\0", 1));
+  }
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::SmallString<32> digest;
+  llvm::MD5::stringifyResult(result, digest);
+  return digest.str().str();
+}
+
+/// Returns the path of the dependency manifest for \p key. The manifest is
+/// written last when storing an entry, so its existence implies that all of
+/// the entry's output files are present.
+static std::string getManifestPath(StringRef cacheDir, StringRef key) {
+  llvm::SmallString<128> path(cacheDir);
+  llvm::sys::path::append(path, key);
+  path += ".deps";
+  return path.str().str();
+}
+
+/// Returns the path under which the \p index-th output file of \p key is
+/// stored.
+static std::string getCachedOutputPath(StringRef cacheDir, StringRef key,
+                                       unsigned index) {
+  llvm::SmallString<128> path(cacheDir);
+  llvm::sys::path::append(path, key);
+  path += ".out";
+  path += llvm::utostr(index);
+  return path.str().str();
+}
+
+/// Writes \p contents to \p path via a unique temporary file and a rename,
+/// so that concurrent frontend invocations never observe a partial file.
+static bool atomicallyWriteFile(StringRef path, StringRef contents) {
+  llvm::SmallString<128> tmpPath;
+  int tmpFD;
+  if (llvm::sys::fs::createUniqueFile(path + ".tmp%%%%%%", tmpFD, tmpPath))
+    return false;
+  {
+    llvm::raw_fd_ostream out(tmpFD, /*shouldClose=*/true);
+    out.write(contents.data(), contents.size());
+  }
+  if (llvm::sys::fs::rename(tmpPath, path)) {
+    llvm::sys::fs::remove(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+bool swift::tryReplayCompilationFromCache(const CompilerInvocation &Invocation,
+                                          ArrayRef<const char *> Args) {
+  if (!supportsCompilationCaching(Invocation))
+    return false;
+
+  const FrontendOptions &opts = Invocation.getFrontendOptions();
+  std::string key = computeCacheKey(opts, Args);
+  if (key.empty())
+    return false;
+
+  StringRef cacheDir = opts.CompilationCachePath;
+  auto manifest =
+      llvm::MemoryBuffer::getFile(getManifestPath(cacheDir, key));
+  if (!manifest)
+    return false;
+
+  // Validate that every dependency recorded when the entry was stored still
+  // has the same contents.
+  SmallVector<StringRef, 32> lines;
+  (*manifest)->getBuffer().split(lines, '\n', /*MaxSplit=*/-1,
+                                 /*KeepEmpty=*/false);
+  for (StringRef line : lines) {
+    auto hashAndPath = line.split(' ');
+    if (hashAndPath.second.empty() ||
+        hashOfFileContents(hashAndPath.second) != hashAndPath.first)
+      return false;
+  }
+
+  SmallVector<std::string, 8> outputs;
+  collectOutputPaths(opts, outputs);
+  for (unsigned i = 0, e = outputs.size(); i != e; ++i) {
+    if (llvm::sys::fs::copy_file(getCachedOutputPath(cacheDir, key, i),
+                                 outputs[i]))
+      return false;
+  }
+  return true;
+}
+
+void swift::storeCompilationInCache(const CompilerInvocation &Invocation,
+                                    ArrayRef<const char *> Args,
+                                    const DependencyTracker &depTracker) {
+  if (!supportsCompilationCaching(Invocation))
+    return;
+
+  const FrontendOptions &opts = Invocation.getFrontendOptions();
+  std::string key = computeCacheKey(opts, Args);
+  if (key.empty())
+    return;
+
+  StringRef cacheDir = opts.CompilationCachePath;
+  if (llvm::sys::fs::create_directories(cacheDir))
+    return;
+
+  // Record the contents of everything the compilation read. If a dependency
+  // cannot be hashed, the entry cannot be validated later, so don't store it.
+  llvm::SmallString<1024> manifest;
+  for (const std::string &dep : depTracker.getDependencies()) {
+    std::string depHash = hashOfFileContents(dep);
+    if (depHash.empty())
+      return;
+    manifest += depHash;
+    manifest += ' ';
+    manifest += dep;
+    manifest += '\n';
+  }
+
+  SmallVector<std::string, 8> outputs;
+  collectOutputPaths(opts, outputs);
+  for (unsigned i = 0, e = outputs.size(); i != e; ++i) {
+    auto buffer = llvm::MemoryBuffer::getFile(outputs[i]);
+    if (!buffer)
+      return;
+    if (!atomicallyWriteFile(getCachedOutputPath(cacheDir, key, i),
+                             (*buffer)->getBuffer()))
+      return;
+  }
+
+  // The manifest goes last: its existence marks the entry as complete.
+  (void)atomicallyWriteFile(getManifestPath(cacheDir, key), manifest);
+}
@@ -0,0 +1,45 @@
+//===--- CompilationCache.h - Reuse outputs of identical invocations ------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_FRONTENDTOOL_COMPILATIONCACHE_H
+#define SWIFT_FRONTENDTOOL_COMPILATIONCACHE_H
+
+#include "swift/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+
+namespace swift {
+
+class CompilerInvocation;
+class DependencyTracker;
+
+/// Returns true if the invocation is configured to use the compilation
+/// cache and produces only outputs which can be stored in and replayed
+/// from it.
+bool supportsCompilationCaching(const CompilerInvocation &Invocation);
+
+/// Tries to satisfy the invocation by copying the output files of a
+/// previous invocation with the same arguments, inputs and dependencies
+/// out of the compilation cache. Returns true on a cache hit, with all
+/// output files written.
+bool tryReplayCompilationFromCache(const CompilerInvocation &Invocation,
+                                   ArrayRef<const char *> Args);
+
+/// Stores the output files of the finished invocation in the compilation
+/// cache, together with the dependencies recorded by \p depTracker.
+/// Failures are ignored; the cache is best-effort.
+void storeCompilationInCache(const CompilerInvocation &Invocation,
+                             ArrayRef<const char *> Args,
+                             const DependencyTracker &depTracker);
+
+} // end namespace swift
+
+#endif
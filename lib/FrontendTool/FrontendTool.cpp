@@ -21,7 +21,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/FrontendTool/FrontendTool.h"
+#include "BackgroundOutputWriter.h"
 #include "ImportedModules.h"
+#include "CompilationCache.h"
 #include "ReferenceDependencies.h"
 #include "TBD.h"
 
@@ -44,6 +46,8 @@
 #include "swift/Basic/Statistic.h"
 #include "swift/Basic/Timer.h"
 #include "swift/Basic/UUID.h"
+#include "swift/Basic/Version.h"
+#include "swift/TBDGen/TBDGen.h"
 #include "swift/Frontend/DiagnosticVerifier.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/Frontend/PrintingDiagnosticConsumer.h"
@@ -72,6 +76,8 @@
 #include "llvm/Option/Option.h"
 #include "llvm/Option/OptTable.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/TargetSelect.h"
@@ -97,19 +103,11 @@ static std::string displayName(StringRef MainExecutablePath) {
 }
 
 /// Emits a Make-style dependencies file.
-static bool emitMakeDependencies(DiagnosticEngine &diags,
-                                 DependencyTracker &depTracker,
-                                 const FrontendOptions &opts) {
-  std::error_code EC;
-  llvm::raw_fd_ostream out(opts.DependenciesFilePath, EC,
-                           llvm::sys::fs::F_None);
-
-  if (out.has_error() || EC) {
-    diags.diagnose(SourceLoc(), diag::error_opening_output,
-                   opts.DependenciesFilePath, EC.message());
-    out.clear_error();
-    return true;
-  }
+static void emitMakeDependencies(DependencyTracker &depTracker,
+                                 const FrontendOptions &opts,
+                                 BackgroundOutputWriter &writer) {
+  std::string stringBuffer;
+  llvm::raw_string_ostream out(stringBuffer);
 
   // Declare a helper for escaping file names for use in Makefiles.
   llvm::SmallString<256> pathBuf;
@@ -147,7 +145,8 @@ static bool emitMakeDependencies(DiagnosticEngine &diags,
     out << '\n';
   });
 
-  return false;
+  out.flush();
+  writer.scheduleWrite(opts.DependenciesFilePath, std::move(stringBuffer));
 }
 
 namespace {
@@ -170,20 +169,10 @@ template <> struct ObjectTraits<LoadedModuleTraceFormat> {
 }
 }
 
-static bool emitLoadedModuleTrace(ASTContext &ctxt,
+static void emitLoadedModuleTrace(ASTContext &ctxt,
                                   DependencyTracker &depTracker,
-                                  const FrontendOptions &opts) {
-  std::error_code EC;
-  llvm::raw_fd_ostream out(opts.LoadedModuleTracePath, EC,
-                           llvm::sys::fs::F_Append);
-
-  if (out.has_error() || EC) {
-    ctxt.Diags.diagnose(SourceLoc(), diag::error_opening_output,
-                        opts.LoadedModuleTracePath, EC.message());
-    out.clear_error();
-    return true;
-  }
-
+                                  const FrontendOptions &opts,
+                                  BackgroundOutputWriter &writer) {
   llvm::SmallVector<std::string, 16> swiftModules;
 
   // Canonicalise all the paths by opening them.
@@ -218,7 +207,7 @@ static bool emitLoadedModuleTrace(ASTContext &ctxt,
 
   // raw_fd_ostream is unbuffered, and we may have multiple processes writing,
   // so first write the whole thing into memory and dump out that buffer to the
-  // file.
+  // file in a single append.
   std::string stringBuffer;
   {
     llvm::raw_string_ostream memoryBuffer(stringBuffer);
@@ -227,9 +216,8 @@ static bool emitLoadedModuleTrace(ASTContext &ctxt,
   }
   stringBuffer += "\n";
 
-  out << stringBuffer;
-
-  return true;
+  writer.scheduleWrite(opts.LoadedModuleTracePath, std::move(stringBuffer),
+                       llvm::sys::fs::F_Append);
 }
 
 
@@ -275,10 +263,49 @@ static bool writeSIL(SILModule &SM, ModuleDecl *M, bool EmitVerboseSIL,
   return false;
 }
 
+/// Computes the key guarding reuse of a generated ObjC header: the module's
+/// API surface hash combined with the other inputs the printed text depends
+/// on (the bridging header's path and contents, the access level printed,
+/// and the compiler version embedded in the prologue).
+static std::string computeObjCHeaderKey(ModuleDecl *M,
+                                        StringRef bridgingHeader,
+                                        bool moduleIsPublic) {
+  llvm::MD5 hash;
+  hash.update(getAPISurfaceHash(M));
+  hash.update(bridgingHeader);
+  if (!bridgingHeader.empty()) {
+    if (auto buffer = llvm::MemoryBuffer::getFile(bridgingHeader))
+      hash.update((*buffer)->getBuffer());
+  }
+  hash.update(StringRef(moduleIsPublic ? "public" : "internal"));
+  hash.update(version::getSwiftFullVersion(
+      M->getASTContext().LangOpts.EffectiveLanguageVersion));
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::SmallString<32> digest;
+  llvm::MD5::stringifyResult(result, digest);
+  return digest.str().str();
+}
+
 static bool printAsObjC(const std::string &outputPath, ModuleDecl *M,
                         StringRef bridgingHeader, bool moduleIsPublic) {
   using namespace llvm::sys;
 
+  // Reprinting the header walks and prints every ObjC-visible decl; on
+  // incremental rebuilds where the API surface didn't move, keep the file
+  // from the previous compilation instead. Identical content would not
+  // have bumped the output's timestamp anyway (moveFileIfDifferent below),
+  // so the sidecar only short-circuits the printing work; deleting it
+  // simply regenerates.
+  llvm::SmallString<128> hashPath(outputPath);
+  hashPath += ".apihash";
+  std::string key = computeObjCHeaderKey(M, bridgingHeader, moduleIsPublic);
+  if (fs::exists(outputPath)) {
+    auto previousKey = llvm::MemoryBuffer::getFile(hashPath);
+    if (previousKey && (*previousKey)->getBuffer() == key)
+      return false;
+  }
+
   clang::CompilerInstance Clang;
 
   std::string tmpFilePath;
@@ -312,6 +339,13 @@ static bool printAsObjC(const std::string &outputPath, ModuleDecl *M,
     return true;
   }
 
+  if (!hadError) {
+    std::error_code hashEC;
+    llvm::raw_fd_ostream hashOS(hashPath, hashEC, fs::F_None);
+    if (!hashEC)
+      hashOS << key;
+  }
+
   return hadError;
 }
 
@@ -713,17 +747,26 @@ static bool performCompile(CompilerInstance &Instance,
   if (opts.PrintClangStats && Context.getClangModuleLoader())
     Context.getClangModuleLoader()->printStatistics();
 
+  // Compose the supplementary outputs in memory and write them out on a
+  // background thread; the writes then overlap with the SIL and IRGen work
+  // below instead of gating job wall time on storage latency. The writer's
+  // destructor joins the thread and diagnoses failures on every exit path
+  // from this function.
+  BackgroundOutputWriter OutputWriter(Context.Diags);
+
   if (!opts.DependenciesFilePath.empty())
-    (void)emitMakeDependencies(Context.Diags, *Instance.getDependencyTracker(),
-                               opts);
+    emitMakeDependencies(*Instance.getDependencyTracker(), opts, OutputWriter);
 
   if (shouldTrackReferences)
     emitReferenceDependencies(Context.Diags, Instance.getPrimarySourceFile(),
-                              *Instance.getDependencyTracker(), opts);
+                              *Instance.getDependencyTracker(), opts,
+                              OutputWriter);
 
   if (!opts.LoadedModuleTracePath.empty())
-    (void)emitLoadedModuleTrace(Context, *Instance.getDependencyTracker(),
-                                opts);
+    emitLoadedModuleTrace(Context, *Instance.getDependencyTracker(), opts,
+                          OutputWriter);
+
+  OutputWriter.start();
 
   bool shouldIndex = !opts.IndexStorePath.empty();
 
@@ -1016,6 +1059,10 @@ static bool performCompile(CompilerInstance &Instance,
   // Convert SIL to a lowered form suitable for IRGen.
   runSILLoweringPasses(*SM);
 
+  // Sema is done with the AST; shed the type checker's memoization caches
+  // before IRGen drives peak memory.
+  Context.releaseTypeCheckerCaches();
+
   // TODO: remove once the frontend understands what action it should perform
   IRGenOpts.OutputKind = getOutputKind(Action);
   if (Action == FrontendOptions::ActionType::Immediate) {
@@ -1217,6 +1264,23 @@ static bool dumpAPI(ModuleDecl *Mod, StringRef OutDir) {
   return false;
 }
 
+namespace {
+/// Counts every diagnostic emitted during a compilation, regardless of
+/// severity. Used to decide whether the result may be stored in the
+/// compilation cache.
+class DiagnosticCountingConsumer : public DiagnosticConsumer {
+public:
+  unsigned NumDiagnostics = 0;
+
+  void handleDiagnostic(SourceManager &SM, SourceLoc Loc, DiagnosticKind Kind,
+                        StringRef FormatString,
+                        ArrayRef<DiagnosticArgument> FormatArgs,
+                        const DiagnosticInfo &Info) override {
+    ++NumDiagnostics;
+  }
+};
+} // end anonymous namespace
+
 static StringRef
 silOptModeArgStr(OptimizationMode mode) {
   switch (mode) {
@@ -1390,6 +1454,7 @@ int swift::performFrontend(ArrayRef<const char *> Args,
     std::string TripleName = LangOpts.Target.normalize();
     auto &SM = Instance->getSourceMgr();
     auto Trace = Invocation.getFrontendOptions().TraceStats;
+    auto ChromeTrace = Invocation.getFrontendOptions().ChromeTraceStats;
     StatsReporter = llvm::make_unique<UnifiedStatsReporter>("swift-frontend",
                                                             FEOpts.ModuleName,
                                                             InputName,
@@ -1398,7 +1463,10 @@ int swift::performFrontend(ArrayRef<const char *> Args,
                                                             OptType,
                                                             StatsOutputDir,
                                                             &SM,
-                                                            Trace);
+                                                            Trace,
+                                                            ChromeTrace);
+    if (auto Rate = Invocation.getFrontendOptions().TraceStatsSampleRate)
+      StatsReporter->setTracerSampleRate(Rate);
   }
 
   const DiagnosticOptions &diagOpts = Invocation.getDiagnosticOptions();
@@ -1406,11 +1474,26 @@ int swift::performFrontend(ArrayRef<const char *> Args,
     enableDiagnosticVerifier(Instance->getSourceMgr());
   }
 
+  // If the compilation cache holds the outputs of a previous invocation with
+  // the same arguments, inputs and dependencies, copy them out and skip the
+  // compilation entirely.
+  if (tryReplayCompilationFromCache(Invocation, Args)) {
+    return finishDiagProcessing(0);
+  }
+
+  // Cache entries are only stored for diagnostic-free compilations, because
+  // replaying an entry does not replay its diagnostics.
+  DiagnosticCountingConsumer CacheDiagnosticCounter;
+  if (supportsCompilationCaching(Invocation)) {
+    Instance->addDiagnosticConsumer(&CacheDiagnosticCounter);
+  }
+
   DependencyTracker depTracker;
   if (!Invocation.getFrontendOptions().DependenciesFilePath.empty() ||
       !Invocation.getFrontendOptions().ReferenceDependenciesFilePath.empty() ||
       !Invocation.getFrontendOptions().IndexStorePath.empty() ||
-      !Invocation.getFrontendOptions().LoadedModuleTracePath.empty()) {
+      !Invocation.getFrontendOptions().LoadedModuleTracePath.empty() ||
+      supportsCompilationCaching(Invocation)) {
     Instance->setDependencyTracker(&depTracker);
   }
 
@@ -1435,10 +1518,21 @@ int swift::performFrontend(ArrayRef<const char *> Args,
     performCompile(*Instance, Invocation, Args, ReturnValue, observer,
                    StatsReporter.get());
 
+  // performCompile's background output writer only diagnoses failed
+  // supplementary-output writes once it is destroyed, which is after the
+  // return value above was computed. Re-check the diagnostic engine so those
+  // late errors still fail the compile (and keep it out of the cache).
+  HadError |= Instance->getDiags().hadAnyError();
+
   if (!HadError) {
     Mangle::printManglingStats();
   }
 
+  if (!HadError && ReturnValue == 0 &&
+      CacheDiagnosticCounter.NumDiagnostics == 0) {
+    storeCompilationInCache(Invocation, Args, depTracker);
+  }
+
   if (!HadError && !Invocation.getFrontendOptions().DumpAPIPath.empty()) {
     HadError = dumpAPI(Instance->getMainModule(),
                        Invocation.getFrontendOptions().DumpAPIPath);
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "ReferenceDependencies.h"
+#include "BackgroundOutputWriter.h"
 #include "swift/AST/ASTContext.h"
 #include "swift/AST/ASTMangler.h"
 #include "swift/AST/Decl.h"
@@ -27,6 +28,7 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/YAMLParser.h"
 
@@ -111,6 +113,48 @@ static std::string mangleTypeAsContext(const NominalTypeDecl *type) {
   return Mangler.mangleTypeAsContextUSR(type);
 }
 
+/// Collect every name under which \p D, or a declaration nested inside it,
+/// can show up in the provides sections of the swiftdeps file.
+///
+/// These names key the decl-fingerprints section, which lets the driver
+/// narrow a cascade to the provides whose declarations actually changed.
+/// Over-approximating is fine here; a name the driver never sees simply
+/// stays conservative. Missing a name would be a correctness bug, since the
+/// driver would never consider it changed.
+static void collectProvidedNames(const Decl *D,
+                                 llvm::SetVector<std::string> &names) {
+  if (auto *ED = dyn_cast<ExtensionDecl>(D)) {
+    if (auto *NTD = ED->getExtendedType()->getAnyNominal())
+      names.insert(mangleTypeAsContext(NTD));
+    for (auto *member : ED->getMembers())
+      collectProvidedNames(member, names);
+    return;
+  }
+
+  if (auto *OD = dyn_cast<OperatorDecl>(D)) {
+    names.insert(OD->getName().str().str());
+    return;
+  }
+
+  if (auto *PGD = dyn_cast<PrecedenceGroupDecl>(D)) {
+    names.insert(PGD->getName().str().str());
+    return;
+  }
+
+  auto *VD = dyn_cast<ValueDecl>(D);
+  if (!VD || !VD->hasName())
+    return;
+
+  // Covers top-level names, member names, and dynamic-lookup names alike.
+  names.insert(VD->getBaseName().userFacingName().str());
+
+  if (auto *NTD = dyn_cast<NominalTypeDecl>(D)) {
+    names.insert(mangleTypeAsContext(NTD));
+    for (auto *member : NTD->getMembers())
+      collectProvidedNames(member, names);
+  }
+}
+
 std::vector<std::string>
 swift::reversePathSortedFilenames(const ArrayRef<std::string> elts) {
   std::vector<std::string> tmp(elts.begin(), elts.end());
@@ -125,7 +169,8 @@ swift::reversePathSortedFilenames(const ArrayRef<std::string> elts) {
 bool swift::emitReferenceDependencies(DiagnosticEngine &diags,
                                       SourceFile *SF,
                                       DependencyTracker &depTracker,
-                                      const FrontendOptions &opts) {
+                                      const FrontendOptions &opts,
+                                      BackgroundOutputWriter &writer) {
   if (!SF) {
     diags.diagnose(SourceLoc(),
                    diag::emit_reference_dependencies_without_primary_file);
@@ -138,16 +183,8 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags,
   llvm::sys::fs::rename(opts.ReferenceDependenciesFilePath,
                         opts.ReferenceDependenciesFilePath + "~");
 
-  std::error_code EC;
-  llvm::raw_fd_ostream out(opts.ReferenceDependenciesFilePath, EC,
-                           llvm::sys::fs::F_None);
-
-  if (out.has_error() || EC) {
-    diags.diagnose(SourceLoc(), diag::error_opening_output,
-                   opts.ReferenceDependenciesFilePath, EC.message());
-    out.clear_error();
-    return true;
-  }
+  std::string stringBuffer;
+  llvm::raw_string_ostream out(stringBuffer);
 
   auto escape = [](DeclBaseName name) -> std::string {
     return llvm::yaml::escape(name.userFacingName());
@@ -420,9 +457,41 @@ bool swift::emitReferenceDependencies(DiagnosticEngine &diags,
     out << "- \"" << llvm::yaml::escape(entry) << "\"\n";
   }
 
+  // Emit the structural fingerprints recorded during parsing, keyed by the
+  // names used in the provides sections above. The driver diffs these
+  // between builds so that, when the interface hash changes, only the
+  // provides whose declarations actually changed have to cascade.
+  out << "decl-fingerprints:\n";
+  {
+    auto &ctx = SF->getASTContext();
+    llvm::MapVector<std::string, uint64_t> fingerprintsByName;
+    for (const Decl *D : SF->Decls) {
+      auto fingerprint = ctx.getDeclFingerprint(D);
+      if (!fingerprint)
+        continue;
+
+      // Fingerprints exist per top-level declaration, so attribute this one
+      // to every name the declaration can provide. The set keeps a name
+      // from absorbing the same fingerprint twice and cancelling out.
+      llvm::SetVector<std::string> names;
+      collectProvidedNames(D, names);
+
+      for (const auto &name : names)
+        fingerprintsByName[name] ^= *fingerprint;
+    }
+    for (const auto &entry : fingerprintsByName) {
+      out << "- [\"" << llvm::yaml::escape(entry.first) << "\", \""
+          << llvm::utohexstr(entry.second) << "\"]\n";
+    }
+  }
+
   llvm::SmallString<32> interfaceHash;
   SF->getInterfaceHash(interfaceHash);
   out << "interface-hash: \"" << interfaceHash << "\"\n";
 
+  out.flush();
+  writer.scheduleWrite(opts.ReferenceDependenciesFilePath,
+                       std::move(stringBuffer));
+
   return false;
 }
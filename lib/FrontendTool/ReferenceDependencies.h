@@ -19,6 +19,7 @@
 
 namespace swift {
 
+class BackgroundOutputWriter;
 class DependencyTracker;
 class DiagnosticEngine;
 class FrontendOptions;
@@ -30,11 +31,13 @@ class SourceFile;
 std::vector<std::string>
 reversePathSortedFilenames(const llvm::ArrayRef<std::string> paths);
 
-/// Emit a Swift-style dependencies file for \p SF.
+/// Emit a Swift-style dependencies file for \p SF. The contents are composed
+/// in memory and handed to \p writer for writing.
 bool emitReferenceDependencies(DiagnosticEngine &diags,
                                SourceFile *SF,
                                DependencyTracker &depTracker,
-                               const FrontendOptions &opts);
+                               const FrontendOptions &opts,
+                               BackgroundOutputWriter &writer);
 } // end namespace swift
 
 #endif
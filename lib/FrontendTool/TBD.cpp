@@ -17,15 +17,19 @@
 #include "swift/AST/DiagnosticsFrontend.h"
 #include "swift/AST/Module.h"
 #include "swift/Basic/LLVM.h"
+#include "swift/Basic/Version.h"
 #include "swift/Demangling/Demangle.h"
 #include "swift/Frontend/FrontendOptions.h"
 #include "swift/TBDGen/TBDGen.h"
 
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ValueSymbolTable.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include <vector>
 
 using namespace swift;
@@ -38,8 +42,43 @@ static std::vector<StringRef> sortSymbols(llvm::StringSet<> &symbols) {
   return sorted;
 }
 
+/// Computes the key guarding reuse of an emitted TBD file: the module's
+/// API surface hash combined with everything else the file's contents
+/// depend on.
+static std::string computeTBDKey(ModuleDecl *M, bool hasMultipleIGMs,
+                                 StringRef installName) {
+  llvm::MD5 hash;
+  hash.update(getAPISurfaceHash(M));
+  hash.update(installName);
+  hash.update(M->getASTContext().LangOpts.Target.str());
+  hash.update(StringRef(hasMultipleIGMs ? "m" : "s"));
+  // Key the file to the toolchain that produced it, so a compiler upgrade
+  // regenerates rather than trusting a hash computed by older logic.
+  hash.update(version::getSwiftFullVersion(
+      M->getASTContext().LangOpts.EffectiveLanguageVersion));
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::SmallString<32> digest;
+  llvm::MD5::stringifyResult(result, digest);
+  return digest.str().str();
+}
+
 bool swift::writeTBD(ModuleDecl *M, bool hasMultipleIGMs,
                      StringRef OutputFilename, StringRef installName) {
+  // The TBD contents are a pure function of the module's API surface, so
+  // an incremental rebuild that did not touch any public decl can keep the
+  // file from the previous compilation and skip symbol enumeration
+  // entirely. The key that produced the existing file lives in a sidecar
+  // next to it; missing or stale sidecars simply regenerate.
+  llvm::SmallString<128> hashPath(OutputFilename);
+  hashPath += ".apihash";
+  std::string key = computeTBDKey(M, hasMultipleIGMs, installName);
+  if (llvm::sys::fs::exists(OutputFilename)) {
+    auto previousKey = llvm::MemoryBuffer::getFile(hashPath);
+    if (previousKey && (*previousKey)->getBuffer() == key)
+      return false;
+  }
+
   std::error_code EC;
   llvm::raw_fd_ostream OS(OutputFilename, EC, llvm::sys::fs::F_None);
   if (EC) {
@@ -50,6 +89,10 @@ bool swift::writeTBD(ModuleDecl *M, bool hasMultipleIGMs,
 
   writeTBDFile(M, OS, hasMultipleIGMs, installName);
 
+  llvm::raw_fd_ostream HashOS(hashPath, EC, llvm::sys::fs::F_None);
+  if (!EC)
+    HashOS << key;
+
   return false;
 }
 
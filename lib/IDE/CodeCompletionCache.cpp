@@ -14,6 +14,7 @@
 #include "swift/Basic/Cache.h"
 #include "llvm/ADT/APInt.h"
 #include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -39,7 +40,8 @@ namespace swift {
     struct CacheValueCostInfo<swift::ide::CodeCompletionCacheImpl::Value> {
       static size_t
       getCost(const swift::ide::CodeCompletionCacheImpl::Value &V) {
-        return V.Sink.Allocator->getTotalMemory();
+        return V.Sink.Allocator->getTotalMemory() +
+               (V.SourceBuffer ? V.SourceBuffer->getBufferSize() : 0);
       }
     };
   } // namespace sys
@@ -100,13 +102,8 @@ CodeCompletionCache::~CodeCompletionCache() {}
 ///
 /// This should be incremented any time we commit a change to the format of the
 /// cached results. This isn't expected to change very often.
-static constexpr uint32_t onDiskCompletionCacheVersion = 1;
-
-static StringRef copyString(llvm::BumpPtrAllocator &Allocator, StringRef Str) {
-  char *Mem = Allocator.Allocate<char>(Str.size());
-  std::copy(Str.begin(), Str.end(), Mem);
-  return StringRef(Mem, Str.size());
-}
+static constexpr uint32_t onDiskCompletionCacheVersion =
+    2; // Added the deduplicated, mmap-referenced string table.
 
 static ArrayRef<StringRef> copyStringArray(llvm::BumpPtrAllocator &Allocator,
                                            ArrayRef<StringRef> Arr) {
@@ -125,8 +122,13 @@ static ArrayRef<std::pair<StringRef, StringRef>> copyStringPairArray(
 }
 
 /// Deserializes CodeCompletionResults from \p in and stores them in \p V.
+///
+/// On success, \p V takes ownership of \p in, because the results' strings
+/// point directly into the (usually memory-mapped) buffer rather than being
+/// copied onto the heap.
+///
 /// \see writeCacheModule.
-static bool readCachedModule(llvm::MemoryBuffer *in,
+static bool readCachedModule(std::unique_ptr<llvm::MemoryBuffer> in,
                              const CodeCompletionCache::Key &K,
                              CodeCompletionCache::Value &V,
                              bool allowOutOfDate = false) {
@@ -180,7 +182,8 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 
     const char *p = strings + index;
     auto size = read32le(p);
-    return copyString(*V.Sink.Allocator, StringRef(p, size));
+    // Point directly into the buffer; V keeps it alive.
+    return StringRef(p, size);
   };
 
   // CHUNKS
@@ -215,32 +218,24 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
     auto context = static_cast<SemanticContextKind>(*cursor++);
     auto notRecommended = static_cast<bool>(*cursor++);
     auto numBytesToErase = static_cast<unsigned>(*cursor++);
-    auto oldCursor = cursor;
     auto chunkIndex = read32le(cursor);
-    auto IntLength = cursor - oldCursor;
     auto moduleIndex = read32le(cursor);
     auto briefDocIndex = read32le(cursor);
-    auto assocUSRCount = read32le(cursor);
-    auto assocUSRsIndex = read32le(cursor);
-    auto declKeywordCount = read32le(cursor);
-    auto declKeywordIndex = read32le(cursor);
 
     CodeCompletionString *string = getCompletionString(chunkIndex);
     auto moduleName = getString(moduleIndex);
     auto briefDocComment = getString(briefDocIndex);
+
+    auto assocUSRCount = read32le(cursor);
     SmallVector<StringRef, 4> assocUSRs;
-    for (unsigned i = 0; i < assocUSRCount; ++i) {
-      auto usr = getString(assocUSRsIndex);
-      assocUSRs.push_back(usr);
-      assocUSRsIndex += usr.size() + IntLength;
-    }
+    for (unsigned i = 0; i < assocUSRCount; ++i)
+      assocUSRs.push_back(getString(read32le(cursor)));
 
+    auto declKeywordCount = read32le(cursor);
     SmallVector<std::pair<StringRef, StringRef>, 4> declKeywords;
     for (unsigned i = 0; i < declKeywordCount; ++i) {
-      auto first = getString(declKeywordIndex);
-      declKeywordIndex += first.size() + IntLength;
-      auto second = getString(declKeywordIndex);
-      declKeywordIndex += second.size() + IntLength;
+      auto first = getString(read32le(cursor));
+      auto second = getString(read32le(cursor));
       declKeywords.push_back(std::make_pair(first, second));
     }
 
@@ -260,6 +255,8 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
     V.Sink.Results.push_back(result);
   }
 
+  // The results reference strings in the buffer; keep it alive with them.
+  V.SourceBuffer = std::move(in);
   return true;
 }
 
@@ -275,8 +272,9 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 ///     * the original CodeCompletionCache::Key, used for debugging the cache.
 ///
 ///   RESULTS
-///     * A length-prefixed array of fixed size CodeCompletionResults.
-///     * Contains offsets into CHUNKS and STRINGS.
+///     * A length-prefixed array of flat CodeCompletionResult records.
+///     * Contains offsets into CHUNKS and STRINGS; strings are always
+///       referenced by offset, never stored inline.
 ///
 ///   CHUNKS
 ///     * A length-prefixed array of CodeCompletionStrings.
@@ -285,6 +283,12 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 ///
 ///   STRINGS
 ///     * A blob of length-prefixed strings referred to in CHUNKS or RESULTS.
+///     * Each distinct string is stored once; repeated references (module
+///       names, punctuation chunks, and the like) share one entry.
+///
+/// The format is designed so a reader can leave all variable-size data in
+/// place: deserialized results point into the (memory-mapped) file for their
+/// string contents instead of copying them out.
 static void writeCachedModule(llvm::raw_ostream &out,
                               const CodeCompletionCache::Key &K,
                               CodeCompletionCache::Value &V) {
@@ -325,14 +329,19 @@ static void writeCachedModule(llvm::raw_ostream &out,
   std::string strings_;
   llvm::raw_string_ostream strings(strings_);
 
-  auto addString = [&strings](StringRef str) {
+  llvm::StringMap<uint32_t> knownStrings;
+  auto addString = [&](StringRef str) -> uint32_t {
     if (str.empty())
       return ~0u;
-    auto size = strings.tell();
+    auto known = knownStrings.find(str);
+    if (known != knownStrings.end())
+      return known->second;
+    auto index = static_cast<uint32_t>(strings.tell());
     endian::Writer<little> LE(strings);
     LE.write(static_cast<uint32_t>(str.size()));
     strings << str;
-    return static_cast<uint32_t>(size);
+    knownStrings[str] = index;
+    return index;
   };
 
   auto addCompletionString = [&](const CodeCompletionString *str) {
@@ -373,25 +382,13 @@ static void writeCachedModule(llvm::raw_ostream &out,
       LE.write(addString(R->getModuleName()));      // index into strings
       LE.write(addString(R->getBriefDocComment())); // index into strings
       LE.write(static_cast<uint32_t>(R->getAssociatedUSRs().size()));
-      if (R->getAssociatedUSRs().empty()) {
-        LE.write(static_cast<uint32_t>(~0u));
-      } else {
-        LE.write(addString(R->getAssociatedUSRs()[0]));
-        for (unsigned i = 1; i < R->getAssociatedUSRs().size(); ++i) {
-          addString(R->getAssociatedUSRs()[i]); // ignore result
-        }
-      }
+      for (StringRef USR : R->getAssociatedUSRs())
+        LE.write(addString(USR));
       auto AllKeywords = R->getDeclKeywords();
       LE.write(static_cast<uint32_t>(AllKeywords.size()));
-      if (AllKeywords.empty()) {
-        LE.write(static_cast<uint32_t>(~0u));
-      } else {
-        LE.write(addString(AllKeywords[0].first));
-        addString(AllKeywords[0].second);
-        for (unsigned i = 1; i < AllKeywords.size(); ++i) {
-          addString(AllKeywords[i].first);
-          addString(AllKeywords[i].second);
-        }
+      for (auto &keyword : AllKeywords) {
+        LE.write(addString(keyword.first));
+        LE.write(addString(keyword.second));
       }
     }
   }
@@ -439,14 +436,17 @@ static std::string getName(StringRef cacheDirectory,
 
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::get(const Key &K) {
-  // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K));
+  // Try to map the cached file. We never rely on a null terminator, which
+  // lets the whole file be mapped rather than read into the heap.
+  auto bufferOrErr =
+      llvm::MemoryBuffer::getFile(getName(cacheDirectory, K), /*FileSize*/ -1,
+                                  /*RequiresNullTerminator*/ false);
   if (!bufferOrErr)
     return None;
 
   // Read the cached results, failing if they are out of date.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V))
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V))
     return None;
 
   return V;
@@ -481,8 +481,10 @@ std::error_code OnDiskCodeCompletionCache::set(const Key &K, ValueRefCntPtr V) {
 
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
-  // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename);
+  // Try to map the cached file.
+  auto bufferOrErr =
+      llvm::MemoryBuffer::getFile(filename, /*FileSize*/ -1,
+                                  /*RequiresNullTerminator*/ false);
   if (!bufferOrErr)
     return None;
 
@@ -491,7 +493,7 @@ OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
 
   // Read the cached results.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V,
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V,
                         /*allowOutOfDate*/ true))
     return None;
 
@@ -494,36 +494,16 @@ class FormatWalker : public SourceEntityWalker {
     TokenIt TI;
     bool NeedExtraIndentation;
 
-    class SourceLocIterator
-        : public std::iterator<std::input_iterator_tag, SourceLoc>
-    {
-      TokenIt It;
-    public:
-      SourceLocIterator(TokenIt It) :It(It) {}
-      SourceLocIterator(const SourceLocIterator& mit) : It(mit.It) {}
-      SourceLocIterator& operator++() {++It; return *this;}
-      SourceLocIterator operator++(int) {
-        SourceLocIterator tmp(*this);
-        operator++();
-        return tmp;
-      }
-      bool operator==(const SourceLocIterator& rhs) {return It==rhs.It;}
-      bool operator!=(const SourceLocIterator& rhs) {return It!=rhs.It;}
-      SourceLoc operator*() {return It->getLoc();}
-    };
-
     void adjustTokenIteratorToImmediateAfter(SourceLoc End) {
-      SourceLocIterator LocBegin(Tokens.begin());
-      SourceLocIterator LocEnd(Tokens.end());
-      auto Lower = std::lower_bound(LocBegin, LocEnd, End,
-                                    [&](SourceLoc L, SourceLoc R) {
-                                      return SM.isBeforeInBuffer(L, R);
-                                    });
-      if (*Lower == End) {
-        Lower ++;
+      // Tokens are contiguous and sorted by location, so binary search them
+      // directly; this runs for every sibling candidate the walker visits.
+      TI = std::lower_bound(Tokens.begin(), Tokens.end(), End,
+                            [&](const Token &T, SourceLoc L) {
+                              return SM.isBeforeInBuffer(T.getLoc(), L);
+                            });
+      if (TI != Tokens.end() && TI->getLoc() == End) {
+        TI ++;
       }
-      TI = Tokens.begin();
-      std::advance(TI, std::distance(LocBegin, Lower));
     }
 
     bool isImmediateAfterSeparator(SourceLoc End, tok Separator) {
@@ -831,8 +831,9 @@ void ClangCommentPrinter::printDeclPost(const Decl *D,
   if (isa<ParamDecl>(D))
     return;
 
+  llvm::SmallString<256> SanitizedText;
   for (auto CommentText : PendingComments) {
-    *this << " " << ASTPrinter::sanitizeUtf8(CommentText);
+    *this << " " << ASTPrinter::sanitizeUtf8(CommentText, SanitizedText);
   }
   PendingComments.clear();
   if (auto ClangN = getEffectiveClangNode(D))
@@ -922,8 +923,9 @@ void ClangCommentPrinter::printComment(StringRef RawText, unsigned StartCol) {
   SmallVector<StringRef, 8> Lines;
   trimLeadingWhitespaceFromLines(RawText, WhitespaceToTrim, Lines);
 
+  llvm::SmallString<256> SanitizedLine;
   for (auto Line : Lines) {
-    *this << ASTPrinter::sanitizeUtf8(Line) << "\n";
+    *this << ASTPrinter::sanitizeUtf8(Line, SanitizedLine) << "\n";
     printIndent();
   }
 }
@@ -21,6 +21,7 @@
 #include "swift/Basic/SourceManager.h"
 #include "swift/Parse/DelayedParsingCallbacks.h"
 #include "swift/Parse/Parser.h"
+#include "swift/Parse/TokenStreamCache.h"
 #include "swift/IDE/CodeCompletion.h"
 #include "swift/Subsystems.h"
 #include "llvm/Support/raw_ostream.h"
@@ -247,7 +248,8 @@ void REPLCompletions::populate(SourceFile &SF, StringRef EnteredCode) {
                    CompletionCallbacksFactory.get());
 
   ASTContext &Ctx = SF.getASTContext();
-  std::vector<Token> Tokens = tokenize(Ctx.LangOpts, Ctx.SourceMgr, BufferID);
+  std::vector<Token> Tokens = TokenStreamCache::getGlobalCache().getTokens(
+      Ctx.LangOpts, Ctx.SourceMgr, BufferID, /*KeepComments=*/true);
 
   if (!Tokens.empty() && Tokens.back().is(tok::code_complete))
     Tokens.pop_back();
@@ -272,7 +272,7 @@ public:
 
 private:
   static bool findUrlStartingLoc(StringRef Text, unsigned &Start,
-                                 std::regex& Regex);
+                                 const std::regex *&Regex);
   bool annotateIfConfigConditionIdentifiers(Expr *Cond);
   bool handleAttrs(const DeclAttributes &Attrs);
   bool handleAttrs(const TypeAttributes &Attrs);
@@ -1223,7 +1223,7 @@ bool ModelASTWalker::processComment(CharSourceRange Range) {
 
 bool ModelASTWalker::findUrlStartingLoc(StringRef Text,
                                         unsigned &Start,
-                                        std::regex &Regex) {
+                                        const std::regex *&Regex) {
 #ifdef SWIFT_HAVE_WORKING_STD_REGEX
   static const auto MailToPosition = std::find(URLProtocols.begin(),
                                                URLProtocols.end(),
@@ -1242,7 +1242,7 @@ bool ModelASTWalker::findUrlStartingLoc(StringRef Text,
   if (HasSlash) {
     for (auto It = URLProtocols.begin(); It < URLProtocols.end(); ++ It) {
       if (Lookback(Index, *It)) {
-        Regex = getURLRegex(*It);
+        Regex = &getURLRegex(*It);
         Start = Index - It->size();
         return true;
       }
@@ -1250,7 +1250,7 @@ bool ModelASTWalker::findUrlStartingLoc(StringRef Text,
   } else {
     for (auto It = MailToPosition; It < URLProtocols.end(); ++ It) {
       if (Lookback(Index, *It)) {
-        Regex = getURLRegex(*It);
+        Regex = &getURLRegex(*It);
         Start = Index - It->size();
         return true;
       }
@@ -1290,11 +1290,13 @@ bool ModelASTWalker::searchForURL(CharSourceRange Range) {
   StringRef Text = OrigText;
   while (1) {
     std::match_results<StringRef::iterator> Matches;
-    std::regex Regex;
+    // Point at one of the static precompiled regexes; copying a std::regex
+    // recompiles it, and this runs for every comment on every editor pass.
+    const std::regex *Regex = nullptr;
     unsigned Start;
     if (findUrlStartingLoc(Text, Start, Regex) &&
         std::regex_search(Text.substr(Start).begin(),
-                          Text.substr(Start).end(), Matches, Regex)) {
+                          Text.substr(Start).end(), Matches, *Regex)) {
       auto &RxMatch = Matches[0];
       StringRef Match(RxMatch.first, RxMatch.second - RxMatch.first);
       SourceLoc Loc = OrigLoc.getAdvancedLoc(Match.data() - OrigText.data());
@@ -891,6 +891,12 @@ void IRGenerator::emitGlobalTopLevel() {
 
     CurrentIGMPtr IGM = getGenModule(&f);
     IGM->emitSILFunction(&f);
+
+    // Once a function is lowered to LLVM IR its SIL body is never read
+    // again; free it so the peak memory of IRGen doesn't include all of
+    // the optimized SIL. References to the function only need its
+    // declaration, which stays valid.
+    f.clearBody();
   }
 
   // Emit static initializers.
@@ -931,14 +937,21 @@ void IRGenModule::finishEmitAfterTopLevel() {
 
 static void emitLazyTypeMetadata(IRGenModule &IGM, NominalTypeDecl *Nominal) {
   if (auto sd = dyn_cast<StructDecl>(Nominal)) {
-    return emitStructMetadata(IGM, sd);
+    emitStructMetadata(IGM, sd);
   } else if (auto ed = dyn_cast<EnumDecl>(Nominal)) {
     emitEnumMetadata(IGM, ed);
   } else if (auto pd = dyn_cast<ProtocolDecl>(Nominal)) {
     IGM.emitProtocolDecl(pd);
+    return;
   } else {
     llvm_unreachable("should not have enqueued a class decl here!");
   }
+
+  // The field metadata record was deferred together with the metadata. Now
+  // that the metadata is known to be used, emit the record so that the type
+  // stays visible to reflection.
+  if (!IGM.shouldEmitOpaqueTypeMetadataRecord(Nominal))
+    IGM.emitFieldMetadataRecord(Nominal);
 }
 
 void IRGenerator::emitProtocolConformances() {
@@ -988,6 +1001,10 @@ void IRGenerator::emitLazyDefinitions() {
       assert(!f->isPossiblyUsedExternally()
              && "function with externally-visible linkage emitted lazily?");
       IGM->emitSILFunction(f);
+
+      // As in emitGlobalTopLevel, the SIL body is dead once the function
+      // has been lowered; release it eagerly.
+      f->clearBody();
     }
   }
 }
@@ -3933,16 +3933,21 @@ namespace {
       }
     }
 
+    /// The number of payload cases which need nontrivial copy/destroy work.
+    unsigned numNontrivialPayloads() const {
+      return std::count_if(ElementsWithPayload.begin(),
+                           ElementsWithPayload.end(),
+                           [](Element e) -> bool {
+                             return !e.ti->isPOD(ResilienceExpansion::Maximal);
+                           });
+    }
+
     void forNontrivialPayloads(IRGenFunction &IGF, llvm::Value *tag,
                std::function<void (unsigned, EnumImplStrategy::Element)> f)
     const {
       auto *endBB = llvm::BasicBlock::Create(IGF.IGM.getLLVMContext());
 
-      unsigned numNontrivialPayloads
-        = std::count_if(ElementsWithPayload.begin(), ElementsWithPayload.end(),
-                     [](Element e) -> bool {
-                       return !e.ti->isPOD(ResilienceExpansion::Maximal);
-                     });
+      unsigned numNontrivialPayloads = this->numNontrivialPayloads();
 
       bool anyTrivial = !ElementsWithNoPayload.empty()
         || numNontrivialPayloads != ElementsWithPayload.size();
@@ -4029,6 +4034,28 @@ namespace {
 
       case BitwiseTakable:
       case Normal: {
+        // If only a single payload case needs nontrivial work, emit it
+        // inline: a tag compare plus the payload copy is barely larger than
+        // the call to the outlined copy function, and it doesn't act as an
+        // optimization barrier in element-wise loops.
+        if (numNontrivialPayloads() == 1) {
+          auto parts = destructureAndTagLoadableEnum(IGF, src);
+          forNontrivialPayloads(IGF, parts.tag,
+            [&](unsigned tagIndex, EnumImplStrategy::Element elt) {
+              auto &lti = cast<LoadableTypeInfo>(*elt.ti);
+              Explosion value;
+              projectPayloadValue(IGF, parts.payload, tagIndex, lti, value);
+
+              Explosion tmp;
+              lti.copy(IGF, value, tmp, atomicity);
+              (void)tmp.claimAll(); // FIXME: repack if not bit-identical
+            });
+          parts.payload.explode(IGF.IGM, dest);
+          if (parts.extraTagBits)
+            dest.add(parts.extraTagBits);
+          return;
+        }
+
         assert(copyEnumFunction && "Did not create copy function for enum");
         Explosion tmp;
         fillExplosionForOutlinedCall(IGF, src, tmp);
@@ -4070,6 +4097,21 @@ namespace {
 
       case BitwiseTakable:
       case Normal: {
+        // As in copy(), inline the work if only a single payload case is
+        // nontrivial.
+        if (numNontrivialPayloads() == 1) {
+          auto parts = destructureAndTagLoadableEnum(IGF, src);
+          forNontrivialPayloads(IGF, parts.tag,
+            [&](unsigned tagIndex, EnumImplStrategy::Element elt) {
+              auto &lti = cast<LoadableTypeInfo>(*elt.ti);
+              Explosion value;
+              projectPayloadValue(IGF, parts.payload, tagIndex, lti, value);
+
+              lti.consume(IGF, value, atomicity);
+            });
+          return;
+        }
+
         assert(consumeEnumFunction &&
                "Did not create consume function for enum");
         Explosion tmp;
@@ -5921,7 +5963,10 @@ MultiPayloadEnumImplStrategy::completeFixedLayout(TypeConverter &TC,
   getFixedEnumTypeInfo(enumTy, Size(sizeWithTag), std::move(spareBits),
                        worstAlignment, isPOD, isBT);
   if (TIK >= Loadable &&
-      (CopyDestroyKind == Normal || CopyDestroyKind == BitwiseTakable)) {
+      (CopyDestroyKind == Normal || CopyDestroyKind == BitwiseTakable) &&
+      numNontrivialPayloads() != 1) {
+    // With a single nontrivial payload case, copy() and consume() emit the
+    // work inline and the outlined functions would be dead.
     computePayloadTypesAndTagType(TC.IGM, *TI, PayloadTypesAndTagType);
     copyEnumFunction = emitCopyEnumFunction(TC.IGM, theEnum);
     consumeEnumFunction = emitConsumeEnumFunction(TC.IGM, theEnum);
@@ -6064,7 +6109,11 @@ void IRGenModule::emitEnumDecl(EnumDecl *theEnum) {
     return;
   }
 
-  emitFieldMetadataRecord(theEnum);
+  // If the metadata is emitted lazily, the field metadata record is only
+  // needed if the metadata is actually used, and is emitted together with
+  // the metadata in that case (see emitLazyTypeMetadata).
+  if (!IRGen.hasLazyMetadata(theEnum))
+    emitFieldMetadataRecord(theEnum);
 }
 
 void irgen::emitSwitchAddressOnlyEnumDispatch(IRGenFunction &IGF,
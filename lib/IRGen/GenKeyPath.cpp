@@ -1042,12 +1042,14 @@ IRGenModule::getAddrOfKeyPathPattern(KeyPathPattern *pattern,
                          llvm::ConstantInt::get(Int32Ty, header.getData()));
   
   // Create the global variable.
-  // TODO: The pattern could be immutable if
-  // it isn't instantiable in place, and if we made the type metadata accessor
-  // references private, it could go in true-const memory.
+  // A pattern which is instantiated in place is mutated at runtime: the
+  // instantiated key path object is built into the pattern's memory. Other
+  // patterns are only ever read by the runtime, so they can go in true-const
+  // memory. The type metadata accessor references are private functions, so
+  // they don't prevent this.
   auto patternVar = fields.finishAndCreateGlobal("keypath",
                                           getPointerAlignment(),
-                                          /*constant*/ false,
+                                          /*constant*/ !isInstantiableInPlace,
                                           llvm::GlobalVariable::PrivateLinkage);
   KeyPathPatterns.insert({pattern, patternVar});
   return patternVar;
@@ -1182,12 +1182,84 @@ static llvm::Value *emitGenericMetadataAccessFunction(IRGenFunction &IGF,
   llvm::Value *arguments =
     IGF.Builder.CreateBitCast(argsBuffer.getAddress(), IGF.IGM.Int8PtrTy);
 
-  // Make the call.
-  auto result = IGF.Builder.CreateCall(IGF.IGM.getGetGenericMetadataFn(),
+  llvm::Value *result;
+  if (IGF.IGM.IRGen.Opts.EnableGenericMetadataInlineCaches &&
+      !genericArgs.Values.empty()) {
+    // Give the accessor a single-entry inline cache. The runtime publishes
+    // an immutable { metadata, arguments... } entry into the slot on the
+    // first instantiation, so in the steady state where this accessor keeps
+    // being asked for the same instantiation we skip the runtime's global
+    // metadata cache entirely.
+    auto inlineCache = new llvm::GlobalVariable(
+        IGF.IGM.Module, IGF.IGM.Int8PtrTy, /*constant*/ false,
+        llvm::GlobalValue::PrivateLinkage,
+        llvm::Constant::getNullValue(IGF.IGM.Int8PtrTy),
+        Twine(IGF.CurFn->getName()) + ".inline_cache");
+    inlineCache->setAlignment(IGF.IGM.getPointerAlignment().getValue());
+
+    auto checkBB = IGF.createBasicBlock("inline-cache-check");
+    auto hitBB = IGF.createBasicBlock("inline-cache-hit");
+    auto missBB = IGF.createBasicBlock("inline-cache-miss");
+    auto contBB = IGF.createBasicBlock("cont");
+
+    // Everything we read through the entry pointer is behind an address
+    // dependency on this load, so like the lazy cache load above we can get
+    // away without an explicit barrier; the runtime publishes the entry with
+    // a release store.
+    auto load = IGF.Builder.CreateLoad(
+        Address(inlineCache, IGF.IGM.getPointerAlignment()));
+    if (IGF.IGM.IRGen.Opts.Sanitizers & SanitizerKind::Thread)
+      load->setOrdering(llvm::AtomicOrdering::Acquire);
+    IGF.Builder.CreateCondBr(
+        IGF.Builder.CreateICmpEQ(
+            load, llvm::Constant::getNullValue(IGF.IGM.Int8PtrTy)),
+        missBB, checkBB);
+
+    // Compare the cached key arguments with ours.
+    IGF.Builder.emitBlock(checkBB);
+    auto entry = IGF.Builder.CreateBitCast(load, IGF.IGM.Int8PtrPtrTy);
+    Address entryAddr(entry, IGF.IGM.getPointerAlignment());
+    llvm::Value *isHit = nullptr;
+    for (unsigned i = 0, e = genericArgs.Values.size(); i != e; ++i) {
+      Address cachedArgAddr = IGF.Builder.CreateConstArrayGEP(
+          entryAddr, i + 1, IGF.IGM.getPointerSize());
+      auto cachedArg = IGF.Builder.CreateLoad(cachedArgAddr);
+      auto isSame = IGF.Builder.CreateICmpEQ(
+          cachedArg, IGF.Builder.CreateBitCast(genericArgs.Values[i],
+                                               IGF.IGM.Int8PtrTy));
+      isHit = isHit ? IGF.Builder.CreateAnd(isHit, isSame) : isSame;
+    }
+    IGF.Builder.CreateCondBr(isHit, hitBB, missBB);
+
+    // Use the cached metadata, which is the first word of the entry.
+    IGF.Builder.emitBlock(hitBB);
+    auto cachedMetadata = IGF.Builder.CreateLoad(entryAddr);
+    auto hitResult = IGF.Builder.CreateBitCast(cachedMetadata,
+                                               IGF.IGM.TypeMetadataPtrTy);
+    IGF.Builder.CreateBr(contBB);
+
+    // Fall back to the runtime, which also fills the inline cache once.
+    IGF.Builder.emitBlock(missBB);
+    auto call =
+        IGF.Builder.CreateCall(IGF.IGM.getGetGenericMetadataCachedFn(),
+                               {metadata, arguments, inlineCache});
+    call->setDoesNotThrow();
+    IGF.Builder.CreateBr(contBB);
+
+    IGF.Builder.emitBlock(contBB);
+    auto phi = IGF.Builder.CreatePHI(IGF.IGM.TypeMetadataPtrTy, 2);
+    phi->addIncoming(hitResult, hitBB);
+    phi->addIncoming(call, missBB);
+    result = phi;
+  } else {
+    // Make the call.
+    auto call = IGF.Builder.CreateCall(IGF.IGM.getGetGenericMetadataFn(),
                                        {metadata, arguments});
-  result->setDoesNotThrow();
-  result->addAttribute(llvm::AttributeList::FunctionIndex,
+    call->setDoesNotThrow();
+    call->addAttribute(llvm::AttributeList::FunctionIndex,
                        llvm::Attribute::ReadOnly);
+    result = call;
+  }
 
   IGF.Builder.CreateLifetimeEnd(argsBuffer,
                           IGF.IGM.getPointerSize() * genericArgs.Values.size());
@@ -851,7 +851,11 @@ void IRGenModule::emitStructDecl(StructDecl *st) {
     return;
   }
 
-  emitFieldMetadataRecord(st);
+  // If the metadata is emitted lazily, the field metadata record is only
+  // needed if the metadata is actually used, and is emitted together with
+  // the metadata in that case (see emitLazyTypeMetadata).
+  if (!IRGen.hasLazyMetadata(st))
+    emitFieldMetadataRecord(st);
 }
 
 namespace {
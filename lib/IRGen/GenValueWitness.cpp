@@ -688,25 +688,71 @@ static llvm::Constant *getNoOpVoidFunction(IRGenModule &IGM) {
   });
 }
 
+/// True if shared value witness functions exist for single retainable
+/// pointers with the given reference-counting style. The shared functions
+/// are keyed purely by the reference layout, so all types with the same
+/// style fold into one witness per module.
+static bool hasSharedStrongFunctions(ReferenceCounting style) {
+  switch (style) {
+  case ReferenceCounting::Native:
+  case ReferenceCounting::Unknown:
+    return true;
+  case ReferenceCounting::ObjC:
+  case ReferenceCounting::Block:
+  case ReferenceCounting::Bridge:
+  case ReferenceCounting::Error:
+    // The remaining styles are rare enough that a shared implementation
+    // isn't worthwhile; they use the standard per-type witness.
+    return false;
+  }
+  llvm_unreachable("bad reference-counting style");
+}
+
+/// Mangle the reference-counting style into the name of a shared strong
+/// value witness function.
+static void appendStrongSuffix(llvm::raw_svector_ostream &nameStream,
+                               ReferenceCounting style) {
+  switch (style) {
+  case ReferenceCounting::Native:
+    nameStream << "_strong";
+    return;
+  case ReferenceCounting::Unknown:
+    nameStream << "_strong_unknown";
+    return;
+  case ReferenceCounting::ObjC:
+  case ReferenceCounting::Block:
+  case ReferenceCounting::Bridge:
+  case ReferenceCounting::Error:
+    llvm_unreachable("no shared strong functions for this style");
+  }
+  llvm_unreachable("bad reference-counting style");
+}
+
 /// Return a function which takes three pointer arguments and does a
 /// retaining assignWithCopy on the first two: it loads a pointer from
 /// the second, retains it, loads a pointer from the first, stores the
 /// new pointer in the first, and releases the old pointer.
-static llvm::Constant *getAssignWithCopyStrongFunction(IRGenModule &IGM) {
-  llvm::Type *ptrPtrTy = IGM.RefCountedPtrTy->getPointerTo();
+static llvm::Constant *getAssignWithCopyStrongFunction(IRGenModule &IGM,
+                                                       ReferenceCounting style) {
+  llvm::Type *ptrPtrTy = IGM.getReferenceType(style)->getPointerTo();
   llvm::Type *argTys[] = { ptrPtrTy, ptrPtrTy, IGM.WitnessTablePtrTy };
-  return IGM.getOrCreateHelperFunction("__swift_assignWithCopy_strong",
-                                       ptrPtrTy, argTys,
+  llvm::SmallString<40> name;
+  {
+    llvm::raw_svector_ostream nameStream(name);
+    nameStream << "__swift_assignWithCopy";
+    appendStrongSuffix(nameStream, style);
+  }
+  return IGM.getOrCreateHelperFunction(name, ptrPtrTy, argTys,
                                        [&](IRGenFunction &IGF) {
     auto it = IGF.CurFn->arg_begin();
     Address dest(&*(it++), IGM.getPointerAlignment());
     Address src(&*(it++), IGM.getPointerAlignment());
 
     llvm::Value *newValue = IGF.Builder.CreateLoad(src, "new");
-    IGF.emitNativeStrongRetain(newValue, IGF.getDefaultAtomicity());
+    IGF.emitStrongRetain(newValue, style, IGF.getDefaultAtomicity());
     llvm::Value *oldValue = IGF.Builder.CreateLoad(dest, "old");
     IGF.Builder.CreateStore(newValue, dest);
-    IGF.emitNativeStrongRelease(oldValue, IGF.getDefaultAtomicity());
+    IGF.emitStrongRelease(oldValue, style, IGF.getDefaultAtomicity());
 
     IGF.Builder.CreateRet(dest.getAddress());
   });
@@ -716,11 +762,17 @@ static llvm::Constant *getAssignWithCopyStrongFunction(IRGenModule &IGM) {
 /// retaining assignWithTake on the first two: it loads a pointer from
 /// the second, retains it, loads a pointer from the first, stores the
 /// new pointer in the first, and releases the old pointer.
-static llvm::Constant *getAssignWithTakeStrongFunction(IRGenModule &IGM) {
-  llvm::Type *ptrPtrTy = IGM.RefCountedPtrTy->getPointerTo();
+static llvm::Constant *getAssignWithTakeStrongFunction(IRGenModule &IGM,
+                                                       ReferenceCounting style) {
+  llvm::Type *ptrPtrTy = IGM.getReferenceType(style)->getPointerTo();
   llvm::Type *argTys[] = { ptrPtrTy, ptrPtrTy, IGM.WitnessTablePtrTy };
-  return IGM.getOrCreateHelperFunction("__swift_assignWithTake_strong",
-                                       ptrPtrTy, argTys,
+  llvm::SmallString<40> name;
+  {
+    llvm::raw_svector_ostream nameStream(name);
+    nameStream << "__swift_assignWithTake";
+    appendStrongSuffix(nameStream, style);
+  }
+  return IGM.getOrCreateHelperFunction(name, ptrPtrTy, argTys,
                                        [&](IRGenFunction &IGF) {
     auto it = IGF.CurFn->arg_begin();
     Address dest(&*(it++), IGM.getPointerAlignment());
@@ -729,7 +781,7 @@ static llvm::Constant *getAssignWithTakeStrongFunction(IRGenModule &IGM) {
     llvm::Value *newValue = IGF.Builder.CreateLoad(src, "new");
     llvm::Value *oldValue = IGF.Builder.CreateLoad(dest, "old");
     IGF.Builder.CreateStore(newValue, dest);
-    IGF.emitNativeStrongRelease(oldValue, IGF.getDefaultAtomicity());
+    IGF.emitStrongRelease(oldValue, style, IGF.getDefaultAtomicity());
 
     IGF.Builder.CreateRet(dest.getAddress());
   });
@@ -738,18 +790,24 @@ static llvm::Constant *getAssignWithTakeStrongFunction(IRGenModule &IGM) {
 /// Return a function which takes three pointer arguments and does a
 /// retaining initWithCopy on the first two: it loads a pointer from
 /// the second, retains it, and stores that in the first.
-static llvm::Constant *getInitWithCopyStrongFunction(IRGenModule &IGM) {
-  llvm::Type *ptrPtrTy = IGM.RefCountedPtrTy->getPointerTo();
+static llvm::Constant *getInitWithCopyStrongFunction(IRGenModule &IGM,
+                                                     ReferenceCounting style) {
+  llvm::Type *ptrPtrTy = IGM.getReferenceType(style)->getPointerTo();
   llvm::Type *argTys[] = { ptrPtrTy, ptrPtrTy, IGM.WitnessTablePtrTy };
-  return IGM.getOrCreateHelperFunction("__swift_initWithCopy_strong",
-                                       ptrPtrTy, argTys,
+  llvm::SmallString<40> name;
+  {
+    llvm::raw_svector_ostream nameStream(name);
+    nameStream << "__swift_initWithCopy";
+    appendStrongSuffix(nameStream, style);
+  }
+  return IGM.getOrCreateHelperFunction(name, ptrPtrTy, argTys,
                                        [&](IRGenFunction &IGF) {
     auto it = IGF.CurFn->arg_begin();
     Address dest(&*(it++), IGM.getPointerAlignment());
     Address src(&*(it++), IGM.getPointerAlignment());
 
     llvm::Value *newValue = IGF.Builder.CreateLoad(src, "new");
-    IGF.emitNativeStrongRetain(newValue, IGF.getDefaultAtomicity());
+    IGF.emitStrongRetain(newValue, style, IGF.getDefaultAtomicity());
     IGF.Builder.CreateStore(newValue, dest);
 
     IGF.Builder.CreateRet(dest.getAddress());
@@ -757,14 +815,22 @@ static llvm::Constant *getInitWithCopyStrongFunction(IRGenModule &IGM) {
 }
 
 /// Return a function which takes two pointer arguments, loads a
-/// pointer from the first, and calls swift_release on it immediately.
-static llvm::Constant *getDestroyStrongFunction(IRGenModule &IGM) {
-  llvm::Type *argTys[] = { IGM.Int8PtrPtrTy, IGM.WitnessTablePtrTy };
-  return IGM.getOrCreateHelperFunction("__swift_destroy_strong",
-                                       IGM.VoidTy, argTys,
+/// pointer from the first, and releases it immediately.
+static llvm::Constant *getDestroyStrongFunction(IRGenModule &IGM,
+                                                ReferenceCounting style) {
+  llvm::Type *ptrPtrTy = IGM.getReferenceType(style)->getPointerTo();
+  llvm::Type *argTys[] = { ptrPtrTy, IGM.WitnessTablePtrTy };
+  llvm::SmallString<40> name;
+  {
+    llvm::raw_svector_ostream nameStream(name);
+    nameStream << "__swift_destroy";
+    appendStrongSuffix(nameStream, style);
+  }
+  return IGM.getOrCreateHelperFunction(name, IGM.VoidTy, argTys,
                                        [&](IRGenFunction &IGF) {
     Address arg(&*IGF.CurFn->arg_begin(), IGM.getPointerAlignment());
-    IGF.emitNativeStrongRelease(IGF.Builder.CreateLoad(arg), IGF.getDefaultAtomicity());
+    IGF.emitStrongRelease(IGF.Builder.CreateLoad(arg), style,
+                          IGF.getDefaultAtomicity());
     IGF.Builder.CreateRetVoid();
   });
 }
@@ -848,13 +914,22 @@ static void addValueWitness(IRGenModule &IGM,
     B.addBitCast(fn, IGM.Int8PtrTy);
   };
 
+  // Copy and destroy witnesses for a single retainable pointer depend only
+  // on the reference layout, so all such types can share one witness per
+  // reference-counting style.
+  ReferenceCounting refcounting;
+  bool isStrongPointer =
+    concreteTI.isSingleRetainablePointer(ResilienceExpansion::Maximal,
+                                         &refcounting) &&
+    hasSharedStrongFunctions(refcounting);
+
   // Try to use a standard function.
   switch (index) {
   case ValueWitness::Destroy:
     if (concreteTI.isPOD(ResilienceExpansion::Maximal)) {
       return addFunction(getNoOpVoidFunction(IGM));
-    } else if (concreteTI.isSingleSwiftRetainablePointer(ResilienceExpansion::Maximal)) {
-      return addFunction(getDestroyStrongFunction(IGM));
+    } else if (isStrongPointer) {
+      return addFunction(getDestroyStrongFunction(IGM, refcounting));
     }
     goto standard;
 
@@ -862,8 +937,8 @@ static void addValueWitness(IRGenModule &IGM,
     if (packing == FixedPacking::OffsetZero) {
       if (concreteTI.isPOD(ResilienceExpansion::Maximal)) {
         return addFunction(getMemCpyFunction(IGM, concreteTI));
-      } else if (concreteTI.isSingleSwiftRetainablePointer(ResilienceExpansion::Maximal)) {
-        return addFunction(getInitWithCopyStrongFunction(IGM));
+      } else if (isStrongPointer) {
+        return addFunction(getInitWithCopyStrongFunction(IGM, refcounting));
       }
     }
     goto standard;
@@ -888,24 +963,24 @@ static void addValueWitness(IRGenModule &IGM,
   case ValueWitness::AssignWithCopy:
     if (concreteTI.isPOD(ResilienceExpansion::Maximal)) {
       return addFunction(getMemCpyFunction(IGM, concreteTI));
-    } else if (concreteTI.isSingleSwiftRetainablePointer(ResilienceExpansion::Maximal)) {
-      return addFunction(getAssignWithCopyStrongFunction(IGM));
+    } else if (isStrongPointer) {
+      return addFunction(getAssignWithCopyStrongFunction(IGM, refcounting));
     }
     goto standard;
 
   case ValueWitness::AssignWithTake:
     if (concreteTI.isPOD(ResilienceExpansion::Maximal)) {
       return addFunction(getMemCpyFunction(IGM, concreteTI));
-    } else if (concreteTI.isSingleSwiftRetainablePointer(ResilienceExpansion::Maximal)) {
-      return addFunction(getAssignWithTakeStrongFunction(IGM));
+    } else if (isStrongPointer) {
+      return addFunction(getAssignWithTakeStrongFunction(IGM, refcounting));
     }
     goto standard;
 
   case ValueWitness::InitializeWithCopy:
     if (concreteTI.isPOD(ResilienceExpansion::Maximal)) {
       return addFunction(getMemCpyFunction(IGM, concreteTI));
-    } else if (concreteTI.isSingleSwiftRetainablePointer(ResilienceExpansion::Maximal)) {
-      return addFunction(getInitWithCopyStrongFunction(IGM));
+    } else if (isStrongPointer) {
+      return addFunction(getInitWithCopyStrongFunction(IGM, refcounting));
     }
     goto standard;
 
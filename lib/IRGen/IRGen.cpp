@@ -52,6 +52,7 @@
 #include "llvm/Linker/Linker.h"
 #include "llvm/MC/SubtargetFeature.h"
 #include "llvm/Object/ObjectFile.h"
+#include "llvm/PassRegistry.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -1036,6 +1037,17 @@ static void performParallelIRGeneration(IRGenOptions &Opts,
   // Bail out if there are any errors.
   if (Ctx.hadError()) return;
 
+  // Pre-register the Swift LLVM passes on this thread. Every backend thread
+  // builds its own pipeline, and the lazy registration in the createXXXPass
+  // functions would otherwise race to take the PassRegistry write lock
+  // during the first pipeline constructions.
+  auto &Registry = *llvm::PassRegistry::getPassRegistry();
+  llvm::initializeSwiftAAWrapperPassPass(Registry);
+  llvm::initializeSwiftRCIdentityPass(Registry);
+  llvm::initializeSwiftARCOptPass(Registry);
+  llvm::initializeSwiftARCContractPass(Registry);
+  llvm::initializeSwiftMergeFunctionsPass(Registry);
+
   SharedTimer timer("LLVM pipeline");
 
   std::vector<std::thread> Threads;
@@ -1427,21 +1427,22 @@ private:
 
     llvm::DIType *DITy = createType(DbgTy, MangledName, Scope, getFile(Scope));
 
-    // Incrementally build the DIRefMap.
-    if (auto *CTy = dyn_cast<llvm::DICompositeType>(DITy)) {
+    // Incrementally build the DIRefMap. TypeBase*'s are not unique, so
+    // this lets all types with the same mangled name share one DIType,
+    // no matter through which sugared type they were reached.
+    if (UID) {
 #ifndef NDEBUG
       // Sanity check.
       if (llvm::Metadata *V = DIRefMap.lookup(UID)) {
         auto *CachedTy = cast<llvm::DIType>(V);
         assert(CachedTy == DITy && "conflicting types for one UID");
       }
+      if (auto *CTy = dyn_cast<llvm::DICompositeType>(DITy))
+        if (auto *Identifier = CTy->getRawIdentifier())
+          assert(Identifier->getString() == MangledName &&
+                 "Unique identifier is different from mangled name ");
 #endif
-      // If this type supports a UID, enter it to the cache.
-      if (auto UID = CTy->getRawIdentifier()) {
-        assert(UID->getString() == MangledName &&
-               "Unique identifier is different from mangled name ");
-        DIRefMap[UID] = llvm::TrackingMDNodeRef(DITy);
-      }
+      DIRefMap[UID] = llvm::TrackingMDNodeRef(DITy);
     }
 
     // Store it in the cache.
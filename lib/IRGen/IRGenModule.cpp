@@ -1201,22 +1201,43 @@ IRGenModule *IRGenerator::getGenModule(DeclContext *ctxt) {
   return IGM;
 }
 
+/// Return an estimate for the cost of generating backend code for \p f,
+/// measured in SIL instructions.
+static uint64_t getEstimatedFunctionCost(SILFunction *f) {
+  uint64_t Cost = 0;
+  for (SILBasicBlock &BB : *f) {
+    Cost += std::distance(BB.begin(), BB.end());
+  }
+  return Cost;
+}
+
 IRGenModule *IRGenerator::getGenModule(SILFunction *f) {
   if (GenModules.size() == 1) {
     return getPrimaryIGM();
   }
 
+  IRGenModule *IGM = nullptr;
   if (DeclContext *ctxt = f->getDeclContext()) {
     if (SourceFile *SF = ctxt->getParentSourceFile()) {
-      IRGenModule *IGM = GenModules[SF];
+      IGM = GenModules[SF];
       assert(IGM);
-      return IGM;
     }
   }
-  // We have no source file for the function.
-  // Let's use the IGM from which the function is referenced the first time.
-  if (IRGenModule *IGM = DefaultIGMForFunction[f])
-    return IGM;
-
-  return getPrimaryIGM();
+  if (!IGM) {
+    // We have no source file for the function, so we are free to emit it into
+    // any LLVM module. Pick the module with the smallest amount of work
+    // assigned so far, to balance the time spent in the LLVM backend across
+    // the compilation threads.
+    IRGenModule *&assignedIGM = DefaultIGMForFunction[f];
+    if (!assignedIGM) {
+      assignedIGM = Queue[0];
+      for (IRGenModule *candidate : Queue) {
+        if (EstimatedIGMCosts[candidate] < EstimatedIGMCosts[assignedIGM])
+          assignedIGM = candidate;
+      }
+    }
+    IGM = assignedIGM;
+  }
+  EstimatedIGMCosts[IGM] += getEstimatedFunctionCost(f);
+  return IGM;
 }
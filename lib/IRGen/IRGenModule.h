@@ -177,10 +177,16 @@ public:
 private:
   llvm::DenseMap<SourceFile *, IRGenModule *> GenModules;
   
-  // Stores the IGM from which a function is referenced the first time.
-  // It is used if a function has no source-file association.
+  // Stores the IGM to which a function without a source-file association
+  // has been assigned, so that repeated queries return the same IGM.
   llvm::DenseMap<SILFunction *, IRGenModule *> DefaultIGMForFunction;
-  
+
+  // The estimated cost of the functions assigned to each IGM so far,
+  // measured in SIL instructions. Used to balance functions which have no
+  // source-file association across the LLVM modules, so that the time spent
+  // in the LLVM backend is distributed across the compilation threads.
+  llvm::DenseMap<IRGenModule *, uint64_t> EstimatedIGMCosts;
+
   // The IGM of the first source file.
   IRGenModule *PrimaryIGM = nullptr;
 
@@ -256,8 +262,9 @@ public:
 
   /// Get an IRGenModule for a function.
   /// Returns the IRGenModule of the containing source file, or if this cannot
-  /// be determined, returns the IGM from which the function is referenced the
-  /// first time.
+  /// be determined, the IGM with the least amount of estimated work assigned
+  /// so far. Also accounts the function's estimated cost to the returned IGM,
+  /// so this should only be called when the function is actually emitted.
   IRGenModule *getGenModule(SILFunction *f);
 
   /// Returns the primary IRGenModule. This is the first added IRGenModule.
@@ -303,6 +310,11 @@ public:
   /// If yes, \p Nominal is added to eligibleLazyMetadata and true is returned.
   bool tryEnableLazyTypeMetadata(NominalTypeDecl *Nominal);
 
+  /// Returns true if the metadata of \p Nominal is emitted lazily.
+  bool hasLazyMetadata(NominalTypeDecl *Nominal) const {
+    return eligibleLazyMetadata.count(Nominal) != 0;
+  }
+
   /// Emit everything which is reachable from already emitted IR.
   void emitLazyDefinitions();
   
@@ -310,7 +322,6 @@ public:
     // Add it to the queue if it hasn't already been put there.
     if (LazilyEmittedFunctions.insert(f).second) {
       LazyFunctionDefinitions.push_back(f);
-      DefaultIGMForFunction[f] = CurrentIGM;
     }
   }
   
@@ -26,6 +26,7 @@
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallBitVector.h"
 #include "llvm/ADT/TinyPtrVector.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Debug.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/Basic/TargetInfo.h"
@@ -141,7 +142,11 @@ public:
   Kind kind;
   
 private:
-  using ExplosionVector = SmallVector<llvm::Value *, 4>;
+  /// The value lists of multi-element explosions are never changed after the
+  /// LoweredValue is created. They are allocated in an arena owned by the
+  /// IRGenSILFunction, so that neither creating nor moving a LoweredValue
+  /// needs a heap allocation.
+  using ExplosionVector = ArrayRef<llvm::Value *>;
   using SingletonExplosion = llvm::Value*;
 
   using Members = ExternalUnionMembers<ContainedAddress,
@@ -216,7 +221,7 @@ public:
     Storage.emplace<ObjCMethod>(kind, std::move(objcMethod));
   }
 
-  LoweredValue(Explosion &e) {
+  LoweredValue(Explosion &e, llvm::BumpPtrAllocator &allocator) {
     auto elts = e.claimAll();
     if (elts.empty()) {
       kind = Kind::EmptyExplosion;
@@ -225,8 +230,10 @@ public:
       Storage.emplace<SingletonExplosion>(kind, elts.front());
     } else {
       kind = Kind::ExplosionVector;
-      auto &explosion = Storage.emplace<ExplosionVector>(kind);
-      explosion.append(elts.begin(), elts.end());
+      auto **values = allocator.Allocate<llvm::Value *>(elts.size());
+      std::uninitialized_copy(elts.begin(), elts.end(), values);
+      Storage.emplace<ExplosionVector>(kind,
+                                       llvm::makeArrayRef(values, elts.size()));
     }
   }
 
@@ -352,6 +359,10 @@ public:
   llvm::DenseMap<SILValue, LoweredValue> LoweredValues;
   llvm::DenseMap<SILType, LoweredValue> LoweredUndefs;
 
+  /// Holds the value lists of multi-element explosions in LoweredValues and
+  /// LoweredUndefs. It lives as long as the function is being emitted.
+  llvm::BumpPtrAllocator LoweredValueAllocator;
+
   /// All alloc_ref instructions which allocate the object on the stack.
   llvm::SmallPtrSet<SILInstruction *, 8> StackAllocs;
 
@@ -441,7 +452,7 @@ public:
   /// Create a new Explosion corresponding to the given SIL value.
   void setLoweredExplosion(SILValue v, Explosion &e) {
     assert(v->getType().isObject() && "explosion for address value?!");
-    setLoweredValue(v, LoweredValue(e));
+    setLoweredValue(v, LoweredValue(e, LoweredValueAllocator));
   }
 
   void setLoweredBox(SILValue v, const OwnedAddress &box) {
@@ -507,7 +518,7 @@ public:
                && "non-scalar element in loadable type schema?!");
         e.add(llvm::UndefValue::get(elt.getScalarType()));
       }
-      LoweredUndefs.insert({t, LoweredValue(e)});
+      LoweredUndefs.insert({t, LoweredValue(e, LoweredValueAllocator)});
       break;
     }
     }
@@ -5252,6 +5263,13 @@ void IRGenModule::emitSILStaticInitializers() {
       continue;
     }
 
+    // The address identity of a statically initialized 'let' is not
+    // observable, so duplicates with identical content can be folded into a
+    // single global by the ConstantMerge pass. Mark local symbols
+    // accordingly; public symbols have to keep their identity.
+    if (Global.isLet() && IRGlobal->hasLocalLinkage())
+      IRGlobal->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+
     // Set the IR global's initializer to the constant for this SIL
     // struct.
     if (auto *SI = dyn_cast<StructInst>(InitValue)) {
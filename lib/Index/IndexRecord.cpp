@@ -21,6 +21,7 @@
 #include "swift/AST/Types.h"
 #include "swift/AST/DiagnosticsFrontend.h"
 #include "swift/AST/ModuleLoader.h"
+#include "swift/Basic/StringExtras.h"
 #include "swift/ClangImporter/ClangModule.h"
 #include "swift/Index/Index.h"
 #include "swift/Strings.h"
@@ -31,6 +32,7 @@
 #include "clang/Index/IndexUnitWriter.h"
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace swift;
 using namespace swift::index;
@@ -108,9 +110,12 @@ public:
     auto pair = USRToSymbol.insert(std::make_pair(indexSym.USR.data(),
                                                   symbols.size()));
     if (pair.second) {
-      Symbol symbol{indexSym.name,
-                    indexSym.USR,
-                    indexSym.group,
+      // Copy the strings; the AST walk that feeds the tracker keeps them in
+      // walker-local scratch space, and record writing may be deferred until
+      // after the walk has finished (see indexAndRecord for a module).
+      Symbol symbol{stringStorage.copyString(indexSym.name),
+                    stringStorage.copyString(indexSym.USR),
+                    stringStorage.copyString(indexSym.group),
                     indexSym.symInfo,
                     0};
       recordHash = llvm::hash_combine(recordHash, symbol.hash());
@@ -143,6 +148,7 @@ private:
   llvm::DenseMap<const char *, size_t> USRToSymbol;
   std::vector<Symbol> symbols;
   std::vector<SymbolOccurrence> occurrences;
+  swift::StringScratchSpace stringStorage;
   bool sorted = false;
   llvm::hash_code recordHash = 0;
 };
@@ -271,8 +277,15 @@ StringRef StdlibGroupsIndexRecordingConsumer::findGroupForSymbol(const IndexSymb
   llvm_unreachable("did not find group name for reference");
 }
 
+/// Writes the record file for \p record, or reuses an existing one if a
+/// record with the same content hash is already in the store.
+///
+/// Does not emit diagnostics so that it may run on a worker thread; on
+/// failure the caller is responsible for reporting \p error.
+///
+/// \returns true if an error occurred.
 static bool writeRecord(SymbolTracker &record, std::string Filename,
-                        std::string indexStorePath, DiagnosticEngine *diags,
+                        std::string indexStorePath, std::string &error,
                         std::string &outRecordFile) {
   if (record.getOccurrences().empty()) {
     outRecordFile = std::string();
@@ -280,12 +293,10 @@ static bool writeRecord(SymbolTracker &record, std::string Filename,
   }
 
   IndexRecordWriter recordWriter(indexStorePath);
-  std::string error;
   auto result = recordWriter.beginRecord(
       Filename, record.hashRecord(), error, &outRecordFile);
   switch (result) {
   case IndexRecordWriter::Result::Failure:
-    diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
     return true;
   case IndexRecordWriter::Result::AlreadyExists:
     return false;
@@ -316,10 +327,8 @@ static bool writeRecord(SymbolTracker &record, std::string Filename,
     return result;
   });
 
-  if (result == IndexRecordWriter::Result::Failure) {
-    diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
+  if (result == IndexRecordWriter::Result::Failure)
     return true;
-  }
 
   return false;
 }
@@ -330,8 +339,11 @@ makeRecordingConsumer(std::string Filename, std::string indexStorePath,
                       std::string *outRecordFile,
                       bool *outFailed) {
   return llvm::make_unique<IndexRecordingConsumer>([=](SymbolTracker &record) {
-    *outFailed = writeRecord(record, Filename, indexStorePath, diags,
+    std::string error;
+    *outFailed = writeRecord(record, Filename, indexStorePath, error,
                              *outRecordFile);
+    if (*outFailed)
+      diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
   });
 }
 
@@ -531,10 +543,14 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
       SmallString<256> fileNameWithGroup = filename;
       appendGroupNameForFilename(groupName, fileNameWithGroup);
 
+      std::string recordError;
       std::string outRecordFile;
-      failed = failed || writeRecord(tracker, fileNameWithGroup.str(), indexStorePath, &diags, outRecordFile);
-      if (failed)
+      failed = failed || writeRecord(tracker, fileNameWithGroup.str(),
+                                     indexStorePath, recordError, outRecordFile);
+      if (failed) {
+        diags.diagnose(SourceLoc(), diag::error_write_index_record, recordError);
         return false;
+      }
       records.emplace_back(outRecordFile, moduleName.str());
       return true;
     });
@@ -583,13 +599,18 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
   return false;
 }
 
+/// Writes the unit file for \p primarySourceFile, referencing \p recordFile
+/// if one was produced for it. Unlike record writing this walks the
+/// imported-module ASTs and the shared FileManager, so it must stay on the
+/// main thread.
 static bool
-recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
-                     StringRef indexStorePath, bool indexSystemModules,
-                     bool isDebugCompilation, StringRef targetTriple,
-                     ArrayRef<const clang::FileEntry *> fileDependencies,
-                     const clang::CompilerInstance &clangCI,
-                     DiagnosticEngine &diags) {
+writeUnitForSourceFile(SourceFile *primarySourceFile, StringRef indexUnitToken,
+                       StringRef recordFile,
+                       StringRef indexStorePath, bool indexSystemModules,
+                       bool isDebugCompilation, StringRef targetTriple,
+                       ArrayRef<const clang::FileEntry *> fileDependencies,
+                       const clang::CompilerInstance &clangCI,
+                       DiagnosticEngine &diags) {
   auto &fileMgr = clangCI.getFileManager();
   auto *module = primarySourceFile->getParentModule();
   bool isSystem = module->isSystemModule();
@@ -614,11 +635,9 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
   for (auto *F : fileDependencies)
     unitWriter.addFileDependency(F, /*FIXME:isSystem=*/false, /*Module=*/nullptr);
 
-  recordSourceFile(primarySourceFile, indexStorePath, diags,
-                   [&](StringRef recordFile, StringRef filename) {
-    unitWriter.addRecordFile(recordFile, fileMgr.getFile(filename),
+  if (!recordFile.empty())
+    unitWriter.addRecordFile(recordFile, mainFile,
                              module->isSystemModule(), /*Module=*/nullptr);
-  });
 
   std::string error;
   if (unitWriter.write(error)) {
@@ -629,6 +648,22 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
   return false;
 }
 
+static bool
+recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
+                     StringRef indexStorePath, bool indexSystemModules,
+                     bool isDebugCompilation, StringRef targetTriple,
+                     ArrayRef<const clang::FileEntry *> fileDependencies,
+                     const clang::CompilerInstance &clangCI,
+                     DiagnosticEngine &diags) {
+  std::string recordFile;
+  recordSourceFile(primarySourceFile, indexStorePath, diags,
+                   [&](StringRef RF, StringRef) { recordFile = RF; });
+  return writeUnitForSourceFile(primarySourceFile, indexUnitToken, recordFile,
+                                indexStorePath, indexSystemModules,
+                                isDebugCompilation, targetTriple,
+                                fileDependencies, clangCI, diags);
+}
+
 // Not currently used, see related comments in the call sites.
 #if 0
 static void
@@ -722,6 +757,16 @@ bool index::indexAndRecord(ModuleDecl *module,
 #endif
 
   // Write a unit for each source file.
+  struct UnitState {
+    SourceFile *SF;
+    StringRef unitToken;
+    std::unique_ptr<SymbolTracker> tracker;
+    std::string recordFile;
+    std::string error;
+    bool failed;
+  };
+  std::vector<UnitState> units;
+
   unsigned unitIndex = 0;
   for (auto *F : module->getFiles()) {
     if (auto *SF = dyn_cast<SourceFile>(F)) {
@@ -729,14 +774,53 @@ bool index::indexAndRecord(ModuleDecl *module,
         diags.diagnose(SourceLoc(), diag::error_index_inputs_more_than_outputs);
         return true;
       }
-      if (recordSourceFileUnit(SF, indexUnitTokens[unitIndex],
+      units.push_back({SF, indexUnitTokens[unitIndex], nullptr,
+                       std::string(), std::string(), false});
+      unitIndex += 1;
+    }
+  }
+
+  // Gather the index data for each file serially; the AST walk type-checks
+  // lazily and emits diagnostics, neither of which is thread-safe. The
+  // trackers own copies of their strings, so they stay valid after the walk.
+  for (auto &unit : units) {
+    IndexRecordingConsumer consumer([&unit](SymbolTracker &record) {
+      unit.tracker = llvm::make_unique<SymbolTracker>(std::move(record));
+    });
+    indexSourceFile(unit.SF, /*Hash=*/"", consumer);
+  }
+
+  // Write the record files, in parallel when there is more than one; each
+  // task touches only its own tracker, and the record writer names files by
+  // content hash and creates them atomically, so concurrent writers never
+  // collide. Diagnostics are deferred to the serial loop below.
+  auto writeRecordForUnit = [&indexStorePath](UnitState &unit) {
+    unit.failed = writeRecord(*unit.tracker, unit.SF->getFilename(),
+                              indexStorePath, unit.error, unit.recordFile);
+  };
+  if (units.size() > 1) {
+    llvm::ThreadPool Pool;
+    for (auto &unit : units)
+      Pool.async([&writeRecordForUnit, &unit] { writeRecordForUnit(unit); });
+    Pool.wait();
+  } else {
+    for (auto &unit : units)
+      writeRecordForUnit(unit);
+  }
+
+  // Write the unit files serially; this walks the imported-module ASTs and
+  // the shared FileManager. A unit whose record failed is still written
+  // without one, matching the single-file path.
+  for (auto &unit : units) {
+    if (unit.failed)
+      diags.diagnose(SourceLoc(), diag::error_write_index_record, unit.error);
+    if (writeUnitForSourceFile(unit.SF, unit.unitToken,
+                               unit.failed ? StringRef() : unit.recordFile,
                                indexStorePath, indexSystemModules,
                                isDebugCompilation, targetTriple,
                                fileDependencies.getArrayRef(),
                                clangCI, diags))
-        return true;
-      unitIndex += 1;
-    }
+      return true;
   }
 
   // In the case where inputs are swift modules, like in the merge-module step,
@@ -0,0 +1,116 @@
+//===--- IncrementalLexing.cpp - Relexing of edited buffers ---------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Parse/IncrementalLexing.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Parse/Lexer.h"
+#include "swift/Subsystems.h"
+#include "llvm/ADT/DenseMap.h"
+
+using namespace swift;
+
+/// Return a copy of \p Tok with its text re-pointed into \p NewBuffer at
+/// \p NewOffset, preserving all flags.
+static Token shiftToken(const Token &Tok, StringRef NewBuffer,
+                        unsigned NewOffset) {
+  Token New;
+  New.setToken(Tok.getKind(),
+               StringRef(NewBuffer.data() + NewOffset,
+                         Tok.getRawText().size()),
+               Tok.getCommentLength(), Tok.IsMultilineString());
+  New.setAtStartOfLine(Tok.isAtStartOfLine());
+  if (Tok.isEscapedIdentifier())
+    New.setEscapedIdentifier(true);
+  return New;
+}
+
+std::vector<Token> swift::relexTokensAfterEdit(const LangOptions &LangOpts,
+                                               const SourceManager &SM,
+                                               unsigned NewBufferID,
+                                               ArrayRef<Token> OldTokens,
+                                               StringRef OldBufferText,
+                                               SourceEdit Edit,
+                                               bool KeepComments) {
+  StringRef NewBuffer = SM.getEntireTextForBuffer(NewBufferID);
+  const char *OldStart = OldBufferText.data();
+  int Delta = int(Edit.InsertedLength) - int(Edit.RemovedLength);
+  unsigned OldEditEnd = Edit.Offset + Edit.RemovedLength;
+  unsigned NewEditEnd = Edit.Offset + Edit.InsertedLength;
+
+  auto oldOffsetOf = [&](const Token &T) -> unsigned {
+    return T.getRawText().data() - OldStart;
+  };
+
+  // Reuse the tokens that end strictly before the edit.  A token abutting
+  // the edit may merge with inserted text (e.g. appending to an
+  // identifier), so it is not reusable.
+  std::vector<Token> Result;
+  size_t PrefixEnd = 0;
+  while (PrefixEnd < OldTokens.size()) {
+    const Token &T = OldTokens[PrefixEnd];
+    if (oldOffsetOf(T) + T.getRawText().size() >= Edit.Offset)
+      break;
+    Result.push_back(shiftToken(T, NewBuffer, oldOffsetOf(T)));
+    ++PrefixEnd;
+  }
+
+  // Relexing restarts at the end of the last reusable token, so the trivia
+  // (whitespace and comments) leading into the first affected token is
+  // lexed again and comment attachment stays correct.
+  unsigned RelexStart = 0;
+  if (!Result.empty()) {
+    const Token &Last = Result.back();
+    RelexStart = (Last.getRawText().data() - NewBuffer.data()) +
+                 Last.getRawText().size();
+  }
+
+  // Index the starts of old tokens that lie entirely after the edit; these
+  // are the candidate resynchronization points, keyed by their position in
+  // the new buffer.
+  llvm::DenseMap<unsigned, size_t> SuffixStarts;
+  for (size_t i = PrefixEnd, e = OldTokens.size(); i != e; ++i) {
+    unsigned Off = oldOffsetOf(OldTokens[i]);
+    if (Off >= OldEditEnd)
+      SuffixStarts[unsigned(Off + Delta)] = i;
+  }
+
+  Lexer L(LangOpts, SM, NewBufferID, /*Diags=*/nullptr, /*InSILMode=*/false,
+          KeepComments ? CommentRetentionMode::ReturnAsTokens
+                       : CommentRetentionMode::AttachToNextToken,
+          TriviaRetentionMode::WithoutTrivia, RelexStart, NewBuffer.size());
+
+  Token Tok;
+  while (true) {
+    L.lex(Tok);
+    if (Tok.is(tok::eof))
+      break;
+
+    unsigned Off = Tok.getRawText().data() - NewBuffer.data();
+    if (Off >= NewEditEnd) {
+      auto It = SuffixStarts.find(Off);
+      if (It != SuffixStarts.end()) {
+        // The relexer reached an old token boundary beyond the edit.
+        // Lexing is stateless across token boundaries, so everything from
+        // here on matches the old stream; reuse it shifted by the edit
+        // delta.  Keep the freshly lexed token rather than the old one:
+        // its preceding comment may have been part of the edited region.
+        Result.push_back(Tok);
+        for (size_t i = It->second + 1, e = OldTokens.size(); i != e; ++i)
+          Result.push_back(shiftToken(OldTokens[i], NewBuffer,
+                                      oldOffsetOf(OldTokens[i]) + Delta));
+        return Result;
+      }
+    }
+    Result.push_back(Tok);
+  }
+  return Result;
+}
@@ -166,6 +166,169 @@ uint32_t swift::validateUTF8CharacterAndAdvance(const char *&Ptr,
   return EncodedBytes == 4 ? CharValue : ~0U;
 }
 
+//===----------------------------------------------------------------------===//
+// Vectorized scanning fast paths
+//===----------------------------------------------------------------------===//
+//
+// The per-character switch in lexImpl and friends is fine for typical source,
+// but machine-generated files are dominated by long runs of "boring" bytes:
+// ASCII identifier characters, horizontal whitespace, and comment bodies.
+// These helpers consume such runs a vector register at a time, leaving the
+// existing byte-at-a-time code to handle the interesting characters (UTF-8
+// sequences, nul, newlines, delimiters) exactly as before.
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SWIFT_LEXER_USE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SWIFT_LEXER_USE_NEON 1
+#endif
+
+#if SWIFT_LEXER_USE_NEON
+/// Return true if any lane of the given byte vector is non-zero.
+static bool anyLaneSet(uint8x16_t V) {
+  uint64x2_t V64 = vreinterpretq_u64_u8(V);
+  return (vgetq_lane_u64(V64, 0) | vgetq_lane_u64(V64, 1)) != 0;
+}
+#endif
+
+/// Advance \p Ptr over a run of ASCII identifier-continuation characters
+/// ([A-Za-z0-9_$]) using vector compares where available.  Stops at (or
+/// before) the first byte outside that set; never reads past \p End.
+static const char *advanceOverASCIIIdentifier(const char *Ptr,
+                                              const char *End) {
+#if SWIFT_LEXER_USE_SSE2
+  while (Ptr + 16 <= End) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    // Letters, case-folded: fold to lowercase and range check 'a'..'z'.
+    __m128i Folded = _mm_or_si128(Chunk, _mm_set1_epi8(0x20));
+    __m128i IsAlpha =
+        _mm_and_si128(_mm_cmpgt_epi8(Folded, _mm_set1_epi8('a' - 1)),
+                      _mm_cmplt_epi8(Folded, _mm_set1_epi8('z' + 1)));
+    __m128i IsDigit =
+        _mm_and_si128(_mm_cmpgt_epi8(Chunk, _mm_set1_epi8('0' - 1)),
+                      _mm_cmplt_epi8(Chunk, _mm_set1_epi8('9' + 1)));
+    __m128i IsOther =
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('_')),
+                     _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('$')));
+    __m128i IsIdent = _mm_or_si128(_mm_or_si128(IsAlpha, IsDigit), IsOther);
+    // High (non-ASCII) bytes compare as negative above; they must terminate
+    // the fast path so the slow path can validate them.  _mm_cmpgt_epi8 on a
+    // negative byte is already false for the alpha/digit checks, so IsIdent
+    // is correctly zero for them.
+    unsigned Mask = _mm_movemask_epi8(IsIdent);
+    if (Mask != 0xFFFF)
+      return Ptr + llvm::countTrailingOnes(Mask);
+    Ptr += 16;
+  }
+#elif SWIFT_LEXER_USE_NEON
+  while (Ptr + 16 <= End) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t Folded = vorrq_u8(Chunk, vdupq_n_u8(0x20));
+    uint8x16_t IsAlpha =
+        vandq_u8(vcgeq_u8(Folded, vdupq_n_u8('a')),
+                 vcleq_u8(Folded, vdupq_n_u8('z')));
+    uint8x16_t IsDigit =
+        vandq_u8(vcgeq_u8(Chunk, vdupq_n_u8('0')),
+                 vcleq_u8(Chunk, vdupq_n_u8('9')));
+    uint8x16_t IsOther = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('_')),
+                                  vceqq_u8(Chunk, vdupq_n_u8('$')));
+    // Unsigned compares treat non-ASCII bytes as >= 0x80; exclude them
+    // explicitly so UTF-8 sequences hit the validating slow path.
+    uint8x16_t IsASCII = vcltq_u8(Chunk, vdupq_n_u8(0x80));
+    uint8x16_t IsIdent =
+        vandq_u8(vorrq_u8(vorrq_u8(IsAlpha, IsDigit), IsOther), IsASCII);
+    if (anyLaneSet(vmvnq_u8(IsIdent)))
+      break;
+    Ptr += 16;
+  }
+#endif
+  // Scalar tail (and full scan on other targets).
+  while (Ptr < End && clang::isIdentifierBody(*Ptr, /*dollar*/true) &&
+         !((signed char)*Ptr < 0))
+    ++Ptr;
+  return Ptr;
+}
+
+/// Advance \p Ptr over a run of bytes that are uninteresting inside a
+/// comment body: everything except CR, LF, nul, non-ASCII bytes, and the
+/// bytes in \p Stop1/\p Stop2 (use 0x80 for "none"; it can never match an
+/// ASCII lane).  Used to skip // and /**/ comment bodies in bulk.
+static const char *advanceOverCommentBody(const char *Ptr, const char *End,
+                                          char Stop1, char Stop2) {
+#if SWIFT_LEXER_USE_SSE2
+  while (Ptr + 16 <= End) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    __m128i IsSpecial =
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\n')),
+                     _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\r')));
+    IsSpecial = _mm_or_si128(IsSpecial,
+                             _mm_cmpeq_epi8(Chunk, _mm_setzero_si128()));
+    IsSpecial = _mm_or_si128(IsSpecial,
+                             _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(Stop1)));
+    IsSpecial = _mm_or_si128(IsSpecial,
+                             _mm_cmpeq_epi8(Chunk, _mm_set1_epi8(Stop2)));
+    // Non-ASCII bytes are negative in a signed compare.
+    IsSpecial = _mm_or_si128(IsSpecial,
+                             _mm_cmplt_epi8(Chunk, _mm_setzero_si128()));
+    unsigned Mask = _mm_movemask_epi8(IsSpecial);
+    if (Mask != 0)
+      return Ptr + llvm::countTrailingZeros(Mask);
+    Ptr += 16;
+  }
+#elif SWIFT_LEXER_USE_NEON
+  while (Ptr + 16 <= End) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t IsSpecial = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8('\n')),
+                                    vceqq_u8(Chunk, vdupq_n_u8('\r')));
+    IsSpecial = vorrq_u8(IsSpecial, vceqq_u8(Chunk, vdupq_n_u8(0)));
+    IsSpecial = vorrq_u8(IsSpecial, vceqq_u8(Chunk, vdupq_n_u8(Stop1)));
+    IsSpecial = vorrq_u8(IsSpecial, vceqq_u8(Chunk, vdupq_n_u8(Stop2)));
+    IsSpecial = vorrq_u8(IsSpecial, vcgeq_u8(Chunk, vdupq_n_u8(0x80)));
+    if (anyLaneSet(IsSpecial))
+      break;
+    Ptr += 16;
+  }
+#endif
+  while (Ptr < End) {
+    char C = *Ptr;
+    if (C == '\n' || C == '\r' || C == 0 || C == Stop1 || C == Stop2 ||
+        (signed char)C < 0)
+      break;
+    ++Ptr;
+  }
+  return Ptr;
+}
+
+/// Advance \p Ptr over a run of spaces and horizontal tabs.
+static const char *advanceOverHorizontalWhitespace(const char *Ptr,
+                                                   const char *End) {
+#if SWIFT_LEXER_USE_SSE2
+  while (Ptr + 16 <= End) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ptr));
+    __m128i IsWS = _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(' ')),
+                                _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\t')));
+    unsigned Mask = _mm_movemask_epi8(IsWS);
+    if (Mask != 0xFFFF)
+      return Ptr + llvm::countTrailingOnes(Mask);
+    Ptr += 16;
+  }
+#elif SWIFT_LEXER_USE_NEON
+  while (Ptr + 16 <= End) {
+    uint8x16_t Chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(Ptr));
+    uint8x16_t IsWS = vorrq_u8(vceqq_u8(Chunk, vdupq_n_u8(' ')),
+                               vceqq_u8(Chunk, vdupq_n_u8('\t')));
+    if (anyLaneSet(vmvnq_u8(IsWS)))
+      break;
+    Ptr += 16;
+  }
+#endif
+  while (Ptr < End && (*Ptr == ' ' || *Ptr == '\t'))
+    ++Ptr;
+  return Ptr;
+}
+
 //===----------------------------------------------------------------------===//
 // Setup and Helper Methods
 //===----------------------------------------------------------------------===//
@@ -330,6 +493,8 @@ static void diagnoseEmbeddedNul(DiagnosticEngine *Diags, const char *Ptr) {
 
 void Lexer::skipToEndOfLine(bool EatNewline) {
   while (1) {
+    // Skip over uninteresting comment bytes in bulk.
+    CurPtr = advanceOverCommentBody(CurPtr, BufferEnd, char(0x80), char(0x80));
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -385,8 +550,10 @@ void Lexer::skipSlashStarComment() {
   
   // /**/ comments can be nested, keep track of how deep we've gone.
   unsigned Depth = 1;
-  
+
   while (1) {
+    // Skip over uninteresting comment bytes in bulk.
+    CurPtr = advanceOverCommentBody(CurPtr, BufferEnd, '*', '/');
     switch (*CurPtr++) {
     case '*':
       // Check for a '*/'
@@ -599,6 +766,9 @@ void Lexer::lexIdentifier() {
   (void) didStart;
 
   // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
+  // Consume runs of plain ASCII identifier characters in bulk, falling back
+  // to the per-code-point path for UTF-8 sequences.
+  CurPtr = advanceOverASCIIIdentifier(CurPtr, BufferEnd);
   while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart), InSILMode);
@@ -2150,6 +2320,9 @@ Restart:
 
   case ' ':
   case '\t':
+    // Skip runs of spaces and tabs in bulk.
+    CurPtr = advanceOverHorizontalWhitespace(CurPtr, BufferEnd);
+    goto Restart;
   case '\f':
   case '\v':
     goto Restart;  // Skip whitespace.
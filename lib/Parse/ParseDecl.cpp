@@ -257,10 +257,13 @@ bool Parser::parseTopLevel() {
     }
   }
 
-  // Add newly parsed decls to the module.
+  // Add newly parsed decls to the module, fingerprinting each one so that
+  // incremental builds can tell which declarations actually changed.
   for (auto Item : Items)
-    if (auto *D = Item.dyn_cast<Decl*>())
+    if (auto *D = Item.dyn_cast<Decl*>()) {
       SF.Decls.push_back(D);
+      recordDeclFingerprint(D);
+    }
 
   // Note that the source file is fully parsed and verify it.
   SF.ASTStage = SourceFile::Parsed;
@@ -280,6 +283,16 @@ bool Parser::parseTopLevel() {
   return FoundTopLevelCodeToExecute;
 }
 
+void Parser::recordDeclFingerprint(Decl *D) {
+  auto range = D->getSourceRange();
+  if (range.isInvalid())
+    return;
+
+  auto charRange = Lexer::getCharSourceRangeFromSourceRange(SourceMgr, range);
+  Context.recordDeclFingerprint(
+      D, llvm::hash_value(SourceMgr.extractText(charRange)));
+}
+
 static Optional<StringRef>
 getStringLiteralIfNotInterpolated(Parser &P, SourceLoc Loc, const Token &Tok,
                                   StringRef DiagText) {
@@ -2039,8 +2039,8 @@ ParserResult<Expr> Parser::parseExprStringLiteral() {
     return makeParserResult(Status, new (Context) ErrorExpr(Loc));
   }
 
-  return makeParserResult(Status, new (Context) InterpolatedStringLiteralExpr(
-                                      Loc, Context.AllocateCopy(Exprs)));
+  return makeParserResult(Status, InterpolatedStringLiteralExpr::create(
+                                      Context, Loc, Exprs));
 }
 
 void Parser::parseOptionalArgumentLabel(Identifier &name, SourceLoc &loc) {
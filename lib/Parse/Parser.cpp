@@ -304,6 +304,7 @@ swift::tokenizeWithTrivia(const LangOptions &LangOpts, const SourceManager &SM,
   std::vector<std::pair<RC<syntax::RawTokenSyntax>, syntax::AbsolutePosition>>
       Tokens;
   syntax::AbsolutePosition RunningPos;
+  syntax::RawTokenSyntaxCache TokenCache;
 
   tokenize(
       LangOpts, SM, BufferID, Offset, EndOffset,
@@ -312,9 +313,8 @@ swift::tokenizeWithTrivia(const LangOptions &LangOpts, const SourceManager &SM,
       /*SplitTokens=*/ArrayRef<Token>(),
       [&](const Token &Tok, const Trivia &LeadingTrivia,
           const Trivia &TrailingTrivia) {
-        auto ThisToken = RawTokenSyntax::make(Tok.getKind(), Tok.getText(),
-                                              SourcePresence::Present,
-                                              LeadingTrivia, TrailingTrivia);
+        auto ThisToken = TokenCache.getToken(Tok.getKind(), Tok.getText(),
+                                             LeadingTrivia, TrailingTrivia);
 
         auto ThisTokenPos = ThisToken->accumulateAbsolutePosition(RunningPos);
         Tokens.push_back({ThisToken, ThisTokenPos});
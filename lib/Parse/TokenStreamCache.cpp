@@ -0,0 +1,81 @@
+//===--- TokenStreamCache.cpp - Content-hash-keyed token cache ------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "swift/Parse/TokenStreamCache.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Subsystems.h"
+#include "llvm/ADT/Hashing.h"
+
+using namespace swift;
+
+TokenStreamCache &TokenStreamCache::getGlobalCache() {
+  static TokenStreamCache GlobalCache;
+  return GlobalCache;
+}
+
+void TokenStreamCache::clear() {
+  std::lock_guard<std::mutex> Guard(Mutex);
+  Streams.clear();
+}
+
+std::vector<Token> TokenStreamCache::getTokens(const LangOptions &LangOpts,
+                                               const SourceManager &SM,
+                                               unsigned BufferID,
+                                               bool KeepComments) {
+  StringRef Buffer = SM.getEntireTextForBuffer(BufferID);
+  const char *BufStart = Buffer.data();
+
+  uint64_t Key = llvm::hash_combine(llvm::hash_value(Buffer), KeepComments);
+
+  {
+    std::lock_guard<std::mutex> Guard(Mutex);
+    auto It = Streams.find(Key);
+    if (It != Streams.end() && It->second->BufferSize == Buffer.size()) {
+      // Rehydrate the cached offset-based tokens against this buffer.
+      std::vector<Token> Result;
+      Result.reserve(It->second->Tokens.size());
+      for (const CachedToken &CT : It->second->Tokens) {
+        Token Tok;
+        Tok.setToken(CT.Kind, StringRef(BufStart + CT.Offset, CT.Length),
+                     CT.CommentLength, CT.MultilineString);
+        Tok.setAtStartOfLine(CT.AtStartOfLine);
+        if (CT.EscapedIdentifier)
+          Tok.setEscapedIdentifier(true);
+        Result.push_back(Tok);
+      }
+      return Result;
+    }
+  }
+
+  std::vector<Token> Result = tokenize(LangOpts, SM, BufferID,
+                                       /*Offset=*/0, /*EndOffset=*/0,
+                                       KeepComments);
+
+  auto Stream = llvm::make_unique<CachedStream>();
+  Stream->BufferSize = Buffer.size();
+  Stream->Tokens.reserve(Result.size());
+  for (const Token &Tok : Result) {
+    CachedToken CT;
+    CT.Offset = Tok.getRawText().data() - BufStart;
+    CT.Length = Tok.getRawText().size();
+    CT.Kind = Tok.getKind();
+    CT.CommentLength = Tok.getCommentLength();
+    CT.AtStartOfLine = Tok.isAtStartOfLine();
+    CT.EscapedIdentifier = Tok.isEscapedIdentifier();
+    CT.MultilineString = Tok.IsMultilineString();
+    Stream->Tokens.push_back(CT);
+  }
+
+  std::lock_guard<std::mutex> Guard(Mutex);
+  Streams[Key] = std::move(Stream);
+  return Result;
+}
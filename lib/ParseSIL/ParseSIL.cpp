@@ -63,6 +63,10 @@ public:
   /// Did we parse a sil_stage for this module?
   bool DidParseSILStage = false;
 
+  /// If non-null, called with each sil function as soon as its body has
+  /// been completely parsed and verified.
+  std::function<void(SILFunction *)> FunctionParsedCallback;
+
   bool parseDeclSIL(Parser &P) override;
   bool parseDeclSILStage(Parser &P) override;
   bool parseSILVTable(Parser &P) override;
@@ -98,6 +102,12 @@ SILParserState::SILParserState(SILModule *M)
 
 SILParserState::~SILParserState() = default;
 
+void SILParserState::setFunctionParsedCallback(
+    std::function<void(SILFunction *)> Fn) {
+  assert(Impl && "no SIL module to parse into");
+  Impl->FunctionParsedCallback = std::move(Fn);
+}
+
 bool swift::parseIntoSourceFile(SourceFile &SF,
                                 unsigned BufferID,
                                 bool *Done,
@@ -5132,6 +5142,12 @@ bool SILParserTUState::parseDeclSIL(Parser &P) {
   if (!P.Diags.hadAnyError())
     FunctionState.F->verify();
 
+  // Hand the completed function to a streaming consumer, if one is
+  // installed.  This lets clients such as sil-opt pipeline function passes
+  // with parsing instead of waiting for the whole module.
+  if (FunctionParsedCallback && !FunctionState.F->isExternalDeclaration())
+    FunctionParsedCallback(FunctionState.F);
+
   return false;
 }
 
@@ -27,6 +27,8 @@
 #include "swift/AST/TypeRepr.h"
 #include "swift/Basic/Mangler.h"
 #include "swift/ClangImporter/ClangImporter.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 
 // TODO: Develop a proper interface for this.
 #include "swift/AST/IRGenOptions.h"
@@ -714,19 +716,58 @@ namespace {
 /// The template subclasses do target-specific logic.
 class RemoteASTContextImpl {
   std::unique_ptr<IRGenContext> IRGen;
+
+  /// Successfully resolved metadata->type mappings, keyed by the metadata
+  /// address and the skipArtificial flag. Debuggers repeat the same
+  /// resolutions on every stop, and each one costs several remote reads
+  /// plus demangling, so successes are remembered. Failures are not: they
+  /// may be transient (e.g. a partially-initialized remote process).
+  llvm::DenseMap<std::pair<uint64_t, unsigned>, Type> MetadataTypeCache;
+
+  /// Successfully resolved nominal type descriptors, keyed by address.
+  llvm::DenseMap<uint64_t, NominalTypeDecl *> DescriptorDeclCache;
+
+  /// Successfully computed member offsets, keyed by the type and metadata
+  /// address, then by member name.
+  llvm::DenseMap<std::pair<TypeBase *, uint64_t>, llvm::StringMap<uint64_t>>
+      MemberOffsetCache;
+
 public:
   RemoteASTContextImpl() = default;
   virtual ~RemoteASTContextImpl() = default;
 
-  virtual Result<Type>
-  getTypeForRemoteTypeMetadata(RemoteAddress metadata, bool skipArtificial) = 0;
   virtual Result<MetadataKind>
   getKindForRemoteTypeMetadata(RemoteAddress metadata) = 0;
-  virtual Result<NominalTypeDecl*>
-  getDeclForRemoteNominalTypeDescriptor(RemoteAddress descriptor) = 0;
   virtual Result<RemoteAddress>
   getHeapMetadataForObject(RemoteAddress object) = 0;
 
+  Result<Type>
+  getTypeForRemoteTypeMetadata(RemoteAddress metadata, bool skipArtificial) {
+    auto key = std::make_pair(metadata.getAddressData(),
+                              unsigned(skipArtificial));
+    auto cached = MetadataTypeCache.find(key);
+    if (cached != MetadataTypeCache.end())
+      return cached->second;
+
+    auto result = getTypeForRemoteTypeMetadataImpl(metadata, skipArtificial);
+    if (result)
+      MetadataTypeCache.insert({key, result.getValue()});
+    return result;
+  }
+
+  Result<NominalTypeDecl*>
+  getDeclForRemoteNominalTypeDescriptor(RemoteAddress descriptor) {
+    auto cached = DescriptorDeclCache.find(descriptor.getAddressData());
+    if (cached != DescriptorDeclCache.end())
+      return cached->second;
+
+    auto result = getDeclForRemoteNominalTypeDescriptorImpl(descriptor);
+    if (result)
+      DescriptorDeclCache.insert(
+          {descriptor.getAddressData(), result.getValue()});
+    return result;
+  }
+
   Result<uint64_t>
   getOffsetOfMember(Type type, RemoteAddress optMetadata, StringRef memberName){
     // Sanity check: obviously invalid arguments.
@@ -738,15 +779,36 @@ public:
     if (type->hasTypeParameter() || type->hasArchetype())
       return Result<uint64_t>::emplaceFailure(Failure::DependentArgument);
 
+    auto &memberCache =
+        MemberOffsetCache[{type.getPointer(), optMetadata.getAddressData()}];
+    auto cached = memberCache.find(memberName);
+    if (cached != memberCache.end())
+      return cached->second;
+
     // Split into cases.
-    if (auto typeDecl = type->getNominalOrBoundGenericNominal()) {
-      return getOffsetOfField(type, typeDecl, optMetadata, memberName);
-    } else if (auto tupleType = type->getAs<TupleType>()) {
-      return getOffsetOfTupleElement(tupleType, optMetadata, memberName);
-    } else {
-      return Result<uint64_t>::emplaceFailure(Failure::TypeHasNoSuchMember,
-                                              memberName);
-    }
+    Result<uint64_t> result = [&]() -> Result<uint64_t> {
+      if (auto typeDecl = type->getNominalOrBoundGenericNominal()) {
+        return getOffsetOfField(type, typeDecl, optMetadata, memberName);
+      } else if (auto tupleType = type->getAs<TupleType>()) {
+        return getOffsetOfTupleElement(tupleType, optMetadata, memberName);
+      } else {
+        return Result<uint64_t>::emplaceFailure(Failure::TypeHasNoSuchMember,
+                                                memberName);
+      }
+    }();
+    if (result)
+      memberCache[memberName] = result.getValue();
+    return result;
+  }
+
+  /// Drop all cached results and the IRGen context. This must be called
+  /// when images are loaded into (or unloaded from) the remote process,
+  /// since cached addresses and layouts may no longer be valid.
+  void clearCaches() {
+    MetadataTypeCache.clear();
+    DescriptorDeclCache.clear();
+    MemberOffsetCache.clear();
+    IRGen.reset();
   }
 
 protected:
@@ -761,6 +823,11 @@ protected:
   }
 
 private:
+  virtual Result<Type>
+  getTypeForRemoteTypeMetadataImpl(RemoteAddress metadata,
+                                   bool skipArtificial) = 0;
+  virtual Result<NominalTypeDecl*>
+  getDeclForRemoteNominalTypeDescriptorImpl(RemoteAddress descriptor) = 0;
   virtual RemoteASTTypeBuilder &getBuilder() = 0;
   virtual MemoryReader &getReader() = 0;
   virtual bool readWordOffset(RemoteAddress address, int64_t *offset) = 0;
@@ -1026,8 +1093,8 @@ public:
                                ASTContext &ctx)
     : Reader(std::move(reader), ctx) {}
 
-  Result<Type> getTypeForRemoteTypeMetadata(RemoteAddress metadata,
-                                            bool skipArtificial) override {
+  Result<Type> getTypeForRemoteTypeMetadataImpl(RemoteAddress metadata,
+                                                bool skipArtificial) override {
     if (auto result = Reader.readTypeFromMetadata(metadata.getAddressData(),
                                                   skipArtificial))
       return result;
@@ -1043,7 +1110,7 @@ public:
   }
 
   Result<NominalTypeDecl*>
-  getDeclForRemoteNominalTypeDescriptor(RemoteAddress descriptor) override {
+  getDeclForRemoteNominalTypeDescriptorImpl(RemoteAddress descriptor) override {
     if (auto result =
           Reader.readNominalTypeFromDescriptor(descriptor.getAddressData()))
       return result;
@@ -1135,3 +1202,7 @@ Result<remote::RemoteAddress>
 RemoteASTContext::getHeapMetadataForObject(remote::RemoteAddress address) {
   return asImpl(Impl)->getHeapMetadataForObject(address);
 }
+
+void RemoteASTContext::clearCaches() {
+  asImpl(Impl)->clearCaches();
+}
@@ -28,6 +28,13 @@ template void Calculate<SILDomTree, swift::SILFunction>(
     SILDomTree &DT, swift::SILFunction &F);
 template void Calculate<SILPostDomTree, swift::SILFunction>(
     SILPostDomTree &DT, swift::SILFunction &F);
+
+template void InsertEdge<SILDomTree>(SILDomTree &DT,
+                                     swift::SILBasicBlock *From,
+                                     swift::SILBasicBlock *To);
+template void DeleteEdge<SILDomTree>(SILDomTree &DT,
+                                     swift::SILBasicBlock *From,
+                                     swift::SILBasicBlock *To);
 } // namespace DomTreeBuilder
 } // namespace llvm
 
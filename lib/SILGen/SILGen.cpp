@@ -577,6 +577,19 @@ void emitOrDelayFunction(SILGenModule &SGM,
     auto linkage = constant.getLinkage(ForDefinition);
     mayDelay = constant.isImplicit()
       && !isPossiblyUsedExternally(linkage, SGM.M.isWholeModule());
+
+    // Under on-demand SILGen, explicit functions may be delayed too, as long
+    // as every reference to them has to come through SIL: an Objective-C
+    // entry point is referenced from emitted class metadata, and @_cdecl or
+    // @_silgen_name symbols can be called by name from C.
+    if (!mayDelay && SGM.M.getOptions().EnableOnDemandSILGen &&
+        !isPossiblyUsedExternally(linkage, SGM.M.isWholeModule()) &&
+        constant.hasDecl()) {
+      auto *decl = constant.getDecl();
+      mayDelay = !decl->isObjC() &&
+                 !decl->getAttrs().hasAttribute<CDeclAttr>() &&
+                 !decl->getAttrs().hasAttribute<SILGenNameAttr>();
+    }
   }
 
   // Avoid emitting a delayable definition if it hasn't already been referenced.
@@ -1393,6 +1406,14 @@ void SILGenModule::emitSourceFile(SourceFile *sf, unsigned startElem) {
 // SILModule::constructSIL method implementation
 //===----------------------------------------------------------------------===//
 
+// Note that SILGen must run single-threaded, even though a type-checked AST
+// is mostly immutable: emitting a body triggers lazy type lowering, which
+// canonicalizes types and creates generic environments in the ASTContext,
+// and both the ASTContext and the SILModule's uniquing tables are unguarded.
+// Until those are thread-safe, SILGen throughput work has to come from
+// emitting less (see the delayed-function machinery above) rather than from
+// emitting concurrently.
+
 std::unique_ptr<SILModule>
 SILModule::constructSIL(ModuleDecl *mod, SILOptions &options, FileUnit *SF,
                         Optional<unsigned> startElem,
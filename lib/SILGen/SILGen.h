@@ -82,6 +82,13 @@ public:
 
   /// Mapping from SILDeclRefs to emitted SILFunctions.
   llvm::DenseMap<SILDeclRef, SILFunction*> emittedFunctions;
+  /// Memoized reabstraction thunks, keyed by the uniqued thunk, source, and
+  /// destination function types. This only short-circuits the repeated
+  /// mangling and interface-type computation at each use site; the
+  /// mangled-name lookup in getOrCreateSharedFunction remains the
+  /// authoritative module-wide deduplication.
+  llvm::DenseMap<std::pair<CanType, std::pair<CanType, CanType>>,
+                 SILFunction *> reabstractionThunks;
   /// Mapping from ProtocolConformances to emitted SILWitnessTables.
   llvm::DenseMap<ProtocolConformance*, SILWitnessTable*> emittedWitnessTables;
 
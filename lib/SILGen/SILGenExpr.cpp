@@ -2873,9 +2873,62 @@ RValue RValueEmitter::visitAbstractClosureExpr(AbstractClosureExpr *e,
   return RValue(SGF, e, refType, result);
 }
 
+/// If every segment of a string interpolation is a plain string literal of
+/// type String, fold the whole interpolation into a single string literal
+/// with the concatenated text.
+///
+/// The semantic expression for "a\("b")c" is a chain of
+/// init(stringInterpolationSegment:) calls fed into
+/// init(stringInterpolation:), which materializes several intermediate
+/// Strings at run time even though the result is a compile-time constant.
+/// Returns null when folding isn't possible, e.g. when a segment is a
+/// non-literal expression or the interpolation resolves to a user-defined
+/// ExpressibleByStringInterpolation type whose initializers we must call.
+static StringLiteralExpr *
+foldConstantInterpolation(SILGenFunction &SGF,
+                          InterpolatedStringLiteralExpr *E) {
+  // Only fold interpolations of the standard String type; a user-defined
+  // conforming type may observe the individual segments.
+  auto *stringDecl = SGF.getASTContext().getStringDecl();
+  if (!stringDecl || !E->getType() ||
+      E->getType()->getAnyNominal() != stringDecl)
+    return nullptr;
+
+  auto segments = E->getSegments();
+  if (segments.empty())
+    return nullptr;
+
+  SmallString<64> text;
+  for (auto *segment : segments) {
+    auto *literal = dyn_cast<StringLiteralExpr>(segment);
+    if (!literal || literal->getEncoding() != StringLiteralExpr::UTF8 ||
+        !literal->getType() || literal->getType()->getAnyNominal() != stringDecl)
+      return nullptr;
+    // The folded literal reuses one segment's initializers, so every segment
+    // must have been type-checked down the ordinary string literal path.
+    if (!literal->getBuiltinInitializer())
+      return nullptr;
+    text += literal->getValue();
+  }
+
+  auto &ctx = SGF.getASTContext();
+  auto *first = cast<StringLiteralExpr>(segments.front());
+  auto *folded = new (ctx) StringLiteralExpr(ctx.AllocateCopy(StringRef(text)),
+                                             E->getSourceRange(),
+                                             /*Implicit=*/true);
+  folded->setType(E->getType());
+  folded->setEncoding(StringLiteralExpr::UTF8);
+  folded->setBuiltinInitializer(first->getBuiltinInitializer());
+  folded->setInitializer(first->getInitializer());
+  return folded;
+}
+
 RValue RValueEmitter::
 visitInterpolatedStringLiteralExpr(InterpolatedStringLiteralExpr *E,
                                    SGFContext C) {
+  if (auto *folded = foldConstantInterpolation(SGF, E))
+    return SGF.emitLiteral(folded, C);
+
   return visit(E->getSemanticExpr(), C);
 }
 
@@ -365,6 +365,16 @@ getOrCreateReabstractionThunk(CanSILFunctionType thunkType,
                               CanSILFunctionType fromType,
                               CanSILFunctionType toType,
                               IsSerialized_t Serialized) {
+  // Thunks are deduplicated by their mangled name, but the mangling itself
+  // is expensive enough to show up in profiles on closure-heavy code. The
+  // inputs are uniqued types, so memoize the result per triple.
+  auto cacheKey = std::make_pair(CanType(thunkType),
+                                 std::make_pair(CanType(fromType),
+                                                CanType(toType)));
+  auto &cacheEntry = reabstractionThunks[cacheKey];
+  if (cacheEntry)
+    return cacheEntry;
+
   // The reference to the thunk is likely @noescape, but declarations are always
   // escaping.
   auto thunkDeclType =
@@ -383,7 +393,8 @@ getOrCreateReabstractionThunk(CanSILFunctionType thunkType,
   
   auto loc = RegularLocation::getAutoGeneratedLocation();
 
-  return M.getOrCreateSharedFunction(loc, name, thunkDeclType, IsBare,
-                                     IsTransparent, IsSerializable,
-                                     ProfileCounter(), IsReabstractionThunk);
+  return cacheEntry = M.getOrCreateSharedFunction(
+                          loc, name, thunkDeclType, IsBare, IsTransparent,
+                          IsSerializable, ProfileCounter(),
+                          IsReabstractionThunk);
 }
@@ -14,6 +14,7 @@
 
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "ARCSequenceOpts.h"
+#include "RCStateTransition.h"
 #include "swift/SIL/SILBuilder.h"
 #include "swift/SIL/SILVisitor.h"
 #include "swift/SILOptimizer/Utils/Local.h"
@@ -259,6 +260,23 @@ static bool processFunctionWithLoopSupport(
 //                              Top Level Driver
 //===----------------------------------------------------------------------===//
 
+/// Returns true if \p F contains any increments or decrements the sequence
+/// optimizer could pair up. Many functions contain no refcounting at all
+/// after earlier passes, and the dataflow below allocates per-block state for
+/// the whole function before it finds that out.
+static bool containsRCInstructions(SILFunction &F) {
+  for (SILBasicBlock &BB : F)
+    for (SILInstruction &I : BB)
+      switch (getRCStateTransitionKind(&I)) {
+      case RCStateTransitionKind::StrongIncrement:
+      case RCStateTransitionKind::StrongDecrement:
+        return true;
+      default:
+        break;
+      }
+  return false;
+}
+
 namespace {
 class ARCSequenceOpts : public SILFunctionTransform {
   /// The entry point to the transformation.
@@ -268,6 +286,10 @@ class ARCSequenceOpts : public SILFunctionTransform {
     if (!getOptions().EnableARCOptimizations)
       return;
 
+    // Skip the (expensive) dataflow if there is nothing to pair.
+    if (!containsRCInstructions(*F))
+      return;
+
     if (!EnableLoopARC) {
       auto *AA = getAnalysis<AliasAnalysis>();
       auto *POTA = getAnalysis<PostOrderAnalysis>();
@@ -182,6 +182,40 @@ static bool isIdentifiedFunctionLocal(SILValue V) {
          isLocalLiteral(V);
 }
 
+/// Return true if \p O1 and \p O2 are references to class instances with
+/// provably unrelated class hierarchies.
+///
+/// TBAA guarantees that class instances are never type punned (see the TBAA
+/// section in the SIL reference manual), so the static class of a reference
+/// bounds the dynamic type of the instance it points to. Two references whose
+/// classes do not share a hierarchy therefore cannot point to the same
+/// instance. This disambiguates e.g. ref_element_addr projections of two
+/// unrelated classes even if nothing is known about the references themselves.
+static bool areUnrelatedClassReferences(SILValue O1, SILValue O2) {
+#ifndef NDEBUG
+  if (!shouldRunTypedAccessTBAA())
+    return false;
+#endif
+
+  SILType T1 = O1->getType();
+  SILType T2 = O2->getType();
+
+  // Only consider object references with a nominal class type. Addresses are
+  // handled by typed access TBAA, and the builtin reference types
+  // (e.g. Builtin.NativeObject) can refer to any class instance.
+  if (T1.isAddress() || T2.isAddress())
+    return false;
+  if (!T1.getClassOrBoundGenericClass() || !T2.getClassOrBoundGenericClass())
+    return false;
+
+  // If the types contain archetypes we don't know the range of possible
+  // dynamic types, so be conservative.
+  if (T1.hasArchetype() || T2.hasArchetype())
+    return false;
+
+  return !T1.isBindableToSuperclassOf(T2) && !T2.isBindableToSuperclassOf(T1);
+}
+
 /// Returns true if we can prove that the two input SILValues which do not equal
 /// cannot alias.
 static bool aliasUnequalObjects(SILValue O1, SILValue O2) {
@@ -209,6 +243,13 @@ static bool aliasUnequalObjects(SILValue O1, SILValue O2) {
     return true;
   }
 
+  // References to class instances with unrelated class hierarchies cannot
+  // point to the same object.
+  if (areUnrelatedClassReferences(O1, O2)) {
+    DEBUG(llvm::dbgs() << "            Found unrelated class references!\n");
+    return true;
+  }
+
   // We failed to prove that the two objects are different.
   return false;
 }
@@ -538,27 +579,99 @@ AliasResult AliasAnalysis::alias(SILValue V1, SILValue V2,
                                  SILType TBAAType1, SILType TBAAType2) {
   AliasKeyTy Key = toAliasKey(V1, V2, TBAAType1, TBAAType2);
 
-  // Check if we've already computed this result.
+  // Check if we've already computed this result. An escape-analysis based
+  // result taints any enclosing computation that observes it.
   auto It = AliasCache.find(Key);
   if (It != AliasCache.end()) {
-    return It->second;
+    LastQueryUsedEscapeAnalysis |= It->second.second;
+    return It->second.first;
   }
 
   // Flush the cache if the size of the cache is too large.
   if (AliasCache.size() > AliasAnalysisMaxCacheSize) {
     AliasCache.clear();
     AliasValueBaseToIndex.clear();
+    AliasCacheKeysByFunction.clear();
+    InterproceduralAliasKeys.clear();
 
     // Key is no longer valid as we cleared the AliasValueBaseToIndex.
     Key = toAliasKey(V1, V2, TBAAType1, TBAAType2);
   }
 
-  // Calculate the aliasing result and store it in the cache.
+  // Calculate the aliasing result and store it in the cache. The flag
+  // accumulates over nested queries, so remember and re-apply the state of
+  // any enclosing computation.
+  bool OuterUsedEscapeAnalysis = LastQueryUsedEscapeAnalysis;
+  LastQueryUsedEscapeAnalysis = false;
   auto Result = aliasInner(V1, V2, TBAAType1, TBAAType2);
-  AliasCache[Key] = Result;
+  AliasCache[Key] = {Result, LastQueryUsedEscapeAnalysis};
+  recordAliasCacheKey(Key, V1, V2);
+  LastQueryUsedEscapeAnalysis |= OuterUsedEscapeAnalysis;
   return Result;
 }
 
+/// Returns the function whose invalidation retires cache entries for \p V,
+/// or null if the value is not owned by any function (e.g. undef).
+static SILFunction *getValueOwner(SILValue V) {
+  if (SILBasicBlock *BB = V->getParentBlock())
+    return BB->getParent();
+  return nullptr;
+}
+
+void AliasAnalysis::recordAliasCacheKey(AliasKeyTy Key, SILValue V1,
+                                        SILValue V2) {
+  if (LastQueryUsedEscapeAnalysis) {
+    InterproceduralAliasKeys.push_back(Key);
+    return;
+  }
+  // Entries for values with no owning function only encode identity and
+  // type facts and never need invalidation.
+  SILFunction *F1 = getValueOwner(V1);
+  SILFunction *F2 = getValueOwner(V2);
+  if (F1)
+    AliasCacheKeysByFunction[F1].push_back(Key);
+  if (F2 && F2 != F1)
+    AliasCacheKeysByFunction[F2].push_back(Key);
+}
+
+void AliasAnalysis::recordMemBehaviorCacheKey(MemBehaviorKeyTy Key,
+                                              SILInstruction *Inst) {
+  // Apply and release instructions get their behavior from escape analysis
+  // and side-effect summaries, which embed facts about other functions.
+  // Any other query is tainted if one of its nested alias queries used
+  // escape analysis.
+  if (FullApplySite::isa(Inst) || isa<StrongReleaseInst>(Inst) ||
+      isa<ReleaseValueInst>(Inst) || LastQueryUsedEscapeAnalysis) {
+    InterproceduralMemBehaviorKeys.push_back(Key);
+    return;
+  }
+  MemBehaviorCacheKeysByFunction[Inst->getFunction()].push_back(Key);
+}
+
+void AliasAnalysis::invalidateFunction(SILFunction *F) {
+  auto AliasIt = AliasCacheKeysByFunction.find(F);
+  if (AliasIt != AliasCacheKeysByFunction.end()) {
+    for (AliasKeyTy &Key : AliasIt->second)
+      AliasCache.erase(Key);
+    AliasCacheKeysByFunction.erase(AliasIt);
+  }
+  auto MBIt = MemBehaviorCacheKeysByFunction.find(F);
+  if (MBIt != MemBehaviorCacheKeysByFunction.end()) {
+    for (MemBehaviorKeyTy &Key : MBIt->second)
+      MemoryBehaviorCache.erase(Key);
+    MemBehaviorCacheKeysByFunction.erase(MBIt);
+  }
+
+  // Results which embed facts about other functions may be stale whenever
+  // any function changes.
+  for (AliasKeyTy &Key : InterproceduralAliasKeys)
+    AliasCache.erase(Key);
+  InterproceduralAliasKeys.clear();
+  for (MemBehaviorKeyTy &Key : InterproceduralMemBehaviorKeys)
+    MemoryBehaviorCache.erase(Key);
+  InterproceduralMemBehaviorKeys.clear();
+}
+
 /// The main AA entry point. Performs various analyses on V1, V2 in an attempt
 /// to disambiguate the two values.
 AliasResult AliasAnalysis::aliasInner(SILValue V1, SILValue V2,
@@ -616,6 +729,9 @@ AliasResult AliasAnalysis::aliasInner(SILValue V1, SILValue V2,
   if (!EA->canPointToSameMemory(V1, V2)) {
     DEBUG(llvm::dbgs() << "            Found not-aliased objects based on"
                                       "escape analysis\n");
+    // The connection graph embeds facts about other functions, so this
+    // result must not survive invalidations of any function.
+    LastQueryUsedEscapeAnalysis = true;
     return AliasResult::NoAlias;
   }
 
@@ -52,6 +52,29 @@ void CalleeCache::sortAndUniqueCallees() {
   }
 }
 
+void CalleeCache::packCallees() {
+  // Lay the per-method lists out back-to-back in a single block and record
+  // an offset/length slice for each method, then drop the scratch lists.
+  // Queries only ever read the lists, so the packed form is all we keep.
+  unsigned TotalCallees = 0;
+  for (auto &Pair : TheCache)
+    TotalCallees += Pair.second.getPointer()->size();
+  FlatCallees.reserve(TotalCallees);
+
+  for (auto &Pair : TheCache) {
+    auto &Callees = *Pair.second.getPointer();
+    CalleeSlice Slice;
+    Slice.Offset = FlatCallees.size();
+    Slice.Size = Callees.size();
+    Slice.CanCallUnknown = Pair.second.getInt();
+    FlatCallees.insert(FlatCallees.end(), Callees.begin(), Callees.end());
+    PackedCache[Pair.first] = Slice;
+  }
+
+  TheCache.shrink_and_clear();
+  Allocator = llvm::SpecificBumpPtrAllocator<Callees>();
+}
+
 CalleeCache::CalleesAndCanCallUnknown &
 CalleeCache::getOrCreateCalleesForMethod(SILDeclRef Decl) {
   auto Found = TheCache.find(Decl);
@@ -179,12 +202,14 @@ CalleeCache::getSingleCalleeForWitnessMethod(WitnessMethodInst *WMI) const {
 // Look up the precomputed callees for an abstract function and
 // return it as a CalleeList.
 CalleeList CalleeCache::getCalleeList(SILDeclRef Decl) const {
-  auto Found = TheCache.find(Decl);
-  if (Found == TheCache.end())
+  auto Found = PackedCache.find(Decl);
+  if (Found == PackedCache.end())
     return CalleeList();
 
-  auto &Pair = Found->second;
-  return CalleeList(*Pair.getPointer(), Pair.getInt());
+  const CalleeSlice &Slice = Found->second;
+  return CalleeList(
+      llvm::makeArrayRef(FlatCallees).slice(Slice.Offset, Slice.Size),
+      Slice.CanCallUnknown);
 }
 
 // Return a callee list for the given witness method.
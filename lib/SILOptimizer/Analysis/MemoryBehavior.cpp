@@ -334,14 +334,23 @@ AliasAnalysis::computeMemoryBehavior(SILInstruction *Inst, SILValue V,
   if (MemoryBehaviorCache.size() > MemoryBehaviorAnalysisMaxCacheSize) {
     MemoryBehaviorCache.clear();
     MemoryBehaviorNodeToIndex.clear();
+    MemBehaviorCacheKeysByFunction.clear();
+    InterproceduralMemBehaviorKeys.clear();
 
     // Key is no longer valid as we cleared the MemoryBehaviorNodeToIndex.
     Key = toMemoryBehaviorKey(Inst, V, InspectionMode);
   }
 
-  // Calculate the aliasing result and store it in the cache.
+  // Calculate the aliasing result and store it in the cache. Track whether
+  // any nested alias query consulted escape analysis so the entry can be
+  // classified for invalidation; re-apply the state of any enclosing
+  // computation afterwards.
+  bool OuterUsedEscapeAnalysis = LastQueryUsedEscapeAnalysis;
+  LastQueryUsedEscapeAnalysis = false;
   auto Result = computeMemoryBehaviorInner(Inst, V, InspectionMode);
   MemoryBehaviorCache[Key] = Result;
+  recordMemBehaviorCacheKey(Key, Inst);
+  LastQueryUsedEscapeAnalysis |= OuterUsedEscapeAnalysis;
   return Result;
 }
 
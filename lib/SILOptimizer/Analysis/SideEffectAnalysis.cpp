@@ -451,38 +451,49 @@ void SideEffectAnalysis::recompute(FunctionInfo *Initial) {
 
   // Second step: propagate the side-effect information up the call-graph until
   // it stabilizes.
-  bool NeedAnotherIteration;
-  do {
-    DEBUG(llvm::dbgs() << "new iteration\n");
-    NeedAnotherIteration = false;
-
-    for (FunctionInfo *FInfo : BottomUpOrder) {
-      if (FInfo->NeedUpdateCallers) {
-        DEBUG(llvm::dbgs() << "  update callers of " << FInfo->F->getName() <<
-              '\n');
-        FInfo->NeedUpdateCallers = false;
-
-        // Propagate the side-effects to all callers.
-        for (const auto &E : FInfo->getCallers()) {
-          assert(E.isValid());
-
-          // Only include callers which we are actually recomputing.
-          if (BottomUpOrder.wasRecomputedWithCurrentUpdateID(E.Caller)) {
-            DEBUG(llvm::dbgs() << "    merge into caller " <<
-                  E.Caller->F->getName() << '\n');
-
-            if (E.Caller->FE.mergeFromApply(FInfo->FE, E.FAS)) {
-              E.Caller->NeedUpdateCallers = true;
-              if (!E.Caller->isScheduledAfter(FInfo)) {
-                // This happens if we have a cycle in the call-graph.
-                NeedAnotherIteration = true;
-              }
-            }
-          }
-        }
+  // A single scan in bottom-up order is sufficient for the acyclic part of
+  // the call-graph. Callers which need to be re-processed because of a cycle
+  // end up on the worklist, so only the functions on cycles are visited again
+  // instead of re-scanning the whole bottom-up order.
+  llvm::SmallVector<FunctionInfo *, 8> WorkList;
+  for (FunctionInfo *FInfo : BottomUpOrder) {
+    if (FInfo->NeedUpdateCallers)
+      updateCallers(FInfo, BottomUpOrder, WorkList);
+  }
+  while (!WorkList.empty()) {
+    FunctionInfo *FInfo = WorkList.pop_back_val();
+    // The flag may have been cleared already if the function got re-processed
+    // by the bottom-up scan after it was added to the worklist.
+    if (FInfo->NeedUpdateCallers)
+      updateCallers(FInfo, BottomUpOrder, WorkList);
+  }
+}
+
+void SideEffectAnalysis::updateCallers(FunctionInfo *FInfo,
+                              FunctionOrder &BottomUpOrder,
+                              llvm::SmallVectorImpl<FunctionInfo *> &WorkList) {
+  DEBUG(llvm::dbgs() << "  update callers of " << FInfo->F->getName() << '\n');
+  FInfo->NeedUpdateCallers = false;
+
+  // Propagate the side-effects to all callers.
+  for (const auto &E : FInfo->getCallers()) {
+    assert(E.isValid());
+
+    // Only include callers which we are actually recomputing.
+    if (BottomUpOrder.wasRecomputedWithCurrentUpdateID(E.Caller)) {
+      DEBUG(llvm::dbgs() << "    merge into caller " <<
+            E.Caller->F->getName() << '\n');
+
+      if (E.Caller->FE.mergeFromApply(FInfo->FE, E.FAS) &&
+          !E.Caller->NeedUpdateCallers) {
+        E.Caller->NeedUpdateCallers = true;
+        // Callers which are scheduled after FInfo are picked up by the
+        // bottom-up scan anyway. Pushing them, too, is harmless: they are
+        // skipped when popped because their flag is already cleared.
+        WorkList.push_back(E.Caller);
       }
     }
-  } while (NeedAnotherIteration);
+  }
 }
 
 void SideEffectAnalysis::getEffects(FunctionEffects &ApplyEffects, FullApplySite FAS) {
@@ -823,6 +823,46 @@ void SILClosureSpecializerTransform::run() {
   invalidateAnalysis(SILAnalysis::InvalidationKind::Everything);
 }
 
+/// Returns true if \p Closure is ever applied in its function, either
+/// directly or after being rewrapped by function conversions or another
+/// partial_apply.
+///
+/// SILGenPoly emits reabstraction thunks which take the original closure as
+/// their only captured argument, so closures produced by functional
+/// combinators are often only invoked through a thunk chain. Such closures
+/// are still worth specializing: cloning moves the closure creation into the
+/// callee and subsequent rounds of the pass peel off the next level of the
+/// chain.
+static bool isClosureApplied(SILValue Closure) {
+  SmallVector<SILValue, 4> Worklist;
+  Worklist.push_back(Closure);
+
+  while (!Worklist.empty()) {
+    SILValue V = Worklist.pop_back_val();
+    for (auto *Op : V->getUses()) {
+      auto *User = Op->getUser();
+      if (auto UserAI = FullApplySite::isa(User)) {
+        if (UserAI.getCallee() == V)
+          return true;
+        continue;
+      }
+      // Look through conversions.
+      if (auto *CFI = dyn_cast<ConvertFunctionInst>(User)) {
+        Worklist.push_back(CFI);
+        continue;
+      }
+      // Look through closures which rewrap our closure, e.g. reabstraction
+      // thunks which capture it: applying the rewrapped closure applies the
+      // original one.
+      if (auto *PAI = dyn_cast<PartialApplyInst>(User)) {
+        Worklist.push_back(PAI);
+        continue;
+      }
+    }
+  }
+  return false;
+}
+
 void SILClosureSpecializerTransform::gatherCallSites(
     SILFunction *Caller,
     llvm::SmallVectorImpl<ClosureInfo*> &ClosureCandidates,
@@ -918,20 +958,16 @@ void SILClosureSpecializerTransform::gatherCallSites(
         if (!ClosureIndex.hasValue())
           continue;
 
-        // Make sure that the Closure is invoked in the Apply's callee. We only
-        // want to perform closure specialization if we know that we will be
-        // able to change a partial_apply into an apply.
+        // Make sure that the Closure is invoked in the Apply's callee,
+        // possibly through a chain of reabstraction thunks. We only want to
+        // perform closure specialization if we know that we will be able to
+        // change a partial_apply into an apply.
         //
         // TODO: Maybe just call the function directly instead of moving the
         // partial apply?
         SILValue Arg = ApplyCallee->getArgument(ClosureIndex.getValue());
-        if (std::none_of(Arg->use_begin(), Arg->use_end(),
-                         [&Arg](Operand *Op) -> bool {
-                           auto UserAI = FullApplySite::isa(Op->getUser());
-                           return UserAI && UserAI.getCallee() == Arg;
-                         })) {
+        if (!isClosureApplied(Arg))
           continue;
-        }
 
         unsigned firstParamArgIdx =
             AI.getSubstCalleeConv().getSILArgIndexOfFirstParam();
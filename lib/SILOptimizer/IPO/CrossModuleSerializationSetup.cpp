@@ -0,0 +1,196 @@
+//===--- CrossModuleSerializationSetup.cpp - Setup cross-module opts ------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// A pass which marks small public functions as [serialized], so that their
+// bodies are emitted into the swiftmodule file and can be inlined into
+// client modules by the optimizer, similar to how ThinLTO imports hot
+// function bodies across translation units.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "cross-module-serialization-setup"
+#include "swift/AST/Decl.h"
+#include "swift/SIL/SILArgument.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILGlobalVariable.h"
+#include "swift/SIL/SILInstruction.h"
+#include "swift/SIL/SILModule.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+/// The maximum size of a function (in number of SIL instructions) which is
+/// serialized for the benefit of other modules. The expected optimization
+/// gain from inlining a larger function into a client is unlikely to pay for
+/// the code size increase there.
+static llvm::cl::opt<int> CMSFunctionSizeLimit("cms-function-size-limit",
+                                               llvm::cl::init(20));
+
+namespace {
+
+/// Marks small public functions as [serialized] before the module is
+/// serialized.
+///
+/// This is a conservative form of cross-module optimization: a serialized
+/// body is deserialized in the context of the client module, so it must not
+/// reference anything which is invisible there. Only functions which
+/// reference nothing but public symbols and public types are eligible.
+class CrossModuleSerializationSetup : public SILModuleTransform {
+  /// Cache for canSerialize(SILFunction *).
+  llvm::DenseMap<SILFunction *, bool> canSerializeCache;
+
+  bool canSerialize(SILFunction *F);
+  bool canSerialize(SILInstruction *inst);
+
+  void markSerialized(SILFunction *F);
+
+  void run() override;
+};
+
+/// Checks if a type which occurs in a serialized function body is visible
+/// to other modules.
+static bool isSerializableType(SILType type) {
+  return !type.getSwiftRValueType().findIf([](Type subType) -> bool {
+    if (NominalTypeDecl *NT = subType->getAnyNominal())
+      return NT->getEffectiveAccess() < AccessLevel::Public;
+    return false;
+  });
+}
+
+/// Returns true if serializing \p F is expected to benefit clients without
+/// bloating their code size.
+static bool isWorthSerializing(SILFunction &F) {
+  if (F.getInlineStrategy() == NoInline)
+    return false;
+
+  int size = 0;
+  for (SILBasicBlock &block : F) {
+    for (SILInstruction &inst : block) {
+      (void)inst;
+      if (++size > CMSFunctionSizeLimit)
+        return false;
+    }
+  }
+  return true;
+}
+
+/// Returns true if the body of \p F can be serialized without making any
+/// non-public symbol or type visible to client modules.
+bool CrossModuleSerializationSetup::canSerialize(SILFunction *F) {
+  auto iter = canSerializeCache.find(F);
+  if (iter != canSerializeCache.end())
+    return iter->second;
+
+  // Treat recursive references conservatively. This also breaks cycles of
+  // shared functions.
+  bool &cachedResult = canSerializeCache[F];
+  cachedResult = false;
+
+  for (SILBasicBlock &block : *F) {
+    for (SILArgument *arg : block.getArguments()) {
+      if (!isSerializableType(arg->getType()))
+        return false;
+    }
+    for (SILInstruction &inst : block) {
+      if (!canSerialize(&inst))
+        return false;
+    }
+  }
+  cachedResult = true;
+  return true;
+}
+
+bool CrossModuleSerializationSetup::canSerialize(SILInstruction *inst) {
+  for (Operand &op : inst->getAllOperands()) {
+    if (!isSerializableType(op.get()->getType()))
+      return false;
+  }
+  for (SILValue result : inst->getResults()) {
+    if (!isSerializableType(result->getType()))
+      return false;
+  }
+
+  if (auto *FRI = dyn_cast<FunctionRefInst>(inst)) {
+    SILFunction *callee = FRI->getReferencedFunction();
+    if (hasPublicVisibility(callee->getLinkage()))
+      return true;
+    // A shared function is emitted into the serialized module together with
+    // the referencing function (see markSerialized), so it must be
+    // serializable itself.
+    return hasSharedVisibility(callee->getLinkage()) &&
+           !callee->isExternalDeclaration() && canSerialize(callee);
+  }
+  if (auto *GA = dyn_cast<GlobalAccessInst>(inst))
+    return hasPublicVisibility(GA->getReferencedGlobal()->getLinkage());
+  if (auto *AG = dyn_cast<AllocGlobalInst>(inst))
+    return hasPublicVisibility(AG->getReferencedGlobal()->getLinkage());
+
+  // Key path patterns reference property descriptors and stored property
+  // offsets which we cannot prove to be visible to other modules.
+  if (isa<KeyPathInst>(inst))
+    return false;
+
+  return true;
+}
+
+/// Marks \p F as [serialized], including all shared functions which are
+/// referenced from its body. The serializer only emits the body of a shared
+/// function if the function itself carries the [serialized] flag.
+void CrossModuleSerializationSetup::markSerialized(SILFunction *F) {
+  if (F->isSerialized() == IsSerialized)
+    return;
+
+  DEBUG(llvm::dbgs() << "Serialize " << F->getName() << '\n');
+  F->setSerialized(IsSerialized);
+
+  for (SILBasicBlock &block : *F) {
+    for (SILInstruction &inst : block) {
+      if (auto *FRI = dyn_cast<FunctionRefInst>(&inst)) {
+        SILFunction *callee = FRI->getReferencedFunction();
+        if (hasSharedVisibility(callee->getLinkage()) &&
+            !callee->isExternalDeclaration())
+          markSerialized(callee);
+      }
+    }
+  }
+}
+
+void CrossModuleSerializationSetup::run() {
+  SILModule &M = *getModule();
+  if (!M.getOptions().EnableCrossModuleSerialization)
+    return;
+  if (M.isSerialized())
+    return;
+
+  for (SILFunction &F : M) {
+    if (F.isSerialized() == IsSerialized)
+      continue;
+    if (F.getLinkage() != SILLinkage::Public)
+      continue;
+    if (F.isExternalDeclaration() || F.isAvailableExternally())
+      continue;
+    if (!isWorthSerializing(F))
+      continue;
+    if (!canSerialize(&F))
+      continue;
+    markSerialized(&F);
+  }
+}
+
+} // end anonymous namespace
+
+SILTransform *swift::createCrossModuleSerializationSetup() {
+  return new CrossModuleSerializationSetup();
+}
@@ -840,6 +840,68 @@ static bool mayChangeArrayValueToNonUniqueState(ArraySemanticsCall &Call) {
   llvm_unreachable("Unhandled ArrayCallKind in switch.");
 }
 
+/// Remove make_mutable calls which are preceded in their block by another
+/// make_mutable on the same array, with no operation in between which could
+/// make the array non-unique again. This catches sequences of mutating
+/// operations on the same array, e.g. after a chain of append helpers has
+/// been inlined.
+static bool removeRedundantMakeMutable(SILFunction *F) {
+  bool Changed = false;
+  for (auto &BB : *F) {
+    // The arrays which are known to be uniquely referenced at the current
+    // instruction.
+    llvm::SmallPtrSet<SILValue, 4> UniqueArrays;
+    for (auto II = BB.begin(); II != BB.end();) {
+      SILInstruction *Inst = &*II;
+      ++II;
+
+      ArraySemanticsCall Sem(Inst);
+      if (Sem) {
+        if (Sem.getKind() == ArrayCallKind::kMakeMutable && Sem.hasSelf()) {
+          ApplyInst *SemCall = Sem;
+          if (!UniqueArrays.insert(Sem.getSelf()).second &&
+              SemCall->use_empty()) {
+            DEBUG(llvm::dbgs() << "    Removing redundant make_mutable "
+                               << *SemCall);
+            Sem.removeCall();
+            Changed = true;
+          }
+          continue;
+        }
+        // Semantic calls which don't change the uniqueness state of an array
+        // value don't invalidate what we know. Note that an append to a
+        // tracked array keeps *it* unique, but may capture another array
+        // value, so it conservatively clears the state like any other call.
+        if (!mayChangeArrayValueToNonUniqueState(Sem))
+          continue;
+        UniqueArrays.clear();
+        continue;
+      }
+
+      if (!Inst->mayHaveSideEffects())
+        continue;
+      if (isa<CondFailInst>(Inst))
+        continue;
+      if (isa<AllocationInst>(Inst) || isa<DeallocStackInst>(Inst))
+        continue;
+
+      // Stores of trivial values to array elements can neither copy nor
+      // replace an array value.
+      if (auto *SI = dyn_cast<StoreInst>(Inst)) {
+        if (isArrayEltStore(SI) &&
+            SI->getSrc()->getType().isTrivial(F->getModule()))
+          continue;
+      }
+
+      // Every other side effect - unknown calls, retains, releases, stores -
+      // could copy an array value or store a new one, so the arrays can no
+      // longer be assumed to be uniquely referenced.
+      UniqueArrays.clear();
+    }
+  }
+  return Changed;
+}
+
 /// Check that the array value stored in \p ArrayStruct is released by \Inst.
 static bool isReleaseOfArrayValueAt(AllocStackInst *ArrayStruct,
                                     SILInstruction *Inst,
@@ -1581,9 +1643,15 @@ class COWArrayOptPass : public SILFunctionTransform {
     auto *LA = PM->getAnalysis<SILLoopAnalysis>();
     auto *RCIA =
       PM->getAnalysis<RCIdentityAnalysis>()->get(getFunction());
+    // Remove straight-line redundant uniqueness checks independently of the
+    // loop optimization below.
+    bool HasChangedStraightLine = removeRedundantMakeMutable(getFunction());
+
     SILLoopInfo *LI = LA->get(getFunction());
     if (LI->empty()) {
       DEBUG(llvm::dbgs() << "  Skipping Function: No loops.\n");
+      if (HasChangedStraightLine)
+        invalidateAnalysis(SILAnalysis::InvalidationKind::CallsAndInstructions);
       return;
     }
 
@@ -1604,7 +1672,7 @@ class COWArrayOptPass : public SILFunctionTransform {
     for (auto *L : *LI)
       pushChildren(L);
 
-    bool HasChanged = false;
+    bool HasChanged = HasChangedStraightLine;
     for (auto *L : Loops)
       HasChanged |= COWArrayOpt(RCIA, L, DA).run();
 
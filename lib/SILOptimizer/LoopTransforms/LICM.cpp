@@ -221,6 +221,22 @@ static bool hasNoSideEffect(SILInstruction *Inst, ReadSet &SafeReads) {
   return false;
 }
 
+/// Returns true if \p Inst is a pure address projection. Such projections
+/// only compute an address and cannot trap, so they may be executed
+/// speculatively and can even be hoisted out of conditionally executed
+/// blocks of the loop.
+static bool isSafeAddressProjection(SILInstruction *Inst) {
+  switch (Inst->getKind()) {
+  case SILInstructionKind::StructElementAddrInst:
+  case SILInstructionKind::TupleElementAddrInst:
+  case SILInstructionKind::RefElementAddrInst:
+  case SILInstructionKind::RefTailAddrInst:
+    return true;
+  default:
+    return false;
+  }
+}
+
 static bool canHoistInstruction(SILInstruction *Inst, SILLoop *Loop,
                                 ReadSet &SafeReads) {
   // Can't hoist terminators.
@@ -265,22 +281,38 @@ static bool hoistInstructions(SILLoop *Loop, DominanceInfo *DT,
        It != E;) {
     auto *CurBB = It->getBlock();
 
-    // Don't decent into control-dependent code. Only traverse into basic blocks
-    // that dominate all exits.
-    if (!std::all_of(ExitingBBs.begin(), ExitingBBs.end(),
-                     [=](SILBasicBlock *ExitBB) {
-          return DT->dominates(CurBB, ExitBB);
-        })) {
-      DEBUG(llvm::dbgs() << "  skipping conditional block " << *CurBB << "\n");
+    // Don't descend into code which is not part of the loop. The dominator
+    // tree below the header also contains the blocks the loop exits to.
+    if (!Loop->contains(CurBB)) {
       It.skipChildren();
       continue;
     }
 
-    // We now that the block is guaranteed to be executed. Hoist if we can.
+    // Only hoist instructions with side effects from basic blocks that
+    // dominate all exits, i.e. which are guaranteed to be executed.
+    // In control-dependent code we can still hoist pure address projections:
+    // they cannot trap and compute the same address in every iteration in
+    // which they are executed.
+    bool DominatesExits = std::all_of(ExitingBBs.begin(), ExitingBBs.end(),
+                                      [=](SILBasicBlock *ExitBB) {
+          return DT->dominates(CurBB, ExitBB);
+        });
+    if (!DominatesExits)
+      DEBUG(llvm::dbgs() << "  conditional block " << *CurBB << "\n");
+
     for (auto InstIt = CurBB->begin(), E = CurBB->end(); InstIt != E; ) {
       SILInstruction *Inst = &*InstIt;
       ++InstIt;
       DEBUG(llvm::dbgs() << "  looking at " << *Inst);
+      if (!DominatesExits) {
+        if (isSafeAddressProjection(Inst) &&
+            hasLoopInvariantOperands(Inst, Loop)) {
+          DEBUG(llvm::dbgs() << "   hoisting projection to preheader.\n");
+          Changed = true;
+          Inst->moveBefore(Preheader->getTerminator());
+        }
+        continue;
+      }
       if (canHoistInstruction(Inst, Loop, SafeReads)) {
         DEBUG(llvm::dbgs() << "   hoisting to preheader.\n");
         Changed = true;
@@ -13,6 +13,7 @@
 #define DEBUG_TYPE "sil-loopunroll"
 
 #include "llvm/ADT/DepthFirstIterator.h"
+#include "llvm/Support/CommandLine.h"
 
 #include "swift/SIL/PatternMatch.h"
 #include "swift/SIL/SILCloner.h"
@@ -29,6 +30,22 @@ using namespace swift::PatternMatch;
 using llvm::DenseMap;
 using llvm::MapVector;
 
+/// Maximum factor by which a counted loop which is too large to unroll fully
+/// may be partially unrolled. The copies keep their exit checks and the
+/// backedge stays, so correctness does not depend on the factor dividing the
+/// trip count. A factor of 1 disables partial unrolling.
+llvm::cl::opt<unsigned> SILPartialUnrollFactor(
+    "sil-partial-unroll-factor", llvm::cl::init(1),
+    llvm::cl::desc("Maximum factor for partially unrolling counted loops "
+                   "which are too large to unroll fully"));
+
+/// Functions whose profiled entry count is at least this high get a doubled
+/// unrolling budget.
+llvm::cl::opt<unsigned long long> SILUnrollHotFunctionCount(
+    "sil-unroll-hot-function-count", llvm::cl::init(1000),
+    llvm::cl::desc("Entry count at which a profiled function gets a larger "
+                   "unrolling budget"));
+
 
 namespace {
 
@@ -172,27 +189,18 @@ static Optional<uint64_t> getMaxLoopTripCount(SILLoop *Loop,
   return Dist.getZExtValue() + Adjust;
 }
 
-/// Check whether we can duplicate the instructions in the loop and use a
-/// heuristic that looks at the trip count and the cost of the instructions in
-/// the loop to determine whether we should unroll this loop.
-static bool canAndShouldUnrollLoop(SILLoop *Loop, uint64_t TripCount) {
-  assert(Loop->getSubLoops().empty() && "Expect innermost loops");
-  if (TripCount > 32)
-    return false;
-
-  // We can unroll a loop if we can duplicate the instructions it holds.
+/// Determine the cost of duplicating the instructions in the loop, or None
+/// if the loop contains instructions which cannot be duplicated.
+static Optional<uint64_t> getLoopCost(SILLoop *Loop) {
   uint64_t Cost = 0;
   // Average number of instructions per basic block.
   // It is used to estimate the cost of the callee
   // inside a loop.
   const uint64_t InsnsPerBB = 4;
-  // Use command-line threshold for unrolling.
-  const uint64_t SILLoopUnrollThreshold = Loop->getBlocks().empty() ? 0 : 
-    (Loop->getBlocks())[0]->getParent()->getModule().getOptions().UnrollThreshold;
   for (auto *BB : Loop->getBlocks()) {
     for (auto &Inst : *BB) {
       if (!Loop->canDuplicate(&Inst))
-        return false;
+        return None;
       if (instructionInlineCost(Inst) != InlineCost::Free)
         ++Cost;
       if (auto AI = FullApplySite::isa(&Inst)) {
@@ -203,11 +211,42 @@ static bool canAndShouldUnrollLoop(SILLoop *Loop, uint64_t TripCount) {
           Cost += Callee->size() * InsnsPerBB;
         }
       }
-      if (Cost * TripCount > SILLoopUnrollThreshold)
-        return false;
-  }
+    }
   }
-  return true;
+  return Cost;
+}
+
+/// Return the cost budget for unrolling loops in \p F. Functions which a
+/// profile shows to be hot get a larger budget.
+static uint64_t getUnrollThreshold(SILFunction *F) {
+  // Use command-line threshold for unrolling.
+  uint64_t Threshold = F->getModule().getOptions().UnrollThreshold;
+  auto EntryCount = F->getEntryCount();
+  if (EntryCount && EntryCount.getValue() >= SILUnrollHotFunctionCount)
+    Threshold *= 2;
+  return Threshold;
+}
+
+/// Determine how often the loop body should be copied: the full trip count if
+/// the loop is small enough, a partial factor if partial unrolling is
+/// enabled, or 1 if the loop should not be unrolled at all.
+static uint64_t getUnrollFactor(SILLoop *Loop, uint64_t TripCount) {
+  assert(Loop->getSubLoops().empty() && "Expect innermost loops");
+
+  // We can unroll a loop if we can duplicate the instructions it holds.
+  auto Cost = getLoopCost(Loop);
+  if (!Cost)
+    return 1;
+  uint64_t Threshold = getUnrollThreshold(Loop->getHeader()->getParent());
+  if (TripCount <= 32 && *Cost * TripCount <= Threshold)
+    return TripCount;
+
+  // The loop cannot be unrolled fully. Copy the body a few times and keep the
+  // backedge. The copies keep their exit checks, so this trades a little
+  // redundant compare-and-branch work for longer runs of straight-line code.
+  uint64_t Factor = std::min(uint64_t(SILPartialUnrollFactor),
+                             *Cost ? Threshold / *Cost : TripCount);
+  return std::max<uint64_t>(std::min(Factor, TripCount - 1), 1);
 }
 
 /// Redirect the terminator of the current loop iteration's latch to the next
@@ -350,8 +389,8 @@ updateSSA(SILLoop *Loop,
   }
 }
 
-/// Try to fully unroll the loop if we can determine the trip count and the trip
-/// count lis below a threshold.
+/// Try to unroll the loop - fully if we can determine the trip count and the
+/// unrolled size is below a threshold, partially otherwise.
 static bool tryToUnrollLoop(SILLoop *Loop) {
   assert(Loop->getSubLoops().empty() && "Expecting innermost loops");
 
@@ -370,8 +409,15 @@ static bool tryToUnrollLoop(SILLoop *Loop) {
   if (!MaxTripCount)
     return false;
 
-  if (!canAndShouldUnrollLoop(Loop, MaxTripCount.getValue()))
+  // Do not grow code which a profile says never runs.
+  auto EntryCount = Header->getParent()->getEntryCount();
+  if (EntryCount && EntryCount.getValue() == 0)
+    return false;
+
+  uint64_t Factor = getUnrollFactor(Loop, *MaxTripCount);
+  if (Factor < 2)
     return false;
+  bool IsPartialUnroll = Factor < *MaxTripCount;
 
   // TODO: We need to split edges from non-condbr exits for the SSA updater. For
   // now just don't handle loops containing such exits.
@@ -392,8 +438,8 @@ static bool tryToUnrollLoop(SILLoop *Loop) {
 
   DenseMap<SILValue, SmallVector<SILValue, 8>> LoopLiveOutValues;
 
-  // Copy the body MaxTripCount-1 times.
-  for (uint64_t Cnt = 1; Cnt < *MaxTripCount; ++Cnt) {
+  // Copy the body Factor-1 times.
+  for (uint64_t Cnt = 1; Cnt < Factor; ++Cnt) {
     // Clone the blocks in the loop.
     LoopCloner Cloner(Loop);
     Cloner.cloneLoop();
@@ -423,11 +469,17 @@ static bool tryToUnrollLoop(SILLoop *Loop) {
     auto *CurrentLatch = Latches[Iteration];
     auto LastIteration = End - 1;
     auto *OriginalHeader = Headers[0];
+    // In a partial unroll the last copy keeps its conditional backedge, now
+    // leading to the first header, instead of exiting - so no latch is
+    // treated as a last one.
     auto *NextIterationsHeader =
-        Iteration == LastIteration ? nullptr : Headers[Iteration + 1];
+        Iteration != LastIteration
+            ? Headers[Iteration + 1]
+            : (IsPartialUnroll ? Headers[0] : nullptr);
 
-    redirectTerminator(CurrentLatch, Iteration, LastIteration, OriginalHeader,
-                       NextIterationsHeader);
+    redirectTerminator(CurrentLatch, Iteration,
+                       IsPartialUnroll ? Latches.size() : LastIteration,
+                       OriginalHeader, NextIterationsHeader);
   }
 
   // Fixup SSA form for loop values used outside the loop.
@@ -293,12 +293,6 @@ void SILPassManager::runPassOnFunction(SILFunctionTransform *SFT,
 
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
 
-  SFT->injectPassManager(this);
-  SFT->injectFunction(F);
-
-  PrettyStackTraceSILFunctionTransform X(SFT, NumPassesRun);
-  DebugPrintEnabler DebugPrint(NumPassesRun);
-
   // If nothing changed since the last run of this pass, we can skip this
   // pass.
   CompletedPasses &completedPasses = CompletedPassesMap[F];
@@ -319,6 +313,12 @@ void SILPassManager::runPassOnFunction(SILFunctionTransform *SFT,
     return;
   }
 
+  SFT->injectPassManager(this);
+  SFT->injectFunction(F);
+
+  PrettyStackTraceSILFunctionTransform X(SFT, NumPassesRun);
+  DebugPrintEnabler DebugPrint(NumPassesRun);
+
   updateSILModuleStatsBeforeTransform(F->getModule(), SFT, *this, NumPassesRun);
 
   CurrentPassHasInvalidated = false;
@@ -370,9 +370,22 @@ void SILPassManager::runPassOnFunction(SILFunctionTransform *SFT,
     verifyAnalyses(F);
   }
 
+  // Recycle any scratch buffers the pass borrowed; nothing allocated from
+  // the arena may outlive the pass run.
+  ScratchArena.Reset();
+
   ++NumPassesRun;
 }
 
+// Note on parallelism: although most function passes only mutate their own
+// function, they cannot safely run on worker threads in this architecture.
+// Passes create shared functions (specializations, thunks, outlined
+// helpers) through the module-wide uniquing tables, push work onto the
+// single function worklist, invalidate analyses whose state spans
+// functions, and call into SIL type lowering, which canonicalizes types in
+// the unguarded ASTContext. Until all of those become thread-safe, the
+// function pipeline must stay serial; the pass-skipping machinery below
+// (CompletedPassesMap) is the mechanism for cutting its cost.
 void SILPassManager::
 runFunctionPasses(ArrayRef<SILFunctionTransform *> FuncTransforms) {
   if (FuncTransforms.empty())
@@ -451,6 +464,8 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
   updateSILModuleStatsBeforeTransform(*Mod, SMT, *this, NumPassesRun);
 
   CurrentPassHasInvalidated = false;
+  CurrentPassInvalidatedModule = false;
+  FunctionsInvalidatedByCurrentPass.clear();
 
   if (SILPrintPassName)
     llvm::dbgs() << "#" << NumPassesRun << " Stage: " << StageName
@@ -487,8 +502,16 @@ void SILPassManager::runModulePass(SILModuleTransform *SMT) {
   updateSILModuleStatsAfterTransform(*Mod, SMT, *this, NumPassesRun, Delta);
 
   if (Options.VerifyAll &&
-      (CurrentPassHasInvalidated || !SILVerifyWithoutInvalidation)) {
-    Mod->verify();
+      (CurrentPassHasInvalidated || SILVerifyWithoutInvalidation)) {
+    // Scope verification to the functions the pass reported as changed.
+    // Fall back to the whole module when the invalidation was not
+    // function-granular, e.g. after vtable or witness table updates.
+    if (CurrentPassInvalidatedModule || SILVerifyWithoutInvalidation) {
+      Mod->verify();
+    } else {
+      for (SILFunction *F : FunctionsInvalidatedByCurrentPass)
+        F->verify();
+    }
     verifyAnalyses();
   }
 }
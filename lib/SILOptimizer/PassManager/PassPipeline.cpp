@@ -245,6 +245,9 @@ void addSSAPasses(SILPassPipelinePlan &P, OptimizationLevelKind OpLevel) {
   case OptimizationLevelKind::MidLevel:
     P.addGlobalOpt();
     P.addLetPropertiesOpt();
+    // Export the bodies of small public functions to client modules. Does
+    // nothing unless cross-module serialization is enabled.
+    P.addCrossModuleSerializationSetup();
     // It is important to serialize before any of the @_semantics
     // functions are inlined, because otherwise the information about
     // uses of such functions inside the module is lost,
@@ -408,6 +411,10 @@ static void addLowLevelPassPipeline(SILPassPipelinePlan &P) {
 
   // We've done a lot of optimizations on this function, attempt to FSO.
   P.addFunctionSignatureOpts();
+
+  // Module-wide fixed-point signature optimization. Only enabled with the
+  // -sil-module-signature-opts option.
+  P.addModuleSignatureOpts();
 }
 
 static void addLateLoopOptPassPipeline(SILPassPipelinePlan &P) {
@@ -424,6 +431,11 @@ static void addLateLoopOptPassPipeline(SILPassPipelinePlan &P) {
   P.addRedundantOverflowCheckRemoval();
   P.addMergeCondFails();
 
+  // Has only an effect if the -enable-cold-path-outlining option is
+  // specified. Runs after all inlining so that the cold regions it creates
+  // are final, and before the last cleanup passes below.
+  P.addColdPathOutlining();
+
   // Remove dead code.
   P.addDCE();
   P.addSILCombine();
@@ -433,6 +445,11 @@ static void addLateLoopOptPassPipeline(SILPassPipelinePlan &P) {
   // after FSO.
   P.addLateReleaseHoisting();
 
+  // Convert the remaining refcount operations on provably thread-local
+  // objects into nonatomic ones. Runs after all release motion so the
+  // surviving operations are final.
+  P.addNonatomicRC();
+
   // Has only an effect if the -assume-single-thread option is specified.
   P.addAssumeSingleThreaded();
 }
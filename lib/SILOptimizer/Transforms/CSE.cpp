@@ -858,6 +858,11 @@ bool CSE::canHandle(SILInstruction *Inst) {
         case ArrayCallKind::kCheckIndex:
         case ArrayCallKind::kCheckSubscript:
           return SemCall.hasGuaranteedSelf();
+        case ArrayCallKind::kNone:
+          // Not an array semantic call. Fall through to the side-effect
+          // based check below, so that calls to pure functions (e.g. small
+          // getters) can be CSE'd before inlining obscures them.
+          break;
         default:
           return false;
       }
@@ -0,0 +1,321 @@
+//===--- ColdPathOutlining.cpp - Outline cold regions of hot functions ----===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass moves cold, never-returning regions of a function - error paths,
+// fatalError branches, the slow paths of precondition checks - into separate
+// functions. The cold code still executes exactly as before (the hot function
+// calls the outlined function, which ends in unreachable), but it no longer
+// occupies space between the hot blocks, so more of the hot code fits into
+// the instruction cache.
+//
+// A region is outlined if its entry block is cold according to ColdBlockInfo,
+// the region is self-contained (it is the dominance subtree of its entry and
+// has no edges entering or leaving it), and every path through it ends in an
+// unreachable instruction. The latter restriction means the region has no
+// live-out values, so only the live-ins have to become parameters of the
+// outlined function.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "cold-path-outlining"
+
+#include "swift/SIL/SILArgument.h"
+#include "swift/SIL/SILBuilder.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILModule.h"
+#include "swift/SIL/SILUndef.h"
+#include "swift/SILOptimizer/Analysis/ColdBlockInfo.h"
+#include "swift/SILOptimizer/Analysis/DominanceAnalysis.h"
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace swift;
+
+STATISTIC(NumColdRegionsOutlined, "Number of cold regions outlined");
+
+/// Set to true to enable outlining of cold never-returning regions.
+llvm::cl::opt<bool> EnableColdPathOutlining(
+    "enable-cold-path-outlining", llvm::cl::init(false),
+    llvm::cl::desc("Outline cold never-returning regions into separate "
+                   "functions"));
+
+/// Regions with fewer instructions than this are not worth a call and a
+/// separate function.
+llvm::cl::opt<unsigned> ColdPathOutliningMinRegionSize(
+    "cold-path-outlining-min-region-size", llvm::cl::init(8),
+    llvm::cl::desc("Minimum number of instructions in an outlined cold "
+                   "region"));
+
+namespace {
+
+/// A self-contained cold region together with the values it needs from the
+/// enclosing function.
+struct ColdRegion {
+  /// The single entry block of the region. Its arguments stay with the
+  /// caller; see outlineRegion().
+  SILBasicBlock *Entry;
+
+  /// All blocks of the region (the dominance subtree of Entry), in dominator
+  /// tree preorder. Contains Entry as the first element.
+  SmallVector<SILBasicBlock *, 8> Blocks;
+
+  /// Values defined outside the region (including Entry's block arguments)
+  /// which are used inside it. They become the parameters of the outlined
+  /// function.
+  llvm::SmallSetVector<SILValue, 8> LiveIns;
+};
+
+/// Collect the dominance subtree of \p Entry into \p Region and check that it
+/// forms a region we can outline: closed under successor and predecessor
+/// edges and terminating in unreachable on all paths.
+static bool collectRegionBlocks(SILBasicBlock *Entry, DominanceInfo *DT,
+                                ColdRegion &Region) {
+  SmallPtrSet<SILBasicBlock *, 16> InRegion;
+  SmallVector<DominanceInfoNode *, 16> Worklist;
+  Worklist.push_back(DT->getNode(Entry));
+  while (!Worklist.empty()) {
+    DominanceInfoNode *Node = Worklist.pop_back_val();
+    SILBasicBlock *BB = Node->getBlock();
+    Region.Blocks.push_back(BB);
+    InRegion.insert(BB);
+    for (DominanceInfoNode *Child : *Node)
+      Worklist.push_back(Child);
+  }
+
+  unsigned NumInstructions = 0;
+  for (SILBasicBlock *BB : Region.Blocks) {
+    // All paths through the region must stay in the region and eventually
+    // end in unreachable. Blocks which return or throw would have live-out
+    // values and are rejected.
+    TermInst *TI = BB->getTerminator();
+    if (TI->getSuccessors().empty() && !isa<UnreachableInst>(TI))
+      return false;
+    for (SILBasicBlock *Succ : BB->getSuccessorBlocks())
+      if (!InRegion.count(Succ))
+        return false;
+
+    // Dominance guarantees that no reachable block branches into the middle
+    // of the region. Blocks which are unreachable from the entry do not obey
+    // dominance, so check the predecessors explicitly.
+    if (BB != Entry)
+      for (SILBasicBlock *Pred : BB->getPredecessorBlocks())
+        if (!InRegion.count(Pred))
+          return false;
+
+    NumInstructions += std::distance(BB->begin(), BB->end());
+  }
+  return NumInstructions >= ColdPathOutliningMinRegionSize;
+}
+
+/// Compute the live-in values of \p Region and check the instruction-level
+/// restrictions on outlining.
+static bool collectRegionLiveIns(ColdRegion &Region) {
+  SmallPtrSet<SILBasicBlock *, 16> InRegion(Region.Blocks.begin(),
+                                            Region.Blocks.end());
+
+  // Returns true if \p V is defined outside of the region. The arguments of
+  // the entry block count as outside: they remain with the caller and are
+  // passed as parameters.
+  auto isDefinedOutside = [&](SILValue V) -> bool {
+    SILBasicBlock *DefBB = V->getParentBlock();
+    if (!DefBB)
+      return false;
+    if (!InRegion.count(DefBB))
+      return true;
+    return DefBB == Region.Entry && isa<SILArgument>(V);
+  };
+
+  for (SILBasicBlock *BB : Region.Blocks) {
+    for (SILInstruction &I : *BB) {
+      // Moving the deallocation of a caller-allocated stack location into a
+      // callee would break the caller's stack discipline.
+      if (isa<DeallocStackInst>(&I) || isa<DeallocRefInst>(&I))
+        if (isDefinedOutside(I.getOperand(0)))
+          return false;
+
+      for (Operand &Op : I.getAllOperands()) {
+        SILValue V = Op.get();
+        if (isa<SILUndef>(V) || !isDefinedOutside(V))
+          continue;
+        // A value of an archetype (including opened existentials) cannot be
+        // passed to a function which does not have the caller's generic
+        // environment.
+        if (V->getType().hasArchetype())
+          return false;
+        Region.LiveIns.insert(V);
+      }
+
+      // Values defined in the region must not be used outside of it. For
+      // reachable code this follows from dominance, but blocks which are
+      // unreachable from the entry may use anything.
+      for (SILValue Result : I.getResults())
+        for (Operand *Use : Result->getUses())
+          if (!InRegion.count(Use->getUser()->getParent()))
+            return false;
+    }
+  }
+  return true;
+}
+
+/// Create the type of the outlined function: one parameter per live-in value,
+/// no results. Addresses are passed @inout, objects are passed unowned - the
+/// outlined code performs exactly the same operations on them as the original
+/// region did, so no ownership is transferred at the call.
+static CanSILFunctionType getOutlinedFunctionType(SILModule &M,
+                                                  const ColdRegion &Region) {
+  SmallVector<SILParameterInfo, 8> Parameters;
+  for (SILValue V : Region.LiveIns) {
+    SILType Ty = V->getType();
+    auto Conv = Ty.isAddress() ? ParameterConvention::Indirect_Inout
+                               : ParameterConvention::Direct_Unowned;
+    Parameters.push_back(SILParameterInfo(Ty.getSwiftRValueType(), Conv));
+  }
+  auto ExtInfo =
+      SILFunctionType::ExtInfo(SILFunctionType::Representation::Thin,
+                               /*pseudogeneric*/ false, /*noescape*/ false);
+  return SILFunctionType::get(nullptr, ExtInfo, SILCoroutineKind::None,
+                              ParameterConvention::Direct_Unowned, Parameters,
+                              /*yields*/ {}, /*results*/ {}, None,
+                              M.getASTContext());
+}
+
+/// Return a name for the next cold region outlined from \p F which is not
+/// taken in the module yet.
+static std::string getOutlinedFunctionName(SILModule &M, SILFunction *F) {
+  unsigned Idx = 0;
+  std::string Name;
+  do {
+    Name.clear();
+    llvm::raw_string_ostream OS(Name);
+    OS << F->getName() << "_cold" << Idx++;
+    OS.flush();
+  } while (M.lookUpFunction(Name));
+  return Name;
+}
+
+/// Move \p Region into a newly created function and replace it in the caller
+/// by a call to that function followed by unreachable.
+static SILFunction *outlineRegion(SILFunction *F, ColdRegion &Region) {
+  SILModule &M = F->getModule();
+
+  auto *OutFn = M.getOrCreateFunction(
+      F->getLocation(), getOutlinedFunctionName(M, F), SILLinkage::Private,
+      getOutlinedFunctionType(M, Region), IsNotBare, IsNotTransparent,
+      IsNotSerialized);
+  assert(OutFn->empty() && "Outlined function name should be unique");
+  if (!F->hasQualifiedOwnership())
+    OutFn->setUnqualifiedOwnership();
+  // Re-inlining the cold code would defeat the purpose of this pass.
+  OutFn->setInlineStrategy(NoInline);
+
+  // Split the region entry right after its arguments. The arguments (and the
+  // branches of the predecessors, which supply them) stay with the caller;
+  // the instructions move into the outlined function.
+  SILBasicBlock *CallBlock = Region.Entry;
+  SILBasicBlock *OutlinedEntry = CallBlock->split(CallBlock->begin());
+
+  // Move the blocks into the new function, the region entry first.
+  OutFn->getBlocks().splice(OutFn->end(), F->getBlocks(), OutlinedEntry);
+  for (SILBasicBlock *BB : Region.Blocks)
+    if (BB != Region.Entry)
+      OutFn->getBlocks().splice(OutFn->end(), F->getBlocks(), BB);
+
+  // Rewrite the uses of the live-in values to the new function arguments.
+  for (SILValue V : Region.LiveIns) {
+    SILArgument *NewArg = OutlinedEntry->createFunctionArgument(V->getType());
+    SmallVector<Operand *, 8> Uses(V->use_begin(), V->use_end());
+    for (Operand *Use : Uses)
+      if (Use->getUser()->getFunction() == OutFn)
+        Use->set(NewArg);
+  }
+
+  // Call the outlined cold path. It never returns, so the call block ends in
+  // unreachable. The split left CallBlock without a terminator.
+  SILLocation Loc = OutlinedEntry->begin()->getLoc();
+  SILBuilder Builder(CallBlock);
+  auto *FunRef = Builder.createFunctionRef(Loc, OutFn);
+  SmallVector<SILValue, 8> Args(Region.LiveIns.begin(), Region.LiveIns.end());
+  Builder.createApply(Loc, FunRef, Args, false);
+  Builder.createUnreachable(Loc);
+
+  DEBUG(llvm::dbgs() << "Outlined cold region of " << F->getName() << " ("
+                     << Region.Blocks.size() << " blocks) into "
+                     << OutFn->getName() << "\n");
+  ++NumColdRegionsOutlined;
+  return OutFn;
+}
+
+class ColdPathOutlining : public SILFunctionTransform {
+  void run() override {
+    if (!EnableColdPathOutlining)
+      return;
+
+    SILFunction *F = getFunction();
+    // A private outlined function cannot be referenced from a serialized
+    // body, and outlined code cannot use the caller's generic environment.
+    if (F->empty() || F->isSerialized() ||
+        F->getLoweredFunctionType()->isPolymorphic())
+      return;
+
+    auto *DA = PM->getAnalysis<DominanceAnalysis>();
+    DominanceInfo *DT = DA->get(F);
+    ColdBlockInfo ColdBlocks(DA);
+
+    // Collect the maximal outlinable cold regions. Walking the dominator
+    // tree in preorder visits the entry of a cold subtree before its
+    // interior blocks, so marking accepted regions suffices to skip nested
+    // candidates.
+    SmallVector<ColdRegion, 4> Regions;
+    SmallPtrSet<SILBasicBlock *, 16> OutlinedBlocks;
+    SmallVector<DominanceInfoNode *, 16> Worklist;
+    Worklist.push_back(DT->getRootNode());
+    while (!Worklist.empty()) {
+      DominanceInfoNode *Node = Worklist.pop_back_val();
+      SILBasicBlock *BB = Node->getBlock();
+      if (OutlinedBlocks.count(BB))
+        continue;
+      if (BB != F->getEntryBlock() && ColdBlocks.isCold(BB)) {
+        ColdRegion Region;
+        Region.Entry = BB;
+        if (collectRegionBlocks(BB, DT, Region) &&
+            collectRegionLiveIns(Region)) {
+          OutlinedBlocks.insert(Region.Blocks.begin(), Region.Blocks.end());
+          Regions.push_back(std::move(Region));
+          continue;
+        }
+      }
+      for (DominanceInfoNode *Child : *Node)
+        Worklist.push_back(Child);
+    }
+    if (Regions.empty())
+      return;
+
+    // The regions are disjoint dominance subtrees, so outlining one does not
+    // disturb the blocks of another.
+    for (ColdRegion &Region : Regions) {
+      SILFunction *OutFn = outlineRegion(F, Region);
+      notifyAddFunction(OutFn, nullptr);
+    }
+    invalidateAnalysis(SILAnalysis::InvalidationKind::FunctionBody);
+  }
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createColdPathOutlining() {
+  return new ColdPathOutlining();
+}
@@ -43,12 +43,19 @@
 #include "swift/SIL/DebugUtils.h"
 #include "swift/SIL/SILFunction.h"
 #include "swift/SIL/SILCloner.h"
+#include "swift/SIL/SILOpenedArchetypesTracker.h"
 #include "swift/SIL/SILValue.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 
 using namespace swift;
 
+llvm::cl::opt<bool> EnableModuleSignatureOpts(
+    "sil-module-signature-opts", llvm::cl::init(false),
+    llvm::cl::desc("Run function signature optimization module-wide to a "
+                   "fixed point, inlining the resulting thunks eagerly"));
+
 STATISTIC(NumFunctionSignaturesOptimized, "Total func sig optimized");
 STATISTIC(NumDeadArgsEliminated, "Total dead args eliminated");
 STATISTIC(NumOwnedConvertedToGuaranteed, "Total owned args -> guaranteed args");
@@ -1131,9 +1138,82 @@ void FunctionSignatureTransform::ArgumentExplosionFinalizeOptimizedFunction() {
 //===----------------------------------------------------------------------===//
 //                           Top Level Entry Point
 //===----------------------------------------------------------------------===//
+
+/// Attempt to optimize the signature of \p F. If anything was done, \p F is
+/// turned into an always-inline thunk and the newly created optimized
+/// function is returned; otherwise returns null.
+static SILFunction *
+tryOptimizeSignature(SILFunction *F, RCIdentityAnalysis *RCIA,
+                     EpilogueARCAnalysis *EA,
+                     const CallerAnalysis::FunctionInfo &FuncInfo,
+                     bool OptForPartialApply) {
+  // Don't run function signature optimizations at -Os.
+  if (F->optimizeForSize())
+    return nullptr;
+
+  // Don't optimize callees that should not be optimized.
+  if (!F->shouldOptimize())
+    return nullptr;
+
+  // This is the function to optimize.
+  DEBUG(llvm::dbgs() << "*** FSO on function: " << F->getName() << " ***\n");
+
+  // Check the signature of F to make sure that it is a function that we
+  // can specialize. These are conditions independent of the call graph.
+  if (!canSpecializeFunction(F, OptForPartialApply ? &FuncInfo : nullptr,
+                             OptForPartialApply)) {
+    DEBUG(llvm::dbgs() << "  cannot specialize function -> abort\n");
+    return nullptr;
+  }
+
+  // As we optimize the function more and more, the name of the function is
+  // going to change, make sure the mangler is aware of all the changes done
+  // to the function.
+  auto P = Demangle::SpecializationPass::FunctionSignatureOpts;
+  Mangle::FunctionSignatureSpecializationMangler Mangler(P,
+                                                         F->isSerialized(), F);
+
+  /// Keep a map between the exploded argument index and the original argument
+  /// index.
+  llvm::SmallDenseMap<int, int> AIM;
+  int asize = F->begin()->getArguments().size();
+  for (auto i = 0; i < asize; ++i) {
+    AIM[i] = i;
+  }
+
+  // Allocate the argument and result descriptors.
+  llvm::SmallVector<ArgumentDescriptor, 4> ArgumentDescList;
+  llvm::SmallVector<ResultDescriptor, 4> ResultDescList;
+  auto Args = F->begin()->getFunctionArguments();
+  for (unsigned i = 0, e = Args.size(); i != e; ++i) {
+    ArgumentDescList.emplace_back(Args[i]);
+  }
+  for (SILResultInfo IR : F->getLoweredFunctionType()->getResults()) {
+    ResultDescList.emplace_back(IR);
+  }
+
+  // Owned to guaranteed optimization.
+  FunctionSignatureTransform FST(F, RCIA, EA, Mangler, AIM,
+                                 ArgumentDescList, ResultDescList);
+
+  bool Changed = false;
+  if (OptForPartialApply) {
+    Changed = FST.removeDeadArgs(FuncInfo.getMinPartialAppliedArgs());
+  } else {
+    Changed = FST.run(FuncInfo.hasCaller());
+  }
+  if (!Changed)
+    return nullptr;
+
+  ++NumFunctionSignaturesOptimized;
+  // The old function must be a thunk now.
+  assert(F->isThunk() && "Old function should have been turned into a thunk");
+  return FST.getOptimizedFunction();
+}
+
 namespace {
 class FunctionSignatureOpts : public SILFunctionTransform {
-  
+
   /// If true, perform a special kind of dead argument elimination to enable
   /// removal of partial_apply instructions where all partially applied
   /// arguments are dead.
@@ -1147,95 +1227,135 @@ public:
   void run() override {
     auto *F = getFunction();
 
-    // Don't run function signature optimizations at -Os.
-    if (F->optimizeForSize())
-      return;
+    CallerAnalysis *CA = PM->getAnalysis<CallerAnalysis>();
+    auto *RCIA = getAnalysis<RCIdentityAnalysis>();
+    auto *EA = PM->getAnalysis<EpilogueARCAnalysis>();
 
-    // Don't optimize callees that should not be optimized.
-    if (!F->shouldOptimize())
+    SILFunction *NewF = tryOptimizeSignature(F, RCIA, EA, CA->getCallerInfo(F),
+                                             OptForPartialApply);
+    if (!NewF)
       return;
 
-    // This is the function to optimize.
-    DEBUG(llvm::dbgs() << "*** FSO on function: " << F->getName() << " ***\n");
+    invalidateAnalysis(SILAnalysis::InvalidationKind::Everything);
 
-    // Check the signature of F to make sure that it is a function that we
-    // can specialize. These are conditions independent of the call graph.
-    // No need for CallerAnalysis if we are not optimizing for partial
-    // applies.
-    if (!OptForPartialApply &&
-        !canSpecializeFunction(F, nullptr, OptForPartialApply)) {
-      DEBUG(llvm::dbgs() << "  cannot specialize function -> abort\n");
-      return;
+    // Make sure the PM knows about this function. This will also help us
+    // with self-recursion.
+    notifyAddFunction(NewF, F);
+
+    if (!OptForPartialApply) {
+      // We have to restart the pipeline for this thunk in order to run the
+      // inliner (and other opts) again. This is important if the new
+      // specialized function (which is called from this thunk) is
+      // function-signature-optimized again and also becomes an
+      // always-inline-thunk.
+      restartPassPipeline();
     }
+  }
 
-    CallerAnalysis *CA = PM->getAnalysis<CallerAnalysis>();
-    const CallerAnalysis::FunctionInfo &FuncInfo = CA->getCallerInfo(F);
+};
+
+/// A module-scope fixed-point driver for the signature transforms above.
+///
+/// FunctionSignatureOpts only sees one function per invocation: the
+/// always-inline thunk it leaves behind keeps all caller-side arguments
+/// alive, so a dead argument exposed in a caller by optimizing its callee is
+/// only removed after the pass pipeline has been restarted and the inliner
+/// has cleaned up the thunk. This pass instead iterates the whole module to
+/// a fixed point: each round optimizes every eligible function and then
+/// inlines the new thunks into all of their callers in one batch, so chains
+/// of internal-linkage utility functions are cleaned up in a single run.
+class ModuleSignatureOpts : public SILModuleTransform {
+
+  /// Bounds the number of optimize-and-inline rounds. Each round removes at
+  /// least one argument from the call chain it is working on, so in practice
+  /// the fixed point is reached much earlier.
+  static constexpr unsigned MaxRounds = 10;
 
-    // Check the signature of F to make sure that it is a function that we
-    // can specialize. These are conditions independent of the call graph.
-    if (OptForPartialApply &&
-        !canSpecializeFunction(F, &FuncInfo, OptForPartialApply)) {
-      DEBUG(llvm::dbgs() << "  cannot specialize function -> abort\n");
+  void run() override {
+    if (!EnableModuleSignatureOpts)
       return;
-    }
 
-    auto *RCIA = getAnalysis<RCIdentityAnalysis>();
+    SILModule &M = *getModule();
+    CallerAnalysis *CA = PM->getAnalysis<CallerAnalysis>();
+    auto *RCIA = PM->getAnalysis<RCIdentityAnalysis>();
     auto *EA = PM->getAnalysis<EpilogueARCAnalysis>();
 
-    // As we optimize the function more and more, the name of the function is
-    // going to change, make sure the mangler is aware of all the changes done
-    // to the function.
-    auto P = Demangle::SpecializationPass::FunctionSignatureOpts;
-    Mangle::FunctionSignatureSpecializationMangler Mangler(P,
-                                                           F->isSerialized(), F);
-
-    /// Keep a map between the exploded argument index and the original argument
-    /// index.
-    llvm::SmallDenseMap<int, int> AIM;
-    int asize = F->begin()->getArguments().size();
-    for (auto i = 0; i < asize; ++i) {
-      AIM[i] = i;
-    }
-
-    // Allocate the argument and result descriptors.
-    llvm::SmallVector<ArgumentDescriptor, 4> ArgumentDescList;
-    llvm::SmallVector<ResultDescriptor, 4> ResultDescList;
-    auto Args = F->begin()->getFunctionArguments();
-    for (unsigned i = 0, e = Args.size(); i != e; ++i) {
-      ArgumentDescList.emplace_back(Args[i]);
-    }
-    for (SILResultInfo IR : F->getLoweredFunctionType()->getResults()) {
-      ResultDescList.emplace_back(IR);
-    }
+    for (unsigned Round = 0; Round < MaxRounds; ++Round) {
+      // Optimize the signature of every eligible function. Iterate over a
+      // snapshot since the transform adds the optimized functions to the
+      // module.
+      llvm::SmallVector<SILFunction *, 32> Functions;
+      for (auto &F : M)
+        Functions.push_back(&F);
+
+      llvm::SmallPtrSet<SILFunction *, 16> Thunks;
+      for (SILFunction *F : Functions) {
+        if (F->isExternalDeclaration())
+          continue;
+        SILFunction *NewF =
+            tryOptimizeSignature(F, RCIA, EA, CA->getCallerInfo(F),
+                                 /*OptForPartialApply*/ false);
+        if (!NewF)
+          continue;
+
+        Thunks.insert(F);
+        invalidateAnalysis(F, SILAnalysis::InvalidationKind::Everything);
+        notifyAddFunction(NewF, F);
+      }
 
-    // Owned to guaranteed optimization.
-    FunctionSignatureTransform FST(F, RCIA, EA, Mangler, AIM,
-                                   ArgumentDescList, ResultDescList);
+      // Fixed point reached.
+      if (Thunks.empty())
+        break;
 
-    bool Changed = false;
-    if (OptForPartialApply) {
-      Changed = FST.removeDeadArgs(FuncInfo.getMinPartialAppliedArgs());
-    } else {
-      Changed = FST.run(FuncInfo.hasCaller());
-    }
-    if (Changed) {
-      ++ NumFunctionSignaturesOptimized;
-      // The old function must be a thunk now.
-      assert(F->isThunk() && "Old function should have been turned into a thunk");
-
-      invalidateAnalysis(SILAnalysis::InvalidationKind::Everything);
-
-      // Make sure the PM knows about this function. This will also help us
-      // with self-recursion.
-      notifyAddFunction(FST.getOptimizedFunction(), F);
-
-      if (!OptForPartialApply) {
-        // We have to restart the pipeline for this thunk in order to run the
-        // inliner (and other opts) again. This is important if the new
-        // specialized function (which is called from this thunk) is
-        // function-signature-optimized again and also becomes an
-        // always-inline-thunk.
-        restartPassPipeline();
+      // Update all call sites in one batch: inline the new always-inline
+      // thunks so that the next round sees the optimized signatures in the
+      // callers.
+      for (auto &Caller : M) {
+        if (Caller.isExternalDeclaration() || !Caller.shouldOptimize())
+          continue;
+        // Inlining a thunk would drag a reference to the (possibly shared)
+        // optimized function into a fragile function.
+        if (Caller.isSerialized())
+          continue;
+
+        // Collect the apply sites first; inlining invalidates iterators.
+        SmallVector<FullApplySite, 8> ApplySites;
+        for (auto &BB : Caller) {
+          for (auto &I : BB) {
+            auto AI = FullApplySite::isa(&I);
+            if (!AI)
+              continue;
+            SILFunction *Callee = AI.getReferencedFunction();
+            if (Callee && Thunks.count(Callee))
+              ApplySites.push_back(AI);
+          }
+        }
+        if (ApplySites.empty())
+          continue;
+
+        for (FullApplySite AI : ApplySites) {
+          SILFunction *Callee = AI.getReferencedFunction();
+
+          SmallVector<SILValue, 8> Args;
+          for (const auto &Arg : AI.getArguments())
+            Args.push_back(Arg);
+
+          SILOpenedArchetypesTracker OpenedArchetypesTracker(&Caller);
+          M.registerDeleteNotificationHandler(&OpenedArchetypesTracker);
+          // The callee only needs to know about opened archetypes used in
+          // the substitution list.
+          OpenedArchetypesTracker.registerUsedOpenedArchetypes(
+              AI.getInstruction());
+
+          SILInliner Inliner(Caller, *Callee,
+                             SILInliner::InlineKind::PerformanceInline,
+                             AI.getSubstitutions(), OpenedArchetypesTracker);
+          Inliner.inlineFunction(AI, Args);
+          recursivelyDeleteTriviallyDeadInstructions(AI.getInstruction(),
+                                                     true);
+        }
+        invalidateAnalysis(&Caller,
+                           SILAnalysis::InvalidationKind::Everything);
       }
     }
   }
@@ -1251,3 +1371,7 @@ SILTransform *swift::createFunctionSignatureOpts() {
 SILTransform *swift::createDeadArgSignatureOpt() {
   return new FunctionSignatureOpts(/* OptForPartialApply */ true);
 }
+
+SILTransform *swift::createModuleSignatureOpts() {
+  return new ModuleSignatureOpts();
+}
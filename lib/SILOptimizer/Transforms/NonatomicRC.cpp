@@ -0,0 +1,111 @@
+//===--- NonatomicRC.cpp - Nonatomic refcounting for local objects --------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Converts reference counting operations on provably thread-local objects
+// into nonatomic ones.
+//
+// Unlike AssumeSingleThreaded, which flips every refcount operation based on
+// a compiler flag, this pass proves thread-locality per object: the
+// RC identity root of the operand must be an allocation in the current
+// function and its connection-graph node must not escape. If no reference to
+// the object can leave the function, no other thread can ever observe its
+// refcount, so the atomic ordering is not needed. Mixing nonatomic with
+// atomic operations on such an object (e.g. in a callee which received it as
+// a guaranteed argument) is fine, because the guarantee we rely on is the
+// absence of concurrent access, not a uniform instruction form.
+//
+//===----------------------------------------------------------------------===//
+
+#define DEBUG_TYPE "nonatomic-rc"
+
+#include "swift/SILOptimizer/PassManager/Passes.h"
+#include "swift/SILOptimizer/PassManager/Transforms.h"
+#include "swift/SILOptimizer/Analysis/EscapeAnalysis.h"
+#include "swift/SILOptimizer/Analysis/RCIdentityAnalysis.h"
+#include "swift/SIL/SILFunction.h"
+#include "swift/SIL/SILInstruction.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Support/Debug.h"
+
+STATISTIC(NumNonatomicRC, "Number of refcount operations made nonatomic");
+
+using namespace swift;
+
+/// Returns true if the object \p V refers to cannot be accessed from another
+/// thread: it is allocated in \p F and no reference to it escapes \p F.
+static bool isThreadLocalObject(SILValue V, RCIdentityFunctionInfo *RCIA,
+                                EscapeAnalysis *EA,
+                                EscapeAnalysis::ConnectionGraph *ConGraph) {
+  SILValue Root = RCIA->getRCIdentityRoot(V);
+
+  // Only objects which are allocated in this function can be known to be
+  // thread-local. Arguments and loaded references may be shared already.
+  if (!isa<AllocRefInst>(Root) && !isa<AllocRefDynamicInst>(Root) &&
+      !isa<AllocBoxInst>(Root))
+    return false;
+
+  auto *Node = ConGraph->getNodeOrNull(Root, EA);
+  if (!Node)
+    return false;
+
+  // If the object escapes, another thread may retain or release it
+  // concurrently.
+  return !Node->escapes();
+}
+
+namespace {
+
+class NonatomicRC : public SILFunctionTransform {
+
+  /// The entry point to the transformation.
+  void run() override {
+    SILFunction *F = getFunction();
+
+    auto *RCIA = PM->getAnalysis<RCIdentityAnalysis>()->get(F);
+    auto *EA = PM->getAnalysis<EscapeAnalysis>();
+    auto *ConGraph = EA->getConnectionGraph(F);
+
+    bool Changed = false;
+    for (auto &BB : *F) {
+      for (auto &I : BB) {
+        if (auto *RCInst = dyn_cast<RefCountingInst>(&I)) {
+          if (RCInst->isNonAtomic())
+            continue;
+          if (isThreadLocalObject(RCInst->getOperand(0), RCIA, EA, ConGraph)) {
+            DEBUG(llvm::dbgs() << "Make nonatomic " << *RCInst);
+            RCInst->setNonAtomic();
+            ++NumNonatomicRC;
+            Changed = true;
+          }
+        } else if (auto *PinInst = dyn_cast<StrongPinInst>(&I)) {
+          if (PinInst->isNonAtomic())
+            continue;
+          if (isThreadLocalObject(PinInst->getOperand(), RCIA, EA, ConGraph)) {
+            DEBUG(llvm::dbgs() << "Make nonatomic " << *PinInst);
+            PinInst->setNonAtomic();
+            ++NumNonatomicRC;
+            Changed = true;
+          }
+        }
+      }
+    }
+    if (Changed)
+      invalidateAnalysis(SILAnalysis::InvalidationKind::Instructions);
+  }
+
+};
+
+} // end anonymous namespace
+
+SILTransform *swift::createNonatomicRC() {
+  return new NonatomicRC();
+}
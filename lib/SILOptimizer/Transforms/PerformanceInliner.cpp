@@ -35,6 +35,17 @@ llvm::cl::opt<bool> EnableSILInliningOfGenerics(
   "sil-inline-generics", llvm::cl::init(false),
   llvm::cl::desc("Enable inlining of generics"));
 
+llvm::cl::opt<int> ProfileDominanceThresholdPercent(
+    "sil-inline-profile-dominance-percent", llvm::cl::init(80),
+    llvm::cl::desc("Minimum percentage of a callee's profiled entry count a "
+                   "call site must account for to be inlined on profile "
+                   "grounds"));
+
+llvm::cl::opt<unsigned long long> HotCallSiteCount(
+    "sil-inline-hot-callsite-count", llvm::cl::init(100),
+    llvm::cl::desc("Call sites executed at least this often are inlined "
+                   "regardless of size when the callee has no profile"));
+
 //===----------------------------------------------------------------------===//
 //                           Performance Inliner
 //===----------------------------------------------------------------------===//
@@ -202,7 +213,7 @@ bool SILPerformanceInliner::profileBasedDecision(
     // If we have Callee count - use SI heuristic:
     auto calleCountVal = calleeCount.getValue();
     auto percent = (long double)callerCount / (long double)calleCountVal;
-    if (percent < 0.8) {
+    if (percent * 100 < (long double)ProfileDominanceThresholdPercent) {
       DEBUG(dumpCaller(AI.getFunction());
             llvm::dbgs() << "profiled decision: NO"
                          << ", reason=SI " << std::to_string(percent) << "%"
@@ -215,7 +226,7 @@ bool SILPerformanceInliner::profileBasedDecision(
                                                      << "%" << '\n';);
   } else {
     // No callee count - use a "modified" aggressive IHF for now
-    if (CalleeCost > Benefit && callerCount < 100) {
+    if (CalleeCost > Benefit && callerCount < HotCallSiteCount) {
       DEBUG(dumpCaller(AI.getFunction());
             llvm::dbgs() << "profiled decision: NO"
                          << ", reason=IHF " << callerCount << '\n';);
@@ -172,13 +172,19 @@ namespace {
 /// # of BBs x(times) # of locations.
 ///
 /// we could run RLE on functions with 128 basic blocks and 128 locations,
-/// which is a large function.  
+/// which is a large function.
 constexpr unsigned MaxLSLocationBBMultiplicationNone = 128*128;
 
 /// we could run optimistic RLE on functions with less than 64 basic blocks
 /// and 64 locations which is a sizable function.
 constexpr unsigned MaxLSLocationBBMultiplicationPessimistic = 64*64;
 
+/// Above MaxLSLocationBBMultiplicationNone we cannot afford the iterative
+/// data flow anymore, but a single pessimistic iteration is still linear in
+/// the function size and catches the locally redundant loads. Only give up
+/// completely on really huge functions.
+constexpr unsigned MaxLSLocationBBMultiplicationOneIteration = 256*256;
+
 /// forward declaration.
 class RLEContext;
 
@@ -1118,10 +1124,15 @@ getProcessFunctionKind(unsigned LoadCount, unsigned StoreCount) {
     HandledBBs.insert(B);
   }
 
-  // Data flow may take too long to run.
-  if (BBCount * LocationCount > MaxLSLocationBBMultiplicationNone)
+  // Even a single iteration may take too long to run.
+  if (BBCount * LocationCount > MaxLSLocationBBMultiplicationOneIteration)
     return ProcessKind::ProcessNone;
 
+  // The iterative data flow may take too long to run. Degrade to a single
+  // pessimistic iteration instead of not optimizing the function at all.
+  if (BBCount * LocationCount > MaxLSLocationBBMultiplicationNone)
+    return ProcessKind::ProcessOneIteration;
+
   // This function's data flow would converge in 1 iteration.
   if (RunOneIteration)
     return ProcessKind::ProcessOneIteration;
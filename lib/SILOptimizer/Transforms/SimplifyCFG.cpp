@@ -664,13 +664,13 @@ bool SimplifyCFG::dominatorBasedSimplify(DominanceAnalysis *DA) {
 
     // Do dominator based simplification of terminator condition. This does not
     // and MUST NOT change the CFG without updating the dominator tree to
-    // reflect such change.
+    // reflect such change. The jump-threading updates the dominator tree
+    // incrementally as it redirects edges, so no recomputation is needed here.
     if (tryCheckedCastBrJumpThreading(&Fn, DT, BlocksForWorklist)) {
       for (auto BB: BlocksForWorklist)
         addToWorklist(BB);
 
       HasChangedInCurrentIter = true;
-      DT->recalculate(Fn);
     }
     BlocksForWorklist.clear();
 
@@ -322,6 +322,33 @@ static bool isDefaultCaseKnown(ClassHierarchyAnalysis *CHA,
   return true;
 }
 
+/// \brief Returns true, if whole-module analysis proves that every class in
+/// the hierarchy rooted at \p CD uses the same implementation of the invoked
+/// method, so the call can be devirtualized unconditionally without any
+/// speculative checks.
+///
+/// \p CHA class hierarchy analysis to be used
+/// \p AI  invocation instruction
+/// \p CD  static class of the instance whose method is being invoked
+/// \p Subs set of all known subclasses of this class
+static bool hasSingleKnownImplementation(ClassHierarchyAnalysis *CHA,
+                                         FullApplySite AI, ClassDecl *CD,
+                                         ClassHierarchyAnalysis::ClassList &Subs) {
+  ClassMethodInst *CMI = cast<ClassMethodInst>(AI.getCallee());
+  auto *Method = CMI->getMember().getFuncDecl();
+
+  // A subclass with its own override needs a run-time check.
+  for (auto S : Subs)
+    if (S->findOverridingDecl(Method))
+      return false;
+
+  // Otherwise the call can be devirtualized if the hierarchy is sealed,
+  // i.e. no new subclasses can show up at run time or in other modules.
+  // isDefaultCaseKnown also proves that all indirect subclasses inherit
+  // the implementation of the static class.
+  return isDefaultCaseKnown(CHA, AI, CD, Subs);
+}
+
 /// \brief Try to speculate the call target for the call \p AI. This function
 /// returns true if a change was made.
 static bool tryToSpeculateTarget(FullApplySite AI, ClassHierarchyAnalysis *CHA,
@@ -383,6 +410,42 @@ static bool tryToSpeculateTarget(FullApplySite AI, ClassHierarchyAnalysis *CHA,
   SmallVector<ClassDecl *, 8> Subs;
   getAllSubclasses(CHA, CD, ClassType, M, Subs);
 
+  // If whole-module analysis proves that every class in the hierarchy uses
+  // the same implementation of the invoked method, there is no need to
+  // speculate at all: devirtualize the call unconditionally.
+  if (hasSingleKnownImplementation(CHA, AI, CD, Subs)) {
+    DEBUG(llvm::dbgs() << "Devirtualizing the single known implementation "
+                          "for the sealed hierarchy of class "
+                       << CD->getName() << "\n");
+    auto NewInstPair = tryDevirtualizeClassMethod(AI, SubTypeValue, &ORE);
+    if (NewInstPair.second.getInstruction()) {
+      if (NewInstPair.first)
+        replaceDeadApply(AI, NewInstPair.first);
+      return true;
+    }
+  }
+
+  // Order the speculative checks by the entry counts of the corresponding
+  // method implementations, so that with profile data the most probable
+  // dynamic types are matched by the earliest checked_cast_br checks and
+  // survive the cut-off below.
+  llvm::SmallDenseMap<ClassDecl *, uint64_t, 8> EntryCounts;
+  for (auto S : Subs) {
+    uint64_t Count = 0;
+    if (!S->isGenericContext()) {
+      CanType CanClassType = S->getDeclaredInterfaceType()->getCanonicalType();
+      SILType SubClassType = SILType::getPrimitiveObjectType(CanClassType);
+      if (SILFunction *Impl = getTargetClassMethod(M, SubClassType, CMI))
+        if (auto ImplCount = Impl->getEntryCount())
+          Count = ImplCount.getValue();
+    }
+    EntryCounts[S] = Count;
+  }
+  std::stable_sort(Subs.begin(), Subs.end(),
+                   [&](ClassDecl *LHS, ClassDecl *RHS) {
+                     return EntryCounts[LHS] > EntryCounts[RHS];
+                   });
+
   // Number of subclasses which cannot be handled by checked_cast_br checks.
   int NotHandledSubsNum = 0;
   if (Subs.size() > MaxNumSpeculativeTargets) {
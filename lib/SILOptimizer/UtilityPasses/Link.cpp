@@ -13,9 +13,20 @@
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SIL/SILModule.h"
+#include "llvm/Support/CommandLine.h"
 
 using namespace swift;
 
+// Deserializing the transitive closure of the stdlib SIL just to let
+// DeadFunctionElimination delete most of it again costs every optimized
+// compilation real time. With lazy linking the eager linker pass becomes a
+// no-op and serialized function bodies are only deserialized when a pass
+// (e.g. the devirtualizer or the performance inliner) actually requests them.
+llvm::cl::opt<bool> EnableLazyLinking(
+    "sil-lazy-linking", llvm::cl::init(false),
+    llvm::cl::desc("Deserialize serialized SIL on demand instead of eagerly "
+                   "linking everything transitively referenced"));
+
 //===----------------------------------------------------------------------===//
 //                          Top Level Driver
 //===----------------------------------------------------------------------===//
@@ -41,6 +52,11 @@ namespace {
 class SILLinker : public SILModuleTransform {
 
   void run() override {
+    // In lazy linking mode function bodies are deserialized on demand by the
+    // passes that need them.
+    if (EnableLazyLinking)
+      return;
+
     SILModule &M = *getModule();
     for (auto &Fn : M)
       if (M.linkFunction(&Fn, SILModule::LinkingMode::LinkAll))
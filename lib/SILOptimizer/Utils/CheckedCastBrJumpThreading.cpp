@@ -85,9 +85,16 @@ class CheckedCastBrJumpThreading {
       SuccessArg(SuccessArg), InvertSuccess(InvertSuccess),
       hasUnknownPreds(hasUnknownPreds) { }
 
-    void modifyCFGForUnknownPreds();
-    void modifyCFGForFailurePreds(Optional<BasicBlockCloner> &Cloner);
-    void modifyCFGForSuccessPreds(Optional<BasicBlockCloner> &Cloner);
+    void modifyCFGForUnknownPreds(DominanceInfo *DT);
+    void modifyCFGForFailurePreds(Optional<BasicBlockCloner> &Cloner,
+                                  DominanceInfo *DT);
+    void modifyCFGForSuccessPreds(Optional<BasicBlockCloner> &Cloner,
+                                  DominanceInfo *DT);
+
+    /// Update the dominator tree for a single redirected edge: \p Pred used
+    /// to branch to CCBBlock and now branches to \p NewTarget instead.
+    void updateDomTreeForRedirectedEdge(DominanceInfo *DT, SILBasicBlock *Pred,
+                                        SILBasicBlock *NewTarget);
   };
 
   // Contains an entry for each checked_cast_br to be optimized.
@@ -221,7 +228,20 @@ SILValue CheckedCastBrJumpThreading::isArgValueEquivalentToCondition(
   }
 }
 
-void CheckedCastBrJumpThreading::Edit::modifyCFGForUnknownPreds() {
+/// Incrementally update the dominator tree after an edge from Pred to
+/// CCBBlock has been redirected to NewTarget. Both updates refer to the same
+/// terminator rewrite, so the CFG is already in its final shape here.
+void CheckedCastBrJumpThreading::Edit::
+updateDomTreeForRedirectedEdge(DominanceInfo *DT, SILBasicBlock *Pred,
+                               SILBasicBlock *NewTarget) {
+  if (!DT)
+    return;
+  DT->insertEdge(Pred, NewTarget);
+  DT->deleteEdge(Pred, CCBBlock);
+}
+
+void CheckedCastBrJumpThreading::Edit::
+modifyCFGForUnknownPreds(DominanceInfo *DT) {
   if (!hasUnknownPreds)
     return;
   // Check the FailureBB if it is a BB that contains a class_method
@@ -232,9 +252,12 @@ void CheckedCastBrJumpThreading::Edit::modifyCFGForUnknownPreds() {
   if (auto *CMI = dyn_cast<ClassMethodInst>(Inst)) {
     if (CMI->getOperand() == stripClassCasts(CCBI->getOperand())) {
       // Replace checked_cast_br by branch to FailureBB.
+      auto *SuccessBB = CCBI->getSuccessBB();
       SILBuilder(CCBI->getParent()).createBranch(CCBI->getLoc(),
                                                  CCBI->getFailureBB());
       CCBI->eraseFromParent();
+      if (DT)
+        DT->deleteEdge(CCBBlock, SuccessBB);
     }
   }
 }
@@ -242,7 +265,8 @@ void CheckedCastBrJumpThreading::Edit::modifyCFGForUnknownPreds() {
 /// Create a copy of the BB as a landing BB
 /// for all FailurePreds.
 void CheckedCastBrJumpThreading::Edit::
-modifyCFGForFailurePreds(Optional<BasicBlockCloner> &Cloner) {
+modifyCFGForFailurePreds(Optional<BasicBlockCloner> &Cloner,
+                         DominanceInfo *DT) {
   if (FailurePreds.empty())
     return;
 
@@ -256,27 +280,34 @@ modifyCFGForFailurePreds(Optional<BasicBlockCloner> &Cloner) {
   auto *CCBI = cast<CheckedCastBranchInst>(CCBBlock->getTerminator());
   Builder.createBranch(TI->getLoc(), CCBI->getFailureBB());
   TI->eraseFromParent();
-  splitIfCriticalEdge(CCBBlock, CCBI->getFailureBB());
+  splitIfCriticalEdge(CCBBlock, CCBI->getFailureBB(), DT);
 
-  // Redirect all FailurePreds to the copy of BB.
+  // Redirect all FailurePreds to the copy of BB. The copy becomes reachable
+  // with the first redirected edge; the incremental dominator-tree update
+  // inserts it into the tree at that point.
   for (auto *Pred : FailurePreds) {
     TermInst *TI = Pred->getTerminator();
     // Replace branch to BB by branch to TargetFailureBB.
     replaceBranchTarget(TI, CCBBlock, TargetFailureBB,
     /*PreserveArgs=*/true);
+    updateDomTreeForRedirectedEdge(DT, Pred, TargetFailureBB);
   }
 }
 
 /// Create a copy of the BB or reuse BB as
 /// a landing basic block for all FailurePreds.
 void CheckedCastBrJumpThreading::Edit::
-modifyCFGForSuccessPreds(Optional<BasicBlockCloner> &Cloner) {
+modifyCFGForSuccessPreds(Optional<BasicBlockCloner> &Cloner,
+                         DominanceInfo *DT) {
   auto *CCBI = cast<CheckedCastBranchInst>(CCBBlock->getTerminator());
 
   if (InvertSuccess) {
+    auto *SuccessBB = CCBI->getSuccessBB();
     SILBuilder B(CCBBlock);
     B.createBranch(CCBI->getLoc(), CCBI->getFailureBB());
     CCBI->eraseFromParent();
+    if (DT)
+      DT->deleteEdge(CCBBlock, SuccessBB);
     return;
   }
   if (hasUnknownPreds) {
@@ -293,13 +324,14 @@ modifyCFGForSuccessPreds(Optional<BasicBlockCloner> &Cloner) {
       // Take argument value from the dominating BB.
       Builder.createBranch(TI->getLoc(), CCBI->getSuccessBB(), {SuccessArg});
       TI->eraseFromParent();
-      splitIfCriticalEdge(CCBBlock, CCBI->getSuccessBB());
+      splitIfCriticalEdge(CCBBlock, CCBI->getSuccessBB(), DT);
 
       // Redirect all SuccessPreds to the copy of BB.
       for (auto *Pred : SuccessPreds) {
         TermInst *TI = Pred->getTerminator();
         // Replace branch to BB by branch to TargetSuccessBB.
         replaceBranchTarget(TI, CCBBlock, TargetSuccessBB, /*PreserveArgs=*/true);
+        updateDomTreeForRedirectedEdge(DT, Pred, TargetSuccessBB);
       }
     }
     return;
@@ -312,9 +344,12 @@ modifyCFGForSuccessPreds(Optional<BasicBlockCloner> &Cloner) {
 
   // Add an unconditional jump at the end of the block.
   // Take argument value from the dominating BB
+  auto *FailureBB = CCBI->getFailureBB();
   SILBuilder(CCBBlock).createBranch(CCBI->getLoc(), CCBI->getSuccessBB(),
                               {SuccessArg});
   CCBI->eraseFromParent();
+  if (DT)
+    DT->deleteEdge(CCBBlock, FailureBB);
 }
 
 /// Handle a special case, where ArgBB is the entry block.
@@ -667,21 +702,23 @@ void CheckedCastBrJumpThreading::optimizeFunction() {
     return;
 
   // Second phase: transformation.
+  // The dominator tree is kept up-to-date incrementally during this phase, so
+  // the caller does not need to recompute it afterwards.
   // Remove critical edges for the SSA-updater. We do this once and keep the
   // CFG critical-edge free during our transformations.
-  splitAllCriticalEdges(*Fn, true, nullptr, nullptr);
+  splitAllCriticalEdges(*Fn, true, DT, nullptr);
 
   for (Edit *edit : Edits) {
     Optional<BasicBlockCloner> Cloner;
 
     // Create a copy of the BB as a landing BB
     // for all FailurePreds.
-    edit->modifyCFGForFailurePreds(Cloner);
+    edit->modifyCFGForFailurePreds(Cloner, DT);
     // Create a copy of the BB or reuse BB as
     // a landing basic block for all SuccessPreds.
-    edit->modifyCFGForSuccessPreds(Cloner);
+    edit->modifyCFGForSuccessPreds(Cloner, DT);
     // Handle unknown preds.
-    edit->modifyCFGForUnknownPreds();
+    edit->modifyCFGForUnknownPreds(DT);
 
     if (Cloner.hasValue()) {
       updateSSAAfterCloning(*Cloner.getPointer(), Cloner->getDestBB(),
@@ -45,6 +45,13 @@ llvm::cl::opt<bool> SupportGenericSubstitutions(
     llvm::cl::init(false),
     llvm::cl::desc("Enable partial specialization with generic substitutions"));
 
+/// Set to true to reuse serialized specializations from imported modules
+/// instead of re-deriving (and re-optimizing) them in every client module.
+llvm::cl::opt<bool> EnableSpecializationReuseAcrossModules(
+    "sil-reuse-serialized-specializations", llvm::cl::init(false),
+    llvm::cl::desc("Deserialize shared generic specializations from imported "
+                   "modules instead of re-creating them"));
+
 /// Set to true to print detected infinite generic specialization loops that
 /// were prevented.
 llvm::cl::opt<bool> PrintGenericSpecializationLoops(
@@ -1824,6 +1831,25 @@ SILFunction *GenericFuncSpecializer::lookupSpecialization() {
                        << "\n");
     return SpecializedF;
   }
+
+  // Check whether an imported module already serialized this specialization.
+  // Serialized shared specializations carry their (optimized) bodies in the
+  // swiftmodule, so deserializing the clone is much cheaper than re-deriving
+  // it here and optimizing it from scratch.
+  if (EnableSpecializationReuseAcrossModules && Serialized &&
+      M.hasFunction(ClonedName)) {
+    if (M.linkFunction(ClonedName, SILModule::LinkingMode::LinkAll)) {
+      SILFunction *SpecializedF = M.lookUpFunction(ClonedName);
+      assert(SpecializedF && "Linked specialization should be in the module");
+      assert(ReInfo.getSpecializedType()
+             == SpecializedF->getLoweredFunctionType() &&
+             "Deserialized specialization does not match expected type.");
+      DEBUG(llvm::dbgs() << "Deserialized a specialization from an imported "
+                            "module: " << ClonedName << "\n");
+      return SpecializedF;
+    }
+  }
+
   DEBUG(llvm::dbgs() << "Could not find an existing specialization for: "
                      << ClonedName << "\n");
   return nullptr;
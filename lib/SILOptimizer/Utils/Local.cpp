@@ -174,7 +174,8 @@ namespace {
 
 void swift::
 recursivelyDeleteTriviallyDeadInstructions(ArrayRef<SILInstruction *> IA,
-                                           bool Force, CallbackTy Callback) {
+                                           bool Force,
+                                           const CallbackTy &Callback) {
   // Delete these instruction and others that become dead after it's deleted.
   llvm::SmallPtrSet<SILInstruction *, 8> DeadInsts;
   for (auto I : IA) {
@@ -234,14 +235,14 @@ recursivelyDeleteTriviallyDeadInstructions(ArrayRef<SILInstruction *> IA,
 ///        considered dead - delete it regardless.
 void swift::recursivelyDeleteTriviallyDeadInstructions(SILInstruction *I,
                                                        bool Force,
-                                                       CallbackTy Callback) {
+                                                       const CallbackTy &Callback) {
 
   ArrayRef<SILInstruction *> AI = ArrayRef<SILInstruction *>(I);
   recursivelyDeleteTriviallyDeadInstructions(AI, Force, Callback);
 }
 
 void swift::eraseUsesOfInstruction(SILInstruction *Inst,
-                                   CallbackTy Callback) {
+                                   const CallbackTy &Callback) {
   for (auto result : Inst->getResults()) {
     while (!result->use_empty()) {
       auto UI = result->use_begin();
@@ -696,6 +696,14 @@ SILFunction *swift::getEligibleFunction(FullApplySite AI,
     }
   }
 
+  // If the callee is a declaration whose body lives in a serialized module,
+  // deserialize it now. With lazy linking (see Link.cpp) the eager linker pass
+  // does not run, so the inliner is responsible for requesting the bodies it
+  // actually wants to look at.
+  if (Callee->isExternalDeclaration()) {
+    AI.getModule().linkFunction(Callee, SILModule::LinkingMode::LinkNormal);
+  }
+
   // We can't inline external declarations.
   if (Callee->empty() || Callee->isExternalDeclaration()) {
     return nullptr;
@@ -1365,7 +1365,29 @@ namespace {
                                       TVO_CanBindToInOut);
       ArrayRef<ValueDecl*> decls = expr->getDecls();
       SmallVector<OverloadChoice, 4> choices;
-      
+
+      // If this reference is the callee of a call whose argument labels
+      // were recorded, use them to drop candidates that cannot
+      // structurally accept the argument list, so the disjunction only
+      // ever contains choices the solver could actually pick.
+      Optional<ConstraintSystem::ArgumentLabelState> argumentLabels;
+      {
+        auto known = CS.ArgumentLabels.find(locator);
+        if (known != CS.ArgumentLabels.end())
+          argumentLabels = known->second;
+      }
+      auto hasCompatibleLabels = [&](ValueDecl *decl) -> bool {
+        if (!argumentLabels)
+          return true;
+
+        // Member operators take 'self' at the first parameter level.
+        unsigned parameterDepth =
+            decl->getDeclContext()->isTypeContext() ? 1 : 0;
+        return areConservativelyCompatibleArgumentLabels(
+            decl, parameterDepth, argumentLabels->Labels,
+            argumentLabels->HasTrailingClosure);
+      };
+
       for (unsigned i = 0, n = decls.size(); i != n; ++i) {
         // If the result is invalid, skip it.
         // FIXME: Note this as invalid, in case we don't find a solution,
@@ -1374,10 +1396,24 @@ namespace {
         if (decls[i]->isInvalid())
           continue;
 
+        if (!hasCompatibleLabels(decls[i]))
+          continue;
+
         choices.push_back(OverloadChoice(Type(), decls[i],
                                          expr->getFunctionRefKind()));
       }
 
+      // If the pre-filter dropped every candidate, fall back to the full
+      // set so diagnostics can explain why nothing matched.
+      if (choices.empty()) {
+        for (unsigned i = 0, n = decls.size(); i != n; ++i) {
+          if (decls[i]->isInvalid())
+            continue;
+          choices.push_back(OverloadChoice(Type(), decls[i],
+                                           expr->getFunctionRefKind()));
+        }
+      }
+
       // If there are no valid overloads, give up.
       if (choices.empty())
         return nullptr;
@@ -3275,6 +3311,18 @@ namespace {
         return { true, expr };
       }
 
+      // Operator applications have no labels, but recording their
+      // (empty) labels still communicates the call-site arity, which is
+      // enough to prune overloads of the wrong operand count.
+      if (auto apply = dyn_cast<ApplyExpr>(expr)) {
+        SmallVector<Identifier, 2> scratch;
+        associateArgumentLabels(apply->getFn(),
+                                { apply->getArgumentLabels(scratch),
+                                  /*hasTrailingClosure=*/false },
+                                /*labelsArePermanent=*/false);
+        return { true, expr };
+      }
+
       // FIXME: other expressions have argument labels, but this is an
       // optimization, so stage it in later.
       return { true, expr };
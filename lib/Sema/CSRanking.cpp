@@ -1175,11 +1175,45 @@ ConstraintSystem::findBestSolution(SmallVectorImpl<Solution> &viable,
 
   SolutionDiff diff(viable);
 
+  // Comparing two solutions is deterministic and symmetric — (j, i) is
+  // the exact mirror of (i, j) — so memoize results across the phases
+  // below rather than re-walking both solutions' overload choices for
+  // pairs we have already ranked.
+  llvm::DenseMap<std::pair<unsigned, unsigned>, SolutionCompareResult>
+    comparisonCache;
+  auto compare = [&](unsigned i, unsigned j) -> SolutionCompareResult {
+    auto known = comparisonCache.find({i, j});
+    if (known != comparisonCache.end())
+      return known->second;
+
+    auto result = compareSolutions(*this, viable, diff, i, j, weights);
+    comparisonCache[{i, j}] = result;
+
+    // Record the mirrored comparison as well.
+    auto mirrored = result;
+    switch (result) {
+    case SolutionCompareResult::Better:
+      mirrored = SolutionCompareResult::Worse;
+      break;
+
+    case SolutionCompareResult::Worse:
+      mirrored = SolutionCompareResult::Better;
+      break;
+
+    case SolutionCompareResult::Identical:
+    case SolutionCompareResult::Incomparable:
+      break;
+    }
+    comparisonCache[{j, i}] = mirrored;
+
+    return result;
+  };
+
   // Find a potential best.
   SmallVector<bool, 16> losers(viable.size(), false);
   unsigned bestIdx = 0;
   for (unsigned i = 1, n = viable.size(); i != n; ++i) {
-    switch (compareSolutions(*this, viable, diff, i, bestIdx, weights)) {
+    switch (compare(i, bestIdx)) {
     case SolutionCompareResult::Identical:
       // FIXME: Might want to warn about this in debug builds, so we can
       // find a way to eliminate the redundancy in the search space.
@@ -1203,7 +1237,7 @@ ConstraintSystem::findBestSolution(SmallVectorImpl<Solution> &viable,
     if (i == bestIdx)
       continue;
 
-    switch (compareSolutions(*this, viable, diff, bestIdx, i, weights)) {
+    switch (compare(bestIdx, i)) {
     case SolutionCompareResult::Identical:
       // FIXME: Might want to warn about this in debug builds, so we can
       // find a way to eliminate the redundancy in the search space.
@@ -1247,7 +1281,7 @@ ConstraintSystem::findBestSolution(SmallVectorImpl<Solution> &viable,
       if (losers[j])
         continue;
 
-      switch (compareSolutions(*this, viable, diff, i, j, weights)) {
+      switch (compare(i, j)) {
       case SolutionCompareResult::Identical:
         // FIXME: Dub one of these the loser arbitrarily?
         break;
@@ -2603,8 +2603,16 @@ ConstraintSystem::SolutionKind ConstraintSystem::simplifyConformsToConstraint(
       return recordConformance(*conformance);
     }
     break;
-  case ConstraintKind::ConformsTo:
   case ConstraintKind::LiteralConformsTo: {
+    // Literal constraints are almost always checked against the protocol's
+    // default literal type, whose conformance is pre-resolved and cached.
+    if (auto conformance =
+          TC.conformsToLiteralProtocol(type, protocol, DC)) {
+      return recordConformance(*conformance);
+    }
+    break;
+  }
+  case ConstraintKind::ConformsTo: {
     // Check whether this type conforms to the protocol.
     if (auto conformance =
           TC.conformsToProtocol(
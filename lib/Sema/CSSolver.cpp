@@ -809,6 +809,95 @@ ConstraintSystem::solveSingle(FreeTypeVariableBinding allowFreeTypeVariables) {
   return std::move(solutions[0]);
 }
 
+namespace {
+/// Computes a structural fingerprint of a shrink-candidate expression and
+/// collects its overload sets in preorder.
+///
+/// Two expressions with equal fingerprints are structurally identical for
+/// the purposes of the shrink pass: they reference the same declarations,
+/// spell the same literals, and use the same argument labels, so solving
+/// one reduces overload domains exactly as solving the other would.
+/// Constructs whose behavior is not captured by the fingerprint (casts,
+/// specializations, placeholders, etc.) make the expression ineligible.
+class ShrinkCandidateFingerprinter : public ASTWalker {
+  llvm::hash_code Hash = llvm::hash_value(0);
+  SmallVectorImpl<OverloadSetRefExpr *> &OverloadSets;
+  bool Eligible = true;
+
+  void combine(const void *Ptr) { Hash = llvm::hash_combine(Hash, Ptr); }
+  void combineName(DeclName Name) {
+    combine(Name.getBaseName().getAsOpaquePointer());
+    for (auto Arg : Name.getArgumentNames())
+      combine(Arg.getAsOpaquePointer());
+  }
+
+public:
+  explicit ShrinkCandidateFingerprinter(
+      SmallVectorImpl<OverloadSetRefExpr *> &overloadSets)
+      : OverloadSets(overloadSets) {}
+
+  std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
+    Hash = llvm::hash_combine(Hash, unsigned(E->getKind()));
+
+    if (auto *OSR = dyn_cast<OverloadSetRefExpr>(E)) {
+      OverloadSets.push_back(OSR);
+      for (auto *D : OSR->getDecls())
+        combine(D);
+    } else if (auto *DRE = dyn_cast<DeclRefExpr>(E)) {
+      combine(DRE->getDecl());
+    } else if (auto *MRE = dyn_cast<MemberRefExpr>(E)) {
+      combine(MRE->getMember().getDecl());
+    } else if (auto *UDE = dyn_cast<UnresolvedDotExpr>(E)) {
+      combineName(UDE->getName());
+    } else if (auto *UME = dyn_cast<UnresolvedMemberExpr>(E)) {
+      combineName(UME->getName());
+    } else if (auto *UDRE = dyn_cast<UnresolvedDeclRefExpr>(E)) {
+      combineName(UDRE->getName());
+    } else if (auto *TE = dyn_cast<TupleExpr>(E)) {
+      for (auto Name : TE->getElementNames())
+        combine(Name.getAsOpaquePointer());
+    } else if (auto *ILE = dyn_cast<IntegerLiteralExpr>(E)) {
+      Hash = llvm::hash_combine(Hash, ILE->getDigitsText());
+    } else if (auto *FLE = dyn_cast<FloatLiteralExpr>(E)) {
+      Hash = llvm::hash_combine(Hash, FLE->getDigitsText());
+    } else if (auto *SLE = dyn_cast<StringLiteralExpr>(E)) {
+      Hash = llvm::hash_combine(Hash, SLE->getValue());
+    } else if (auto *BLE = dyn_cast<BooleanLiteralExpr>(E)) {
+      Hash = llvm::hash_combine(Hash, BLE->getValue());
+    } else if (auto *MILE = dyn_cast<MagicIdentifierLiteralExpr>(E)) {
+      Hash = llvm::hash_combine(Hash, unsigned(MILE->getKind()));
+    } else if (isa<ExplicitCastExpr>(E) || isa<UnresolvedSpecializeExpr>(E) ||
+               isa<ObjectLiteralExpr>(E) || isa<KeyPathExpr>(E) ||
+               isa<EditorPlaceholderExpr>(E) || isa<CodeCompletionExpr>(E) ||
+               isa<ErrorExpr>(E)) {
+      // These carry semantic payload (types, placeholders) that the
+      // fingerprint does not capture.
+      Eligible = false;
+      return { false, nullptr };
+    }
+
+    return { true, E };
+  }
+
+  /// Finish the walk over \p E and return the fingerprint, combined with
+  /// the given contextual type and purpose, or None if the expression is
+  /// not eligible for memoization.
+  Optional<uint64_t> finish(Expr *E, Type CT, ContextualTypePurpose CTP) && {
+    E->walk(*this);
+    if (!Eligible)
+      return None;
+    Hash = llvm::hash_combine(
+        Hash, CT.isNull() ? nullptr : CT->getCanonicalType().getPointer(),
+        unsigned(CTP));
+    // Avoid the DenseMap key sentinels.
+    uint64_t Result = uint64_t(size_t(Hash));
+    if (Result == ~0ULL || Result == ~0ULL - 1)
+      Result = 1;
+    return Result;
+  }
+};
+} // end anonymous namespace
+
 bool ConstraintSystem::Candidate::solve(
     llvm::SmallDenseSet<OverloadSetRefExpr *> &shrunkExprs) {
   // Don't attempt to solve candidate if there is closure
@@ -826,6 +915,35 @@ bool ConstraintSystem::Candidate::solve(
   if (containsClosure)
     return false;
 
+  // If a structurally identical sub-expression with the same contextual
+  // type has already been solved, replay its overload domain reductions
+  // instead of solving again.  That is the only lasting effect solving a
+  // candidate has (assigned types are cleaned up below), so replaying is
+  // equivalent to re-solving.
+  SmallVector<OverloadSetRefExpr *, 4> overloadSets;
+  Optional<uint64_t> fingerprint =
+      ShrinkCandidateFingerprinter(overloadSets).finish(E, CT, CTP);
+  if (fingerprint) {
+    auto known = TC.ShrinkCache.find(*fingerprint);
+    if (known != TC.ShrinkCache.end() &&
+        known->second.NumOverloadSets == overloadSets.size()) {
+      auto &entry = known->second;
+      for (auto &indexAndDomain : entry.ReducedDomains) {
+        auto *OSR = overloadSets[indexAndDomain.first];
+        auto &choices = indexAndDomain.second;
+        if (OSR->getDecls().size() == choices.size())
+          continue;
+
+        MutableArrayRef<ValueDecl *> decls(
+            Allocator.Allocate<ValueDecl *>(choices.size()), choices.size());
+        std::copy(choices.begin(), choices.end(), decls.begin());
+        OSR->setDecls(decls);
+        shrunkExprs.insert(OSR);
+      }
+      return entry.HadNoSolutions;
+    }
+  }
+
   auto cleanupImplicitExprs = [&](Expr *expr) {
     expr->forEachChildExpr([&](Expr *childExpr) -> Expr * {
       Type type = childExpr->getType();
@@ -917,6 +1035,24 @@ bool ConstraintSystem::Candidate::solve(
   // Record found solutions as suggestions.
   this->applySolutions(solutions, shrunkExprs);
 
+  // Remember the outcome so structurally identical candidates can replay
+  // it without solving.
+  if (fingerprint) {
+    auto &entry = TC.ShrinkCache[*fingerprint];
+    entry.HadNoSolutions = solutions.empty();
+    entry.NumOverloadSets = overloadSets.size();
+    entry.ReducedDomains.clear();
+    for (unsigned i = 0, n = overloadSets.size(); i != n; ++i) {
+      auto *OSR = overloadSets[i];
+      if (!shrunkExprs.count(OSR))
+        continue;
+
+      entry.ReducedDomains.emplace_back(
+          i, SmallVector<ValueDecl *, 2>(OSR->getDecls().begin(),
+                                         OSR->getDecls().end()));
+    }
+  }
+
   // Let's double-check if we have any implicit expressions
   // with type variables and nullify their types.
   cleanupImplicitExprs(E);
@@ -1930,8 +2066,38 @@ bool ConstraintSystem::solveSimplified(
 
   ++solverState->NumDisjunctions;
   auto constraints = disjunction->getNestedConstraints();
+
+  // Order the exploration of the branches so that cheap, specific choices
+  // are attempted before expensive ones: favored choices first, generic
+  // operators and unavailable declarations last.  Solving a specific
+  // choice early establishes a non-generic best score that lets
+  // shouldSkipDisjunctionChoice prune most of the generic tail outright,
+  // which is where the time goes in overload-heavy expressions.  (True
+  // parallel descent over branches would require forking the ASTContext's
+  // type uniquing tables, which are mutated during solving.)
+  SmallVector<unsigned, 4> choiceOrder;
+  {
+    SmallVector<unsigned, 4> deferred;
+    choiceOrder.reserve(constraints.size());
+    for (auto index : indices(constraints)) {
+      if (constraints[index]->isFavored()) {
+        choiceOrder.push_back(index);
+        continue;
+      }
+      DisjunctionChoice choice(this, disjunction, constraints[index]);
+      if (choice.isGenericOperatorOrUnavailable())
+        deferred.push_back(index);
+    }
+    for (auto index : indices(constraints)) {
+      if (!constraints[index]->isFavored() &&
+          !llvm::is_contained(deferred, index))
+        choiceOrder.push_back(index);
+    }
+    choiceOrder.append(deferred.begin(), deferred.end());
+  }
+
   // Try each of the constraints within the disjunction.
-  for (auto index : indices(constraints)) {
+  for (auto index : choiceOrder) {
     auto currentChoice =
         DisjunctionChoice(this, disjunction, constraints[index]);
     if (shouldSkipDisjunctionChoice(*this, currentChoice, bestNonGenericScore))
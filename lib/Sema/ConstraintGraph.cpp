@@ -279,6 +279,16 @@ ConstraintGraph::Change::boundTypeVariable(TypeVariableType *typeVar,
   return result;
 }
 
+ConstraintGraph::Change
+ConstraintGraph::Change::mergedComponents(TypeVariableType *childRoot,
+                                          TypeVariableType *parentRoot) {
+  Change result;
+  result.Kind = ChangeKind::MergedComponents;
+  result.Merge.ChildRoot = childRoot;
+  result.Merge.ParentRoot = parentRoot;
+  return result;
+}
+
 void ConstraintGraph::Change::undo(ConstraintGraph &cg) {
   /// Temporarily change the active scope to null, so we don't record
   /// any changes made while performing the undo operation.
@@ -309,6 +319,13 @@ void ConstraintGraph::Change::undo(ConstraintGraph &cg) {
   case ChangeKind::BoundTypeVariable:
     cg.unbindTypeVariable(Binding.TypeVar, Binding.FixedType);
     break;
+
+  case ChangeKind::MergedComponents:
+    // Detach the child root, making it the root of its own component
+    // again.
+    cg.ComponentParent[Merge.ChildRoot] = Merge.ChildRoot;
+    cg.ComponentSize[Merge.ParentRoot] -= cg.ComponentSize[Merge.ChildRoot];
+    break;
   }
 }
 
@@ -326,6 +343,12 @@ void ConstraintGraph::removeNode(TypeVariableType *typeVar) {
   if (index < lastIndex)
     TypeVariables[index] = TypeVariables[lastIndex];
   TypeVariables.pop_back();
+
+  // Remove the type variable's singleton component.  Any merges
+  // involving it were recorded after its addition, so they have already
+  // been undone.
+  ComponentParent.erase(typeVar);
+  ComponentSize.erase(typeVar);
 }
 
 void ConstraintGraph::addConstraint(Constraint *constraint) {
@@ -349,6 +372,14 @@ void ConstraintGraph::addConstraint(Constraint *constraint) {
     }
   }
 
+  // All of the type variables mentioned by a single constraint belong to
+  // the same connected component.
+  if (referencedTypeVars.size() > 1) {
+    auto firstTypeVar = referencedTypeVars.front();
+    for (auto typeVar : referencedTypeVars.slice(1))
+      mergeComponents(firstTypeVar, typeVar);
+  }
+
   // If the constraint doesn't reference any type variables, it's orphaned;
   // track it as such.
   if (referencedTypeVars.empty()) {
@@ -419,6 +450,9 @@ void ConstraintGraph::mergeNodes(TypeVariableType *typeVar1,
   // Merge equivalence class from the non-representative type variable.
   auto &nonRepNode = (*this)[typeVarNonRep];
   repNode.addToEquivalenceClass(nonRepNode.getEquivalenceClassUnsafe());
+
+  // Members of one equivalence class share a connected component.
+  mergeComponents(typeVarRep, typeVarNonRep);
 }
 
 void ConstraintGraph::bindTypeVariable(TypeVariableType *typeVar, Type fixed) {
@@ -436,6 +470,10 @@ void ConstraintGraph::bindTypeVariable(TypeVariableType *typeVar, Type fixed) {
 
       (*this)[otherTypeVar].addFixedBinding(typeVar);
       node.addFixedBinding(otherTypeVar);
+
+      // The fixed binding links the components of the two type
+      // variables.
+      mergeComponents(typeVar, otherTypeVar);
     }
   }
 
@@ -516,41 +554,46 @@ void ConstraintGraph::gatherConstraints(
 
 #pragma mark Algorithms
 
-/// Depth-first search for connected components
-static void connectedComponentsDFS(ConstraintGraph &cg,
-                                   ConstraintGraphNode &node,
-                                   unsigned component,
-                                   SmallVectorImpl<unsigned> &components) {
-  // Local function that recurses on the given set of type variables.
-  auto visitAdjacencies = [&](ArrayRef<TypeVariableType *> typeVars) {
-    for (auto adj : typeVars) {
-      auto nodeAndIndex = cg.lookupNode(adj);
-      // If we've already seen this node in this component, we're done.
-      unsigned &curComponent = components[nodeAndIndex.second];
-      if (curComponent == component)
-        continue;
+TypeVariableType *
+ConstraintGraph::findComponentRoot(TypeVariableType *typeVar) {
+  // Create a singleton component for a type variable we haven't seen
+  // before.
+  auto known = ComponentParent.find(typeVar);
+  if (known == ComponentParent.end()) {
+    ComponentParent[typeVar] = typeVar;
+    ComponentSize[typeVar] = 1;
+    return typeVar;
+  }
 
-      // Mark this node as part of this connected component, then recurse.
-      assert(curComponent == components.size() && "Already in a component?");
-      curComponent = component;
-      connectedComponentsDFS(cg, nodeAndIndex.first, component, components);
-    }
-  };
-
-  // Recurse to mark adjacent nodes as part of this connected component.
-  visitAdjacencies(node.getAdjacencies());
-
-  // Figure out the representative for this type variable.
-  auto &cs = cg.getConstraintSystem();
-  auto typeVarRep = cs.getRepresentative(node.getTypeVariable());
-  if (typeVarRep == node.getTypeVariable()) {
-    // This type variable is the representative of its set; visit all of the
-    // other type variables in the same equivalence class.
-    visitAdjacencies(node.getEquivalenceClass().slice(1));
-  } else {
-    // Otherwise, visit the representative of the set.
-    visitAdjacencies(typeVarRep);
+  // Walk up to the root.  We never compress the path, because every
+  // parent link has to be undoable in stack order; union-by-size keeps
+  // the walk logarithmic.
+  auto parent = known->second;
+  while (typeVar != parent) {
+    typeVar = parent;
+    parent = ComponentParent[typeVar];
   }
+
+  return typeVar;
+}
+
+void ConstraintGraph::mergeComponents(TypeVariableType *typeVar1,
+                                      TypeVariableType *typeVar2) {
+  auto root1 = findComponentRoot(typeVar1);
+  auto root2 = findComponentRoot(typeVar2);
+  if (root1 == root2)
+    return;
+
+  // Merge the smaller component into the larger one.
+  if (ComponentSize[root1] < ComponentSize[root2])
+    std::swap(root1, root2);
+
+  ComponentParent[root2] = root1;
+  ComponentSize[root1] += ComponentSize[root2];
+
+  // Record the change, if there are active scopes.
+  if (ActiveScope)
+    Changes.push_back(Change::mergedComponents(root2, root1));
 }
 
 unsigned ConstraintGraph::computeConnectedComponents(
@@ -561,31 +604,21 @@ unsigned ConstraintGraph::computeConnectedComponents(
                                                          typeVars.end());
   typeVars.clear();
 
-  // Initialize the components with component == # of type variables,
-  // a sentinel value indicating
   unsigned numTypeVariables = TypeVariables.size();
   components.assign(numTypeVariables, numTypeVariables);
 
-  // Perform a depth-first search from each type variable to identify
-  // what component it is in.
+  // Read the component of each type variable off the incrementally
+  // maintained component forest, assigning component numbers in order of
+  // first appearance.
+  llvm::SmallDenseMap<TypeVariableType *, unsigned, 8> componentForRoot;
   unsigned numComponents = 0;
   for (unsigned i = 0; i != numTypeVariables; ++i) {
-    auto typeVar = TypeVariables[i];
-
-    // Look up the node for this type variable.
-    auto nodeAndIndex = lookupNode(typeVar);
-
-    // If we're already assigned a component for this node, skip it.
-    unsigned &curComponent = components[nodeAndIndex.second];
-    if (curComponent != numTypeVariables)
-      continue;
-
-    // Record this component.
-    unsigned component = numComponents++;
+    auto root = findComponentRoot(TypeVariables[i]);
+    auto known = componentForRoot.insert({root, numComponents});
+    if (known.second)
+      ++numComponents;
 
-    // Note that this node is part of this component, then visit it.
-    curComponent = component;
-    connectedComponentsDFS(*this, nodeAndIndex.first, component, components);
+    components[i] = known.first->second;
   }
 
   // Figure out which components have unbound type variables; these
@@ -315,6 +315,17 @@ private:
   void unbindTypeVariable(TypeVariableType *typeVar, Type fixedType);
 
 
+  /// Retrieve the root of the component containing the given type
+  /// variable within the component forest, creating a singleton
+  /// component for type variables that have not been seen before.
+  TypeVariableType *findComponentRoot(TypeVariableType *typeVar);
+
+  /// Merge the components containing the two given type variables,
+  /// recording the change so it can be undone when the current solver
+  /// scope is popped.
+  void mergeComponents(TypeVariableType *typeVar1,
+                       TypeVariableType *typeVar2);
+
   /// Perform edge contraction on the constraint graph, merging equivalence
   /// classes until a fixed point is reached.
   bool contractEdges();
@@ -332,6 +343,21 @@ private:
   /// Constraints that are "orphaned" because they contain no type variables.
   SmallVector<Constraint *, 4> OrphanedConstraints;
 
+  /// A union-find forest tracking the connected component of each type
+  /// variable, maintained incrementally as edges are introduced.
+  ///
+  /// The forest is a conservative over-approximation of connectivity:
+  /// removing a constraint does not split the components its type
+  /// variables belong to.  Merging components that are no longer
+  /// connected only makes the solver's problem partitioning coarser,
+  /// never incorrect.  Parent links are never path-compressed, so each
+  /// merge can be undone in stack order when solver scopes are popped.
+  llvm::DenseMap<TypeVariableType *, TypeVariableType *> ComponentParent;
+
+  /// The number of type variables in the component rooted at each root
+  /// of the component forest, used for union-by-size.
+  llvm::DenseMap<TypeVariableType *, unsigned> ComponentSize;
+
   /// The kind of change made to the graph.
   enum class ChangeKind {
     /// Added a type variable.
@@ -344,6 +370,8 @@ private:
     ExtendedEquivalenceClass,
     /// Added a fixed binding for a type variable.
     BoundTypeVariable,
+    /// Merged two connected components in the component forest.
+    MergedComponents,
   };
 
   /// A change made to the constraint graph.
@@ -373,6 +401,15 @@ private:
         /// The fixed type to which the type variable was bound.
         TypeBase *FixedType;
       } Binding;
+
+      struct {
+        /// The root of the component that was merged into another
+        /// component.
+        TypeVariableType *ChildRoot;
+
+        /// The root of the component that absorbed the other component.
+        TypeVariableType *ParentRoot;
+      } Merge;
     };
 
   public:
@@ -394,6 +431,10 @@ private:
     /// Create a change that bound a type variable to a fixed type.
     static Change boundTypeVariable(TypeVariableType *typeVar, Type fixed);
 
+    /// Create a change that merged two connected components.
+    static Change mergedComponents(TypeVariableType *childRoot,
+                                   TypeVariableType *parentRoot);
+
     /// Undo this change, reverting the constraint graph to the state it
     /// had prior to this change.
     ///
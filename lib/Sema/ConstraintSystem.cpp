@@ -68,6 +68,8 @@ ExpressionTimer::~ExpressionTimer() {
 ConstraintSystem::ConstraintSystem(TypeChecker &tc, DeclContext *dc,
                                    ConstraintSystemOptions options)
   : TC(tc), DC(dc), Options(options),
+    OwnedAllocator(tc.takeConstraintAllocator()),
+    Allocator(*OwnedAllocator),
     Arena(tc.Context, Allocator),
     CG(*new ConstraintGraph(*this))
 {
@@ -76,6 +78,7 @@ ConstraintSystem::ConstraintSystem(TypeChecker &tc, DeclContext *dc,
 
 ConstraintSystem::~ConstraintSystem() {
   delete &CG;
+  TC.recycleConstraintAllocator(std::move(OwnedAllocator));
 }
 
 void ConstraintSystem::incrementScopeCounter() {
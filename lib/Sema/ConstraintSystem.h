@@ -917,7 +917,13 @@ public:
 private:
 
   /// \brief Allocator used for all of the related constraint systems.
-  llvm::BumpPtrAllocator Allocator;
+  ///
+  /// Acquired from and recycled to the TypeChecker, so the slabs backing
+  /// constraints and locators are reused across the many constraint systems
+  /// created while checking a single file instead of being returned to
+  /// malloc after every expression.
+  std::unique_ptr<llvm::BumpPtrAllocator> OwnedAllocator;
+  llvm::BumpPtrAllocator &Allocator;
 
   /// \brief Arena used for memory management of constraint-checker-related
   /// allocations.
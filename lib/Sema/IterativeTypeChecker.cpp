@@ -73,22 +73,32 @@ void IterativeTypeChecker::satisfy(TypeCheckRequest request) {
   // If the request has already been satisfied, we're done.
   if (isSatisfied(request)) return;
 
-  // Check for circular dependencies in our requests.
-  // FIXME: This stack operation is painfully inefficient.
-  auto existingRequest = std::find(ActiveRequests.rbegin(),
-                                   ActiveRequests.rend(),
-                                   request);
-  if (existingRequest != ActiveRequests.rend()) {
-    auto first = existingRequest.base();
-    --first;
-    diagnoseCircularReference(llvm::makeArrayRef(&*first,
-                                                 &*ActiveRequests.end()));
-    return;
+  // Check for circular dependencies in our requests. Only scan the stack
+  // when the request's hash is present; a hash collision merely costs a
+  // scan that finds nothing.
+  size_t requestHash = hash_value(request);
+  if (ActiveRequestHashes.count(requestHash)) {
+    auto existingRequest = std::find(ActiveRequests.rbegin(),
+                                     ActiveRequests.rend(),
+                                     request);
+    if (existingRequest != ActiveRequests.rend()) {
+      auto first = existingRequest.base();
+      --first;
+      diagnoseCircularReference(llvm::makeArrayRef(&*first,
+                                                   &*ActiveRequests.end()));
+      return;
+    }
   }
 
   // Add this request to the stack of active requests.
   ActiveRequests.push_back(request);
-  SWIFT_DEFER { ActiveRequests.pop_back(); };
+  ++ActiveRequestHashes[requestHash];
+  SWIFT_DEFER {
+    ActiveRequests.pop_back();
+    auto known = ActiveRequestHashes.find(requestHash);
+    if (--known->second == 0)
+      ActiveRequestHashes.erase(known);
+  };
 
   while (true) {
     // Process this requirement, enumerating dependencies if anything else needs
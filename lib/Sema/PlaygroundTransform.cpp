@@ -878,7 +878,9 @@ public:
 
 } // end anonymous namespace
 
-void swift::performPlaygroundTransform(SourceFile &SF, bool HighPerformance) {
+void swift::performPlaygroundTransform(SourceFile &SF, bool HighPerformance,
+                                       unsigned RegionStartLine,
+                                       unsigned RegionEndLine) {
   class ExpressionFinder : public ASTWalker {
   private:
     std::mt19937_64 RNG;
@@ -921,7 +923,20 @@ void swift::performPlaygroundTransform(SourceFile &SF, bool HighPerformance) {
   };
 
   ExpressionFinder EF(HighPerformance);
+  SourceManager &SM = SF.getASTContext().SourceMgr;
   for (Decl *D : SF.Decls) {
+    // In region mode, leave declarations outside the edited line range
+    // uninstrumented so re-running a region only logs - and only pays
+    // for - the region itself.
+    if (RegionStartLine != 0) {
+      SourceRange Range = D->getSourceRange();
+      if (Range.isValid()) {
+        unsigned DeclStartLine = SM.getLineAndColumn(Range.Start).first;
+        unsigned DeclEndLine = SM.getLineAndColumn(Range.End).first;
+        if (DeclEndLine < RegionStartLine || DeclStartLine > RegionEndLine)
+          continue;
+      }
+    }
     D->walk(EF);
   }
 }
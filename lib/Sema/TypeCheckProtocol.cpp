@@ -3361,6 +3361,37 @@ Optional<ProtocolConformanceRef> TypeChecker::containsProtocol(
   return conformsToProtocol(T, Proto, DC, options);
 }
 
+Optional<ProtocolConformanceRef>
+TypeChecker::conformsToLiteralProtocol(Type T, ProtocolDecl *Proto,
+                                       DeclContext *DC) {
+  auto key = std::make_pair(T.getPointer(), Proto);
+  auto known = LiteralConformances.find(key);
+  if (known != LiteralConformances.end()) {
+    // Dependencies are tracked per context, so a cache hit still has to
+    // record the edge for this file.
+    recordConformanceDependency(DC, T->getAnyNominal(),
+                                known->second.getConcrete(),
+                                /*InExpression=*/true);
+    return known->second;
+  }
+
+  auto lookupResult =
+    conformsToProtocol(T, Proto, DC,
+                       (ConformanceCheckFlags::InExpression|
+                        ConformanceCheckFlags::SkipConditionalRequirements));
+
+  // Only pre-resolve conformances of the protocol's default literal type.
+  // Those are unconditional and defined in the standard library, so they
+  // can never be invalidated or superseded by a later extension.
+  if (lookupResult && lookupResult->isConcrete() &&
+      lookupResult->getConditionalRequirements().empty()) {
+    if (Type defaultType = getDefaultType(Proto, DC))
+      if (T->isEqual(defaultType))
+        LiteralConformances.insert({key, *lookupResult});
+  }
+  return lookupResult;
+}
+
 Optional<ProtocolConformanceRef> TypeChecker::conformsToProtocol(
                                    Type T, ProtocolDecl *Proto,
                                    DeclContext *DC,
@@ -3374,9 +3405,17 @@ Optional<ProtocolConformanceRef> TypeChecker::conformsToProtocol(
         recordConformanceDependency(DC, nominal, conformance, InExpression);
   };
 
-  // Look up conformance in the module.
+  // Look up conformance in the module, consulting the cache of prior
+  // answers first; the same (type, protocol) queries recur constantly
+  // across the primary files of a module.
   ModuleDecl *M = DC->getParentModule();
-  auto lookupResult = M->lookupConformance(T, Proto);
+  Optional<ProtocolConformanceRef> lookupResult;
+  if (auto cached = Context.getCachedConformsToProtocolResult(M, T, Proto)) {
+    lookupResult = *cached;
+  } else {
+    lookupResult = M->lookupConformance(T, Proto);
+    Context.recordConformsToProtocolResult(M, T, Proto, lookupResult);
+  }
   if (!lookupResult) {
     if (ComplainLoc.isValid())
       diagnoseConformanceFailure(*this, T, Proto, DC, ComplainLoc);
@@ -96,6 +96,45 @@ Decl *TypeCheckRequest::getAnchor() const {
   llvm_unreachable("Unhandled PayloadKind in switch.");
 }
 
+llvm::hash_code swift::hash_value(const TypeCheckRequest &x) {
+  auto kind = static_cast<unsigned>(x.getKind());
+  switch (TypeCheckRequest::getPayloadKind(x.getKind())) {
+  case TypeCheckRequest::PayloadKind::Class:
+    return llvm::hash_combine(kind, x.getClassPayload());
+
+  case TypeCheckRequest::PayloadKind::Enum:
+    return llvm::hash_combine(kind, x.getEnumPayload());
+
+  case TypeCheckRequest::PayloadKind::InheritedClauseEntry: {
+    auto payload = x.getInheritedClauseEntryPayload();
+    return llvm::hash_combine(kind, payload.first.getOpaqueValue(),
+                              payload.second);
+  }
+
+  case TypeCheckRequest::PayloadKind::Protocol:
+    return llvm::hash_combine(kind, x.getProtocolPayload());
+
+  case TypeCheckRequest::PayloadKind::DeclContextLookup: {
+    auto payload = x.getDeclContextLookupPayload();
+    // The equality predicate ignores the source location, so the hash
+    // must as well.
+    return llvm::hash_combine(kind, payload.DC,
+                              payload.Name.getOpaqueValue());
+  }
+
+  case TypeCheckRequest::PayloadKind::TypeResolution: {
+    auto payload = x.getTypeResolutionPayload();
+    return llvm::hash_combine(kind, std::get<0>(payload),
+                              std::get<1>(payload), std::get<2>(payload));
+  }
+
+  case TypeCheckRequest::PayloadKind::TypeDeclResolution:
+    return llvm::hash_combine(kind, x.getTypeDeclResolutionPayload());
+  }
+
+  llvm_unreachable("Unhandled PayloadKind in switch.");
+}
+
 bool swift::operator==(const TypeCheckRequest &x, const TypeCheckRequest &y) {
   // Check the request kinds.
   if (x.getKind() != y.getKind()) return false;
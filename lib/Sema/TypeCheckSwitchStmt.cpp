@@ -21,6 +21,7 @@
 
 #include <llvm/ADT/APInt.h>
 #include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/BitVector.h>
 
 #include <numeric>
 #include <forward_list>
@@ -1028,6 +1029,212 @@ namespace {
       }
     }
     
+    /// The verdict of the bitset-backed covering analysis.
+    enum class BitsetCoverage {
+      /// The switch is outside the fragment the analysis handles.
+      Inapplicable,
+      /// Every value of the subject type is covered by some case.
+      Covered,
+      /// At least one value of the subject type is uncovered.
+      Uncovered,
+    };
+
+    /// A single dimension of the subject type in the bitset-backed
+    /// covering analysis: an enum or Bool, whose values are numbered.
+    struct CoverageDimension {
+      unsigned Size = 0;
+      bool IsBool = false;
+      llvm::SmallDenseMap<Identifier, unsigned, 8> ElementIndices;
+    };
+
+    /// The maximum number of cells the bitset-backed covering analysis
+    /// will track; a 30x20 two-enum switch needs 600.
+    static const size_t MAX_COVERAGE_CELLS = 1 << 22;
+
+    /// Translate one dimension of a projected case-pattern space into the
+    /// set of element indices it covers within \p dim.
+    ///
+    /// \returns false if the space is outside the fragment the analysis
+    /// handles; an empty \p indices with a true return means the space
+    /// covers no values at all.
+    static bool gatherElementIndices(const Space &space,
+                                     const CoverageDimension &dim,
+                                     SmallVectorImpl<unsigned> &indices) {
+      switch (space.getKind()) {
+      case SpaceKind::Empty:
+        return true;
+      case SpaceKind::Type:
+        // An irrefutable match covers the entire dimension.
+        for (unsigned i = 0; i != dim.Size; ++i)
+          indices.push_back(i);
+        return true;
+      case SpaceKind::BooleanConstant:
+        if (!dim.IsBool)
+          return false;
+        indices.push_back(space.getBoolValue() ? 0 : 1);
+        return true;
+      case SpaceKind::Constructor: {
+        if (dim.IsBool)
+          return false;
+
+        // Only an element whose payload is matched irrefutably covers the
+        // element completely; partial payload matches fall back to the
+        // general space engine.
+        bool coversNothing = false;
+        for (auto &param : space.getSpaces()) {
+          if (param.getKind() == SpaceKind::Empty) {
+            coversNothing = true;
+            continue;
+          }
+          if (param.getKind() != SpaceKind::Type)
+            return false;
+        }
+        if (coversNothing)
+          return true;
+
+        auto known = dim.ElementIndices.find(space.getHead());
+        if (known == dim.ElementIndices.end())
+          return false;
+        indices.push_back(known->second);
+        return true;
+      }
+      case SpaceKind::Disjunct:
+        for (auto &sub : space.getSpaces())
+          if (!gatherElementIndices(sub, dim, indices))
+            return false;
+        return true;
+      }
+    }
+
+    /// Check the covering of a switch whose subject is an enum, a Bool,
+    /// or a tuple of such types by numbering every value of the subject
+    /// and marking the cells each case covers in a bitset.  Unlike the
+    /// symbolic space subtraction this is linear in the number of covered
+    /// cells, so it stays tractable for products of large enums.
+    BitsetCoverage checkCoverageWithBitsets(Type subjectType,
+                                            ArrayRef<Space> caseSpaces) {
+      if (!subjectType)
+        return BitsetCoverage::Inapplicable;
+
+      // Split the subject into its dimensions.
+      SmallVector<Type, 4> dimTypes;
+      if (auto *TTy = subjectType->getAs<TupleType>()) {
+        for (auto &elt : TTy->getElements())
+          dimTypes.push_back(elt.getType());
+      } else {
+        dimTypes.push_back(subjectType);
+      }
+      if (dimTypes.empty())
+        return BitsetCoverage::Inapplicable;
+
+      // Number the values of each dimension.
+      SmallVector<CoverageDimension, 4> dims;
+      size_t numCells = 1;
+      for (auto dimTy : dimTypes) {
+        CoverageDimension dim;
+        if (dimTy->isBool()) {
+          dim.Size = 2;
+          dim.IsBool = true;
+        } else if (auto *E = dimTy->getEnumOrBoundGenericEnum()) {
+          for (auto *eed : E->getAllElements()) {
+            dim.ElementIndices.insert({eed->getName(), dim.Size});
+            ++dim.Size;
+          }
+        } else {
+          return BitsetCoverage::Inapplicable;
+        }
+
+        // A dimension with no values makes the subject uninhabited.
+        if (dim.Size == 0)
+          return BitsetCoverage::Covered;
+
+        // Keep the bitset to a sane size.
+        if (numCells > MAX_COVERAGE_CELLS / dim.Size)
+          return BitsetCoverage::Inapplicable;
+        numCells *= dim.Size;
+        dims.push_back(std::move(dim));
+      }
+
+      // Compute the stride of each dimension within the cell numbering.
+      SmallVector<size_t, 4> strides(dims.size(), 1);
+      for (unsigned d = dims.size() - 1; d > 0; --d)
+        strides[d - 1] = strides[d] * dims[d].Size;
+
+      llvm::BitVector covered(numCells);
+
+      SmallVector<const Space *, 8> worklist;
+      for (auto &space : caseSpaces)
+        worklist.push_back(&space);
+
+      while (!worklist.empty()) {
+        const Space *space = worklist.pop_back_val();
+
+        // A wildcard case covers the whole subject.
+        if (space->getKind() == SpaceKind::Type)
+          return BitsetCoverage::Covered;
+
+        if (space->getKind() == SpaceKind::Empty)
+          continue;
+
+        if (space->getKind() == SpaceKind::Disjunct) {
+          for (auto &sub : space->getSpaces())
+            worklist.push_back(&sub);
+          continue;
+        }
+
+        // Determine which element indices this case covers in each
+        // dimension.
+        SmallVector<SmallVector<unsigned, 4>, 4> indexSets(dims.size());
+        if (dimTypes.size() > 1) {
+          // A tuple subject projects as a constructor space with an empty
+          // head and one argument per dimension.
+          if (space->getKind() != SpaceKind::Constructor ||
+              !space->getHead().empty())
+            return BitsetCoverage::Inapplicable;
+
+          unsigned d = 0;
+          for (auto &param : space->getSpaces()) {
+            if (d == dims.size() ||
+                !gatherElementIndices(param, dims[d], indexSets[d]))
+              return BitsetCoverage::Inapplicable;
+            ++d;
+          }
+          if (d != dims.size())
+            return BitsetCoverage::Inapplicable;
+        } else {
+          if (!gatherElementIndices(*space, dims[0], indexSets[0]))
+            return BitsetCoverage::Inapplicable;
+        }
+
+        // Skip case items that cover no values.
+        bool coversNothing = llvm::any_of(
+            indexSets, [](const SmallVector<unsigned, 4> &set) {
+              return set.empty();
+            });
+        if (coversNothing)
+          continue;
+
+        // Mark every cell in the cartesian product of the per-dimension
+        // index sets.
+        size_t combos = 1;
+        for (auto &set : indexSets)
+          combos *= set.size();
+        for (size_t i = 0; i != combos; ++i) {
+          size_t tmp = i;
+          size_t cell = 0;
+          for (unsigned d = dims.size(); d-- > 0;) {
+            auto &set = indexSets[d];
+            cell += strides[d] * set[tmp % set.size()];
+            tmp /= set.size();
+          }
+          covered.set(cell);
+        }
+      }
+
+      return covered.all() ? BitsetCoverage::Covered
+                           : BitsetCoverage::Uncovered;
+    }
+
     void checkExhaustiveness(bool limitedChecking) {
       // If the type of the scrutinee is uninhabited, we're already dead.
       // Allow any well-typed patterns through.
@@ -1092,6 +1299,15 @@ namespace {
 
       size_t totalSpaceSize = totalSpace.getSize(TC);
       if (totalSpaceSize > Space::getMaximumSize() && !coveredSpace.isAllIrrefutable()) {
+        // Before requiring 'default', try the bitset-backed covering
+        // analysis; when the subject is built from enums and booleans it
+        // decides exhaustiveness without the symbolic space subtraction
+        // that blows up on products of large enums.
+        if (checkCoverageWithBitsets(subjectType, spaces) ==
+              BitsetCoverage::Covered) {
+          return;
+        }
+
         // Because the space is large, fall back to requiring 'default'.
         //
         // FIXME: Explore ways of reducing runtime of this analysis or doing
@@ -32,6 +32,7 @@
 #include "swift/Config.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/TinyPtrVector.h"
+#include "llvm/Support/Allocator.h"
 #include <functional>
 
 namespace swift {
@@ -741,8 +742,63 @@ public:
     TypeAccessScopeCache;
 
   // Caches whether a given declaration is "as specialized" as another.
-  llvm::DenseMap<std::pair<ValueDecl*, ValueDecl*>, bool> 
+  llvm::DenseMap<std::pair<ValueDecl*, ValueDecl*>, bool>
     specializedOverloadComparisonCache;
+
+  /// Memoized results of the constraint solver's shrink pass, keyed by a
+  /// structural fingerprint of the candidate sub-expression together with
+  /// its contextual type.  Structurally identical sub-expressions (common in
+  /// generated and literal-heavy code) reuse the reduced overload domains
+  /// from the first time they were solved instead of being re-solved from
+  /// scratch.  The only observable effects of solving a shrink candidate
+  /// are its per-overload-set domain reductions and whether any solution
+  /// existed, so replaying those is sound.
+  struct ShrinkCacheEntry {
+    /// Whether the candidate had no solutions (propagated as failure).
+    bool HadNoSolutions;
+    /// Reduced overload domains, keyed by the preorder index of the
+    /// overload set in the candidate expression.
+    SmallVector<std::pair<unsigned, SmallVector<ValueDecl *, 2>>, 2>
+      ReducedDomains;
+    /// Total number of overload sets seen, used to validate a hit.
+    unsigned NumOverloadSets;
+  };
+  llvm::DenseMap<uint64_t, ShrinkCacheEntry> ShrinkCache;
+
+  /// Pre-resolved conformances of the literal protocols' default types
+  /// (e.g. Int: ExpressibleByIntegerLiteral), keyed by (type, protocol).
+  /// Literal-heavy code re-proves these conformances for every literal in
+  /// the constraint solver; the cached conformances are unconditional and
+  /// defined in the standard library, so entries never need invalidation.
+  llvm::SmallDenseMap<std::pair<TypeBase *, ProtocolDecl *>,
+                      ProtocolConformanceRef, 8>
+    LiteralConformances;
+
+  /// Bump-pointer allocators retired by destroyed constraint systems, kept
+  /// around so the thousands of expressions checked in a large file reuse
+  /// solver slabs instead of repeatedly handing them back to malloc.
+  std::vector<std::unique_ptr<llvm::BumpPtrAllocator>>
+    RetiredConstraintAllocators;
+
+  /// Acquire an allocator for a new constraint system, preferring a
+  /// recycled one whose slabs are already resident.
+  std::unique_ptr<llvm::BumpPtrAllocator> takeConstraintAllocator() {
+    if (!RetiredConstraintAllocators.empty()) {
+      auto alloc = std::move(RetiredConstraintAllocators.back());
+      RetiredConstraintAllocators.pop_back();
+      return alloc;
+    }
+    return llvm::make_unique<llvm::BumpPtrAllocator>();
+  }
+
+  /// Return a constraint system's allocator to the pool.  The memory is
+  /// reset (constraints and locators are never individually destroyed) but
+  /// the initial slab is retained for the next expression.
+  void recycleConstraintAllocator(
+      std::unique_ptr<llvm::BumpPtrAllocator> alloc) {
+    alloc->Reset();
+    RetiredConstraintAllocators.push_back(std::move(alloc));
+  }
   
   // We delay validation of C and Objective-C type-bridging functions in the
   // standard library until we encounter a declaration that requires one. This
@@ -2008,6 +2064,13 @@ public:
                      ConformanceCheckOptions options, SourceLoc ComplainLoc,
                      UnsatisfiedDependency *unsatisfiedDependency);
 
+  /// A fast path of \c conformsToProtocol for literal protocol constraints
+  /// in the constraint solver. Conformances of a literal protocol's default
+  /// type are resolved once and then answered from a cache; other types
+  /// fall back to the regular conformance check.
+  Optional<ProtocolConformanceRef>
+  conformsToLiteralProtocol(Type T, ProtocolDecl *Proto, DeclContext *DC);
+
   /// Mark the given protocol conformance as "used" from the given declaration
   /// context.
   void markConformanceUsed(ProtocolConformanceRef conformance,
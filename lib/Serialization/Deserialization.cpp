@@ -1290,9 +1290,20 @@ ModuleFile::resolveCrossReference(ModuleDecl *baseModule, uint32_t pathLen) {
       pathTrace.addType(filterTy);
     }
 
-    baseModule->lookupQualified(ModuleType::get(baseModule), name,
-                                NL_QualifiedDefault | NL_KnownNoDependency,
-                                /*typeResolver=*/nullptr, values);
+    // Many cross-references share their first path piece; reuse the result
+    // of the base-module walk for all of them. Note that the lookup itself
+    // can recursively deserialize and grow the cache, so don't hold an entry
+    // reference across it.
+    auto cacheKey = std::make_pair(baseModule, name);
+    auto cachedValues = TopLevelXRefCache.find(cacheKey);
+    if (cachedValues != TopLevelXRefCache.end()) {
+      values.append(cachedValues->second.begin(), cachedValues->second.end());
+    } else {
+      baseModule->lookupQualified(ModuleType::get(baseModule), name,
+                                  NL_QualifiedDefault | NL_KnownNoDependency,
+                                  /*typeResolver=*/nullptr, values);
+      TopLevelXRefCache[cacheKey].assign(values.begin(), values.end());
+    }
     filterValues(filterTy, nullptr, nullptr, isType, inProtocolExt, isStatic,
                  None, values);
     break;
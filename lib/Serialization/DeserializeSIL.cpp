@@ -126,6 +126,18 @@ public:
   }
 };
 
+/// Fill an offset table from a blob of fixed-width little-endian words, as
+/// emitted by writeIndexOffsets in SerializeSIL.cpp.
+template <typename T>
+static void readOffsetBlob(std::vector<T> &offsets, StringRef blobData) {
+  assert(blobData.size() % sizeof(uint32_t) == 0);
+  offsets.reserve(blobData.size() / sizeof(uint32_t));
+  auto *data = reinterpret_cast<const uint8_t *>(blobData.data());
+  auto *end = data + blobData.size();
+  while (data != end)
+    offsets.push_back(endian::readNext<uint32_t, little, unaligned>(data));
+}
+
 SILDeserializer::SILDeserializer(ModuleFile *MF, SILModule &M,
                                  SerializedSILLoader::Callback *callback)
     : MF(MF), SILMod(M), Callback(callback) {
@@ -185,27 +197,27 @@ SILDeserializer::SILDeserializer(ModuleFile *MF, SILModule &M,
       assert((next.Kind == llvm::BitstreamEntry::Record &&
               offKind == sil_index_block::SIL_FUNC_OFFSETS) &&
              "Expect a SIL_FUNC_OFFSETS record.");
-      Funcs.assign(scratch.begin(), scratch.end());
+      readOffsetBlob(Funcs, blobData);
     } else if (kind == sil_index_block::SIL_VTABLE_NAMES) {
       assert((next.Kind == llvm::BitstreamEntry::Record &&
               offKind == sil_index_block::SIL_VTABLE_OFFSETS) &&
              "Expect a SIL_VTABLE_OFFSETS record.");
-      VTables.assign(scratch.begin(), scratch.end());
+      readOffsetBlob(VTables, blobData);
     } else if (kind == sil_index_block::SIL_GLOBALVAR_NAMES) {
       assert((next.Kind == llvm::BitstreamEntry::Record &&
               offKind == sil_index_block::SIL_GLOBALVAR_OFFSETS) &&
              "Expect a SIL_GLOBALVAR_OFFSETS record.");
-      GlobalVars.assign(scratch.begin(), scratch.end());
+      readOffsetBlob(GlobalVars, blobData);
     } else if (kind == sil_index_block::SIL_WITNESS_TABLE_NAMES) {
       assert((next.Kind == llvm::BitstreamEntry::Record &&
               offKind == sil_index_block::SIL_WITNESS_TABLE_OFFSETS) &&
              "Expect a SIL_WITNESS_TABLE_OFFSETS record.");
-      WitnessTables.assign(scratch.begin(), scratch.end());
+      readOffsetBlob(WitnessTables, blobData);
     } else if (kind == sil_index_block::SIL_DEFAULT_WITNESS_TABLE_NAMES) {
       assert((next.Kind == llvm::BitstreamEntry::Record &&
               offKind == sil_index_block::SIL_DEFAULT_WITNESS_TABLE_OFFSETS) &&
              "Expect a SIL_DEFAULT_WITNESS_TABLE_OFFSETS record.");
-      DefaultWitnessTables.assign(scratch.begin(), scratch.end());
+      readOffsetBlob(DefaultWitnessTables, blobData);
     }
   }
 }
@@ -751,6 +751,18 @@ ModuleFile::readObjCMethodTable(ArrayRef<uint64_t> fields, StringRef blobData) {
                                              base + sizeof(uint32_t), base));
 }
 
+/// Populate \p offsets from a blob of fixed-width little-endian words, as
+/// emitted by Serializer::writeOffsets.
+template <typename T>
+static void readOffsetBlob(std::vector<T> &offsets, StringRef blobData) {
+  assert(blobData.size() % sizeof(uint32_t) == 0);
+  offsets.reserve(blobData.size() / sizeof(uint32_t));
+  auto *data = reinterpret_cast<const uint8_t *>(blobData.data());
+  auto *end = data + blobData.size();
+  while (data != end)
+    offsets.push_back(endian::readNext<uint32_t, little, unaligned>(data));
+}
+
 bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
   cursor.EnterSubBlock(INDEX_BLOCK_ID);
 
@@ -791,20 +803,16 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
 
       switch (kind) {
       case index_block::DECL_OFFSETS:
-        assert(blobData.empty());
-        Decls.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(Decls, blobData);
         break;
       case index_block::DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        DeclContexts.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(DeclContexts, blobData);
         break;
       case index_block::TYPE_OFFSETS:
-        assert(blobData.empty());
-        Types.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(Types, blobData);
         break;
       case index_block::IDENTIFIER_OFFSETS:
-        assert(blobData.empty());
-        Identifiers.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(Identifiers, blobData);
         break;
       case index_block::TOP_LEVEL_DECLS:
         TopLevelDecls = readDeclTable(scratch, blobData);
@@ -841,24 +849,19 @@ bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
         DeclMemberNames = readDeclMemberNamesTable(scratch, blobData);
         break;
       case index_block::LOCAL_DECL_CONTEXT_OFFSETS:
-        assert(blobData.empty());
-        LocalDeclContexts.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(LocalDeclContexts, blobData);
         break;
       case index_block::GENERIC_SIGNATURE_OFFSETS:
-        assert(blobData.empty());
-        GenericSignatures.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(GenericSignatures, blobData);
         break;
       case index_block::GENERIC_ENVIRONMENT_OFFSETS:
-        assert(blobData.empty());
-        GenericEnvironments.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(GenericEnvironments, blobData);
         break;
       case index_block::NORMAL_CONFORMANCE_OFFSETS:
-        assert(blobData.empty());
-        NormalConformances.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(NormalConformances, blobData);
         break;
       case index_block::SIL_LAYOUT_OFFSETS:
-        assert(blobData.empty());
-        SILLayouts.assign(scratch.begin(), scratch.end());
+        readOffsetBlob(SILLayouts, blobData);
         break;
 
       default:
@@ -126,7 +126,7 @@ namespace sil_index_block {
 
   using OffsetLayout = BCGenericRecordLayout<
     BCFixed<4>,  // record ID
-    BCArray<BitOffsetField>
+    BCBlob       // array of fixed-width little-endian offsets
   >;
 }
 
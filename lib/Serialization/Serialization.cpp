@@ -56,6 +56,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/YAMLParser.h"
 
+#include <thread>
 #include <vector>
 
 using namespace swift;
@@ -4047,7 +4048,18 @@ void Serializer::writeAllIdentifiers() {
 
 void Serializer::writeOffsets(const index_block::OffsetsLayout &Offsets,
                               const std::vector<BitOffset> &values) {
-  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), values);
+  // Emit the offsets as a blob of fixed-width little-endian words rather than
+  // a VBR-encoded array, so that the reader can fill its offset tables with a
+  // trivial loop over the memory-mapped module file instead of decoding each
+  // element through a bitstream cursor.
+  SmallString<2048> blob;
+  {
+    llvm::raw_svector_ostream blobStream(blob);
+    endian::Writer<little> writer(blobStream);
+    for (BitOffset offset : values)
+      writer.write<uint32_t>(offset);
+  }
+  Offsets.emit(ScratchRecord, getOffsetRecordCode(values), blob);
 }
 
 /// Writes an in-memory decl table to an on-disk representation, using the
@@ -4933,9 +4945,15 @@ void Serializer::writeDocToStream(raw_ostream &os, ModuleOrSourceFile DC,
   S.writeToStream(os);
 }
 
-static inline bool
-withOutputFile(ASTContext &ctx, StringRef outputPath,
-               llvm::function_ref<void(raw_ostream &)> action){
+/// Runs \p action with a stream writing to the output file at \p outputPath.
+///
+/// Does not emit diagnostics, so it is safe to call off the main thread. On
+/// failure, returns the error and sets \p problematicPath to the path
+/// involved in the failure.
+static std::error_code
+writeToOutputFile(StringRef outputPath,
+                  llvm::function_ref<void(raw_ostream &)> action,
+                  std::string &problematicPath) {
   namespace path = llvm::sys::path;
   clang::CompilerInstance Clang;
 
@@ -4954,11 +4972,11 @@ withOutputFile(ASTContext &ctx, StringRef outputPath,
                              &tmpFilePath);
 
     if (!out) {
-      StringRef problematicPath =
-          tmpFilePath.empty() ? outputPath : StringRef(tmpFilePath);
-      ctx.Diags.diagnose(SourceLoc(), diag::error_opening_output,
-                         problematicPath, EC.message());
-      return true;
+      problematicPath =
+          tmpFilePath.empty() ? outputPath.str() : tmpFilePath;
+      if (!EC)
+        EC = std::make_error_code(std::errc::io_error);
+      return EC;
     }
 
     action(*out);
@@ -4967,12 +4985,39 @@ withOutputFile(ASTContext &ctx, StringRef outputPath,
   if (!tmpFilePath.empty()) {
     std::error_code EC = swift::moveFileIfDifferent(tmpFilePath, outputPath);
     if (EC) {
-      ctx.Diags.diagnose(SourceLoc(), diag::error_opening_output,
-                         outputPath, EC.message());
-      return true;
+      problematicPath = outputPath.str();
+      return EC;
     }
   }
 
+  return std::error_code();
+}
+
+/// Returns true if the file at \p outputPath already contains exactly
+/// \p contents.
+///
+/// In incremental builds the serializer frequently reproduces the previous
+/// output byte for byte. Detecting that against the in-memory buffer skips
+/// the temporary file entirely and leaves the output's timestamp alone, so
+/// downstream dependency checking does not rerun.
+static bool outputFileMatches(StringRef outputPath, StringRef contents) {
+  auto existing = llvm::MemoryBuffer::getFile(outputPath, /*FileSize=*/-1,
+                                              /*RequiresNullTerminator=*/false);
+  if (!existing)
+    return false;
+  return (*existing)->getBuffer() == contents;
+}
+
+static inline bool
+withOutputFile(ASTContext &ctx, StringRef outputPath,
+               llvm::function_ref<void(raw_ostream &)> action){
+  std::string problematicPath;
+  if (std::error_code EC = writeToOutputFile(outputPath, action,
+                                             problematicPath)) {
+    ctx.Diags.diagnose(SourceLoc(), diag::error_opening_output,
+                       problematicPath, EC.message());
+    return true;
+  }
   return false;
 }
 
@@ -4988,20 +5033,54 @@ void swift::serialize(ModuleOrSourceFile DC,
     return;
   }
 
-  bool hadError = withOutputFile(getContext(DC), options.OutputPath,
-                                 [&](raw_ostream &out) {
+  llvm::SmallString<0> moduleBuffer;
+  {
     SharedTimer timer("Serialization, swiftmodule");
+    llvm::raw_svector_ostream out(moduleBuffer);
     Serializer::writeToStream(out, DC, M, options);
-  });
-  if (hadError)
-    return;
+  }
+
+  std::string writeErrorPath;
+  std::error_code writeEC;
+  auto writeModuleFile = [&] {
+    if (outputFileMatches(options.OutputPath, moduleBuffer))
+      return;
+    writeEC = writeToOutputFile(options.OutputPath,
+                                [&](raw_ostream &out) {
+                                  out.write(moduleBuffer.data(),
+                                            moduleBuffer.size());
+                                },
+                                writeErrorPath);
+  };
+
+  if (!options.DocOutputPath || options.DocOutputPath[0] == '\0') {
+    writeModuleFile();
+  } else {
+    // Write the module file on a worker thread while this thread serializes
+    // the swiftdoc file: the disk write only touches the finished buffer, so
+    // all AST access stays on this thread. Diagnostics for a failed write
+    // are emitted after the join.
+    std::thread writerThread(writeModuleFile);
 
-  if (options.DocOutputPath && options.DocOutputPath[0] != '\0') {
-    (void)withOutputFile(getContext(DC), options.DocOutputPath,
-                         [&](raw_ostream &out) {
+    llvm::SmallString<0> docBuffer;
+    {
       SharedTimer timer("Serialization, swiftdoc");
+      llvm::raw_svector_ostream out(docBuffer);
       Serializer::writeDocToStream(out, DC, options.GroupInfoPath,
                                    getContext(DC));
-    });
+    }
+    if (!outputFileMatches(options.DocOutputPath, docBuffer)) {
+      (void)withOutputFile(getContext(DC), options.DocOutputPath,
+                           [&](raw_ostream &out) {
+        out.write(docBuffer.data(), docBuffer.size());
+      });
+    }
+
+    writerThread.join();
+  }
+
+  if (writeEC) {
+    getContext(DC).Diags.diagnose(SourceLoc(), diag::error_opening_output,
+                                  writeErrorPath, writeEC.message());
   }
 }
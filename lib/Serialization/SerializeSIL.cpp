@@ -2063,6 +2063,23 @@ static void writeIndexTable(const sil_index_block::ListLayout &List,
   List.emit(scratch, kind, tableOffset, hashTableBlob);
 }
 
+/// Emit a list of bit offsets as a blob of fixed-width little-endian words,
+/// so that the deserializer can fill its offset tables with a trivial loop
+/// instead of decoding a VBR-encoded array.
+static void writeIndexOffsets(const sil_index_block::OffsetLayout &Offset,
+                              sil_index_block::RecordKind kind,
+                              const std::vector<BitOffset> &values) {
+  llvm::SmallString<4096> offsetBlob;
+  {
+    llvm::raw_svector_ostream blobStream(offsetBlob);
+    endian::Writer<little> writer(blobStream);
+    for (BitOffset value : values)
+      writer.write<uint32_t>(value);
+  }
+  SmallVector<uint64_t, 8> scratch;
+  Offset.emit(scratch, kind, offsetBlob);
+}
+
 void SILSerializer::writeIndexTables() {
   BCBlockRAII restoreBlock(Out, SIL_INDEX_BLOCK_ID, 4);
 
@@ -2070,34 +2087,34 @@ void SILSerializer::writeIndexTables() {
   sil_index_block::OffsetLayout Offset(Out);
   if (!FuncTable.empty()) {
     writeIndexTable(List, sil_index_block::SIL_FUNC_NAMES, FuncTable);
-    Offset.emit(ScratchRecord, sil_index_block::SIL_FUNC_OFFSETS, Funcs);
+    writeIndexOffsets(Offset, sil_index_block::SIL_FUNC_OFFSETS, Funcs);
   }
 
   if (!VTableList.empty()) {
     writeIndexTable(List, sil_index_block::SIL_VTABLE_NAMES, VTableList);
-    Offset.emit(ScratchRecord, sil_index_block::SIL_VTABLE_OFFSETS,
-                VTableOffset);
+    writeIndexOffsets(Offset, sil_index_block::SIL_VTABLE_OFFSETS,
+                      VTableOffset);
   }
 
   if (!GlobalVarList.empty()) {
     writeIndexTable(List, sil_index_block::SIL_GLOBALVAR_NAMES, GlobalVarList);
-    Offset.emit(ScratchRecord, sil_index_block::SIL_GLOBALVAR_OFFSETS,
-                GlobalVarOffset);
+    writeIndexOffsets(Offset, sil_index_block::SIL_GLOBALVAR_OFFSETS,
+                      GlobalVarOffset);
   }
 
   if (!WitnessTableList.empty()) {
     writeIndexTable(List, sil_index_block::SIL_WITNESS_TABLE_NAMES,
                     WitnessTableList);
-    Offset.emit(ScratchRecord, sil_index_block::SIL_WITNESS_TABLE_OFFSETS,
-                WitnessTableOffset);
+    writeIndexOffsets(Offset, sil_index_block::SIL_WITNESS_TABLE_OFFSETS,
+                      WitnessTableOffset);
   }
 
   if (!DefaultWitnessTableList.empty()) {
     writeIndexTable(List, sil_index_block::SIL_DEFAULT_WITNESS_TABLE_NAMES,
                     DefaultWitnessTableList);
-    Offset.emit(ScratchRecord,
-                sil_index_block::SIL_DEFAULT_WITNESS_TABLE_OFFSETS,
-                DefaultWitnessTableOffset);
+    writeIndexOffsets(Offset,
+                      sil_index_block::SIL_DEFAULT_WITNESS_TABLE_OFFSETS,
+                      DefaultWitnessTableOffset);
   }
 }
 
@@ -37,12 +37,32 @@ SerializedModuleLoader::SerializedModuleLoader(ASTContext &ctx,
   : ModuleLoader(tracker), Ctx(ctx) {}
 SerializedModuleLoader::~SerializedModuleLoader() = default;
 
+/// Returns true if the directory \p DirName contains an entry named
+/// \p Name, consulting (and lazily populating) the given cache of
+/// directory listings. A directory that cannot be listed is cached as
+/// empty; either way each directory is read at most once per process.
+static bool directoryContains(StringRef DirName, StringRef Name,
+                              llvm::StringMap<llvm::StringSet<>> &Listings) {
+  auto known = Listings.find(DirName);
+  if (known == Listings.end()) {
+    auto &entries = Listings[DirName];
+    std::error_code EC;
+    for (llvm::sys::fs::directory_iterator It(DirName, EC), End;
+         !EC && It != End; It.increment(EC)) {
+      entries.insert(llvm::sys::path::filename(It->path()));
+    }
+    known = Listings.find(DirName);
+  }
+  return known->second.count(Name);
+}
+
 static std::error_code
 openModuleFiles(StringRef DirName, StringRef ModuleFilename,
                 StringRef ModuleDocFilename,
                 std::unique_ptr<llvm::MemoryBuffer> *ModuleBuffer,
                 std::unique_ptr<llvm::MemoryBuffer> *ModuleDocBuffer,
-                llvm::SmallVectorImpl<char> &Scratch) {
+                llvm::SmallVectorImpl<char> &Scratch,
+                llvm::StringMap<llvm::StringSet<>> &DirListings) {
   assert(((ModuleBuffer && ModuleDocBuffer)
             || (!ModuleBuffer && !ModuleDocBuffer))
          && "Module and Module Doc buffer must both be initialized or NULL");
@@ -50,6 +70,13 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
   // module documentation file.
   Scratch.clear();
   llvm::sys::path::append(Scratch, DirName, ModuleFilename);
+
+  // Check the cached listing of the directory before touching the
+  // filesystem. Nearly all probes are misses, and this answers them
+  // without a syscall.
+  if (!directoryContains(DirName, ModuleFilename, DirListings))
+    return std::make_error_code(std::errc::no_such_file_or_directory);
+
   // If there are no buffers to load into, simply check for the existence of
   // the module file.
   if (!(ModuleBuffer || ModuleDocBuffer)) {
@@ -57,8 +84,15 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
                                  llvm::sys::fs::AccessMode::Exist);
   }
 
+  // Open the module file without requiring a null terminator so the buffer
+  // is always mmap'ed rather than copied into private heap memory. The
+  // bitstream reader never runs off the end of the buffer, and concurrent
+  // frontend jobs deserializing the same module then share one physical
+  // copy of its tables through the page cache.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleOrErr =
-  llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()));
+  llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()),
+                              /*FileSize=*/-1,
+                              /*RequiresNullTerminator=*/false);
   if (!ModuleOrErr)
     return ModuleOrErr.getError();
 
@@ -67,7 +101,12 @@ openModuleFiles(StringRef DirName, StringRef ModuleFilename,
   Scratch.clear();
   llvm::sys::path::append(Scratch, DirName, ModuleDocFilename);
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> ModuleDocOrErr =
-      llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()));
+      std::make_error_code(std::errc::no_such_file_or_directory);
+  if (directoryContains(DirName, ModuleDocFilename, DirListings))
+    ModuleDocOrErr =
+      llvm::MemoryBuffer::getFile(StringRef(Scratch.data(), Scratch.size()),
+                                  /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
   if (!ModuleDocOrErr &&
       ModuleDocOrErr.getError() != std::errc::no_such_file_or_directory) {
     return ModuleDocOrErr.getError();
@@ -84,7 +123,8 @@ static bool
 findModule(ASTContext &ctx, AccessPathElem moduleID,
            std::unique_ptr<llvm::MemoryBuffer> *moduleBuffer,
            std::unique_ptr<llvm::MemoryBuffer> *moduleDocBuffer,
-           bool &isFramework) {
+           bool &isFramework,
+           llvm::StringMap<llvm::StringSet<>> &dirListings) {
   llvm::SmallString<64> moduleFilename(moduleID.first.str());
   moduleFilename += '.';
   moduleFilename += SERIALIZED_MODULE_EXTENSION;
@@ -113,14 +153,14 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
     auto err = openModuleFiles(path,
                                moduleFilename.str(), moduleDocFilename.str(),
                                moduleBuffer, moduleDocBuffer,
-                               scratch);
+                               scratch, dirListings);
     if (err == std::errc::is_a_directory) {
       currPath = path;
       llvm::sys::path::append(currPath, moduleFilename.str());
       err = openModuleFiles(currPath,
                             archFile.str(), archDocFile.str(),
                             moduleBuffer, moduleDocBuffer,
-                            scratch);
+                            scratch, dirListings);
     }
     if (!err)
       return true;
@@ -138,7 +178,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
       auto err = openModuleFiles(currPath,
                                  archFile.str(), archDocFile.str(),
                                  moduleBuffer, moduleDocBuffer,
-                                 scratch);
+                                 scratch, dirListings);
       return !err;
     };
 
@@ -170,7 +210,7 @@ findModule(ASTContext &ctx, AccessPathElem moduleID,
   isFramework = false;
   return !openModuleFiles(ctx.SearchPathOpts.RuntimeLibraryImportPath,
                           moduleFilename.str(), moduleDocFilename.str(),
-                          moduleBuffer, moduleDocBuffer, scratch);
+                          moduleBuffer, moduleDocBuffer, scratch, dirListings);
 }
 
 FileUnit *SerializedModuleLoader::loadAST(
@@ -394,7 +434,8 @@ SerializedModuleLoader::canImportModule(std::pair<Identifier, SourceLoc> mID) {
 
   // Otherwise look on disk.
   bool isFramework = false;
-  return findModule(Ctx, mID, nullptr, nullptr, isFramework);
+  return findModule(Ctx, mID, nullptr, nullptr, isFramework,
+                    SearchPathListings);
 }
 
 ModuleDecl *SerializedModuleLoader::loadModule(SourceLoc importLoc,
@@ -423,7 +464,7 @@ ModuleDecl *SerializedModuleLoader::loadModule(SourceLoc importLoc,
   // Otherwise look on disk.
   if (!moduleInputBuffer) {
     if (!findModule(Ctx, moduleID, &moduleInputBuffer, &moduleDocInputBuffer,
-                    isFramework)) {
+                    isFramework, SearchPathListings)) {
       return nullptr;
     }
 
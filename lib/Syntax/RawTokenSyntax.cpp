@@ -36,6 +36,35 @@ RawTokenSyntax::RawTokenSyntax(tok TokenKind, OwnedString Text,
                 TokenKind(TokenKind), Text(Text),
                 LeadingTrivia(LeadingTrivia), TrailingTrivia(TrailingTrivia) {}
 
+static llvm::hash_code hashTrivia(llvm::hash_code Seed, const Trivia &T) {
+  for (const TriviaPiece &Piece : T)
+    Seed = llvm::hash_combine(Seed, Piece.hash());
+  return Seed;
+}
+
+RC<RawTokenSyntax>
+RawTokenSyntaxCache::getToken(tok TokenKind, OwnedString Text,
+                              const Trivia &LeadingTrivia,
+                              const Trivia &TrailingTrivia) {
+  auto Hash = llvm::hash_combine(static_cast<unsigned>(TokenKind), Text.str());
+  Hash = hashTrivia(Hash, LeadingTrivia);
+  Hash = hashTrivia(Hash, TrailingTrivia);
+
+  auto &Bucket = Nodes[unsigned(size_t(Hash))];
+  for (const RC<RawTokenSyntax> &Existing : Bucket) {
+    if (Existing->TokenKind == TokenKind &&
+        Existing->getText() == Text.str() &&
+        Existing->LeadingTrivia.Pieces == LeadingTrivia.Pieces &&
+        Existing->TrailingTrivia.Pieces == TrailingTrivia.Pieces)
+      return Existing;
+  }
+
+  auto Token = RawTokenSyntax::make(TokenKind, Text, SourcePresence::Present,
+                                    LeadingTrivia, TrailingTrivia);
+  Bucket.push_back(Token);
+  return Token;
+}
+
 AbsolutePosition
 RawTokenSyntax::accumulateAbsolutePosition(AbsolutePosition &Pos) const {
   for (auto Leader : LeadingTrivia) {
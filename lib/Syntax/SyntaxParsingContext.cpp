@@ -55,7 +55,8 @@ static RC<RawSyntax> createSyntaxAs(SyntaxKind Kind,
 SyntaxParsingContext::SyntaxParsingContext(SyntaxParsingContext *&CtxtHolder,
                                            SourceFile &SF)
     : Parent(nullptr), CtxtHolder(CtxtHolder), Mode(AccumulationMode::Root),
-      SF(&SF), Enabled(SF.shouldKeepSyntaxInfo()) {
+      SF(&SF), Enabled(SF.shouldKeepSyntaxInfo()),
+      TokenCache(Enabled ? new RawTokenSyntaxCache() : nullptr) {
   CtxtHolder = this;
 }
 
@@ -77,9 +78,8 @@ void SyntaxParsingContext::addToken(Token &Tok, Trivia &LeadingTrivia,
   if (!Enabled)
     return;
 
-  addRawSyntax(RawTokenSyntax::make(Tok.getKind(), Tok.getText(),
-                                    SourcePresence::Present, LeadingTrivia,
-                                    TrailingTrivia));
+  addRawSyntax(TokenCache->getToken(Tok.getKind(), Tok.getText(),
+                                    LeadingTrivia, TrailingTrivia));
 }
 
 /// Add Syntax to the parts.
@@ -248,6 +248,8 @@ SyntaxParsingContext::~SyntaxParsingContext() {
     // Pop this context from the stack.
     if (!isRoot())
       CtxtHolder = Parent;
+    else
+      delete TokenCache;
   };
 
   if (!Enabled)
@@ -28,6 +28,8 @@
 #include "swift/SIL/SILVTableVisitor.h"
 #include "swift/SIL/TypeLowering.h"
 #include "llvm/ADT/StringSet.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "TBDGenVisitor.h"
 
@@ -357,6 +359,131 @@ void TBDGenVisitor::visitProtocolDecl(ProtocolDecl *PD) {
 #endif
 }
 
+namespace {
+/// Computes a stable hash of a module's API surface. Unlike the symbol
+/// enumeration above, this walk never mangles names or computes linkage;
+/// it only folds in the facts the symbol list depends on, which makes it
+/// cheap enough to run on every incremental build. It errs on the side of
+/// hashing too much: a spurious hash change only costs a regeneration,
+/// while a missed one would let a stale TBD file be reused.
+class APISurfaceHasher {
+  llvm::MD5 Hash;
+
+  void combine(uint64_t Value) {
+    Hash.update(llvm::ArrayRef<uint8_t>(
+        reinterpret_cast<uint8_t *>(&Value), sizeof Value));
+  }
+
+  void combine(StringRef Str) {
+    Hash.update(Str);
+    // Separator, so that adjacent strings don't run together.
+    Hash.update(StringRef("\0", 1));
+  }
+
+  void hashConformances(DeclContext *DC) {
+    // Conformances determine witness table symbols.
+    for (auto conformance : DC->getLocalConformances())
+      combine(conformance->getProtocol()->getNameStr());
+  }
+
+  void hashDecl(Decl *D) {
+    combine((uint64_t)D->getKind());
+    // Attributes like @objc, @_fixed_layout or dynamic change which
+    // symbols a decl produces; hashing every attribute kind is
+    // conservative but harmless. Some attributes also carry payloads
+    // that feed directly into symbol names, so fold those in as well.
+    for (auto *attr : D->getAttrs()) {
+      combine((uint64_t)attr->getKind());
+      if (auto *SGNA = dyn_cast<SILGenNameAttr>(attr))
+        combine(SGNA->Name);
+      else if (auto *CDA = dyn_cast<CDeclAttr>(attr))
+        combine(CDA->Name);
+      else if (auto *OA = dyn_cast<ObjCAttr>(attr)) {
+        if (auto name = OA->getName()) {
+          llvm::SmallString<64> scratch;
+          combine(name->getString(scratch));
+        }
+      } else if (auto *AvA = dyn_cast<AvailableAttr>(attr)) {
+        // Availability doesn't affect the symbol list, but it is printed
+        // verbatim into the generated ObjC header, which reuses this hash.
+        combine((uint64_t)AvA->Platform);
+        combine((uint64_t)AvA->PlatformAgnostic);
+        combine(AvA->Message);
+        combine(AvA->Rename);
+        for (auto &version : {AvA->Introduced, AvA->Deprecated,
+                              AvA->Obsoleted})
+          combine(version ? version->getAsString() : std::string());
+      }
+    }
+
+    if (auto *PBD = dyn_cast<PatternBindingDecl>(D)) {
+      // Stored property initializers can have their own symbols.
+      for (auto &entry : PBD->getPatternList())
+        combine((uint64_t)(entry.getInit() != nullptr));
+    }
+
+    if (auto *VD = dyn_cast<ValueDecl>(D)) {
+      llvm::SmallString<64> scratch;
+      combine(VD->getFullName().getString(scratch));
+      combine((uint64_t)VD->getFormalAccess());
+      // The interface type feeds the mangled names of the symbols.
+      if (VD->hasInterfaceType())
+        combine(VD->getInterfaceType()->getCanonicalType().getString());
+    }
+
+    if (auto *AFD = dyn_cast<AbstractFunctionDecl>(D)) {
+      // Default arguments have their own generator symbols.
+      for (auto *paramList : AFD->getParameterLists())
+        for (auto *param : *paramList)
+          combine((uint64_t)(param->getDefaultValue() != nullptr));
+    }
+
+    if (auto *NTD = dyn_cast<NominalTypeDecl>(D)) {
+      hashConformances(NTD);
+      for (auto *member : NTD->getMembers())
+        hashDecl(member);
+    } else if (auto *ED = dyn_cast<ExtensionDecl>(D)) {
+      if (auto extended = ED->getExtendedType())
+        combine(extended->getCanonicalType().getString());
+      hashConformances(ED);
+      for (auto *member : ED->getMembers())
+        hashDecl(member);
+    } else if (auto *ASD = dyn_cast<AbstractStorageDecl>(D)) {
+      // Accessors aren't in the member lists; visit them explicitly.
+      SmallVector<Decl *, 4> accessors;
+      ASD->getAllAccessorFunctions(accessors);
+      for (auto *accessor : accessors)
+        hashDecl(accessor);
+    }
+  }
+
+public:
+  std::string hashModule(ModuleDecl *M) {
+    // -enable-testing widens the effective access of internal decls, which
+    // adds their symbols without changing any formal access hashed above.
+    combine((uint64_t)M->isTestingEnabled());
+    for (auto *file : M->getFiles()) {
+      // Files with entry points emit a main symbol and suppress global
+      // variable accessors.
+      combine((uint64_t)file->hasEntryPoint());
+      SmallVector<Decl *, 16> decls;
+      file->getTopLevelDecls(decls);
+      for (auto *D : decls)
+        hashDecl(D);
+    }
+    llvm::MD5::MD5Result result;
+    Hash.final(result);
+    llvm::SmallString<32> digest;
+    llvm::MD5::stringifyResult(result, digest);
+    return digest.str().str();
+  }
+};
+} // end anonymous namespace
+
+std::string swift::getAPISurfaceHash(ModuleDecl *M) {
+  return APISurfaceHasher().hashModule(M);
+}
+
 static void enumeratePublicSymbolsAndWrite(ModuleDecl *M, FileUnit *singleFile,
                                            StringSet &symbols,
                                            bool hasMultipleIGMs,
@@ -99,19 +99,29 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
   else
     return {};
 
-  std::vector<std::pair<std::string, const TypeRef *>> Fields;
-  for (auto Info : ReflectionInfos) {
+  auto Found = FieldTypeInfoCache.find(MangledName);
+  if (Found != FieldTypeInfoCache.end())
+    return Found->second;
+
+  // Index the field sections of any images added since the last lookup.
+  // Each section is walked exactly once no matter how many types are
+  // queried. Images are indexed in registration order and the first
+  // descriptor for a name wins, matching the old scan order.
+  for (; IndexedFieldInfos < ReflectionInfos.size(); ++IndexedFieldInfos) {
+    const auto &Info = ReflectionInfos[IndexedFieldInfos];
     uintptr_t Offset = Info.Field.SectionOffset;
     for (auto &FD : Info.Field.Metadata) {
       if (!FD.hasMangledTypeName())
         continue;
-      auto CandidateMangledName = FD.getMangledTypeName(Offset);
-      if (MangledName.compare(CandidateMangledName) != 0)
-        continue;
-      return {&FD, Offset};
+      FieldTypeInfoCache.insert(
+          {FD.getMangledTypeName(Offset), {&FD, Offset}});
     }
   }
 
+  Found = FieldTypeInfoCache.find(MangledName);
+  if (Found != FieldTypeInfoCache.end())
+    return Found->second;
+
   return {nullptr, 0};
 }
 
@@ -16,6 +16,8 @@
 #include "swift/Runtime/Unreachable.h"
 #include "swift/SwiftRemoteMirror/SwiftRemoteMirror.h"
 
+#include <unordered_map>
+
 using namespace swift;
 using namespace swift::reflection;
 using namespace swift::remote;
@@ -269,6 +271,51 @@ swift_reflection_childOfInstance(SwiftReflectionContextRef ContextRef,
   return convertChild(TI, Index);
 }
 
+void
+swift_reflection_infoForInstances(SwiftReflectionContextRef ContextRef,
+                                  const uintptr_t *Objects,
+                                  size_t Count,
+                                  swift_instanceinfo_t *OutInfos) {
+  auto Context = reinterpret_cast<NativeReflectionContext *>(ContextRef);
+
+  // Per-call memo of metadata address -> (typeref, typeinfo), so objects
+  // sharing a type pay for resolution and lowering once.
+  std::unordered_map<uintptr_t,
+                     std::pair<const TypeRef *, const TypeInfo *>> Memo;
+
+  for (size_t i = 0; i < Count; ++i) {
+    auto MetadataAddress = Context->readMetadataFromInstance(Objects[i]);
+    if (!MetadataAddress.first) {
+      OutInfos[i].TypeRef = 0;
+      OutInfos[i].TypeInfo = convertTypeInfo(nullptr);
+      continue;
+    }
+
+    const TypeRef *TR;
+    const TypeInfo *TI;
+    auto Found = Memo.find(MetadataAddress.second);
+    if (Found != Memo.end()) {
+      TR = Found->second.first;
+      TI = Found->second.second;
+    } else {
+      TR = Context->readTypeFromMetadata(MetadataAddress.second);
+      TI = Context->getMetadataTypeInfo(MetadataAddress.second);
+      if (TI != nullptr) {
+        // Class instances sharing metadata share layout, so the result
+        // can be reused for every other object with this metadata.
+        Memo.insert({MetadataAddress.second, {TR, TI}});
+      } else {
+        // Non-class heap objects (boxes, closure contexts, errors) can
+        // have object-dependent layout; resolve them individually.
+        TI = Context->getInstanceTypeInfo(Objects[i]);
+      }
+    }
+
+    OutInfos[i].TypeRef = reinterpret_cast<swift_typeref_t>(TR);
+    OutInfos[i].TypeInfo = convertTypeInfo(TI);
+  }
+}
+
 int swift_reflection_projectExistential(SwiftReflectionContextRef ContextRef,
                                         swift_addr_t ExistentialAddress,
                                         swift_typeref_t ExistentialTypeRef,
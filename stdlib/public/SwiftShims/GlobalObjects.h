@@ -63,12 +63,17 @@ struct _SwiftEmptyDictionaryStorage {
   struct HeapObject header;
   struct _SwiftDictionaryBodyStorage body;
   __swift_uintptr_t entries;
+  // One word of zeroed hash fragment bytes; lives directly after the bitmap
+  // words, matching the tail allocation layout of real storage.
+  __swift_uintptr_t hashFragments;
 };
 
 struct _SwiftEmptySetStorage {
   struct HeapObject header;
   struct _SwiftSetBodyStorage body;
   __swift_uintptr_t entries;
+  // See _SwiftEmptyDictionaryStorage.hashFragments.
+  __swift_uintptr_t hashFragments;
 };
 
 SWIFT_RUNTIME_STDLIB_INTERFACE
@@ -1298,6 +1298,13 @@ class HeapObjectSideTableEntry {
     : object(newObject), refCounts()
   { }
 
+  // Side table entries are allocated and freed through the runtime's own
+  // heap entry points, which serve small blocks from per-thread caches, so
+  // threads creating and destroying weak references at a high rate don't
+  // contend on the malloc locks. Defined in RefCount.cpp.
+  void *operator new(size_t size);
+  void operator delete(void *p);
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winvalid-offsetof"
   static ptrdiff_t refCountsOffset() {
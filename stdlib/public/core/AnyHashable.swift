@@ -176,6 +176,17 @@ public struct AnyHashable {
       return
     }
 
+    // For value types, the upcasting entry point in the runtime just falls
+    // back to the default representation, so build that directly and skip
+    // the runtime round trip. When this initializer is specialized for a
+    // concrete struct or enum key - Int and String keys being the common
+    // cases - the check folds away entirely.
+    if !(H.self is AnyObject.Type) {
+      self._box = _ConcreteHashableBox(base)
+      self._usedCustomRepresentation = false
+      return
+    }
+
     self._box = _ConcreteHashableBox(0 as Int)
     self._usedCustomRepresentation = false
     _makeAnyHashableUpcastingToHashableBaseType(
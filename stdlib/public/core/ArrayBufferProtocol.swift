@@ -132,6 +132,18 @@ extension _ArrayBufferProtocol {
     return firstElementAddress
   }
 
+  /// A buffer over the tail-allocated capacity that has not been initialized
+  /// yet. Writers that produce elements in bulk can initialize a prefix of
+  /// this memory directly and then advance `count` past what they wrote.
+  ///
+  /// - Precondition: The elements are known to be stored contiguously.
+  @_inlineable
+  @_versioned
+  internal var unusedCapacityBuffer: UnsafeMutableBufferPointer<Element> {
+    return UnsafeMutableBufferPointer(
+      start: firstElementAddress + count, count: capacity - count)
+  }
+
   @_inlineable
   @_versioned
   internal mutating func replaceSubrange<C>(
@@ -194,6 +194,31 @@ internal func _decodeCString<Encoding : _UnicodeEncoding>(
   repairingInvalidCodeUnits isRepairing: Bool = true)
 -> (result: String, repairsMade: Bool)? {
 
+  // Fast path: all-ASCII UTF-8 input needs neither repair nor transcoding;
+  // a single exact-sized copy into one-byte storage is the whole
+  // conversion. The generic path below walks the input twice through the
+  // UTF-16 decoder, which dominates the cost of converting the small,
+  // almost-always-ASCII C strings this entry point typically sees.
+  if encoding == UTF8.self {
+    let raw = UnsafeRawPointer(cString)
+    var allASCII = true
+    for i in 0..<length {
+      if raw.load(fromByteOffset: i, as: UInt8.self) > 0x7f {
+        allASCII = false
+        break
+      }
+    }
+    if allASCII {
+      let stringBuffer = _StringBuffer(
+        capacity: length, initialSize: length, elementWidth: 1)
+      _memcpy(
+        dest: stringBuffer.start,
+        src: UnsafeMutableRawPointer(mutating: raw),
+        size: UInt(length))
+      return (result: String(_storage: stringBuffer), repairsMade: false)
+    }
+  }
+
   let buffer = UnsafeBufferPointer<Encoding.CodeUnit>(
     start: cString, count: length)
 
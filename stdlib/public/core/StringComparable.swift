@@ -134,10 +134,9 @@ extension String : Equatable {
   @_inlineable // FIXME(sil-serialize-all)
   @inline(__always)
   public static func == (lhs: String, rhs: String) -> Bool {
-#if _runtime(_ObjC)
-    // We only want to perform this optimization on objc runtimes. Elsewhere,
-    // we will make it follow the unicode collation algorithm even for ASCII.
-    // This is consistent with Foundation, but incorrect as defined by Unicode.
+    // Unlike ordering (see _compareString), this fast path is sound on every
+    // runtime: two distinct ASCII byte sequences are never canonically
+    // equivalent, so equality of ASCII strings is exactly byte equality.
     if lhs._core.isASCII && rhs._core.isASCII {
       if lhs._core.count != rhs._core.count {
         return false
@@ -149,7 +148,6 @@ extension String : Equatable {
         lhs._core.startASCII, rhs._core.startASCII,
         rhs._core.count) == (0 as CInt)
     }
-#endif
     return lhs._compareString(rhs) == 0
   }
 }
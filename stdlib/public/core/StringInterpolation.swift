@@ -29,8 +29,22 @@ extension String : _ExpressibleByStringInterpolation {
   @effects(readonly)
   public init(stringInterpolation strings: String...) {
     self.init()
+    if strings.count < 2 {
+      // A single segment (or none) reuses the segment's storage outright.
+      for str in strings {
+        self += str
+      }
+      return
+    }
+    // Size the result once up front instead of growing it segment by
+    // segment; every segment knows its code unit count in O(1).
+    var utf16Count = 0
+    for str in strings {
+      utf16Count += str._core.count
+    }
+    self._core.reserveCapacity(utf16Count)
     for str in strings {
-      self += str
+      self._core.append(str._core)
     }
   }
 
@@ -363,6 +363,20 @@ extension String {
   ///     // Prints "6"
   @_inlineable // FIXME(sil-serialize-all)
   public var utf8CString: ContiguousArray<CChar> {
+    if let asciiBuffer = self._core.asciiBuffer {
+      // Contiguous ASCII storage is already valid UTF-8; copy the bytes
+      // directly instead of driving them through the transcoding iterator.
+      defer { _fixLifetime(self._core) }
+      let count = asciiBuffer.count
+      let source = asciiBuffer.baseAddress!
+      var result = ContiguousArray<CChar>()
+      result.reserveCapacity(count + 1)
+      for i in 0..<count {
+        result.append(CChar(bitPattern: source[i]))
+      }
+      result.append(0)
+      return result
+    }
     var result = ContiguousArray<CChar>()
     result.reserveCapacity(utf8.count + 1)
     for c in utf8 {
@@ -42,10 +42,17 @@ struct HashableConformanceEntry {
   /// don't have to deal with cache invalidation.
   const Metadata *baseTypeThatConformsToHashable;
 
+  /// The `Hashable` witness table for the derived type.
+  ///
+  /// Always non-NULL, for the same reason as above.
+  const HashableWitnessTable *hashableConformance;
+
   HashableConformanceEntry(HashableConformanceKey key,
-                           const Metadata *baseTypeThatConformsToHashable)
+                           const Metadata *baseTypeThatConformsToHashable,
+                           const HashableWitnessTable *hashableConformance)
       : derivedType(key.derivedType),
-        baseTypeThatConformsToHashable(baseTypeThatConformsToHashable) {}
+        baseTypeThatConformsToHashable(baseTypeThatConformsToHashable),
+        hashableConformance(hashableConformance) {}
 
   int compareWithKey(const HashableConformanceKey &key) const {
     if (key.derivedType != derivedType) {
@@ -57,7 +64,8 @@ struct HashableConformanceEntry {
 
   static size_t
   getExtraAllocationSize(HashableConformanceKey key,
-                         const Metadata *baseTypeThatConformsToHashable) {
+                         const Metadata *baseTypeThatConformsToHashable,
+                         const HashableWitnessTable *hashableConformance) {
     return 0;
   }
 
@@ -74,14 +82,16 @@ HashableConformances;
 
 template<bool KnownToConformToHashable>
 LLVM_ATTRIBUTE_ALWAYS_INLINE
-static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
+static const HashableConformanceEntry *
+findHashableConformanceEntry(const Metadata *type) {
   // Check the cache first.
   if (HashableConformanceEntry *entry =
           HashableConformances.find(HashableConformanceKey{type})) {
-    return entry->baseTypeThatConformsToHashable;
+    return entry;
   }
-  if (!KnownToConformToHashable &&
-      !swift_conformsToProtocol(type, &HashableProtocolDescriptor)) {
+  auto hashableConformance = reinterpret_cast<const HashableWitnessTable *>(
+      swift_conformsToProtocol(type, &HashableProtocolDescriptor));
+  if (!KnownToConformToHashable && !hashableConformance) {
     // Don't cache the negative response because we don't invalidate
     // this cache when a new conformance is loaded dynamically.
     return nullptr;
@@ -98,9 +108,9 @@ static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
       break;
     baseTypeThatConformsToHashable = superclass;
   }
-  HashableConformances.getOrInsert(HashableConformanceKey{type},
-                                   baseTypeThatConformsToHashable);
-  return baseTypeThatConformsToHashable;
+  return HashableConformances.getOrInsert(HashableConformanceKey{type},
+                                          baseTypeThatConformsToHashable,
+                                          hashableConformance).first;
 }
 
 /// Find the base type that introduces the `Hashable` conformance.
@@ -110,17 +120,30 @@ static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
 /// - Precondition: `type` conforms to `Hashable` (not checked).
 const Metadata *swift::hashable_support::findHashableBaseTypeOfHashableType(
     const Metadata *type) {
-  auto result =
-    findHashableBaseTypeImpl</*KnownToConformToHashable=*/ true>(type);
-  assert(result && "Known-hashable types should have a `Hashable` conformance.");
-  return result;
+  auto entry =
+    findHashableConformanceEntry</*KnownToConformToHashable=*/ true>(type);
+  assert(entry && "Known-hashable types should have a `Hashable` conformance.");
+  return entry->baseTypeThatConformsToHashable;
 }
 
 /// Find the base type that introduces the `Hashable` conformance.
 /// If `type` does not conform to `Hashable`, `nullptr` is returned.
 const Metadata *swift::hashable_support::findHashableBaseType(
     const Metadata *type) {
-  return findHashableBaseTypeImpl</*KnownToConformToHashable=*/ false>(type);
+  auto entry =
+    findHashableConformanceEntry</*KnownToConformToHashable=*/ false>(type);
+  return entry ? entry->baseTypeThatConformsToHashable : nullptr;
+}
+
+/// Find the `Hashable` witness table for a type, consulting the same cache
+/// as the base-type lookup so repeated boxing of the same concrete type
+/// doesn't resolve the conformance again.
+/// If `type` does not conform to `Hashable`, `nullptr` is returned.
+const HashableWitnessTable *swift::hashable_support::findHashableConformance(
+    const Metadata *type) {
+  auto entry =
+    findHashableConformanceEntry</*KnownToConformToHashable=*/ false>(type);
+  return entry ? entry->hashableConformance : nullptr;
 }
 
 // internal func _makeAnyHashableUsingDefaultRepresentation<H : Hashable>(
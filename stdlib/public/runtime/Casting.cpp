@@ -18,6 +18,7 @@
 #include "swift/Basic/Lazy.h"
 #include "swift/Demangling/Demangler.h"
 #include "swift/Runtime/Casting.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Config.h"
 #include "swift/Runtime/Enum.h"
 #include "swift/Runtime/HeapObject.h"
@@ -661,9 +662,9 @@ static bool _dynamicCastToAnyHashable(OpaqueValue *destination,
                                       const Metadata *sourceType,
                                       const Metadata *targetType,
                                       DynamicCastFlags flags) {
-  // Look for a conformance to Hashable.
-  auto hashableConformance = reinterpret_cast<const HashableWitnessTable *>(
-      swift_conformsToProtocol(sourceType, &HashableProtocolDescriptor));
+  // Look for a conformance to Hashable. This consults the hashable
+  // conformance cache, so a recurring source type resolves it only once.
+  auto hashableConformance = findHashableConformance(sourceType);
 
   // If we don't find one, the cast fails.
   if (!hashableConformance) {
@@ -2394,228 +2395,394 @@ static bool _dynamicCastTupleToTuple(OpaqueValue *destination,
 }
 
 /******************************************************************************/
-/****************************** Main Entrypoint *******************************/
+/*************************** Cast Strategy Cache ******************************/
 /******************************************************************************/
 
-/// Perform a dynamic cast to an arbitrary type.
+namespace {
 
-bool swift::swift_dynamicCast(OpaqueValue *dest, OpaqueValue *src,
+/// The type of a function implementing the cast strategy resolved for a
+/// particular (source type, target type) pair.
+using DynamicCastFn = bool (*)(OpaqueValue *dest, OpaqueValue *src,
+                               const Metadata *srcType,
+                               const Metadata *targetType,
+                               DynamicCastFlags flags);
+
+using DynamicCastCacheKey = std::pair<const Metadata *, const Metadata *>;
+
+/// A cache entry mapping a (source type, target type) pair to its resolved
+/// cast strategy.
+struct DynamicCastCacheEntry {
+  const Metadata *SourceType;
+  const Metadata *TargetType;
+  DynamicCastFn Fn;
+
+  DynamicCastCacheEntry(DynamicCastCacheKey key, DynamicCastFn fn)
+    : SourceType(key.first), TargetType(key.second), Fn(fn) {}
+
+  intptr_t getKeyIntValueForDump() const {
+    return reinterpret_cast<intptr_t>(SourceType);
+  }
+
+  int compareWithKey(DynamicCastCacheKey key) const {
+    if (key.first != SourceType)
+      return (uintptr_t(key.first) < uintptr_t(SourceType) ? -1 : 1);
+    if (key.second != TargetType)
+      return (uintptr_t(key.second) < uintptr_t(TargetType) ? -1 : 1);
+    return 0;
+  }
+
+  template <class... Args>
+  static size_t getExtraAllocationSize(Args &&... ignored) {
+    return 0;
+  }
+};
+
+} // end anonymous namespace
+
+/// The cache of resolved cast strategies, keyed by (source, target) pairs.
+static Lazy<ConcurrentMap<DynamicCastCacheEntry>> DynamicCastStrategies;
+
+/// A resolved cast strategy: a cast that always fails.
+static bool _castAlwaysFails(OpaqueValue *dest, OpaqueValue *src,
+                             const Metadata *srcType,
+                             const Metadata *targetType,
+                             DynamicCastFlags flags) {
+  return _fail(src, srcType, targetType, flags);
+}
+
+/// A resolved cast strategy: class-to-class reference cast.
+static bool _castClassToClass(OpaqueValue *dest, OpaqueValue *src,
                               const Metadata *srcType,
                               const Metadata *targetType,
-                              DynamicCastFlags flags)
-    SWIFT_CC(RegisterPreservingCC_IMPL) {
-  auto unwrapResult = checkDynamicCastFromOptional(dest, src, srcType,
-                                                   targetType, flags);
-  srcType = unwrapResult.payloadType;
-  if (!srcType)
-    return unwrapResult.success;
+                              DynamicCastFlags flags) {
+  // Do a dynamic cast on the instance pointer.
+  void *object = *reinterpret_cast<void * const *>(src);
+  return _dynamicCastUnknownClassIndirect(dest, object, targetType, flags);
+}
 
-#if SWIFT_OBJC_INTEROP
-  // A class or AnyObject reference may point to a _SwiftValue box.
-  {
-    auto innerFlags = flags - DynamicCastFlags::Unconditional
-                            - DynamicCastFlags::DestroyOnFailure;
-    if (tryDynamicCastBoxedSwiftValue(dest, src, srcType,
-                                      targetType, innerFlags)) {
-      // TakeOnSuccess was handled inside tryDynamicCastBoxedSwiftValue().
-      return true;
-    } else {
-      // Couldn't cast boxed value to targetType.
-      // Fall through and try to cast the _SwiftValue box itself to targetType.
-      // (for example, casting _SwiftValue to NSObject will be successful)
-    }
-  }
-#endif
+/// A resolved cast strategy: cast from an existential to a class type.
+static bool _castExistentialToClass(OpaqueValue *dest, OpaqueValue *src,
+                                    const Metadata *srcType,
+                                    const Metadata *targetType,
+                                    DynamicCastFlags flags) {
+  auto srcExistentialType = cast<ExistentialTypeMetadata>(srcType);
+  return _dynamicCastToUnknownClassFromExistential(dest, src,
+                                                   srcExistentialType,
+                                                   targetType, flags);
+}
 
-  switch (targetType->getKind()) {
-  // Handle wrapping an Optional target.
-  case MetadataKind::Optional: {
-    // If the source is an existential, attempt to cast it first without
-    // unwrapping the target. This handles an optional source wrapped within an
-    // existential that Optional conforms to (Any).
-    if (auto srcExistentialType = dyn_cast<ExistentialTypeMetadata>(srcType)) {
 #if SWIFT_OBJC_INTEROP
-      // If coming from AnyObject, we may want to bridge.
-      if (isAnyObjectExistentialType(srcExistentialType)) {
-        if (auto targetBridgeWitness = findBridgeWitness(targetType)) {
-          return _dynamicCastClassToValueViaObjCBridgeable(dest, src, srcType,
-                                                           targetType,
-                                                           targetBridgeWitness,
-                                                           flags);
-        }
-      }
+/// A resolved cast strategy: bridge a value type to a class target.
+static bool _castValueToClassViaBridge(OpaqueValue *dest, OpaqueValue *src,
+                                       const Metadata *srcType,
+                                       const Metadata *targetType,
+                                       DynamicCastFlags flags) {
+  // The source type had a bridge witness when the strategy was resolved,
+  // so this lookup hits in the conformance cache.
+  auto srcBridgeWitness = findBridgeWitness(srcType);
+  assert(srcBridgeWitness && "bridge witness disappeared?");
+  return _dynamicCastValueToClassViaObjCBridgeable(dest, src, srcType,
+                                                   targetType,
+                                                   srcBridgeWitness,
+                                                   flags);
+}
 #endif
-      return _dynamicCastFromExistential(dest, src, srcExistentialType,
-                                         targetType, flags);
-    }
-    // Recursively cast into the layout compatible payload area.
-    const Metadata *payloadType =
-      cast<EnumMetadata>(targetType)->getGenericArgs()[0];
-    if (swift_dynamicCast(dest, src, srcType, payloadType, flags)) {
-      swift_storeEnumTagSinglePayload(dest, payloadType, -1 /*case*/,
-                                      1 /*emptyCases*/);
-      return true;
-    }
-    return false;
-  }
 
-  // Casts to class type.
+/// Resolve the strategy for casting to a class, ObjC class wrapper, or
+/// foreign class target from the given source type.
+static DynamicCastFn resolveClassCast(const Metadata *srcType) {
+  switch (srcType->getKind()) {
   case MetadataKind::Class:
   case MetadataKind::ObjCClassWrapper:
-#if SWIFT_OBJC_INTEROP
-    // If the destination type is an NSError, and the source type is an
-    // Error, then the cast can succeed by NSError bridging.
-    if (targetType == getNSErrorMetadata()) {
-      // Don't rebridge if the source is already some kind of NSError.
-      if (srcType->isAnyClass()
-          && swift_dynamicCastObjCClass(*reinterpret_cast<id*>(src),
-               static_cast<const ObjCClassWrapperMetadata*>(targetType)->Class))
-        return _succeed(dest, src, srcType, flags);
-      if (auto srcErrorWitness = findErrorWitness(srcType)) {
-        auto error = dynamicCastValueToNSError(src, srcType,
-                                               srcErrorWitness, flags);
-        *reinterpret_cast<id *>(dest) = error;
-        return true;
-      }
-    }
+  case MetadataKind::ForeignClass:
+    return _castClassToClass;
+
+  case MetadataKind::Existential:
+    return _castExistentialToClass;
+
+  case MetadataKind::Struct:
+    // If the source type is AnyHashable, cast from that.
+    if (isAnyHashableType(cast<StructMetadata>(srcType)))
+      return _dynamicCastFromAnyHashable;
     LLVM_FALLTHROUGH;
+
+  case MetadataKind::Enum:
+  case MetadataKind::Optional:
+#if SWIFT_OBJC_INTEROP
+    // If the source type is bridged to Objective-C, try to bridge.
+    if (findBridgeWitness(srcType))
+      return _castValueToClassViaBridge;
 #endif
+    return _castAlwaysFails;
 
-  case MetadataKind::ForeignClass:
-    switch (srcType->getKind()) {
-    case MetadataKind::Class:
-    case MetadataKind::ObjCClassWrapper:
-    case MetadataKind::ForeignClass: {
-      // Do a dynamic cast on the instance pointer.
-      void *object = *reinterpret_cast<void * const *>(src);
-      return _dynamicCastUnknownClassIndirect(dest, object,
-                                              targetType, flags);
-    }
+  case MetadataKind::ExistentialMetatype:
+  case MetadataKind::Function:
+  case MetadataKind::HeapLocalVariable:
+  case MetadataKind::HeapGenericLocalVariable:
+  case MetadataKind::ErrorObject:
+  case MetadataKind::Metatype:
+  case MetadataKind::Opaque:
+  case MetadataKind::Tuple:
+    return _castAlwaysFails;
+  }
 
-    case MetadataKind::Existential: {
-      auto srcExistentialType = cast<ExistentialTypeMetadata>(srcType);
-      return _dynamicCastToUnknownClassFromExistential(dest, src,
-                                                       srcExistentialType,
-                                                       targetType, flags);
-    }
+  swift_runtime_unreachable("Unhandled MetadataKind in switch.");
+}
 
-    case MetadataKind::Struct:
-      // If the source type is AnyHashable, cast from that.
-      if (isAnyHashableType(cast<StructMetadata>(srcType))) {
-        return _dynamicCastFromAnyHashable(dest, src, srcType,
-                                           targetType, flags);
-      }
-      LLVM_FALLTHROUGH;
+#if SWIFT_OBJC_INTEROP
+/// A resolved cast strategy: cast to the NSError class. Whether NSError
+/// bridging applies depends on the source value, so these checks cannot be
+/// resolved away per type pair.
+static bool _castToNSError(OpaqueValue *dest, OpaqueValue *src,
+                           const Metadata *srcType,
+                           const Metadata *targetType,
+                           DynamicCastFlags flags) {
+  // The cast can succeed by NSError bridging if the source is an Error.
+  // Don't rebridge if the source is already some kind of NSError.
+  if (srcType->isAnyClass()
+      && swift_dynamicCastObjCClass(*reinterpret_cast<id*>(src),
+           static_cast<const ObjCClassWrapperMetadata*>(targetType)->Class))
+    return _succeed(dest, src, srcType, flags);
+  if (auto srcErrorWitness = findErrorWitness(srcType)) {
+    auto error = dynamicCastValueToNSError(src, srcType,
+                                           srcErrorWitness, flags);
+    *reinterpret_cast<id *>(dest) = error;
+    return true;
+  }
 
-    case MetadataKind::Enum:
-    case MetadataKind::Optional: {
+  // Not an NSError bridging case; cast as an ordinary class reference.
+  return resolveClassCast(srcType)(dest, src, srcType, targetType, flags);
+}
+#endif
+
+/// A resolved cast strategy: cast to an Optional target type.
+static bool _castToOptional(OpaqueValue *dest, OpaqueValue *src,
+                            const Metadata *srcType,
+                            const Metadata *targetType,
+                            DynamicCastFlags flags) {
+  // If the source is an existential, attempt to cast it first without
+  // unwrapping the target. This handles an optional source wrapped within an
+  // existential that Optional conforms to (Any).
+  if (auto srcExistentialType = dyn_cast<ExistentialTypeMetadata>(srcType)) {
 #if SWIFT_OBJC_INTEROP
-      // If the source type is bridged to Objective-C, try to bridge.
-      if (auto srcBridgeWitness = findBridgeWitness(srcType)) {
-        return _dynamicCastValueToClassViaObjCBridgeable(dest, src, srcType,
+    // If coming from AnyObject, we may want to bridge.
+    if (isAnyObjectExistentialType(srcExistentialType)) {
+      if (auto targetBridgeWitness = findBridgeWitness(targetType)) {
+        return _dynamicCastClassToValueViaObjCBridgeable(dest, src, srcType,
                                                          targetType,
-                                                         srcBridgeWitness,
+                                                         targetBridgeWitness,
                                                          flags);
       }
-#endif
-      return _fail(src, srcType, targetType, flags);
     }
+#endif
+    return _dynamicCastFromExistential(dest, src, srcExistentialType,
+                                       targetType, flags);
+  }
+  // Recursively cast into the layout compatible payload area.
+  const Metadata *payloadType =
+    cast<EnumMetadata>(targetType)->getGenericArgs()[0];
+  if (swift_dynamicCast(dest, src, srcType, payloadType, flags)) {
+    swift_storeEnumTagSinglePayload(dest, payloadType, -1 /*case*/,
+                                    1 /*emptyCases*/);
+    return true;
+  }
+  return false;
+}
 
-    case MetadataKind::ExistentialMetatype:
-    case MetadataKind::Function:
-    case MetadataKind::HeapLocalVariable:
-    case MetadataKind::HeapGenericLocalVariable:
-    case MetadataKind::ErrorObject:
-    case MetadataKind::Metatype:
-    case MetadataKind::Opaque:
-    case MetadataKind::Tuple:
-      return _fail(src, srcType, targetType, flags);
-    }
-    break;
+/// A resolved cast strategy: cast to an existential target type.
+static bool _castToExistential(OpaqueValue *dest, OpaqueValue *src,
+                               const Metadata *srcType,
+                               const Metadata *targetType,
+                               DynamicCastFlags flags) {
+  return _dynamicCastToExistential(dest, src, srcType,
+                                   cast<ExistentialTypeMetadata>(targetType),
+                                   flags);
+}
 
-  case MetadataKind::Existential:
-    return _dynamicCastToExistential(dest, src, srcType,
-                                     cast<ExistentialTypeMetadata>(targetType),
-                                     flags);
+/// A resolved cast strategy: cast to a metatype target type.
+static bool _castToMetatype(OpaqueValue *dest, OpaqueValue *src,
+                            const Metadata *srcType,
+                            const Metadata *targetType,
+                            DynamicCastFlags flags) {
+  return _dynamicCastToMetatype(dest, src, srcType,
+                                cast<MetatypeMetadata>(targetType),
+                                flags);
+}
 
-  case MetadataKind::Metatype:
-    return _dynamicCastToMetatype(dest, src, srcType,
-                                  cast<MetatypeMetadata>(targetType),
-                                  flags);
-    
-  case MetadataKind::ExistentialMetatype:
-    return _dynamicCastToExistentialMetatype(dest, src, srcType,
-                                 cast<ExistentialMetatypeMetadata>(targetType),
-                                             flags);
+/// A resolved cast strategy: cast to an existential metatype target type.
+static bool _castToExistentialMetatype(OpaqueValue *dest, OpaqueValue *src,
+                                       const Metadata *srcType,
+                                       const Metadata *targetType,
+                                       DynamicCastFlags flags) {
+  return _dynamicCastToExistentialMetatype(dest, src, srcType,
+                               cast<ExistentialMetatypeMetadata>(targetType),
+                                           flags);
+}
+
+/// A resolved cast strategy: cast to a function target type.
+static bool _castToFunction(OpaqueValue *dest, OpaqueValue *src,
+                            const Metadata *srcType,
+                            const Metadata *targetType,
+                            DynamicCastFlags flags) {
+  return _dynamicCastToFunction(dest, src, srcType,
+                                cast<FunctionTypeMetadata>(targetType),
+                                flags);
+}
+
+/// A resolved cast strategy: cast to a non-polymorphic target type.
+static bool _castToNonPolymorphic(OpaqueValue *dest, OpaqueValue *src,
+                                  const Metadata *srcType,
+                                  const Metadata *targetType,
+                                  DynamicCastFlags flags) {
+  // If there's an exact type match, we're done.
+  if (srcType == targetType)
+    return _succeed(dest, src, srcType, flags);
 
-  // Function types.
-  case MetadataKind::Function: {
-    return _dynamicCastToFunction(dest, src, srcType,
-                                  cast<FunctionTypeMetadata>(targetType),
-                                  flags);
+  // If we have an existential, look at its dynamic type.
+  if (auto srcExistentialType = dyn_cast<ExistentialTypeMetadata>(srcType)) {
+    return _dynamicCastFromExistential(dest, src, srcExistentialType,
+                                       targetType, flags);
+  }
+
+  // If both are tuple types, allow the cast to add/remove labels.
+  if (srcType->getKind() == MetadataKind::Tuple &&
+      targetType->getKind() == MetadataKind::Tuple) {
+    return _dynamicCastTupleToTuple(dest, src,
+                                    cast<TupleTypeMetadata>(srcType),
+                                    cast<TupleTypeMetadata>(targetType),
+                                    flags);
+  }
+
+  // Otherwise, we have a failure.
+  return _fail(src, srcType, targetType, flags);
+}
+
+/// A resolved cast strategy: struct-to-struct cast.
+static bool _castStructToStruct(OpaqueValue *dest, OpaqueValue *src,
+                                const Metadata *srcType,
+                                const Metadata *targetType,
+                                DynamicCastFlags flags) {
+  return _dynamicCastStructToStruct(dest, src,
+                                    cast<StructMetadata>(srcType),
+                                    cast<StructMetadata>(targetType),
+                                    flags);
+}
+
+#if SWIFT_OBJC_INTEROP
+/// A resolved cast strategy: cast a class reference to a struct or enum
+/// target. NSError-to-value bridging depends on the source value, so the
+/// checks cannot be resolved away per type pair.
+static bool _castClassToValue(OpaqueValue *dest, OpaqueValue *src,
+                              const Metadata *srcType,
+                              const Metadata *targetType,
+                              DynamicCastFlags flags) {
+  // If the target type is bridged to Objective-C, try to bridge.
+  if (auto targetBridgeWitness = findBridgeWitness(targetType)) {
+    return _dynamicCastClassToValueViaObjCBridgeable(dest, src, srcType,
+                                                     targetType,
+                                                     targetBridgeWitness,
+                                                     flags);
+  }
+
+  // If the source is an NSError, and the target is a bridgeable
+  // Error, try to bridge.
+  if (tryDynamicCastNSErrorToValue(dest, src, srcType, targetType, flags)) {
+    return true;
   }
 
+  return _castToNonPolymorphic(dest, src, srcType, targetType, flags);
+}
+#endif
+
+/// Resolve the strategy for casting to a struct or enum target from the
+/// given source type.
+static DynamicCastFn resolveValueCast(const Metadata *srcType,
+                                      const Metadata *targetType) {
+  switch (srcType->getKind()) {
+  case MetadataKind::Class:
+  case MetadataKind::ObjCClassWrapper:
+  case MetadataKind::ForeignClass:
+    // Casts to AnyHashable.
+    if (isAnyHashableType(targetType))
+      return _dynamicCastToAnyHashable;
+#if SWIFT_OBJC_INTEROP
+    return _castClassToValue;
+#else
+    return _castToNonPolymorphic;
+#endif
+
   case MetadataKind::Struct:
+    // Collection and AnyHashable casts.
+    if (targetType->getKind() == MetadataKind::Struct)
+      return _castStructToStruct;
+    return _castToNonPolymorphic;
+
+  case MetadataKind::Optional:
   case MetadataKind::Enum:
-    switch (srcType->getKind()) {
-    case MetadataKind::Class:
-    case MetadataKind::ObjCClassWrapper:
-    case MetadataKind::ForeignClass: {
-      // Casts to AnyHashable.
-      if (isAnyHashableType(targetType)) {
-        return _dynamicCastToAnyHashable(dest, src, srcType, targetType, flags);
-      }
+    // Casts to AnyHashable.
+    if (isAnyHashableType(targetType))
+      return _dynamicCastToAnyHashable;
+    return _castToNonPolymorphic;
+
+  case MetadataKind::Existential:
+  case MetadataKind::ExistentialMetatype:
+  case MetadataKind::Function:
+  case MetadataKind::HeapLocalVariable:
+  case MetadataKind::HeapGenericLocalVariable:
+  case MetadataKind::ErrorObject:
+  case MetadataKind::Metatype:
+  case MetadataKind::Opaque:
+  case MetadataKind::Tuple:
+    return _castToNonPolymorphic;
+  }
+
+  swift_runtime_unreachable("Unhandled MetadataKind in switch.");
+}
+
+/// Resolve the strategy for a dynamic cast between the given source and
+/// target types. The result depends only on the two metadata pointers —
+/// never on the value being cast or on the cast flags — so a positive
+/// resolution can be cached per (source, target) pair. Checks that do
+/// inspect the value (such as NSError bridging) live inside the returned
+/// functions. A _castAlwaysFails resolution must not be cached: it can
+/// reflect the absence of an _ObjectiveCBridgeable conformance, and a
+/// later-loaded image may register one.
+static DynamicCastFn resolveDynamicCast(const Metadata *srcType,
+                                        const Metadata *targetType) {
+  switch (targetType->getKind()) {
+  // Handle wrapping an Optional target.
+  case MetadataKind::Optional:
+    return _castToOptional;
 
+  // Casts to class type.
+  case MetadataKind::Class:
+  case MetadataKind::ObjCClassWrapper:
 #if SWIFT_OBJC_INTEROP
-      // If the target type is bridged to Objective-C, try to bridge.
-      if (auto targetBridgeWitness = findBridgeWitness(targetType)) {
-        return _dynamicCastClassToValueViaObjCBridgeable(dest, src, srcType,
-                                                         targetType,
-                                                         targetBridgeWitness,
-                                                         flags);
-      }
-      
-      // If the source is an NSError, and the target is a bridgeable
-      // Error, try to bridge.
-      if (tryDynamicCastNSErrorToValue(dest, src, srcType, targetType, flags)) {
-        return true;
-      }
+    // Casts to NSError may succeed by Error boxing.
+    if (targetType == getNSErrorMetadata())
+      return _castToNSError;
+    LLVM_FALLTHROUGH;
 #endif
 
-      break;
-    }
+  case MetadataKind::ForeignClass:
+    return resolveClassCast(srcType);
 
-    case MetadataKind::Struct:
-      // Collection and AnyHashable casts.
-      if (targetType->getKind() == MetadataKind::Struct) {
-        return _dynamicCastStructToStruct(dest, src,
-                                          cast<StructMetadata>(srcType),
-                                          cast<StructMetadata>(targetType),
-                                          flags);
-      }
-      break;
+  case MetadataKind::Existential:
+    return _castToExistential;
 
-    case MetadataKind::Optional:
-    case MetadataKind::Enum:
-      // Casts to AnyHashable.
-      if (isAnyHashableType(targetType)) {
-        return _dynamicCastToAnyHashable(dest, src, srcType, targetType, flags);
-      }
-      break;
+  case MetadataKind::Metatype:
+    return _castToMetatype;
 
-    case MetadataKind::Existential:
-    case MetadataKind::ExistentialMetatype:
-    case MetadataKind::Function:
-    case MetadataKind::HeapLocalVariable:
-    case MetadataKind::HeapGenericLocalVariable:
-    case MetadataKind::ErrorObject:
-    case MetadataKind::Metatype:
-    case MetadataKind::Opaque:
-    case MetadataKind::Tuple:
-      break;
-    }
+  case MetadataKind::ExistentialMetatype:
+    return _castToExistentialMetatype;
 
-    LLVM_FALLTHROUGH;
+  // Function types.
+  case MetadataKind::Function:
+    return _castToFunction;
+
+  case MetadataKind::Struct:
+  case MetadataKind::Enum:
+    return resolveValueCast(srcType, targetType);
 
   // The non-polymorphic types.
   case MetadataKind::HeapLocalVariable:
@@ -2623,29 +2790,62 @@ bool swift::swift_dynamicCast(OpaqueValue *dest, OpaqueValue *src,
   case MetadataKind::ErrorObject:
   case MetadataKind::Opaque:
   case MetadataKind::Tuple:
-    // If there's an exact type match, we're done.
-    if (srcType == targetType)
-      return _succeed(dest, src, srcType, flags);
-
-    // If we have an existential, look at its dynamic type.
-    if (auto srcExistentialType = dyn_cast<ExistentialTypeMetadata>(srcType)) {
-      return _dynamicCastFromExistential(dest, src, srcExistentialType,
-                                         targetType, flags);
-    }
+    return _castToNonPolymorphic;
+  }
+  _failCorruptType(srcType);
+}
 
-    // If both are tuple types, allow the cast to add/remove labels.
-    if (srcType->getKind() == MetadataKind::Tuple &&
-        targetType->getKind() == MetadataKind::Tuple) {
-      return _dynamicCastTupleToTuple(dest, src,
-                                      cast<TupleTypeMetadata>(srcType),
-                                      cast<TupleTypeMetadata>(targetType),
-                                      flags);
-    }
+/******************************************************************************/
+/****************************** Main Entrypoint *******************************/
+/******************************************************************************/
 
-    // Otherwise, we have a failure.
-    return _fail(src, srcType, targetType, flags);
+/// Perform a dynamic cast to an arbitrary type.
+
+bool swift::swift_dynamicCast(OpaqueValue *dest, OpaqueValue *src,
+                              const Metadata *srcType,
+                              const Metadata *targetType,
+                              DynamicCastFlags flags)
+    SWIFT_CC(RegisterPreservingCC_IMPL) {
+  auto unwrapResult = checkDynamicCastFromOptional(dest, src, srcType,
+                                                   targetType, flags);
+  srcType = unwrapResult.payloadType;
+  if (!srcType)
+    return unwrapResult.success;
+
+#if SWIFT_OBJC_INTEROP
+  // A class or AnyObject reference may point to a _SwiftValue box.
+  {
+    auto innerFlags = flags - DynamicCastFlags::Unconditional
+                            - DynamicCastFlags::DestroyOnFailure;
+    if (tryDynamicCastBoxedSwiftValue(dest, src, srcType,
+                                      targetType, innerFlags)) {
+      // TakeOnSuccess was handled inside tryDynamicCastBoxedSwiftValue().
+      return true;
+    } else {
+      // Couldn't cast boxed value to targetType.
+      // Fall through and try to cast the _SwiftValue box itself to targetType.
+      // (for example, casting _SwiftValue to NSObject will be successful)
+    }
   }
-  _failCorruptType(srcType);
+#endif
+
+  // Consult the strategy cache. Casts among a recurring set of types resolve
+  // their strategy once and skip the dispatch on every subsequent call.
+  auto &strategies = DynamicCastStrategies.get();
+  DynamicCastCacheKey key(srcType, targetType);
+  if (auto *entry = strategies.find(key))
+    return entry->Fn(dest, src, srcType, targetType, flags);
+
+  auto fn = resolveDynamicCast(srcType, targetType);
+  // Only cache positive resolutions. A failure resolved today may succeed
+  // tomorrow: findBridgeWitness consults the conformance cache, which is
+  // invalidated when new images register conformance sections, so re-running
+  // the resolver on each miss picks up a conformance registered after the
+  // first failed cast. Positive strategies can never be invalidated by
+  // loading more code.
+  if (fn != _castAlwaysFails)
+    strategies.getOrInsert(key, fn);
+  return fn(dest, src, srcType, targetType, flags);
 }
 
 static inline bool swift_isClassOrObjCExistentialTypeImpl(const Metadata *T) {
@@ -20,6 +20,7 @@
 #include "swift/Runtime/Metadata.h"
 #include <memory>
 #include <stdio.h>
+#include <stdlib.h>
 
 // Pick an implementation strategy.
 #ifndef SWIFT_EXCLUSIVITY_USE_THREADLOCAL
@@ -182,14 +183,177 @@ static_assert(sizeof(Access) <= sizeof(ValueBuffer) &&
               alignof(Access) <= alignof(ValueBuffer),
               "Access doesn't fit in a value buffer!");
 
-/// A set of accesses that we're tracking.  Just a singly-linked list.
+/// A set of accesses that we're tracking.  A singly-linked list while the
+/// set is small, so that shallow access nesting never allocates; an
+/// open-addressing hash table keyed by the accessed pointer once the set
+/// grows past a threshold, so that deeply nested accesses don't pay a
+/// linear scan per swift_beginAccess.
 class AccessSet {
+  enum : uint32_t {
+    /// Live entry count beyond which the set switches to the hash table.
+    TableThreshold = 8,
+
+    /// Initial number of table slots.  Must be a power of two and larger
+    /// than TableThreshold.
+    TableInitialCapacity = 64
+  };
+
+  /// The head of the list.  Unused (null) while the table is active.
   Access *Head = nullptr;
+
+  /// The table slots, or null while the set is list-backed.  The table is
+  /// allocated when the set grows past TableThreshold and freed when the
+  /// set empties.
+  Access **Table = nullptr;
+
+  /// The number of table slots.  Always a power of two.
+  uint32_t TableCapacity = 0;
+
+  /// The number of table slots holding a live entry or a tombstone.
+  uint32_t TableOccupied = 0;
+
+  /// The number of live entries, in either representation.
+  uint32_t Count = 0;
+
+  /// The marker for a slot whose entry was removed.  Probes must continue
+  /// past it, but inserts may reuse it.
+  static Access *tombstone() {
+    return reinterpret_cast<Access *>(uintptr_t(1));
+  }
+
+  static Access **allocateSlots(uint32_t capacity) {
+    auto slots = static_cast<Access **>(calloc(capacity, sizeof(Access *)));
+    if (!slots)
+      swift::crash("Could not allocate memory.");
+    return slots;
+  }
+
+  /// Map an accessed pointer to its preferred slot index.
+  uint32_t slotForPointer(void *pointer) const {
+    // Accessed addresses are at least word-aligned, so discard the low
+    // bits, then spread the remaining bits with a multiplicative hash and
+    // fold the high half down into the slot index.
+    uintptr_t value = reinterpret_cast<uintptr_t>(pointer) >> 4;
+    value *= (sizeof(uintptr_t) == 8 ? uintptr_t(0x9E3779B97F4A7C15ull)
+                                     : uintptr_t(0x9E3779B9u));
+    value ^= value >> (sizeof(uintptr_t) * 4);
+    return uint32_t(value) & (TableCapacity - 1);
+  }
+
+  /// Place an already-initialized access into the table without checking
+  /// for conflicts.  Used for migration and rehashing.
+  void placeInTable(Access *access) {
+    uint32_t idx = slotForPointer(access->Pointer);
+    while (Table[idx] != nullptr && Table[idx] != tombstone())
+      idx = (idx + 1) & (TableCapacity - 1);
+    if (Table[idx] == nullptr)
+      ++TableOccupied;
+    Table[idx] = access;
+  }
+
+  /// Move the list entries into a freshly allocated table.
+  void switchToTable() {
+    Table = allocateSlots(TableInitialCapacity);
+    TableCapacity = TableInitialCapacity;
+    TableOccupied = 0;
+    for (Access *cur = Head; cur != nullptr; cur = cur->getNext())
+      placeInTable(cur);
+    Head = nullptr;
+  }
+
+  /// Rebuild the table to purge tombstones, growing it if it is mostly
+  /// live entries.
+  void rehash() {
+    Access **oldTable = Table;
+    uint32_t oldCapacity = TableCapacity;
+
+    uint32_t newCapacity =
+      (Count * 2 >= TableCapacity ? TableCapacity * 2 : TableCapacity);
+    Table = allocateSlots(newCapacity);
+    TableCapacity = newCapacity;
+    TableOccupied = 0;
+    for (uint32_t i = 0; i < oldCapacity; ++i) {
+      if (oldTable[i] != nullptr && oldTable[i] != tombstone())
+        placeInTable(oldTable[i]);
+    }
+    free(oldTable);
+  }
+
+  void insertIntoTable(Access *access, void *pc, void *pointer,
+                       ExclusivityFlags flags, ExclusivityFlags action) {
+    // Keep at least a quarter of the slots empty so probes stay short.
+    if ((TableOccupied + 1) * 4 > TableCapacity * 3)
+      rehash();
+
+    // All entries for the same pointer lie on its probe sequence, so a
+    // single probe to the first empty slot visits every access we might
+    // conflict with.
+    Access **slot = nullptr;
+    bool reported = false;
+    uint32_t idx = slotForPointer(pointer);
+    for (Access *cur = Table[idx]; cur != nullptr;
+         idx = (idx + 1) & (TableCapacity - 1), cur = Table[idx]) {
+      if (cur == tombstone()) {
+        if (!slot) slot = &Table[idx];
+        continue;
+      }
+
+      // Ignore accesses to different values.
+      if (cur->Pointer != pointer)
+        continue;
+
+      if (reported)
+        continue;
+
+      // If both accesses are reads, it's not a conflict.
+      if (action == ExclusivityFlags::Read &&
+          action == cur->getAccessAction())
+        continue;
+
+      // Otherwise, it's a conflict.
+      reportExclusivityConflict(cur->getAccessAction(), cur->PC,
+                                flags, pc, pointer);
+
+      // If we're only warning, don't report multiple conflicts.
+      reported = true;
+    }
+
+    if (!slot) {
+      slot = &Table[idx];
+      ++TableOccupied;
+    }
+    access->initialize(pc, pointer, nullptr, action);
+    *slot = access;
+  }
+
+  void removeFromTable(Access *access) {
+    uint32_t idx = slotForPointer(access->Pointer);
+    while (Table[idx] != access) {
+      if (Table[idx] == nullptr)
+        swift_runtime_unreachable("access not found in set");
+      idx = (idx + 1) & (TableCapacity - 1);
+    }
+    Table[idx] = tombstone();
+
+    // When the set empties, free the table and return to the list so that
+    // shallow access nesting goes back to not allocating.
+    if (Count == 0) {
+      free(Table);
+      Table = nullptr;
+      TableCapacity = 0;
+      TableOccupied = 0;
+    }
+  }
+
 public:
   constexpr AccessSet() {}
 
   void insert(Access *access, void *pc, void *pointer, ExclusivityFlags flags) {
     auto action = getAccessAction(flags);
+    ++Count;
+
+    if (Table)
+      return insertIntoTable(access, pc, pointer, flags, action);
 
     for (Access *cur = Head; cur != nullptr; cur = cur->getNext()) {
       // Ignore accesses to different values.
@@ -212,9 +376,17 @@ public:
     // Insert to the front of the array so that remove tends to find it faster.
     access->initialize(pc, pointer, Head, action);
     Head = access;
+
+    if (Count > TableThreshold)
+      switchToTable();
   }
 
   void remove(Access *access) {
+    --Count;
+
+    if (Table)
+      return removeFromTable(access);
+
     auto cur = Head;
     // Fast path: stack discipline.
     if (cur == access) {
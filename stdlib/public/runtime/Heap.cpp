@@ -19,18 +19,237 @@
 #include "Private.h"
 #include "swift/Runtime/Debug.h"
 #include <stdlib.h>
+#include <string.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#endif
+
+// Pick an implementation strategy for the per-thread magazines. They need
+// fast thread-local access, a hook to run at thread exit, and a way to ask
+// the allocator for a block's actual size (malloc_size/malloc_usable_size),
+// so they're only enabled where all three are available; elsewhere
+// swift_slowAlloc goes straight to malloc as before.
+#ifndef SWIFT_HEAP_USE_MAGAZINES
+#if LLVM_ENABLE_THREADS && (defined(__APPLE__) || defined(__linux__)) && \
+    (!defined(__clang__) || __has_feature(cxx_thread_local))
+# define SWIFT_HEAP_USE_MAGAZINES 1
+#else
+# define SWIFT_HEAP_USE_MAGAZINES 0
+#endif
+#endif
+
+#if SWIFT_HEAP_USE_MAGAZINES
+#include <atomic>
+#include <pthread.h>
+#endif
 
 using namespace swift;
 
+#if SWIFT_HEAP_USE_MAGAZINES
+
+namespace {
+
+/// A free block cached in a magazine. Blocks are ordinary malloc
+/// allocations, so they can always be handed back to free(), and pointers
+/// freed on a different thread than they were allocated on can be cached
+/// without tracking their origin.
+struct MagazineBlock {
+  MagazineBlock *Next;
+};
+
+/// Size classes cover allocations of 16 through 256 bytes in 16-byte steps.
+constexpr size_t MagazineSizeClassGranularity = 16;
+constexpr unsigned MagazineNumSizeClasses = 16;
+
+/// How many blocks to request from malloc when a size class runs dry.
+constexpr unsigned MagazineRefillCount = 16;
+
+/// When a size class reaches this many cached blocks, half of them are
+/// returned to malloc so idle threads don't hoard memory.
+constexpr unsigned MagazineHighWater = 64;
+
+/// A per-thread cache of free blocks, segregated by size class. The hot
+/// paths are a singly-linked-list push and pop with no atomics and no
+/// locks; malloc is only entered to refill an empty class or to drain an
+/// overfull one.
+///
+/// This must be trivially constructible and destructible; draining at
+/// thread exit is handled by a pthread key destructor instead.
+struct Magazine {
+  MagazineBlock *Blocks[MagazineNumSizeClasses];
+  unsigned Counts[MagazineNumSizeClasses];
+
+  /// Whether this thread's magazine has been registered for draining at
+  /// thread exit.
+  bool RegisteredForDrain;
+
+  void push(unsigned sizeClass, void *ptr) {
+    auto block = reinterpret_cast<MagazineBlock *>(ptr);
+    block->Next = Blocks[sizeClass];
+    Blocks[sizeClass] = block;
+    Counts[sizeClass]++;
+  }
+
+  void *pop(unsigned sizeClass) {
+    auto block = Blocks[sizeClass];
+    if (!block)
+      return nullptr;
+    Blocks[sizeClass] = block->Next;
+    Counts[sizeClass]--;
+    return block;
+  }
+
+  /// Return half of an overfull size class's blocks to malloc.
+  void rebalance(unsigned sizeClass) {
+    for (unsigned i = 0; i < MagazineHighWater / 2; ++i)
+      free(pop(sizeClass));
+  }
+
+  /// Return every cached block to malloc.
+  void drain() {
+    for (unsigned i = 0; i < MagazineNumSizeClasses; ++i)
+      while (auto block = pop(i))
+        free(block);
+  }
+};
+
+} // end anonymous namespace
+
+static_assert(LLVM_ENABLE_THREADS, "LLVM_THREAD_LOCAL will use a global?");
+static LLVM_THREAD_LOCAL Magazine ThreadMagazine;
+
+static pthread_key_t createMagazineDrainKey() {
+  pthread_key_t key;
+  int result = pthread_key_create(&key, [](void *pointer) {
+    static_cast<Magazine *>(pointer)->drain();
+  });
+
+  if (result != 0)
+    swift::crash("couldn't create pthread key for heap magazines");
+  return key;
+}
+
+static Magazine &getMagazine() {
+  Magazine &magazine = ThreadMagazine;
+  if (!magazine.RegisteredForDrain) {
+    static pthread_key_t key = createMagazineDrainKey();
+    pthread_setspecific(key, &magazine);
+    magazine.RegisteredForDrain = true;
+  }
+  return magazine;
+}
+
+/// Can an allocation with this size and alignment be served from a
+/// magazine? Alignments beyond what malloc guarantees fall back to the
+/// plain path, as does anything bigger than the largest size class.
+static bool isMagazineEligible(size_t size, size_t alignMask) {
+  return size - 1 < MagazineSizeClassGranularity * MagazineNumSizeClasses &&
+         alignMask < MagazineSizeClassGranularity;
+}
+
+/// The size class for an eligible size. All blocks in a class have the
+/// class's rounded-up size, so a block cached at one size can serve any
+/// other size in the same class.
+static unsigned magazineSizeClass(size_t size) {
+  return (size - 1) / MagazineSizeClassGranularity;
+}
+
+static size_t magazineBlockSize(unsigned sizeClass) {
+  return (sizeClass + 1) * MagazineSizeClassGranularity;
+}
+
+/// Ask the allocator how big the block behind \p ptr really is.
+static size_t magazineActualBlockSize(void *ptr) {
+#if defined(__APPLE__)
+  return malloc_size(ptr);
+#else
+  return malloc_usable_size(ptr);
+#endif
+}
+
+/// The actual size malloc gives blocks of each class, recorded the first
+/// time a class is refilled. Zero means the class has never handed out a
+/// block, so nothing freed to it can be one of ours.
+static std::atomic<size_t> MagazineActualSizes[MagazineNumSizeClasses];
+
+static void *magazineAlloc(size_t size) {
+  auto &magazine = getMagazine();
+  unsigned sizeClass = magazineSizeClass(size);
+  if (void *p = magazine.pop(sizeClass))
+    return p;
+
+  // The class is empty; refill it with a batch of blocks and hand out the
+  // first one.
+  void *blocks[MagazineRefillCount];
+  swift_slowAllocBatch(magazineBlockSize(sizeClass), 0, blocks,
+                       MagazineRefillCount);
+  for (unsigned i = 1; i < MagazineRefillCount; ++i)
+    magazine.push(sizeClass, blocks[i]);
+  MagazineActualSizes[sizeClass].store(magazineActualBlockSize(blocks[0]),
+                                       std::memory_order_relaxed);
+  return blocks[0];
+}
+
+static void magazineDealloc(void *ptr, size_t size) {
+  // The reported size is not always the allocation size. In particular, the
+  // deallocation path for a class with tail-allocated storage passes the
+  // static instance size even though the object was allocated at header
+  // plus capacity. Only recycle a block if the allocator confirms it is
+  // exactly the size this class hands out; anything else goes straight back
+  // to free() instead of pinning an arbitrarily large block under a small
+  // size class (or, worse, re-issuing an undersized block for a larger
+  // request later).
+  unsigned sizeClass = magazineSizeClass(size);
+  size_t expected =
+      MagazineActualSizes[sizeClass].load(std::memory_order_relaxed);
+  if (expected == 0 || magazineActualBlockSize(ptr) != expected)
+    return free(ptr);
+
+  auto &magazine = getMagazine();
+  magazine.push(sizeClass, ptr);
+  if (magazine.Counts[sizeClass] >= MagazineHighWater)
+    magazine.rebalance(sizeClass);
+}
+
+#endif // SWIFT_HEAP_USE_MAGAZINES
+
 void *swift::swift_slowAlloc(size_t size, size_t alignMask)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
+#if SWIFT_HEAP_USE_MAGAZINES
+  if (isMagazineEligible(size, alignMask))
+    return magazineAlloc(size);
+#endif
   // FIXME: use posix_memalign if alignMask is larger than the system guarantee.
   void *p = malloc(size);
   if (!p) swift::crash("Could not allocate memory.");
   return p;
 }
 
+void swift::swift_slowAllocBatch(size_t size, size_t alignMask,
+                                 void **ptrs, size_t count) {
+  size_t allocated = 0;
+#if defined(__APPLE__)
+  // The system allocator can carve out many blocks of one size per zone
+  // lock acquisition. It allocates as many as it likes; whatever it
+  // declines (e.g. because the size is too large for the batch path) is
+  // allocated one at a time below.
+  allocated = malloc_zone_batch_malloc(malloc_default_zone(), size,
+                                       ptrs, unsigned(count));
+#endif
+  for (; allocated < count; ++allocated) {
+    void *p = malloc(size);
+    if (!p) swift::crash("Could not allocate memory.");
+    ptrs[allocated] = p;
+  }
+}
+
 void swift::swift_slowDealloc(void *ptr, size_t bytes, size_t alignMask)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
+#if SWIFT_HEAP_USE_MAGAZINES
+  if (isMagazineEligible(bytes, alignMask))
+    return magazineDealloc(ptr, bytes);
+#endif
   free(ptr);
 }
@@ -105,6 +105,26 @@ SWIFT_RT_ENTRY_IMPL(swift_allocObject)(HeapMetadata const *metadata,
   return object;
 }
 
+void swift::swift_allocObjects(HeapMetadata const *metadata,
+                               size_t requiredSize,
+                               size_t requiredAlignmentMask,
+                               HeapObject **objects,
+                               size_t count) {
+  assert(isAlignmentMask(requiredAlignmentMask));
+  swift_slowAllocBatch(requiredSize, requiredAlignmentMask,
+                       reinterpret_cast<void **>(objects), count);
+  for (size_t i = 0; i < count; ++i) {
+    auto object = objects[i];
+    object->metadata = metadata;
+    object->refCounts.init();
+
+    // If leak tracking is enabled, start tracking this object.
+    SWIFT_LEAKS_START_TRACKING_OBJECT(object);
+
+    SWIFT_RT_TRACK_INVOCATION(object, swift_allocObject);
+  }
+}
+
 HeapObject *
 swift::swift_initStackObject(HeapMetadata const *metadata,
                              HeapObject *object) {
@@ -305,9 +325,28 @@ HeapObject *swift::swift_allocEmptyBox() {
 }
 
 // Forward-declare this, but define it after swift_release.
-extern "C" LLVM_LIBRARY_VISIBILITY LLVM_ATTRIBUTE_NOINLINE LLVM_ATTRIBUTE_USED 
+extern "C" LLVM_LIBRARY_VISIBILITY LLVM_ATTRIBUTE_NOINLINE LLVM_ATTRIBUTE_USED
 void _swift_release_dealloc(HeapObject *object) SWIFT_CC(RegisterPreservingCC_IMPL);
 
+/// When true, the strong retain and release entry points use non-atomic
+/// operations on the refcount word. Only valid while the process is
+/// effectively single-threaded; see swift_enableBiasedRefCounting().
+static std::atomic<bool> BiasedRefCounting(false);
+
+static inline bool useBiasedRefCounting() {
+  return BiasedRefCounting.load(std::memory_order_relaxed);
+}
+
+void swift::swift_enableBiasedRefCounting() {
+  BiasedRefCounting.store(true, std::memory_order_seq_cst);
+}
+
+void swift::swift_disableBiasedRefCounting() {
+  // The caller's subsequent thread creation or object hand-off publishes
+  // this store together with the preceding non-atomic refcount updates.
+  BiasedRefCounting.store(false, std::memory_order_seq_cst);
+}
+
 HeapObject *swift::swift_retain(HeapObject *object)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
   return SWIFT_RT_ENTRY_REF(swift_retain)(object);
@@ -343,8 +382,12 @@ extern "C"
 HeapObject *SWIFT_RT_ENTRY_IMPL(swift_retain)(HeapObject *object)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
   SWIFT_RT_TRACK_INVOCATION(object, swift_retain);
-  if (isValidPointerForNativeRetain(object))
-    object->refCounts.increment(1);
+  if (isValidPointerForNativeRetain(object)) {
+    if (useBiasedRefCounting())
+      object->refCounts.incrementNonAtomic(1);
+    else
+      object->refCounts.increment(1);
+  }
   return object;
 }
 
@@ -358,8 +401,12 @@ extern "C"
 HeapObject *SWIFT_RT_ENTRY_IMPL(swift_retain_n)(HeapObject *object, uint32_t n)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
   SWIFT_RT_TRACK_INVOCATION(object, swift_retain_n);
-  if (isValidPointerForNativeRetain(object))
-    object->refCounts.increment(n);
+  if (isValidPointerForNativeRetain(object)) {
+    if (useBiasedRefCounting())
+      object->refCounts.incrementNonAtomic(n);
+    else
+      object->refCounts.increment(n);
+  }
   return object;
 }
 
@@ -388,8 +435,12 @@ extern "C"
 void SWIFT_RT_ENTRY_IMPL(swift_release)(HeapObject *object)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
   SWIFT_RT_TRACK_INVOCATION(object, swift_release);
-  if (isValidPointerForNativeRetain(object))
-    object->refCounts.decrementAndMaybeDeinit(1);
+  if (isValidPointerForNativeRetain(object)) {
+    if (useBiasedRefCounting())
+      object->refCounts.decrementAndMaybeDeinitNonAtomic(1);
+    else
+      object->refCounts.decrementAndMaybeDeinit(1);
+  }
 }
 
 void swift::swift_release_n(HeapObject *object, uint32_t n)
@@ -402,8 +453,12 @@ extern "C"
 void SWIFT_RT_ENTRY_IMPL(swift_release_n)(HeapObject *object, uint32_t n)
     SWIFT_CC(RegisterPreservingCC_IMPL) {
   SWIFT_RT_TRACK_INVOCATION(object, swift_release_n);
-  if (isValidPointerForNativeRetain(object))
-    object->refCounts.decrementAndMaybeDeinit(n);
+  if (isValidPointerForNativeRetain(object)) {
+    if (useBiasedRefCounting())
+      object->refCounts.decrementAndMaybeDeinitNonAtomic(n);
+    else
+      object->refCounts.decrementAndMaybeDeinit(n);
+  }
 }
 
 void swift::swift_setDeallocating(HeapObject *object) {
@@ -242,6 +242,36 @@ const Metadata *swift::swift_getGenericMetadata(GenericMetadata *pattern,
   return entry->Value;
 }
 
+const Metadata *
+swift::swift_getGenericMetadataCached(GenericMetadata *pattern,
+                                      const void *arguments,
+                                      const void **inlineCache)
+    SWIFT_CC(RegisterPreservingCC_IMPL) {
+  auto metadata = swift_getGenericMetadata(pattern, arguments);
+
+  // Fill the caller's inline cache if nobody has claimed it yet. The entry
+  // is immutable once published and is intentionally installed only once:
+  // replacing it racily could pair one instantiation's arguments with
+  // another's metadata, and megamorphic call sites wouldn't profit from
+  // updates anyway.
+  auto cache = reinterpret_cast<std::atomic<const void **> *>(inlineCache);
+  if (cache->load(std::memory_order_relaxed) == nullptr) {
+    size_t numGenericArgs = pattern->NumKeyArguments;
+    auto entry = reinterpret_cast<const void **>(
+        malloc((1 + numGenericArgs) * sizeof(void *)));
+    entry[0] = metadata;
+    memcpy(entry + 1, arguments, numGenericArgs * sizeof(void *));
+
+    const void **expected = nullptr;
+    if (!cache->compare_exchange_strong(expected, entry,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+      free(entry);
+  }
+
+  return metadata;
+}
+
 /***************************************************************************/
 /*** Objective-C class wrappers ********************************************/
 /***************************************************************************/
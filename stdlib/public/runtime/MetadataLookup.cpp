@@ -80,6 +80,22 @@ struct TypeMetadataState {
   std::vector<TypeMetadataSection> SectionsToScan;
   Mutex SectionsToScanLock;
 
+  /// A lazily built index from mangled type name to the nominal type
+  /// descriptor record with that name, so lookups don't scan every record
+  /// of every registered section. Newly registered sections are folded in
+  /// on the next lookup. Guarded by SectionsToScanLock; the keys point at
+  /// name strings in the images themselves.
+  llvm::DenseMap<llvm::StringRef, const TypeMetadataRecord *> NameIndex;
+
+  /// The few records that name a type by metadata rather than by nominal
+  /// type descriptor (foreign types); these still get a linear scan.
+  /// Guarded by SectionsToScanLock.
+  std::vector<const TypeMetadataRecord *> NonNominalRecords;
+
+  /// The number of sections already folded into the index.
+  /// Guarded by SectionsToScanLock.
+  unsigned IndexedSections = 0;
+
   TypeMetadataState() {
     SectionsToScan.reserve(16);
     initializeTypeMetadataRecordLookup();
@@ -160,25 +176,50 @@ swift::_matchMetadataByMangledTypeName(const llvm::StringRef typeName,
   return metadata;
 }
 
+// Fold any newly registered sections into the name index.
+// The caller must hold SectionsToScanLock.
+static void _indexTypeMetadataRecords(TypeMetadataState &T) {
+  unsigned endSectionIdx = T.SectionsToScan.size();
+
+  for (; T.IndexedSections < endSectionIdx; ++T.IndexedSections) {
+    auto &section = T.SectionsToScan[T.IndexedSections];
+    for (const auto &record : section) {
+      if (record.getTypeKind() == TypeMetadataRecordKind::NonuniqueDirectType) {
+        // Resolving these instantiates foreign type metadata; defer that
+        // to lookup time by scanning them linearly.
+        T.NonNominalRecords.push_back(&record);
+      } else if (auto ntd = record.getNominalTypeDescriptor()) {
+        // The first record with a given name wins, matching the order the
+        // old linear scan visited records in.
+        T.NameIndex.try_emplace(llvm::StringRef(ntd->Name.get()), &record);
+      }
+    }
+  }
+}
+
 // returns the type metadata for the type named by typeName
 static const Metadata *
-_searchTypeMetadataRecords(const TypeMetadataState &T,
+_searchTypeMetadataRecords(TypeMetadataState &T,
                            const llvm::StringRef typeName) {
-  unsigned sectionIdx = 0;
-  unsigned endSectionIdx = T.SectionsToScan.size();
   const Metadata *foundMetadata = nullptr;
 
-  for (; sectionIdx < endSectionIdx; ++sectionIdx) {
-    auto &section = T.SectionsToScan[sectionIdx];
-    for (const auto &record : section) {
-      if (auto metadata = record.getCanonicalTypeMetadata())
-        foundMetadata = _matchMetadataByMangledTypeName(typeName, metadata, nullptr);
-      else if (auto ntd = record.getNominalTypeDescriptor())
-        foundMetadata = _matchMetadataByMangledTypeName(typeName, nullptr, ntd);
+  _indexTypeMetadataRecords(T);
 
-      if (foundMetadata != nullptr)
-        return foundMetadata;
-    }
+  auto found = T.NameIndex.find(typeName);
+  if (found != T.NameIndex.end()) {
+    foundMetadata = _matchMetadataByMangledTypeName(
+        typeName, nullptr, found->second->getNominalTypeDescriptor());
+    if (foundMetadata != nullptr)
+      return foundMetadata;
+  }
+
+  for (auto record : T.NonNominalRecords) {
+    if (auto metadata = record->getCanonicalTypeMetadata())
+      foundMetadata = _matchMetadataByMangledTypeName(typeName, metadata,
+                                                      nullptr);
+
+    if (foundMetadata != nullptr)
+      return foundMetadata;
   }
 
   return nullptr;
@@ -26,6 +26,8 @@
 #include "ImageInspection.h"
 #include "Private.h"
 
+#include "llvm/ADT/DenseMap.h"
+
 #include <vector>
 
 using namespace swift;
@@ -168,6 +170,14 @@ namespace {
     }
   };
 
+  /// A conformance record together with the index of the section it was
+  /// registered in, so scans resuming from a cached failure generation can
+  /// skip records they have already seen.
+  struct IndexedConformance {
+    const ProtocolConformanceRecord *Record;
+    unsigned SectionIdx;
+  };
+
   struct ConformanceCacheKey {
     /// Either a Metadata* or a NominalTypeDescriptor*.
     const void *Type;
@@ -239,7 +249,16 @@ struct ConformanceState {
   ConcurrentMap<ConformanceCacheEntry> Cache;
   std::vector<ConformanceSection> SectionsToScan;
   Mutex SectionsToScanLock;
-  
+
+  /// Maps each protocol to the records conforming to it, across all
+  /// registered sections. Built at image-registration time so a lookup
+  /// only ever scans records for the queried protocol instead of every
+  /// record in every image. Guarded by SectionsToScanLock; the entries of
+  /// each vector are in section order.
+  llvm::DenseMap<const ProtocolDescriptor *,
+                 std::vector<IndexedConformance>> ProtocolIndex;
+
+
   ConformanceState() {
     SectionsToScan.reserve(16);
     initializeProtocolConformanceLookup();
@@ -281,7 +300,10 @@ _registerProtocolConformances(ConformanceState &C,
                               const ProtocolConformanceRecord *begin,
                               const ProtocolConformanceRecord *end) {
   ScopedLock guard(C.SectionsToScanLock);
+  unsigned sectionIdx = C.SectionsToScan.size();
   C.SectionsToScan.push_back(ConformanceSection{begin, end});
+  for (const auto &record : C.SectionsToScan.back())
+    C.ProtocolIndex[record.getProtocol()].push_back({&record, sectionIdx});
 }
 
 void swift::addImageProtocolConformanceBlockCallback(const void *conformances,
@@ -520,21 +542,21 @@ swift::swift_conformsToProtocol(const Metadata * const type,
   }
 
   // Really scan conformance records.
+  // The index built at registration time lets us visit only the records for
+  // this protocol rather than every record in every unscanned section.
 
-  for (unsigned sectionIdx = startSectionIdx;
-       sectionIdx < endSectionIdx;
-       ++sectionIdx) {
-    auto &section = C.SectionsToScan[sectionIdx];
+  auto indexed = C.ProtocolIndex.find(protocol);
+  if (indexed != C.ProtocolIndex.end()) {
     // Eagerly pull records for nondependent witnesses into our cache.
-    for (const auto &record : section) {
+    for (const auto &entry : indexed->second) {
+      // Skip records in sections that a previous scan already covered.
+      if (entry.SectionIdx < startSectionIdx)
+        continue;
+      const auto &record = *entry.Record;
+      auto P = record.getProtocol();
+
       // If the record applies to a specific type, cache it.
       if (auto metadata = record.getCanonicalTypeMetadata()) {
-        auto P = record.getProtocol();
-
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
-
         if (!isRelatedType(type, metadata, /*candidateIsMetadata=*/true))
           continue;
 
@@ -554,11 +576,6 @@ swift::swift_conformsToProtocol(const Metadata * const type,
                  record.getTypeKind()
                   == TypeMetadataRecordKind::IndirectNominalTypeDescriptor) {
         auto R = record.getNominalTypeDescriptor();
-        auto P = record.getProtocol();
-
-        // Look for an exact match.
-        if (protocol != P)
-          continue;
 
         if (!isRelatedType(type, R, /*candidateIsMetadata=*/false))
           continue;
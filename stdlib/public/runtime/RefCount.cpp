@@ -104,8 +104,8 @@ HeapObjectSideTableEntry* RefCounts<InlineRefCountBits>::allocateSideTable()
   }
 
   // Preflight passed. Allocate a side table.
-  
-  // FIXME: custom side table allocator
+  // Allocation goes through the runtime heap's per-thread caches; see the
+  // operator new defined below.
   HeapObjectSideTableEntry *side = new HeapObjectSideTableEntry(getHeapObject());
   
   auto newbits = InlineRefCountBits(side);
@@ -131,6 +131,15 @@ HeapObjectSideTableEntry* RefCounts<InlineRefCountBits>::allocateSideTable()
   return side;
 }
 
+void *HeapObjectSideTableEntry::operator new(size_t size) {
+  return swift_slowAlloc(size, alignof(HeapObjectSideTableEntry) - 1);
+}
+
+void HeapObjectSideTableEntry::operator delete(void *p) {
+  swift_slowDealloc(p, sizeof(HeapObjectSideTableEntry),
+                    alignof(HeapObjectSideTableEntry) - 1);
+}
+
 
 // SideTableRefCountBits specialization intentionally does not exist.
 template <>
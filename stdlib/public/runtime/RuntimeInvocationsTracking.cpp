@@ -47,8 +47,50 @@ struct RuntimeFunctionCountersState {
 static bool UpdatePerObjectRuntimeFunctionCounters = false;
 /// If set, per object runtime function counters should be tracked.
 static bool UpdateGlobalRuntimeFunctionCounters = false;
+/// If set, per thread runtime function counters should be tracked.
+static bool UpdatePerThreadRuntimeFunctionCounters = false;
 /// TODO: Add support for enabling/disabling counters on a per object basis?
 
+/// Only every Nth runtime call updates the per thread counters, where N is
+/// the sampling period. Each sampled update adds the period to the counter,
+/// so the aggregated numbers stay estimates of the true call counts. A
+/// period of 1 counts every call.
+static uint32_t PerThreadCountersSamplingPeriod = 1;
+
+/// A per-thread block of counters, chained into a global list so the
+/// counters of all threads can be aggregated on demand. Blocks are created
+/// lazily on a thread's first tracked call and are deliberately never
+/// freed: the totals of exited threads stay part of the aggregate.
+struct PerThreadCountersBlock {
+  RuntimeFunctionCountersState State;
+  PerThreadCountersBlock *Next = nullptr;
+};
+
+/// The list of all per-thread counter blocks ever created.
+static PerThreadCountersBlock *PerThreadCountersList = nullptr;
+static StaticMutex PerThreadCountersListLock;
+
+static LLVM_THREAD_LOCAL PerThreadCountersBlock *ThreadCountersBlock = nullptr;
+/// Number of tracked calls on this thread since the last sampled update.
+static LLVM_THREAD_LOCAL uint32_t ThreadSampleTick = 0;
+
+/// Return this thread's counters, creating and registering the block on
+/// first use. The hot path after that is a plain thread-local load; the
+/// list lock is only taken on creation and aggregation.
+static RuntimeFunctionCountersState *getOrCreateThreadLocalCounters() {
+  auto *block = ThreadCountersBlock;
+  if (!block) {
+    block = new PerThreadCountersBlock();
+    {
+      StaticScopedLock lock(PerThreadCountersListLock);
+      block->Next = PerThreadCountersList;
+      PerThreadCountersList = block;
+    }
+    ThreadCountersBlock = block;
+  }
+  return &block->State;
+}
+
 /// Global set of counters tracking the total number of runtime invocations.
 struct RuntimeFunctionCountersStateSentinel {
   RuntimeFunctionCountersState State;
@@ -125,6 +167,15 @@ static uint16_t RuntimeFunctionCountersOffsets[] = {
           RT_FUNCTION)++;                                                      \
       /* TODO: Remember the order/history of  operations? */                   \
     }                                                                          \
+    /* Update per thread counters. Lock-free: every Nth call bumps this */     \
+    /* thread's own block by the sampling period N. */                         \
+    if (UpdatePerThreadRuntimeFunctionCounters &&                              \
+        ++ThreadSampleTick >= PerThreadCountersSamplingPeriod) {               \
+      ThreadSampleTick = 0;                                                    \
+      getOrCreateThreadLocalCounters()                                         \
+          ->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) +=         \
+          PerThreadCountersSamplingPeriod;                                     \
+    }                                                                          \
   }
 #include "RuntimeInvocationsTracking.def"
 
@@ -219,6 +270,57 @@ int _swift_setPerObjectRuntimeFunctionCountersMode(int mode) {
   return oldMode;
 }
 
+/// Set mode for per thread runtime function counters.
+/// Return the old value of this flag.
+int _swift_setPerThreadRuntimeFunctionCountersMode(int mode) {
+  int oldMode = UpdatePerThreadRuntimeFunctionCounters;
+  UpdatePerThreadRuntimeFunctionCounters = mode ? 1 : 0;
+  return oldMode;
+}
+
+/// Set the sampling period for per thread runtime function counters.
+/// Return the old period.
+uint32_t _swift_setRuntimeFunctionCountersSamplingPeriod(uint32_t period) {
+  uint32_t oldPeriod = PerThreadCountersSamplingPeriod;
+  PerThreadCountersSamplingPeriod = period ? period : 1;
+  return oldPeriod;
+}
+
+/// Aggregate the per thread counters of all threads into the result.
+/// Updates racing with the aggregation may or may not be included, which
+/// is fine for the statistical counters this tracks.
+void _swift_getPerThreadRuntimeFunctionCounters(
+    RuntimeFunctionCountersState *result) {
+  *result = RuntimeFunctionCountersState();
+  StaticScopedLock lock(PerThreadCountersListLock);
+  for (auto *block = PerThreadCountersList; block; block = block->Next) {
+#define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
+  result->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) +=           \
+      block->State.SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION);
+#include "RuntimeInvocationsTracking.def"
+  }
+}
+
+/// Begin a counter scope on the current thread by snapshotting this
+/// thread's counters into the provided state.
+void _swift_beginRuntimeFunctionCountersScope(
+    RuntimeFunctionCountersState *scopeState) {
+  *scopeState = *getOrCreateThreadLocalCounters();
+}
+
+/// End a counter scope on the current thread: replace the snapshot taken
+/// by _swift_beginRuntimeFunctionCountersScope with the number of calls
+/// counted on this thread since then, e.g. while serving one request.
+void _swift_endRuntimeFunctionCountersScope(
+    RuntimeFunctionCountersState *scopeState) {
+  auto *current = getOrCreateThreadLocalCounters();
+#define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
+  scopeState->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) =        \
+      current->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) -       \
+      scopeState->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION);
+#include "RuntimeInvocationsTracking.def"
+}
+
 /// Add the ability to call custom handlers when a counter
 /// is being updated. The handler should take the object and may be
 /// the name of the runtime function as parameters. And this handler
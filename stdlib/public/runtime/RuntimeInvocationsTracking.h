@@ -103,6 +103,33 @@ _swift_setPerObjectRuntimeFunctionCountersMode(int mode);
 /// Return the old value of this flag.
 SWIFT_RUNTIME_EXPORT int _swift_setGlobalRuntimeFunctionCountersMode(int mode);
 
+/// Set mode for per thread runtime function counters.
+/// Return the old value of this flag.
+SWIFT_RUNTIME_EXPORT int
+_swift_setPerThreadRuntimeFunctionCountersMode(int mode);
+
+/// Set the sampling period for per thread runtime function counters: only
+/// every Nth tracked call updates the counters, each update adding N, so
+/// the counters remain estimates of the true call counts. A period of 1
+/// counts every call. Return the old period.
+SWIFT_RUNTIME_EXPORT uint32_t
+_swift_setRuntimeFunctionCountersSamplingPeriod(uint32_t period);
+
+/// Aggregate the per thread counters of all threads into the result.
+SWIFT_RUNTIME_EXPORT void _swift_getPerThreadRuntimeFunctionCounters(
+    swift::RuntimeFunctionCountersState *result);
+
+/// Begin a counter scope on the current thread by snapshotting this
+/// thread's counters into the provided state.
+SWIFT_RUNTIME_EXPORT void _swift_beginRuntimeFunctionCountersScope(
+    swift::RuntimeFunctionCountersState *scopeState);
+
+/// End a counter scope on the current thread: replace the snapshot taken
+/// at the begin of the scope with the number of calls counted on this
+/// thread since then.
+SWIFT_RUNTIME_EXPORT void _swift_endRuntimeFunctionCountersScope(
+    swift::RuntimeFunctionCountersState *scopeState);
+
 /// Set the global runtime state of function pointers from a provided state.
 SWIFT_RUNTIME_EXPORT void _swift_setGlobalRuntimeFunctionCounters(
     swift::RuntimeFunctionCountersState *state);
@@ -57,6 +57,11 @@ const Metadata *findHashableBaseTypeOfHashableType(
 /// If `type` does not conform to `Hashable`, `nullptr` is returned.
 const Metadata *findHashableBaseType(const Metadata *type);
 
+/// Find the `Hashable` witness table for a type, using the same cache as
+/// the base-type lookup.
+/// If `type` does not conform to `Hashable`, `nullptr` is returned.
+const HashableWitnessTable *findHashableConformance(const Metadata *type);
+
 } // namespace hashable_support
 } // namespace swift
 
@@ -76,7 +76,8 @@ swift::_SwiftEmptyDictionaryStorage swift::_swiftEmptyDictionaryStorage = {
     (void*)1  // void* values; (non-null garbage)
   },
 
-  0 // int entries; (zero'd bits)
+  0, // int entries; (zero'd bits)
+  0  // int hashFragments; (zero'd bytes, so every bucket reads as a hole)
 };
 
 
@@ -103,7 +104,8 @@ swift::_SwiftEmptySetStorage swift::_swiftEmptySetStorage = {
     (void*)1 // void* keys; (non-null garbage)
   },
 
-  0 // int entries; (zero'd bits)
+  0, // int entries; (zero'd bits)
+  0  // int hashFragments; (zero'd bytes, so every bucket reads as a hole)
 };
 
 static __swift_uint64_t randomUInt64() {
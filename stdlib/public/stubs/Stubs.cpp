@@ -190,6 +190,312 @@ static int swift_snprintf_l(char *Str, size_t StrSize, locale_t Locale,
 }
 #endif
 
+// Shortest round-trip conversion of binary floating-point values to decimal
+// digit strings, following Loitsch's Grisu2 algorithm ("Printing
+// floating-point numbers quickly and accurately with integers", PLDI 2010).
+// Grisu2 emits a digit string that is guaranteed to parse back to the exact
+// same value and is the shortest such string in the overwhelming majority of
+// cases; in the rare remainder it emits one digit more than necessary, which
+// is still correct.
+struct DiyFp {
+  uint64_t f;
+  int e;
+};
+
+static inline DiyFp DiyFpSub(DiyFp x, DiyFp y) {
+  return DiyFp{x.f - y.f, x.e};
+}
+
+// Round-to-nearest 64x64->top-64 multiplication, without relying on a
+// 128-bit integer type.
+static inline DiyFp DiyFpMul(DiyFp x, DiyFp y) {
+  const uint64_t M32 = 0xFFFFFFFFu;
+  uint64_t a = x.f >> 32, b = x.f & M32;
+  uint64_t c = y.f >> 32, d = y.f & M32;
+  uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+  uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+  tmp += 1u << 31;  // round
+  return DiyFp{ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64};
+}
+
+// Cached powers of ten, 10^-348 to 10^340 in steps of 8, as normalized
+// 64-bit significands with binary exponents.
+static const uint64_t kCachedPowersF[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+    0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+    0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+    0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+    0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+    0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+    0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+    0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+    0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+    0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+    0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+    0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+    0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+    0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+    0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+static const int16_t kCachedPowersE[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034,
+    -1007, -980, -954, -927, -901, -874, -847, -821,
+    -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396,
+    -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242,
+    269, 295, 322, 348, 375, 402, 428, 455,
+    481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+static DiyFp GetCachedPower(int e, int *K) {
+  // k = ceil((-61 - e) * log10(2)) + 347, mapped onto the table's step of 8.
+  double dk = (-61 - e) * 0.30102999566398114 + 347;
+  int k = static_cast<int>(dk);
+  if (dk - k > 0.0)
+    k++;
+  unsigned index = static_cast<unsigned>((k >> 3) + 1);
+  *K = -(-348 + static_cast<int>(index << 3));
+  return DiyFp{kCachedPowersF[index], kCachedPowersE[index]};
+}
+
+static inline int CountDecimalDigit32(uint32_t n) {
+  if (n < 10) return 1;
+  if (n < 100) return 2;
+  if (n < 1000) return 3;
+  if (n < 10000) return 4;
+  if (n < 100000) return 5;
+  if (n < 1000000) return 6;
+  if (n < 10000000) return 7;
+  if (n < 100000000) return 8;
+  if (n < 1000000000) return 9;
+  return 10;
+}
+
+static void GrisuRound(char *buffer, int len, uint64_t delta, uint64_t rest,
+                       uint64_t tenKappa, uint64_t wpW) {
+  while (rest < wpW && delta - rest >= tenKappa &&
+         (rest + tenKappa < wpW || wpW - rest > rest + tenKappa - wpW)) {
+    buffer[len - 1]--;
+    rest += tenKappa;
+  }
+}
+
+static void DigitGen(DiyFp W, DiyFp Mp, uint64_t delta, char *buffer, int *len,
+                     int *K) {
+  static const uint32_t kPow10[] = {1,      10,      100,      1000, 10000,
+                                    100000, 1000000, 10000000, 100000000,
+                                    1000000000};
+  const DiyFp one = {uint64_t(1) << -Mp.e, Mp.e};
+  const DiyFp wpW = DiyFpSub(Mp, W);
+  uint32_t p1 = static_cast<uint32_t>(Mp.f >> -one.e);
+  uint64_t p2 = Mp.f & (one.f - 1);
+  int kappa = CountDecimalDigit32(p1);
+  *len = 0;
+
+  while (kappa > 0) {
+    uint32_t d = p1 / kPow10[kappa - 1];
+    p1 %= kPow10[kappa - 1];
+    if (d || *len)
+      buffer[(*len)++] = static_cast<char>('0' + d);
+    kappa--;
+    uint64_t rest = (uint64_t(p1) << -one.e) + p2;
+    if (rest <= delta) {
+      *K += kappa;
+      GrisuRound(buffer, *len, delta, rest, uint64_t(kPow10[kappa]) << -one.e,
+                 wpW.f);
+      return;
+    }
+  }
+
+  for (;;) {
+    p2 *= 10;
+    delta *= 10;
+    char d = static_cast<char>(p2 >> -one.e);
+    if (d || *len)
+      buffer[(*len)++] = static_cast<char>('0' + d);
+    p2 &= one.f - 1;
+    kappa--;
+    if (p2 < delta) {
+      *K += kappa;
+      GrisuRound(buffer, *len, delta, p2, one.f,
+                 wpW.f * kPow10[-kappa]);
+      return;
+    }
+  }
+}
+
+// Produces the shortest digit string for a positive, finite, nonzero value
+// whose significand and unbiased binary exponent are given, together with a
+// decimal exponent K such that 0.digits... * 10^(length + K) == value.
+// The boundaries (half-ULP distances to the neighbouring representable
+// values) are derived from the source type by the caller, which is what
+// makes float digit strings shorter than double ones;
+// lowerBoundaryIsCloser is true when the value sits on a binary power
+// boundary so its lower neighbour is only a quarter-ULP away.
+static void Grisu2(uint64_t significand, int exponent,
+                   bool lowerBoundaryIsCloser, char *buffer, int *length,
+                   int *K) {
+  // Compute the boundaries m- and m+ of v.
+  DiyFp plus = {(significand << 1) + 1, exponent - 1};
+  // The lower boundary is closer if v sits on a power-of-two boundary
+  // (lowest significand of a normal), except for the very lowest one.
+  DiyFp minus = lowerBoundaryIsCloser
+    ? DiyFp{(significand << 2) - 1, exponent - 2}
+    : DiyFp{(significand << 1) - 1, exponent - 1};
+
+  // Normalize m+ so its significand's top bit is set.
+  while (!(plus.f & (uint64_t(1) << 63))) {
+    plus.f <<= 1;
+    plus.e--;
+  }
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+
+  DiyFp v = {significand, exponent};
+  while (!(v.f & (uint64_t(1) << 63))) {
+    v.f <<= 1;
+    v.e--;
+  }
+
+  const DiyFp cMk = GetCachedPower(plus.e, K);
+  const DiyFp W = DiyFpMul(v, cMk);
+  DiyFp Wp = DiyFpMul(plus, cMk);
+  DiyFp Wm = DiyFpMul(minus, cMk);
+  Wm.f++;
+  Wp.f--;
+  DigitGen(W, Wp, Wp.f - Wm.f, buffer, length, K);
+}
+
+// Decompose a value into its significand (with the hidden bit made explicit
+// for normals) and unbiased exponent, scaled so that
+// value == significand * 2^exponent. Returns false for zeroes, infinities
+// and NaNs, which take the printf-based path below.
+static bool decomposeForShortestDecimal(double Value, bool &Negative,
+                                        uint64_t &Significand, int &Exponent,
+                                        bool &LowerBoundaryIsCloser) {
+  uint64_t Bits;
+  memcpy(&Bits, &Value, sizeof(Value));
+  Negative = (Bits >> 63) != 0;
+  uint64_t RawSignificand = Bits & ((uint64_t(1) << 52) - 1);
+  int RawExponent = static_cast<int>((Bits >> 52) & 0x7FF);
+  if (RawExponent == 0x7FF)
+    return false;
+  if (RawExponent == 0) {
+    if (RawSignificand == 0)
+      return false;
+    Significand = RawSignificand;
+    Exponent = 1 - 1075;
+  } else {
+    Significand = RawSignificand | (uint64_t(1) << 52);
+    Exponent = RawExponent - 1075;
+  }
+  LowerBoundaryIsCloser = RawSignificand == 0 && RawExponent > 1;
+  return true;
+}
+
+static bool decomposeForShortestDecimal(float Value, bool &Negative,
+                                        uint64_t &Significand, int &Exponent,
+                                        bool &LowerBoundaryIsCloser) {
+  uint32_t Bits;
+  memcpy(&Bits, &Value, sizeof(Value));
+  Negative = (Bits >> 31) != 0;
+  uint32_t RawSignificand = Bits & ((uint32_t(1) << 23) - 1);
+  int RawExponent = static_cast<int>((Bits >> 23) & 0xFF);
+  if (RawExponent == 0xFF)
+    return false;
+  if (RawExponent == 0) {
+    if (RawSignificand == 0)
+      return false;
+    Significand = RawSignificand;
+    Exponent = 1 - 150;
+  } else {
+    Significand = RawSignificand | (uint32_t(1) << 23);
+    Exponent = RawExponent - 150;
+  }
+  LowerBoundaryIsCloser = RawSignificand == 0 && RawExponent > 1;
+  return true;
+}
+
+// Float80 keeps the printf-based path; its 64-bit significand leaves Grisu2
+// no spare bits to work with.
+static bool decomposeForShortestDecimal(long double, bool &, uint64_t &,
+                                        int &, bool &) {
+  return false;
+}
+
+// Format the digit string produced by Grisu2 the way "%g" would: plain
+// decimal notation while the decimal exponent is moderate, scientific
+// notation with an explicit sign and at least two exponent digits otherwise.
+// The shared ".0" fixup in swift_floatingPointToString still applies to the
+// result.
+static uint64_t formatShortestDecimal(char *Buffer, bool Negative,
+                                      const char *Digits, int Length, int K,
+                                      int MaxFixedExponent) {
+  // Digits is an integer d1...dn with value == Digits * 10^K.
+  int DecimalExponent = Length + K - 1;
+  char *p = Buffer;
+  if (Negative)
+    *p++ = '-';
+  if (DecimalExponent < -4 || DecimalExponent > MaxFixedExponent) {
+    // d1.d2...dn e±XX
+    *p++ = Digits[0];
+    if (Length > 1) {
+      *p++ = '.';
+      memcpy(p, Digits + 1, Length - 1);
+      p += Length - 1;
+    }
+    *p++ = 'e';
+    int E = DecimalExponent;
+    *p++ = E < 0 ? '-' : '+';
+    if (E < 0)
+      E = -E;
+    char ExpDigits[4];
+    int n = 0;
+    do {
+      ExpDigits[n++] = static_cast<char>('0' + E % 10);
+      E /= 10;
+    } while (E);
+    if (n < 2)
+      *p++ = '0';
+    while (n)
+      *p++ = ExpDigits[--n];
+  } else if (DecimalExponent >= Length - 1) {
+    // All digits land before the decimal point: d1...dn0...0
+    memcpy(p, Digits, Length);
+    p += Length;
+    for (int i = Length - 1; i < DecimalExponent; i++)
+      *p++ = '0';
+  } else if (DecimalExponent >= 0) {
+    // d1...dk.dk+1...dn
+    memcpy(p, Digits, DecimalExponent + 1);
+    p += DecimalExponent + 1;
+    *p++ = '.';
+    memcpy(p, Digits + DecimalExponent + 1, Length - DecimalExponent - 1);
+    p += Length - DecimalExponent - 1;
+  } else {
+    // 0.0...0d1...dn
+    *p++ = '0';
+    *p++ = '.';
+    for (int i = DecimalExponent; i < -1; i++)
+      *p++ = '0';
+    memcpy(p, Digits, Length);
+    p += Length;
+  }
+  *p = '\0';
+  return p - Buffer;
+}
+
 template <typename T>
 static uint64_t swift_floatingPointToString(char *Buffer, size_t BufferLength,
                                             T Value, const char *Format, 
@@ -197,6 +503,39 @@ static uint64_t swift_floatingPointToString(char *Buffer, size_t BufferLength,
   if (BufferLength < 32)
     swift::crash("swift_floatingPointToString: insufficient buffer size");
 
+  // Finite nonzero floats and doubles get the shortest digit string that
+  // parses back to the same value, instead of a fixed printf precision that
+  // is either lossy (digits10) or padded with noise digits (max_digits10).
+  {
+    bool Negative;
+    uint64_t Significand;
+    int Exponent;
+    bool LowerBoundaryIsCloser;
+    if (decomposeForShortestDecimal(Value, Negative, Significand, Exponent,
+                                    LowerBoundaryIsCloser)) {
+      char Digits[24];
+      int Length, K;
+      Grisu2(Significand, Exponent, LowerBoundaryIsCloser, Digits, &Length,
+             &K);
+      // Match the fixed/scientific cutoff of the %g path this replaces: %g
+      // switches to scientific notation when the decimal exponent reaches
+      // the precision, which was digits10 for description and max_digits10
+      // for debugDescription.
+      int MaxFixedExponent = (Debug ? std::numeric_limits<T>::max_digits10
+                                    : std::numeric_limits<T>::digits10) - 1;
+      uint64_t i = formatShortestDecimal(Buffer, Negative, Digits, Length, K,
+                                         MaxFixedExponent);
+      // Add ".0" when the result has neither a fraction nor an exponent, the
+      // same fixup the printf-based path below gets.
+      if (strchr(Buffer, 'e') == nullptr && strchr(Buffer, '.') == nullptr) {
+        Buffer[i++] = '.';
+        Buffer[i++] = '0';
+        Buffer[i] = '\0';
+      }
+      return i;
+    }
+  }
+
   int Precision = std::numeric_limits<T>::digits10;
   if (Debug) {
     Precision = std::numeric_limits<T>::max_digits10;
@@ -0,0 +1,6 @@
+# Dependencies after compilation:
+provides-top-level: [a, b]
+decl-fingerprints:
+- ["a", "1111"]
+- ["b", "3333"]
+interface-hash: "after"
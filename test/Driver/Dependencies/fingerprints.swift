@@ -0,0 +1,38 @@
+/// a-and-b ==> uses-a, uses-b
+/// 'b' is the only declaration whose fingerprint changes.
+
+// RUN: rm -rf %t && cp -r %S/Inputs/fingerprints/ %t
+// RUN: touch -t 201401240005 %t/*
+
+// Generate the build record...
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./a-and-b.swift ./uses-a.swift ./uses-b.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-FIRST %s
+
+// CHECK-FIRST-NOT: warning
+// CHECK-FIRST: Handled a-and-b.swift
+// CHECK-FIRST: Handled uses-a.swift
+// CHECK-FIRST: Handled uses-b.swift
+
+// ...then reset the .swiftdeps files.
+// RUN: cp -r %S/Inputs/fingerprints/*.swiftdeps %t
+
+// By default the fingerprint diff must not narrow the cascade: the changed
+// interface hash rebuilds both dependents.
+// RUN: touch -t 201401240006 %t/a-and-b.swift
+// RUN: cd %t && %swiftc_driver -c -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./a-and-b.swift ./uses-a.swift ./uses-b.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-DEFAULT %s
+
+// CHECK-DEFAULT: Handled a-and-b.swift
+// CHECK-DEFAULT-DAG: Handled uses-a.swift
+// CHECK-DEFAULT-DAG: Handled uses-b.swift
+
+// RUN: cp -r %S/Inputs/fingerprints/*.swiftdeps %t
+
+// With the opt-in flag, only the dependent of the changed declaration is
+// rebuilt.
+// RUN: touch -t 201401240007 %t/a-and-b.swift
+// RUN: cd %t && %swiftc_driver -c -driver-enable-fingerprint-cascades -driver-use-frontend-path %S/Inputs/update-dependencies.py -output-file-map %t/output.json -incremental ./a-and-b.swift ./uses-a.swift ./uses-b.swift -module-name main -j1 -v 2>&1 | %FileCheck -check-prefix=CHECK-FILTERED %s
+
+// CHECK-FILTERED-NOT: Handled uses-a.swift
+// CHECK-FILTERED: Handled a-and-b.swift
+// CHECK-FILTERED-NOT: Handled uses-a.swift
+// CHECK-FILTERED: Handled uses-b.swift
+// CHECK-FILTERED-NOT: Handled uses-a.swift
@@ -0,0 +1,14 @@
+// RUN: %empty-directory(%t)
+// RUN: cp %s %t/main.swift
+// RUN: %target-build-swift -Xfrontend -playground -Xfrontend -playground-region -Xfrontend 11:11 -Xfrontend -debugger-support -o %t/main %S/Inputs/PlaygroundsRuntime.swift %t/main.swift
+// RUN: %target-run %t/main | %FileCheck %s
+// REQUIRES: executable_test
+
+var a = 2
+var b = 3
+a + b
+// The next line is the instrumented region.
+a - b
+// CHECK-NOT: ='5'
+// CHECK: {{\[}}[[@LINE-2]]:1-[[@LINE-2]]:6] $builtin_log[='-1']
+// CHECK-NOT: ='5'
@@ -32,6 +32,8 @@ class FuzzyStringMatcher {
   double maxScore; ///< The maximum possible raw score for this pattern.
   /// If (and only if) c is in pattern, charactersInPattern[c] == 1
   llvm::BitVector charactersInPattern;
+  /// The character classes occurring in pattern; see computeCharClasses.
+  uint64_t patternCharClasses;
 
 public:
   bool normalize = false; ///< Whether to normalize scores to [0, 1].
@@ -39,6 +41,24 @@ public:
 public:
   FuzzyStringMatcher(StringRef pattern);
 
+  /// Computes a bitmask of the character classes occurring in \p text: one
+  /// bit per case-folded letter and per digit, with other bytes hashed into
+  /// the remaining bits.
+  ///
+  /// Any match (prefix or fuzzy) requires every pattern character to occur
+  /// somewhere in the candidate, so a candidate whose mask is missing one of
+  /// the pattern's classes can be rejected without reading its string. A
+  /// flat, precomputed array of candidate masks makes that first pass a
+  /// simple linear scan.
+  static uint64_t computeCharClasses(StringRef text);
+
+  /// Whether a candidate whose mask is \p candidateCharClasses could
+  /// possibly match the pattern; use to prune candidates before
+  /// matchesCandidate or scoreCandidate.
+  bool mayMatchCandidate(uint64_t candidateCharClasses) const {
+    return (patternCharClasses & ~candidateCharClasses) == 0;
+  }
+
   /// Whether \p candidate matches the pattern.
   ///
   /// This operation is much simpler/faster than calculating
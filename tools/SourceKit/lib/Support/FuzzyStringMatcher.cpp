@@ -34,6 +34,8 @@ FuzzyStringMatcher::FuzzyStringMatcher(StringRef pattern_)
   }
   assert(pattern.size() == lowercasePattern.size());
 
+  patternCharClasses = computeCharClasses(pattern);
+
   // FIXME: pull out the magic constants.
   // This depends on the inner details of the matching algorithm and will need
   // to be updated if we substantially alter it.
@@ -50,6 +52,21 @@ FuzzyStringMatcher::FuzzyStringMatcher(StringRef pattern_)
   }
 }
 
+uint64_t FuzzyStringMatcher::computeCharClasses(StringRef text) {
+  uint64_t classes = 0;
+  for (char c : text) {
+    char lower = toLowercase(c);
+    if (lower >= 'a' && lower <= 'z')
+      classes |= uint64_t(1) << (lower - 'a');
+    else if (lower >= '0' && lower <= '9')
+      classes |= uint64_t(1) << (26 + (lower - '0'));
+    else // Hash other bytes into the remaining bits; collisions only make
+         // the prefilter conservative, never wrong.
+      classes |= uint64_t(1) << (36 + static_cast<unsigned char>(c) % 28);
+  }
+  return classes;
+}
+
 bool FuzzyStringMatcher::matchesCandidate(StringRef candidate) const {
   unsigned patternLength = pattern.size();
   unsigned candidateLength = candidate.size();
@@ -222,7 +222,8 @@ public:
   void addCompletionsWithFilter(ArrayRef<Completion *> completions,
                                 StringRef filterText, Options options,
                                 const FilterRules &rules,
-                                Completion *&exactMatch);
+                                Completion *&exactMatch,
+                                ArrayRef<uint64_t> completionCharClasses);
 
   void sort(Options options);
 
@@ -297,9 +298,10 @@ void CodeCompletionOrganizer::preSortCompletions(
 
 void CodeCompletionOrganizer::addCompletionsWithFilter(
     ArrayRef<Completion *> completions, StringRef filterText,
-    const FilterRules &rules, Completion *&exactMatch) {
+    const FilterRules &rules, Completion *&exactMatch,
+    ArrayRef<uint64_t> completionCharClasses) {
   impl.addCompletionsWithFilter(completions, filterText, options, rules,
-                                exactMatch);
+                                exactMatch, completionCharClasses);
 }
 
 void CodeCompletionOrganizer::groupAndSort(const Options &options) {
@@ -524,8 +526,11 @@ bool FilterRules::hideCompletion(SwiftResult *completion, StringRef filterName,
 
 void CodeCompletionOrganizer::Impl::addCompletionsWithFilter(
     ArrayRef<Completion *> completions, StringRef filterText, Options options,
-    const FilterRules &rules, Completion *&exactMatch) {
+    const FilterRules &rules, Completion *&exactMatch,
+    ArrayRef<uint64_t> completionCharClasses) {
   assert(rootGroup);
+  assert(completionCharClasses.empty() ||
+         completionCharClasses.size() == completions.size());
 
   auto &contents = rootGroup->contents;
 
@@ -591,7 +596,15 @@ void CodeCompletionOrganizer::Impl::addCompletionsWithFilter(
 
   FuzzyStringMatcher pattern(filterText);
   pattern.normalize = true;
-  for (Completion *completion : completions) {
+  bool havePrefilter = !completionCharClasses.empty();
+  for (size_t i = 0, e = completions.size(); i != e; ++i) {
+    Completion *completion = completions[i];
+    // First pass: any match, prefix or fuzzy, needs all of the pattern's
+    // character classes to occur in the candidate, so scanning the flat mask
+    // array prunes most candidates without touching their names.
+    if (havePrefilter && !pattern.mayMatchCandidate(completionCharClasses[i]))
+      continue;
+
     if (rules.hideCompletion(completion))
       continue;
 
@@ -84,10 +84,16 @@ public:
   /// Add \p completions to the organizer, removing any results that don't match
   /// \p filterText and returning \p exactMatch if there is an exact match.
   ///
+  /// If \p completionCharClasses is non-empty it must be parallel to
+  /// \p completions, holding each completion's
+  /// FuzzyStringMatcher::computeCharClasses mask; it is scanned to prune
+  /// candidates that cannot match before their names are examined.
+  ///
   /// Precondition: \p completions should be sorted with preSortCompletions().
   void addCompletionsWithFilter(ArrayRef<Completion *> completions,
                                 StringRef filterText, const FilterRules &rules,
-                                Completion *&exactMatch);
+                                Completion *&exactMatch,
+                                ArrayRef<uint64_t> completionCharClasses = {});
 
   void groupAndSort(const Options &options);
 
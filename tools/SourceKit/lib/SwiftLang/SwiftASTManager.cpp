@@ -30,6 +30,7 @@
 #include "swift/Sema/IDETypeChecking.h"
 
 #include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -257,6 +258,10 @@ struct FileContent {
 class ASTProducer : public ThreadSafeRefCountedBase<ASTProducer> {
   SwiftInvocationRef InvokRef;
   SmallVector<BufferStamp, 8> Stamps;
+  /// Fingerprints of the input buffer contents the AST was built from,
+  /// parallel to \c Stamps. Used to keep the AST alive across edits that
+  /// don't change the text (re-saves, undo back to the built state).
+  SmallVector<uint64_t, 8> ContentHashes;
   ThreadSafeRefCntPtr<ASTUnit> AST;
   SmallVector<std::pair<std::string, BufferStamp>, 8> DependencyStamps;
   std::vector<std::pair<SwiftASTConsumerRef, const void*>> QueuedConsumers;
@@ -297,6 +302,9 @@ private:
                            ArrayRef<ImmutableTextSnapshotRef> Snapshots,
                            std::string &Error);
 
+  bool matchesContentFingerprints(SwiftASTManager::Implementation &MgrImpl,
+                                  ArrayRef<ImmutableTextSnapshotRef> Snapshots);
+
   void findSnapshotAndOpenFiles(SwiftASTManager::Implementation &MgrImpl,
                                 ArrayRef<ImmutableTextSnapshotRef> Snapshots,
                                 SmallVectorImpl<FileContent> &Contents,
@@ -724,8 +732,17 @@ bool ASTProducer::shouldRebuild(SwiftASTManager::Implementation &MgrImpl,
   }
   assert(InputStamps.size() ==
          Invok.Opts.Invok.getFrontendOptions().Inputs.inputCount());
-  if (Stamps != InputStamps)
-    return true;
+  if (Stamps != InputStamps) {
+    // A stamp changed, but the text may not have (e.g. a re-save, or edits
+    // that were undone back to the built state). A full AST rebuild is the
+    // most expensive response to a keystroke, so compare the content
+    // fingerprints before discarding the existing AST.
+    if (!matchesContentFingerprints(MgrImpl, Snapshots))
+      return true;
+    // The text is identical; adopt the new stamps so later checks stay
+    // cheap, and keep the AST.
+    Stamps = InputStamps;
+  }
 
   for (auto &Dependency : DependencyStamps) {
     if (Dependency.second != MgrImpl.getBufferStamp(Dependency.first))
@@ -735,6 +752,40 @@ bool ASTProducer::shouldRebuild(SwiftASTManager::Implementation &MgrImpl,
   return false;
 }
 
+bool ASTProducer::matchesContentFingerprints(
+    SwiftASTManager::Implementation &MgrImpl,
+    ArrayRef<ImmutableTextSnapshotRef> Snapshots) {
+  const SwiftInvocation::Implementation &Invok = InvokRef->Impl;
+  if (ContentHashes.size() !=
+      Invok.Opts.Invok.getFrontendOptions().Inputs.inputCount())
+    return false;
+
+  unsigned Index = 0;
+  for (const auto &input :
+       Invok.Opts.Invok.getFrontendOptions().Inputs.getAllFiles()) {
+    StringRef File = input.file();
+    uint64_t Hash;
+    bool FoundSnapshot = false;
+    for (auto &Snap : Snapshots) {
+      if (Snap->getFilename() == File) {
+        FoundSnapshot = true;
+        Hash = llvm::hash_value(Snap->getBuffer()->getText());
+        break;
+      }
+    }
+    if (!FoundSnapshot) {
+      std::string Error;
+      auto Content = MgrImpl.getFileContent(File, /*IsPrimary=*/false, Error);
+      if (!Content.Buffer)
+        return false;
+      Hash = llvm::hash_value(Content.Buffer->getBuffer());
+    }
+    if (ContentHashes[Index++] != Hash)
+      return false;
+  }
+  return true;
+}
+
 static void collectModuleDependencies(ModuleDecl *TopMod,
     llvm::SmallPtrSetImpl<ModuleDecl *> &Visited,
     SmallVectorImpl<std::string> &Filenames) {
@@ -792,13 +843,16 @@ ASTUnitRef ASTProducer::createASTUnit(SwiftASTManager::Implementation &MgrImpl,
   ++MgrImpl.Stats.numASTBuilds;
 
   Stamps.clear();
+  ContentHashes.clear();
   DependencyStamps.clear();
 
   SmallVector<FileContent, 8> Contents;
   findSnapshotAndOpenFiles(MgrImpl, Snapshots, Contents, Error);
 
-  for (auto &Content : Contents)
+  for (auto &Content : Contents) {
     Stamps.push_back(Content.Stamp);
+    ContentHashes.push_back(llvm::hash_value(Content.Buffer->getBuffer()));
+  }
 
   trace::SwiftInvocation TraceInfo;
 
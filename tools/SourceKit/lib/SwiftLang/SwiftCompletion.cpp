@@ -13,6 +13,7 @@
 #include "CodeCompletionOrganizer.h"
 #include "SwiftASTManager.h"
 #include "SwiftLangSupport.h"
+#include "SourceKit/Support/FuzzyStringMatcher.h"
 #include "SourceKit/Support/Logging.h"
 #include "SourceKit/Support/UIdent.h"
 
@@ -708,11 +709,23 @@ void CodeCompletion::SessionCache::setSortedCompletions(
     std::vector<Completion *> &&completions) {
   llvm::sys::ScopedLock L(mtx);
   sortedCompletions = std::move(completions);
+  // Compute the character-class masks once per session; every subsequent
+  // filter pass scans this flat pool instead of the candidate names.
+  sortedCompletionCharClasses.clear();
+  sortedCompletionCharClasses.reserve(sortedCompletions.size());
+  for (Completion *completion : sortedCompletions)
+    sortedCompletionCharClasses.push_back(
+        FuzzyStringMatcher::computeCharClasses(completion->getName()));
 }
 ArrayRef<Completion *> CodeCompletion::SessionCache::getSortedCompletions() {
   llvm::sys::ScopedLock L(mtx);
   return sortedCompletions;
 }
+ArrayRef<uint64_t>
+CodeCompletion::SessionCache::getSortedCompletionCharClasses() {
+  llvm::sys::ScopedLock L(mtx);
+  return sortedCompletionCharClasses;
+}
 llvm::MemoryBuffer *CodeCompletion::SessionCache::getBuffer() {
   llvm::sys::ScopedLock L(mtx);
   return buffer.get();
@@ -1042,8 +1055,9 @@ static void transformAndForwardResults(
       session->getCompletionKind() == CompletionKind::PostfixExpr;
 
   if (!hasEarlyInnerResults) {
-    organizer.addCompletionsWithFilter(session->getSortedCompletions(),
-                                       filterText, rules, exactMatch);
+    organizer.addCompletionsWithFilter(
+        session->getSortedCompletions(), filterText, rules, exactMatch,
+        session->getSortedCompletionCharClasses());
     // Add leading dot?
     if (options.addInnerOperators && !rules.hideFilterName(".") &&
         session->getCompletionMayUseImplicitMemberExpr()) {
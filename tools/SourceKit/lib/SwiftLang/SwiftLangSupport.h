@@ -142,6 +142,9 @@ class SessionCache : public ThreadSafeRefCountedBase<SessionCache> {
   std::vector<std::string> args;
   CompletionSink sink;
   std::vector<Completion *> sortedCompletions;
+  /// Character-class masks parallel to \c sortedCompletions, used to prune
+  /// candidates during filtering without touching the completion names.
+  std::vector<uint64_t> sortedCompletionCharClasses;
   CompletionKind completionKind;
   bool completionHasExpectedTypes;
   bool completionMayUseImplicitMemberExpr;
@@ -161,6 +164,7 @@ public:
         filterRules(std::move(filterRules)) {}
   void setSortedCompletions(std::vector<Completion *> &&completions);
   ArrayRef<Completion *> getSortedCompletions();
+  ArrayRef<uint64_t> getSortedCompletionCharClasses();
   llvm::MemoryBuffer *getBuffer();
   ArrayRef<std::string> getCompilerArgs();
   const FilterRules &getFilterRules();
@@ -38,8 +38,12 @@
 #include "clang/Index/USRGeneration.h"
 #include "clang/Lex/Lexer.h"
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/raw_ostream.h"
 
+#include <memory>
 #include <numeric>
 
 using namespace SourceKit;
@@ -1184,6 +1188,145 @@ public:
   }
 };
 
+namespace {
+/// An owning copy of a CursorInfoData response. CursorInfoData itself only
+/// holds StringRefs into storage that dies with the request, so cached
+/// responses are deep-copied and replayed through \c pass().
+struct CursorInfoCopy {
+  UIdent Kind;
+  std::string Name;
+  std::string USR;
+  std::string TypeName;
+  std::string TypeUSR;
+  std::string ContainerTypeUSR;
+  std::string DocComment;
+  std::string TypeInterface;
+  std::string GroupName;
+  std::string LocalizationKey;
+  std::string AnnotatedDeclaration;
+  std::string FullyAnnotatedDeclaration;
+  std::string ModuleName;
+  std::string ModuleInterfaceName;
+  llvm::Optional<std::pair<unsigned, unsigned>> DeclarationLoc;
+  std::string Filename;
+  std::vector<std::string> OverrideUSRs;
+  std::vector<std::string> AnnotatedRelatedDeclarations;
+  std::vector<std::string> ModuleGroupArray;
+  struct Action {
+    UIdent Kind;
+    std::string KindName;
+    std::string UnavailableReason;
+  };
+  std::vector<Action> AvailableActions;
+  bool IsSystem;
+  llvm::Optional<unsigned> ParentNameOffset;
+
+  explicit CursorInfoCopy(const CursorInfoData &Info)
+      : Kind(Info.Kind), Name(Info.Name.str()), USR(Info.USR.str()),
+        TypeName(Info.TypeName.str()), TypeUSR(Info.TypeUSR.str()),
+        ContainerTypeUSR(Info.ContainerTypeUSR.str()),
+        DocComment(Info.DocComment.str()),
+        TypeInterface(Info.TypeInterface.str()),
+        GroupName(Info.GroupName.str()),
+        LocalizationKey(Info.LocalizationKey.str()),
+        AnnotatedDeclaration(Info.AnnotatedDeclaration.str()),
+        FullyAnnotatedDeclaration(Info.FullyAnnotatedDeclaration.str()),
+        ModuleName(Info.ModuleName.str()),
+        ModuleInterfaceName(Info.ModuleInterfaceName.str()),
+        DeclarationLoc(Info.DeclarationLoc), Filename(Info.Filename.str()),
+        IsSystem(Info.IsSystem), ParentNameOffset(Info.ParentNameOffset) {
+    for (auto USR : Info.OverrideUSRs)
+      OverrideUSRs.push_back(USR.str());
+    for (auto Decl : Info.AnnotatedRelatedDeclarations)
+      AnnotatedRelatedDeclarations.push_back(Decl.str());
+    for (auto Group : Info.ModuleGroupArray)
+      ModuleGroupArray.push_back(Group.str());
+    for (auto &Act : Info.AvailableActions)
+      AvailableActions.push_back(
+          {Act.Kind, Act.KindName.str(), Act.UnavailableReason.str()});
+  }
+
+  /// Passes a view of the stored response to \p Receiver; the StringRefs
+  /// in the view are only valid for the duration of the call.
+  void pass(std::function<void(const CursorInfoData &)> Receiver) const {
+    CursorInfoData Info;
+    Info.Kind = Kind;
+    Info.Name = Name;
+    Info.USR = USR;
+    Info.TypeName = TypeName;
+    Info.TypeUSR = TypeUSR;
+    Info.ContainerTypeUSR = ContainerTypeUSR;
+    Info.DocComment = DocComment;
+    Info.TypeInterface = TypeInterface;
+    Info.GroupName = GroupName;
+    Info.LocalizationKey = LocalizationKey;
+    Info.AnnotatedDeclaration = AnnotatedDeclaration;
+    Info.FullyAnnotatedDeclaration = FullyAnnotatedDeclaration;
+    Info.ModuleName = ModuleName;
+    Info.ModuleInterfaceName = ModuleInterfaceName;
+    Info.DeclarationLoc = DeclarationLoc;
+    Info.Filename = Filename;
+    SmallVector<StringRef, 4> Overrides(OverrideUSRs.begin(),
+                                        OverrideUSRs.end());
+    Info.OverrideUSRs = Overrides;
+    SmallVector<StringRef, 4> Related(AnnotatedRelatedDeclarations.begin(),
+                                      AnnotatedRelatedDeclarations.end());
+    Info.AnnotatedRelatedDeclarations = Related;
+    SmallVector<StringRef, 4> Groups(ModuleGroupArray.begin(),
+                                     ModuleGroupArray.end());
+    Info.ModuleGroupArray = Groups;
+    SmallVector<RefactoringInfo, 4> Actions;
+    for (auto &Act : AvailableActions)
+      Actions.push_back({Act.Kind, Act.KindName, Act.UnavailableReason});
+    Info.AvailableActions = Actions;
+    Info.IsSystem = IsSystem;
+    Info.ParentNameOffset = ParentNameOffset;
+    Receiver(Info);
+  }
+};
+
+/// Caches cursor-info responses within an editor session. Hovering around
+/// a file issues many identical requests; as long as the document snapshot
+/// is unchanged, the previous response for a location can be replayed
+/// without consulting the AST. Keys include the snapshot stamp, so an edit
+/// naturally misses; stale entries are discarded wholesale once the cache
+/// grows past its bound.
+class CursorInfoCache {
+  llvm::sys::Mutex Mtx;
+  llvm::StringMap<std::shared_ptr<CursorInfoCopy>> Entries;
+  static const size_t MaxEntries = 256;
+
+public:
+  static std::string makeKey(StringRef InputFile, unsigned Offset,
+                             unsigned Length, bool Actionables,
+                             uint64_t Stamp) {
+    std::string Key;
+    llvm::raw_string_ostream OS(Key);
+    OS << InputFile << ':' << Offset << ':' << Length << ':' << Actionables
+       << ':' << Stamp;
+    return OS.str();
+  }
+
+  std::shared_ptr<CursorInfoCopy> get(StringRef Key) {
+    llvm::sys::ScopedLock L(Mtx);
+    auto It = Entries.find(Key);
+    return It == Entries.end() ? nullptr : It->second;
+  }
+
+  void set(StringRef Key, const CursorInfoData &Info) {
+    llvm::sys::ScopedLock L(Mtx);
+    if (Entries.size() >= MaxEntries)
+      Entries.clear();
+    Entries[Key] = std::make_shared<CursorInfoCopy>(Info);
+  }
+};
+} // end anonymous namespace
+
+static CursorInfoCache &getCursorInfoCache() {
+  static CursorInfoCache Cache;
+  return Cache;
+}
+
 static void resolveCursor(SwiftLangSupport &Lang,
                           StringRef InputFile, unsigned Offset,
                           unsigned Length, bool Actionables,
@@ -1601,6 +1744,22 @@ void SwiftLangSupport::getCursorInfo(
     return;
   }
 
+  // Repeated hovers over the same location issue identical requests; when
+  // the editor document's snapshot hasn't changed since the last response
+  // for this location, replay it without consulting the AST. Files not
+  // open in the editor have no snapshot stamp to key on and bypass the
+  // cache.
+  std::string CacheKey;
+  if (auto EditorDoc = getEditorDocuments().findByPath(InputFile)) {
+    CacheKey = CursorInfoCache::makeKey(
+        InputFile, Offset, Length, Actionables,
+        EditorDoc->getLatestSnapshot()->getStamp());
+    if (auto Cached = getCursorInfoCache().get(CacheKey)) {
+      Cached->pass(Receiver);
+      return;
+    }
+  }
+
   std::string Error;
   SwiftInvocationRef Invok = ASTMgr->getInvocation(Args, InputFile, Error);
   if (!Invok) {
@@ -1610,8 +1769,15 @@ void SwiftLangSupport::getCursorInfo(
     return;
   }
 
+  auto CachingReceiver = [CacheKey,
+                          Receiver](const CursorInfoData &Info) {
+    if (!CacheKey.empty() && !Info.IsCancelled)
+      getCursorInfoCache().set(CacheKey, Info);
+    Receiver(Info);
+  };
   resolveCursor(*this, InputFile, Offset, Length, Actionables, Invok,
-                /*TryExistingAST=*/true, CancelOnSubsequentRequest, Receiver);
+                /*TryExistingAST=*/true, CancelOnSubsequentRequest,
+                CachingReceiver);
 }
 
 void SwiftLangSupport::
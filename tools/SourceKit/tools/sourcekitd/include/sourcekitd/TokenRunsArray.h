@@ -0,0 +1,52 @@
+//===--- TokenRunsArray.h - -------------------------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SOURCEKITD_TOKEN_RUNS_ARRAY_H
+#define LLVM_SOURCEKITD_TOKEN_RUNS_ARRAY_H
+
+#include "sourcekitd/Internal.h"
+
+namespace sourcekitd {
+
+VariantFunctions *getVariantFunctionsForTokenRunsArray();
+
+/// Builds a delta-encoded token array. Unlike TokenAnnotationsArrayBuilder,
+/// which stores a fixed-width entry per token, this encodes each token as a
+/// single kind byte (an index into a small table of distinct kind UIDs) plus
+/// varint-encoded offset delta and length. For syntax maps, where tokens are
+/// dense and sorted, this is typically 3-4 bytes per token instead of 16.
+/// Tokens are grouped into fixed-size chunks with an index so that elements
+/// can still be read in any order through the variant API.
+///
+/// Tokens must be added in order of non-decreasing offset.
+class TokenRunsArrayBuilder {
+public:
+  TokenRunsArrayBuilder();
+  ~TokenRunsArrayBuilder();
+
+  void add(SourceKit::UIdent Kind,
+           unsigned Offset,
+           unsigned Length,
+           bool IsSystem);
+
+  bool empty() const;
+
+  std::unique_ptr<llvm::MemoryBuffer> createBuffer();
+
+private:
+  struct Implementation;
+  Implementation &Impl;
+};
+
+}
+
+#endif
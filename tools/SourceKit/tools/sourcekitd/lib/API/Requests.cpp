@@ -15,6 +15,7 @@
 #include "sourcekitd/DocStructureArray.h"
 #include "sourcekitd/DocSupportAnnotationArray.h"
 #include "sourcekitd/TokenAnnotationsArray.h"
+#include "sourcekitd/TokenRunsArray.h"
 
 #include "SourceKit/Core/Context.h"
 #include "SourceKit/Core/LangSupport.h"
@@ -699,8 +700,36 @@ void handleRequestImpl(sourcekitd_object_t ReqObj, ResponseReceiver Rec) {
 
   static WorkQueue SemaQueue{ WorkQueue::Dequeuing::Concurrent,
                               "sourcekit.request.semantic" };
+
+  // Code completion is latency-sensitive, so give it its own high-priority
+  // queue rather than letting it wait behind indexing or cursor-info. While
+  // a completion request is in flight, also suspend the default semantic
+  // queue so queued background requests yield; blocks that already started
+  // keep running. The suspension count nests, so overlapping completion
+  // requests stay balanced.
+  static WorkQueue InteractiveSemaQueue{
+      WorkQueue::Dequeuing::Concurrent,
+      "sourcekit.request.semantic.interactive", WorkQueue::Priority::High };
+
+  bool IsInteractive = ReqUID == RequestCodeComplete ||
+                       ReqUID == RequestCodeCompleteOpen ||
+                       ReqUID == RequestCodeCompleteUpdate;
+
   sourcekitd_request_retain(ReqObj);
   ++numSemaRequests;
+  if (IsInteractive) {
+    SemaQueue.suspend();
+    InteractiveSemaQueue.dispatch(
+      [ReqObj, Rec, ReqUID, SourceFile, SourceText, Args] {
+        RequestDict Req(ReqObj);
+        handleSemanticRequest(Req, Rec, ReqUID, SourceFile, SourceText, Args);
+        sourcekitd_request_release(ReqObj);
+        SemaQueue.resume();
+      },
+      /*isStackDeep=*/true);
+    return;
+  }
+
   SemaQueue.dispatch(
     [ReqObj, Rec, ReqUID, SourceFile, SourceText, Args] {
       RequestDict Req(ReqObj);
@@ -1973,7 +2002,7 @@ class SKEditorConsumer : public EditorConsumer {
 
   ResponseBuilder::Dictionary Dict;
   DocStructureArrayBuilder DocStructure;
-  TokenAnnotationsArrayBuilder SyntaxMap;
+  TokenRunsArrayBuilder SyntaxMap;
   TokenAnnotationsArrayBuilder SemanticAnnotations;
 
   ResponseBuilder::Array Diags;
@@ -2196,7 +2225,7 @@ sourcekitd_response_t SKEditorConsumer::createResponse() {
 
   if (EnableSyntaxMap) {
     Dict.setCustomBuffer(KeySyntaxMap,
-        CustomBufferKind::TokenAnnotationsArray,
+        CustomBufferKind::TokenRunsArray,
         SyntaxMap.createBuffer());
   }
   if (!SemanticAnnotations.empty()) {
@@ -0,0 +1,357 @@
+//===--- TokenRunsArray.cpp -----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "sourcekitd/TokenRunsArray.h"
+#include "sourcekitd/CompactArray.h"
+#include "SourceKit/Core/LLVM.h"
+#include "SourceKit/Support/UIdent.h"
+#include "DictionaryKeys.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+using namespace SourceKit;
+using namespace sourcekitd;
+
+/// Number of tokens encoded per chunk. Random access decodes at most this
+/// many tokens; larger chunks shrink the index, smaller ones speed up
+/// out-of-order reads.
+static const size_t TokensPerChunk = 64;
+
+/// Buffer layout:
+///   uint64           token count
+///   uint64           number of distinct kind UIDs
+///   sourcekitd_uid_t kind table
+///   uint64           number of chunks
+///   2 x uint32       per chunk: byte offset into the run data, and the
+///                    offset of the token preceding the chunk (delta base)
+///   uint8            run data; per token a kind byte (kind table index in
+///                    the low 7 bits, is-system flag in the top bit), then
+///                    the offset delta and the length as LEB128 varints.
+
+static void appendVarint(llvm::SmallVectorImpl<uint8_t> &Buf, unsigned Val) {
+  while (Val >= 0x80) {
+    Buf.push_back(uint8_t(Val) | 0x80);
+    Val >>= 7;
+  }
+  Buf.push_back(uint8_t(Val));
+}
+
+static const uint8_t *readVarint(const uint8_t *P, unsigned &Val) {
+  Val = 0;
+  unsigned Shift = 0;
+  while (true) {
+    uint8_t Byte = *P++;
+    Val |= unsigned(Byte & 0x7f) << Shift;
+    if (!(Byte & 0x80))
+      break;
+    Shift += 7;
+  }
+  return P;
+}
+
+template <typename T>
+static void addScalar(T Val, llvm::SmallVectorImpl<char> &Buf) {
+  const char *ValPtr = reinterpret_cast<const char *>(&Val);
+  Buf.append(ValPtr, ValPtr + sizeof(Val));
+}
+
+template <typename T>
+static const uint8_t *readScalar(const uint8_t *Buf, T &Val) {
+  memcpy(&Val, Buf, sizeof(Val));
+  return Buf + sizeof(Val);
+}
+
+struct TokenRunsArrayBuilder::Implementation {
+  struct ChunkInfo {
+    uint32_t ByteOffset;
+    uint32_t BaseOffset;
+  };
+
+  llvm::SmallVector<sourcekitd_uid_t, 32> Kinds;
+  llvm::SmallVector<ChunkInfo, 16> Chunks;
+  llvm::SmallVector<uint8_t, 256> RunData;
+  uint64_t Count = 0;
+  unsigned LastOffset = 0;
+
+  uint8_t getKindIndex(sourcekitd_uid_t Kind) {
+    for (unsigned i = 0, e = Kinds.size(); i != e; ++i)
+      if (Kinds[i] == Kind)
+        return i;
+    assert(Kinds.size() <= 0x7f && "too many distinct token kinds");
+    Kinds.push_back(Kind);
+    return Kinds.size() - 1;
+  }
+};
+
+TokenRunsArrayBuilder::TokenRunsArrayBuilder()
+  : Impl(*new Implementation()) {
+
+}
+
+TokenRunsArrayBuilder::~TokenRunsArrayBuilder() {
+  delete &Impl;
+}
+
+void TokenRunsArrayBuilder::add(
+    UIdent Kind,
+    unsigned Offset,
+    unsigned Length,
+    bool IsSystem) {
+
+  assert(Offset >= Impl.LastOffset && "tokens must be added in source order");
+  if (Impl.Count % TokensPerChunk == 0)
+    Impl.Chunks.push_back({uint32_t(Impl.RunData.size()), Impl.LastOffset});
+
+  sourcekitd_uid_t uid =
+      Kind.isValid() ? SKDUIDFromUIdent(Kind) : sourcekitd_uid_t(nullptr);
+  Impl.RunData.push_back(Impl.getKindIndex(uid) | (IsSystem ? 0x80 : 0));
+  appendVarint(Impl.RunData, Offset - Impl.LastOffset);
+  appendVarint(Impl.RunData, Length);
+  Impl.LastOffset = Offset;
+  ++Impl.Count;
+}
+
+bool TokenRunsArrayBuilder::empty() const {
+  return Impl.Count == 0;
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+TokenRunsArrayBuilder::createBuffer() {
+  llvm::SmallVector<char, 512> Buf;
+  addScalar(uint64_t(Impl.Count), Buf);
+  addScalar(uint64_t(Impl.Kinds.size()), Buf);
+  for (sourcekitd_uid_t Kind : Impl.Kinds)
+    addScalar(Kind, Buf);
+  addScalar(uint64_t(Impl.Chunks.size()), Buf);
+  for (const auto &Chunk : Impl.Chunks) {
+    addScalar(Chunk.ByteOffset, Buf);
+    addScalar(Chunk.BaseOffset, Buf);
+  }
+  Buf.append(Impl.RunData.begin(), Impl.RunData.end());
+
+  return llvm::MemoryBuffer::getMemBufferCopy(
+      StringRef(Buf.data(), Buf.size()));
+}
+
+namespace {
+
+class TokenRunsArrayReader {
+public:
+  explicit TokenRunsArrayReader(void *Buf) {
+    const uint8_t *P = (const uint8_t *)Buf;
+    P = readScalar(P, Count);
+    uint64_t NumKinds;
+    P = readScalar(P, NumKinds);
+    Kinds = P;
+    P += NumKinds * sizeof(sourcekitd_uid_t);
+    uint64_t NumChunks;
+    P = readScalar(P, NumChunks);
+    Chunks = P;
+    RunData = P + NumChunks * 2 * sizeof(uint32_t);
+  }
+
+  size_t getCount() const { return Count; }
+
+  void readToken(size_t Index,
+                 sourcekitd_uid_t &Kind,
+                 unsigned &Offset,
+                 unsigned &Length,
+                 bool &IsSystem) const {
+    assert(Index < Count);
+    size_t Chunk = Index / TokensPerChunk;
+    uint32_t ByteOffset;
+    uint32_t BaseOffset;
+    const uint8_t *P =
+        readScalar(Chunks + Chunk * 2 * sizeof(uint32_t), ByteOffset);
+    readScalar(P, BaseOffset);
+
+    const uint8_t *Data = RunData + ByteOffset;
+    Offset = BaseOffset;
+    uint8_t KindByte;
+    for (size_t i = Chunk * TokensPerChunk; ; ++i) {
+      unsigned Delta;
+      KindByte = *Data++;
+      Data = readVarint(Data, Delta);
+      Data = readVarint(Data, Length);
+      Offset += Delta;
+      if (i == Index)
+        break;
+    }
+    readScalar(Kinds + (KindByte & 0x7f) * sizeof(sourcekitd_uid_t), Kind);
+    IsSystem = KindByte & 0x80;
+  }
+
+private:
+  uint64_t Count;
+  const uint8_t *Kinds;
+  const uint8_t *Chunks;
+  const uint8_t *RunData;
+};
+
+class TokenRunsArray {
+public:
+  typedef TokenRunsArrayReader CompactArrayReaderTy;
+
+  static void readElements(void *Buf, size_t Index,
+                           sourcekitd_uid_t &Kind,
+                           unsigned &Offset,
+                           unsigned &Length,
+                           bool &IsSystem) {
+    TokenRunsArrayReader Reader(Buf);
+    Reader.readToken(Index, Kind, Offset, Length, IsSystem);
+  }
+
+  static bool apply(sourcekitd_uid_t Kind,
+                    unsigned Offset,
+                    unsigned Length,
+                    bool IsSystem,
+                    llvm::function_ref<bool(sourcekitd_uid_t,
+                                            sourcekitd_variant_t)> applier) {
+
+#define APPLY(K, Ty, Field)                              \
+  do {                                                   \
+    sourcekitd_uid_t key = SKDUIDFromUIdent(K);          \
+    sourcekitd_variant_t var = make##Ty##Variant(Field); \
+    if (!applier(key, var)) return false;                \
+  } while (0)
+
+    APPLY(KeyKind, UID, Kind);
+    APPLY(KeyOffset, Int, Offset);
+    APPLY(KeyLength, Int, Length);
+    if (IsSystem)
+      APPLY(KeyIsSystem, Bool, IsSystem);
+
+    return true;
+  }
+
+  static bool getBool(sourcekitd_uid_t Key,
+                      sourcekitd_uid_t Kind,
+                      unsigned Offset,
+                      unsigned Length,
+                      bool IsSystem) {
+    if (Key == SKDUIDFromUIdent(KeyIsSystem))
+      return IsSystem;
+    return false;
+  }
+
+  static int64_t getInt(sourcekitd_uid_t Key,
+                        sourcekitd_uid_t Kind,
+                        unsigned Offset,
+                        unsigned Length,
+                        bool IsSystem) {
+    if (Key == SKDUIDFromUIdent(KeyOffset))
+      return Offset;
+    if (Key == SKDUIDFromUIdent(KeyLength))
+      return Length;
+    return 0;
+  }
+
+  static sourcekitd_uid_t getUID(sourcekitd_uid_t Key,
+                                 sourcekitd_uid_t Kind,
+                                 unsigned Offset,
+                                 unsigned Length,
+                                 bool IsSystem) {
+    if (Key == SKDUIDFromUIdent(KeyKind))
+      return Kind;
+    return nullptr;
+  }
+};
+
+} // end anonymous namespace
+
+namespace sourcekitd {
+
+template <>
+struct CompactVariantFuncs<TokenRunsArray> {
+  static sourcekitd_variant_type_t get_type(sourcekitd_variant_t var) {
+    return SOURCEKITD_VARIANT_TYPE_DICTIONARY;
+  }
+
+  template <typename FnTy>
+  static auto getElement(sourcekitd_variant_t dict, sourcekitd_uid_t key,
+                const FnTy &Fn) -> decltype(Fn(nullptr, nullptr, 0, 0, false)) {
+    void *Buf = (void*)dict.data[1];
+    size_t Index = dict.data[2];
+
+    sourcekitd_uid_t Kind;
+    unsigned Offset;
+    unsigned Length;
+    bool IsSystem;
+    TokenRunsArray::readElements(Buf, Index, Kind, Offset, Length, IsSystem);
+
+    return Fn(key, Kind, Offset, Length, IsSystem);
+  }
+
+  static bool
+  dictionary_apply(sourcekitd_variant_t dict,
+                   llvm::function_ref<bool(sourcekitd_uid_t,
+                                           sourcekitd_variant_t)> applier) {
+    void *Buf = (void*)dict.data[1];
+    size_t Index = dict.data[2];
+
+    sourcekitd_uid_t Kind;
+    unsigned Offset;
+    unsigned Length;
+    bool IsSystem;
+    TokenRunsArray::readElements(Buf, Index, Kind, Offset, Length, IsSystem);
+    return TokenRunsArray::apply(Kind, Offset, Length, IsSystem, applier);
+  }
+
+  static bool dictionary_get_bool(sourcekitd_variant_t dict,
+                                  sourcekitd_uid_t key) {
+    return getElement(dict, key, TokenRunsArray::getBool);
+  }
+
+  static int64_t dictionary_get_int64(sourcekitd_variant_t dict,
+                                      sourcekitd_uid_t key) {
+
+    return getElement(dict, key, TokenRunsArray::getInt);
+  }
+
+  static sourcekitd_uid_t dictionary_get_uid(sourcekitd_variant_t dict,
+                                             sourcekitd_uid_t key) {
+
+    return getElement(dict, key, TokenRunsArray::getUID);
+  }
+
+  static VariantFunctions Funcs;
+};
+
+VariantFunctions CompactVariantFuncs<TokenRunsArray>::Funcs = {
+  get_type,
+  nullptr/*Annot_array_apply*/,
+  nullptr/*Annot_array_get_bool*/,
+  nullptr/*Annot_array_get_count*/,
+  nullptr/*Annot_array_get_int64*/,
+  nullptr/*Annot_array_get_string*/,
+  nullptr/*Annot_array_get_uid*/,
+  nullptr/*Annot_array_get_value*/,
+  nullptr/*Annot_bool_get_value*/,
+  dictionary_apply,
+  dictionary_get_bool,
+  dictionary_get_int64,
+  nullptr/*Annot_dictionary_get_string*/,
+  nullptr/*Annot_dictionary_get_value*/,
+  dictionary_get_uid,
+  nullptr/*Annot_string_get_length*/,
+  nullptr/*Annot_string_get_ptr*/,
+  nullptr/*Annot_int64_get_value*/,
+  nullptr/*Annot_uid_get_value*/
+};
+
+} // namespace sourcekitd
+
+VariantFunctions *
+sourcekitd::getVariantFunctionsForTokenRunsArray() {
+  return &CompactArrayFuncs<TokenRunsArray>::Funcs;
+}
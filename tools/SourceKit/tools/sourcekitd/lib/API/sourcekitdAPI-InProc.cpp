@@ -17,19 +17,20 @@
 #include "sourcekitd/DocStructureArray.h"
 #include "sourcekitd/DocSupportAnnotationArray.h"
 #include "sourcekitd/TokenAnnotationsArray.h"
+#include "sourcekitd/TokenRunsArray.h"
 #include "sourcekitd/Logging.h"
 #include "SourceKit/Core/LLVM.h"
+#include "SourceKit/Support/Concurrency.h"
 #include "SourceKit/Support/UIdent.h"
 #include "swift/Basic/ThreadSafeRefCounted.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
 
-#include <map>
-
 using namespace SourceKit;
 using namespace sourcekitd;
 
@@ -108,7 +109,11 @@ public:
     return O->getKind() == ObjectKind::Dictionary;
   }
 private:
-  std::map<sourcekitd_uid_t, SKDObjectRef> Storage;
+  /// Most response dictionaries hold a handful of keys, so keep the buckets
+  /// inline instead of paying a node allocation per entry. Iteration order is
+  /// not meaningful; consumers that need ordered keys (e.g. the printer) sort
+  /// by key themselves.
+  llvm::SmallDenseMap<sourcekitd_uid_t, SKDObjectRef, 8> Storage;
 };
 
 class SKDArray: public SKDObject {
@@ -254,6 +259,7 @@ public:
       case CustomBufferKind::InheritedTypesArray:
       case CustomBufferKind::DocStructureElementArray:
       case CustomBufferKind::AttributesArray:
+      case CustomBufferKind::TokenRunsArray:
         return SOURCEKITD_VARIANT_TYPE_ARRAY;
     }
     llvm::report_fatal_error("sourcekitd object did not resolve to a known type");
@@ -534,7 +540,16 @@ sourcekitd_request_uid_create(sourcekitd_uid_t uid) {
 
 void
 sourcekitd_response_dispose(sourcekitd_response_t obj) {
-  static_cast<SKDObject *>(obj)->Release();
+  // Dropping the client's reference to a large response (e.g. a code
+  // completion result set) tears down thousands of small ref-counted objects.
+  // Do that on a background queue instead of whatever latency-sensitive
+  // thread the client happens to call dispose from; the reference counts are
+  // thread-safe and nothing can reach the object once dispose is called.
+  static WorkQueue DisposeQueue{ WorkQueue::Dequeuing::Serial,
+                                 "sourcekitd.response.dispose",
+                                 WorkQueue::Priority::Background };
+  auto *Object = static_cast<SKDObject *>(obj);
+  DisposeQueue.dispatch([Object] { Object->Release(); });
 }
 
 bool
@@ -951,6 +966,9 @@ static sourcekitd_variant_t variantFromSKDObject(SKDObjectRef Object) {
       case CustomBufferKind::AttributesArray:
         return {{ (uintptr_t)getVariantFunctionsForAttributesArray(),
           (uintptr_t)DataObject->getDataPtr(), 0 }};
+      case CustomBufferKind::TokenRunsArray:
+        return {{ (uintptr_t)getVariantFunctionsForTokenRunsArray(),
+          (uintptr_t)DataObject->getDataPtr(), 0 }};
     }
   }
   
@@ -42,8 +42,13 @@ extension Syntax {
     guard result.wasSuccessful else {
       throw ParserError.swiftcFailed(result.exitCode, result.stderr)
     }
-    let decoder = JSONDecoder()
-    let raw = try decoder.decode(RawSyntax.self, from: result.stdoutData)
+    let raw: RawSyntax
+    if RawSyntax.isBinaryTree(result.stdoutData) {
+      raw = try RawSyntax.decode(fromBinary: result.stdoutData)
+    } else {
+      let decoder = JSONDecoder()
+      raw = try decoder.decode(RawSyntax.self, from: result.stdoutData)
+    }
     guard let file = Syntax.fromRaw(raw) as? SourceFileSyntax else {
       throw ParserError.invalidFile
     }
@@ -0,0 +1,187 @@
+//===------ SyntaxBinaryDecoder.swift - Binary Syntax Tree Decoding -------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+// This file decodes RawSyntax trees from the compact binary format written
+// by SyntaxBinaryWriter (include/swift/Syntax/Serialization/
+// SyntaxBinarySerialization.h). The format is a deduplicated string table
+// followed by flat node records in post-order; see that header for the
+// full layout. Decoding walks the records once, resolving child references
+// into already-decoded nodes, which avoids the intermediate object graph a
+// JSON parse materializes.
+//===----------------------------------------------------------------------===//
+
+import Foundation
+
+/// A list of possible errors that could occur while decoding a binary
+/// syntax tree.
+public enum BinaryDecodeError: Error {
+  case invalidMagic
+  case unsupportedVersion(UInt32)
+  case truncated
+  case invalidString
+  case unknownTriviaKind(String)
+  case invalidNodeReference
+}
+
+/// A cursor over the serialized bytes that reads the primitives of the
+/// format: little-endian 32-bit integers and string-table references.
+private struct BinaryTreeReader {
+  let bytes: [UInt8]
+
+  /// Current read position, in bytes.
+  var offset = 0
+
+  /// Start of the string table, filled in once the header is read.
+  var stringsStart = 0
+
+  /// Previously resolved string refs; duplicated strings are decoded once.
+  var resolvedStrings = [UInt32: String]()
+
+  init(data: Data) {
+    self.bytes = [UInt8](data)
+  }
+
+  mutating func readUInt32() throws -> UInt32 {
+    guard offset + 4 <= bytes.count else {
+      throw BinaryDecodeError.truncated
+    }
+    let value = UInt32(bytes[offset])
+              | UInt32(bytes[offset + 1]) << 8
+              | UInt32(bytes[offset + 2]) << 16
+              | UInt32(bytes[offset + 3]) << 24
+    offset += 4
+    return value
+  }
+
+  /// Reads a string ref and resolves it against the string table.
+  mutating func readString() throws -> String {
+    let ref = try readUInt32()
+    if let resolved = resolvedStrings[ref] {
+      return resolved
+    }
+    var cursor = stringsStart + Int(ref)
+    guard cursor + 4 <= bytes.count else {
+      throw BinaryDecodeError.truncated
+    }
+    let length = Int(UInt32(bytes[cursor])
+                   | UInt32(bytes[cursor + 1]) << 8
+                   | UInt32(bytes[cursor + 2]) << 16
+                   | UInt32(bytes[cursor + 3]) << 24)
+    cursor += 4
+    guard cursor + length <= bytes.count else {
+      throw BinaryDecodeError.truncated
+    }
+    guard let string = String(bytes: bytes[cursor..<cursor + length],
+                              encoding: .utf8) else {
+      throw BinaryDecodeError.invalidString
+    }
+    resolvedStrings[ref] = string
+    return string
+  }
+
+  mutating func readTrivia() throws -> Trivia {
+    let count = try readUInt32()
+    var pieces = [TriviaPiece]()
+    pieces.reserveCapacity(Int(count))
+    for _ in 0..<count {
+      pieces.append(try readTriviaPiece())
+    }
+    return Trivia(pieces: pieces)
+  }
+
+  private mutating func readTriviaPiece() throws -> TriviaPiece {
+    let kind = try readString()
+    switch kind {
+    case "Space": return .spaces(Int(try readUInt32()))
+    case "Tab": return .tabs(Int(try readUInt32()))
+    case "VerticalTab": return .verticalTabs(Int(try readUInt32()))
+    case "Formfeed": return .formfeeds(Int(try readUInt32()))
+    case "Newline": return .newlines(Int(try readUInt32()))
+    case "CarriageReturn": return .carriageReturns(Int(try readUInt32()))
+    case "CarriageReturnLineFeed":
+      return .carriageReturnLineFeeds(Int(try readUInt32()))
+    case "Backtick": return .backticks(Int(try readUInt32()))
+    case "LineComment": return .lineComment(try readString())
+    case "BlockComment": return .blockComment(try readString())
+    case "DocLineComment": return .docLineComment(try readString())
+    case "DocBlockComment": return .docBlockComment(try readString())
+    case "GarbageText": return .garbageText(try readString())
+    default: throw BinaryDecodeError.unknownTriviaKind(kind)
+    }
+  }
+}
+
+extension RawSyntax {
+  /// The 4-byte magic that opens a binary syntax tree: "SSBT".
+  static let binaryTreeMagic: [UInt8] = [0x53, 0x53, 0x42, 0x54]
+
+  /// Whether the provided data carries the binary syntax tree magic.
+  static func isBinaryTree(_ data: Data) -> Bool {
+    return data.count >= binaryTreeMagic.count &&
+           data.prefix(binaryTreeMagic.count).elementsEqual(binaryTreeMagic)
+  }
+
+  /// Decodes a RawSyntax tree from the provided binary-format data.
+  /// - Parameter data: The serialized bytes, as written by
+  ///                   SyntaxBinaryWriter.
+  /// - Returns: The root of the decoded tree.
+  static func decode(fromBinary data: Data) throws -> RawSyntax {
+    var reader = BinaryTreeReader(data: data)
+    guard isBinaryTree(data) else {
+      throw BinaryDecodeError.invalidMagic
+    }
+    reader.offset = binaryTreeMagic.count
+    let version = try reader.readUInt32()
+    guard version == 1 else {
+      throw BinaryDecodeError.unsupportedVersion(version)
+    }
+    let stringTableSize = try reader.readUInt32()
+    let nodeCount = try reader.readUInt32()
+    reader.stringsStart = reader.offset
+    reader.offset += Int(stringTableSize)
+
+    // Records are in post-order, so every child reference points at a node
+    // that has already been decoded. The root is the last record.
+    var nodes = [RawSyntax]()
+    nodes.reserveCapacity(Int(nodeCount))
+    for _ in 0..<nodeCount {
+      let kindName = try reader.readString()
+      let presence: SourcePresence =
+        try reader.readUInt32() == 0 ? .present : .missing
+      if kindName == "Token" {
+        let tokenKindName = try reader.readString()
+        let text = try reader.readString()
+        let leadingTrivia = try reader.readTrivia()
+        let trailingTrivia = try reader.readTrivia()
+        let tokenKind = try TokenKind(kind: tokenKindName, text: text)
+        nodes.append(.token(tokenKind, leadingTrivia, trailingTrivia,
+                            presence))
+      } else {
+        let childCount = try reader.readUInt32()
+        var layout = [RawSyntax]()
+        layout.reserveCapacity(Int(childCount))
+        for _ in 0..<childCount {
+          let child = try reader.readUInt32()
+          guard Int(child) < nodes.count else {
+            throw BinaryDecodeError.invalidNodeReference
+          }
+          layout.append(nodes[Int(child)])
+        }
+        nodes.append(.node(SyntaxKind(rawValue: kindName) ?? .unknown,
+                           layout, presence))
+      }
+    }
+    guard let root = nodes.last else {
+      throw BinaryDecodeError.truncated
+    }
+    return root
+  }
+}
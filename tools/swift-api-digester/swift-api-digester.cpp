@@ -35,6 +35,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Signals.h"
@@ -154,6 +155,13 @@ SwiftVersion("swift-version",
 
 static llvm::cl::opt<bool>
 OutputInJson("json", llvm::cl::desc("Print output in JSON format."));
+
+static llvm::cl::opt<std::string>
+DigestCachePath("digest-cache-path",
+                llvm::cl::desc("Directory caching per-module digests keyed by "
+                               "the hash of the module file; modules whose "
+                               "binary interface is unchanged are copied from "
+                               "the cache instead of being digested again"));
 } // namespace options
 
 namespace {
@@ -3207,6 +3215,32 @@ static std::string getDumpFilePath(StringRef OutputDir, StringRef FileName) {
   return ConstructPath();
 }
 
+// Returns the hash of the module's serialized interface file on disk, or an
+// empty string when the file cannot be read. The hash keys the per-module
+// digest cache: a module whose swiftmodule (or clang pcm) is byte-identical
+// to a previously digested one produces the same dump.
+static std::string getModuleFileHash(ModuleDecl *M) {
+  StringRef Filename = M->getModuleFilename();
+  if (Filename.empty())
+    return std::string();
+  auto FileBufOrErr = llvm::MemoryBuffer::getFile(Filename);
+  if (!FileBufOrErr)
+    return std::string();
+  llvm::MD5 Hash;
+  Hash.update(FileBufOrErr.get()->getBuffer());
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  llvm::SmallString<32> HashString;
+  llvm::MD5::stringifyResult(Result, HashString);
+  return HashString.str().str();
+}
+
+static std::string getCachedDigestPath(StringRef ModuleName, StringRef Hash) {
+  llvm::SmallString<128> CachedPath(options::DigestCachePath);
+  path::append(CachedPath, ModuleName + "-" + Hash + ".js");
+  return CachedPath.str().str();
+}
+
 static int dumpSwiftModules(const CompilerInvocation &InitInvok,
                             const llvm::StringSet<> &ModuleNames,
                             StringRef OutputDir,
@@ -3243,8 +3277,31 @@ static int dumpSwiftModules(const CompilerInvocation &InitInvok,
     Modules.push_back(M);
   }
 
+  bool UseCache = !options::DigestCachePath.empty();
+  if (UseCache && !fs::exists(options::DigestCachePath)) {
+    if (auto EC = fs::create_directories(options::DigestCachePath)) {
+      llvm::errs() << "Cannot create digest cache directory: "
+                   << EC.message() << '\n';
+      UseCache = false;
+    }
+  }
+
   SDKContext Ctx;
   for (auto M : Modules) {
+    std::string Path = getDumpFilePath(OutputDir, M->getName().str());
+    std::string CachedPath;
+    if (UseCache) {
+      std::string Hash = getModuleFileHash(M);
+      if (!Hash.empty()) {
+        CachedPath = getCachedDigestPath(M->getName().str(), Hash);
+        if (fs::exists(CachedPath) && !fs::copy_file(CachedPath, Path)) {
+          if (options::Verbose)
+            llvm::errs() << "Reused cached digest for " << M->getName()
+                         << " at " << Path << "\n";
+          continue;
+        }
+      }
+    }
     SwiftDeclCollector Collector(Ctx);
     SmallVector<Decl*, 256> Decls;
     M->getTopLevelDecls(Decls);
@@ -3252,8 +3309,12 @@ static int dumpSwiftModules(const CompilerInvocation &InitInvok,
       if (auto VD = dyn_cast<ValueDecl>(D))
         Collector.foundDecl(VD, DeclVisibilityKind::VisibleAtTopLevel);
     }
-    std::string Path = getDumpFilePath(OutputDir, M->getName().str());
     Collector.serialize(Path);
+    if (!CachedPath.empty()) {
+      if (auto EC = fs::copy_file(Path, CachedPath))
+        llvm::errs() << "Failed to cache digest for " << M->getName()
+                     << ": " << EC.message() << '\n';
+    }
     if (options::Verbose)
       llvm::errs() << "Dumped to "<< Path << "\n";
   }
@@ -30,7 +30,13 @@
 #include <cstdlib>
 #endif
 
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 static llvm::cl::opt<bool>
 ExpandMode("expand",
@@ -64,6 +70,17 @@ static llvm::cl::opt<bool>
 Classify("classify",
            llvm::cl::desc("Display symbol classification characters"));
 
+static llvm::cl::opt<bool>
+BulkMode("bulk",
+           llvm::cl::desc("Bulk mode (read stdin in large chunks and demangle "
+                          "lines on multiple threads; implies -compact)"));
+
+static llvm::cl::opt<unsigned>
+BulkJobs("jobs",
+           llvm::cl::desc("Number of worker threads used by -bulk "
+                          "(0 means one per core)"),
+           llvm::cl::init(0));
+
 static llvm::cl::list<std::string>
 InputNames(llvm::cl::Positional, llvm::cl::desc("[mangled name...]"),
                llvm::cl::ZeroOrMore);
@@ -185,6 +202,111 @@ static int demangleSTDIN(const swift::Demangle::DemangleOptions &options) {
   return EXIT_SUCCESS;
 }
 
+/// Demangles every symbol in \p chunk (a sequence of whole lines) into \p out,
+/// the same way demangleSTDIN does in compact mode.
+static void demangleBulkChunk(llvm::StringRef chunk, std::string &out,
+                              const swift::Demangle::DemangleOptions &options) {
+  // See demangleSTDIN. Each worker compiles its own regex and uses its own
+  // context; both are cheaper than contending on shared ones.
+  llvm::Regex maybeSymbol("(_T|_*\\$S|" MANGLING_PREFIX_STR ")[_a-zA-Z0-9$.]+");
+
+  llvm::raw_string_ostream os(out);
+  swift::Demangle::Context DCtx;
+  while (!chunk.empty()) {
+    llvm::StringRef line;
+    std::tie(line, chunk) = chunk.split('\n');
+
+    llvm::SmallVector<llvm::StringRef, 1> matches;
+    while (maybeSymbol.match(line, &matches)) {
+      os << substrBefore(line, matches.front());
+      llvm::StringRef name = matches.front();
+      if (name.startswith("__"))
+        name = name.substr(1);
+      os << DCtx.demangleSymbolAsString(name, options);
+      DCtx.clear();
+      line = substrAfter(line, matches.front());
+    }
+
+    os << line << '\n';
+  }
+  os.flush();
+}
+
+static int demangleBulk(const swift::Demangle::DemangleOptions &options) {
+  // Read (or, when stdin is redirected from a regular file, mmap) the whole
+  // input up front; the line-by-line getline loop in demangleSTDIN spends
+  // most of its time in I/O for large symbol lists.
+  auto input = llvm::MemoryBuffer::getFileOrSTDIN("-");
+  if (!input) {
+    llvm::errs() << "error: cannot read stdin: "
+                 << input.getError().message() << '\n';
+    return EXIT_FAILURE;
+  }
+  llvm::StringRef contents = (*input)->getBuffer();
+
+  unsigned numThreads = BulkJobs ? BulkJobs.getValue()
+                                 : std::thread::hardware_concurrency();
+  if (numThreads == 0)
+    numThreads = 1;
+
+  // Split the input into line-aligned chunks. Several chunks per thread keep
+  // all workers busy even if some chunks demangle slower than others.
+  const size_t targetChunkSize =
+      std::max(contents.size() / (numThreads * 8) + 1, (size_t)0x10000);
+  std::vector<llvm::StringRef> chunks;
+  for (size_t pos = 0; pos < contents.size();) {
+    size_t end = pos + targetChunkSize;
+    if (end >= contents.size())
+      end = contents.size();
+    else {
+      end = contents.find('\n', end);
+      end = (end == llvm::StringRef::npos) ? contents.size() : end + 1;
+    }
+    chunks.push_back(contents.slice(pos, end));
+    pos = end;
+  }
+
+  // Workers claim chunks dynamically and post the demangled text; the main
+  // thread writes finished chunks in input order so the output never has to
+  // be held in memory in its entirety.
+  std::vector<std::string> results(chunks.size());
+  std::vector<bool> done(chunks.size(), false);
+  std::atomic<size_t> nextChunk(0);
+  std::mutex doneMutex;
+  std::condition_variable doneCond;
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < numThreads; ++i) {
+    workers.emplace_back([&] {
+      for (;;) {
+        size_t idx = nextChunk.fetch_add(1);
+        if (idx >= chunks.size())
+          return;
+        demangleBulkChunk(chunks[idx], results[idx], options);
+        {
+          std::lock_guard<std::mutex> lock(doneMutex);
+          done[idx] = true;
+        }
+        doneCond.notify_one();
+      }
+    });
+  }
+
+  for (size_t idx = 0; idx < chunks.size(); ++idx) {
+    {
+      std::unique_lock<std::mutex> lock(doneMutex);
+      doneCond.wait(lock, [&] { return done[idx]; });
+    }
+    llvm::outs() << results[idx];
+    std::string().swap(results[idx]);
+  }
+
+  for (auto &worker : workers)
+    worker.join();
+
+  return EXIT_SUCCESS;
+}
+
 int main(int argc, char **argv) {
 #if defined(__CYGWIN__)
   // Cygwin clang 3.5.2 with '-O3' generates CRASHING BINARY,
@@ -198,6 +320,16 @@ int main(int argc, char **argv) {
   if (Simplified)
     options = swift::Demangle::DemangleOptions::SimplifiedUIDemangleOptions();
 
+  if (BulkMode) {
+    if (ExpandMode || TreeOnly || RemangleMode || RemangleNew || Classify ||
+        !InputNames.empty()) {
+      llvm::errs() << "error: -bulk reads stdin and only supports plain "
+                      "demangling\n";
+      return EXIT_FAILURE;
+    }
+    return demangleBulk(options);
+  }
+
   if (InputNames.empty()) {
     CompactMode = true;
     return demangleSTDIN(options);
@@ -27,6 +27,7 @@
 #include "swift/Parse/Lexer.h"
 #include "swift/Parse/Parser.h"
 #include "swift/Subsystems.h"
+#include "swift/Syntax/Serialization/SyntaxBinarySerialization.h"
 #include "swift/Syntax/Serialization/SyntaxSerialization.h"
 #include "swift/Syntax/SyntaxData.h"
 #include "swift/Syntax/SyntaxNodes.h"
@@ -43,6 +44,7 @@ enum class ActionType {
   FullLexRoundTrip,
   FullParseRoundTrip,
   SerializeRawTree,
+  SerializeRawTreeBinary,
   ParserGen,
   None
 };
@@ -72,7 +74,11 @@ Action(llvm::cl::desc("Action (required):"),
         clEnumValN(ActionType::SerializeRawTree,
                    "serialize-raw-tree",
                    "Parse the source file and serialize the raw tree"
-                   "to JSON")));
+                   "to JSON"),
+        clEnumValN(ActionType::SerializeRawTreeBinary,
+                   "serialize-raw-tree-binary",
+                   "Parse the source file and serialize the raw tree "
+                   "to the compact binary format")));
 
 static llvm::cl::opt<std::string>
 InputSourceFilename("input-source-filename",
@@ -215,11 +221,17 @@ int doFullParseRoundTrip(const char *MainExecutablePath,
 }
 
 int doSerializeRawTree(const char *MainExecutablePath,
-                       const StringRef InputFileName) {
+                       const StringRef InputFileName,
+                       bool Binary) {
   CompilerInstance Instance;
   SourceFile *SF = getSourceFile(Instance, InputFileName, MainExecutablePath);
 
   auto Root = SF->getSyntaxRoot().getRaw();
+  if (Binary) {
+    SyntaxBinaryWriter Writer;
+    Writer.write(Root, llvm::outs());
+    return EXIT_SUCCESS;
+  }
   swift::json::Output out(llvm::outs());
   out << Root;
   llvm::outs() << "\n";
@@ -267,7 +279,12 @@ int main(int argc, char *argv[]) {
     ExitCode = doFullParseRoundTrip(argv[0], options::InputSourceFilename);
     break;
   case ActionType::SerializeRawTree:
-    ExitCode = doSerializeRawTree(argv[0], options::InputSourceFilename);
+    ExitCode = doSerializeRawTree(argv[0], options::InputSourceFilename,
+                                  /*Binary=*/false);
+    break;
+  case ActionType::SerializeRawTreeBinary:
+    ExitCode = doSerializeRawTree(argv[0], options::InputSourceFilename,
+                                  /*Binary=*/true);
     break;
   case ActionType::ParserGen:
     ExitCode = dumpParserGen(argv[0], options::InputSourceFilename);
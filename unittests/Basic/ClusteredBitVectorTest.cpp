@@ -1,4 +1,5 @@
 #include "swift/Basic/ClusteredBitVector.h"
+#include "llvm/ADT/APInt.h"
 #include "gtest/gtest.h"
 
 using namespace swift;
@@ -208,3 +209,71 @@ TEST(ClusteredBitVector, FlipAllBig) {
   EXPECT_EQ(true, vec[7]);
   EXPECT_EQ(1u, vec.count());
 }
+
+TEST(ClusteredBitVector, FromAPInt) {
+  llvm::APInt bits(163, 0);
+  bits.setBit(0);
+  bits.setBit(63);
+  bits.setBit(64);
+  bits.setBit(100);
+  bits.setBit(162);
+
+  ClusteredBitVector vec = ClusteredBitVector::fromAPInt(bits);
+  EXPECT_EQ(163u, vec.size());
+  EXPECT_EQ(5u, vec.count());
+  EXPECT_EQ(true, vec[0]);
+  EXPECT_EQ(false, vec[1]);
+  EXPECT_EQ(true, vec[63]);
+  EXPECT_EQ(true, vec[64]);
+  EXPECT_EQ(true, vec[100]);
+  EXPECT_EQ(true, vec[162]);
+  EXPECT_EQ(bits, vec.asAPInt());
+}
+
+TEST(ClusteredBitVector, AppendConstantBitsMisaligned) {
+  ClusteredBitVector vec;
+  vec.appendClearBits(37);
+  vec.appendSetBits(131);
+  vec.appendClearBits(41);
+  vec.appendSetBits(19);
+
+  EXPECT_EQ(228u, vec.size());
+  EXPECT_EQ(150u, vec.count());
+  EXPECT_EQ(false, vec[36]);
+  EXPECT_EQ(true, vec[37]);
+  EXPECT_EQ(true, vec[167]);
+  EXPECT_EQ(false, vec[168]);
+  EXPECT_EQ(false, vec[208]);
+  EXPECT_EQ(true, vec[209]);
+  EXPECT_EQ(true, vec[227]);
+}
+
+TEST(ClusteredBitVector, XorAssign) {
+  ClusteredBitVector lhs;
+  lhs.appendSetBits(72);
+  lhs.appendClearBits(72);
+
+  ClusteredBitVector rhs;
+  rhs.appendClearBits(36);
+  rhs.appendSetBits(72);
+  rhs.appendClearBits(36);
+
+  lhs ^= rhs;
+  EXPECT_EQ(144u, lhs.size());
+  EXPECT_EQ(72u, lhs.count());
+  EXPECT_EQ(true, lhs[0]);
+  EXPECT_EQ(false, lhs[36]);
+  EXPECT_EQ(true, lhs[72]);
+  EXPECT_EQ(false, lhs[108]);
+
+  // Xor-ing with an all-clear vector is an identity.
+  ClusteredBitVector clear;
+  clear.appendClearBits(144);
+  lhs ^= clear;
+  EXPECT_EQ(72u, lhs.count());
+
+  // Xor-ing into an all-clear vector copies.
+  clear ^= lhs;
+  EXPECT_EQ(72u, clear.count());
+  EXPECT_EQ(true, clear[0]);
+}
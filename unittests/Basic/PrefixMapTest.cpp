@@ -194,3 +194,23 @@ TEST(PrefixMapTest, Test4) {
   tester.validate();
   tester.find("zguowwnctgmkg");
 }
+
+TEST(PrefixMapTest, CopyAndMove) {
+  PrefixMap<char, int> map;
+  map.insert(asArray("abc"), 1);
+  map.insert(asArray("abcdef"), 2);
+  map.insert(asArray("abd"), 3);
+
+  PrefixMap<char, int> copy = map;
+  map.clear();
+  EXPECT_TRUE(map.empty());
+
+  auto result = copy.findPrefix(asArray("abcdefgh"));
+  ASSERT_TRUE((bool) result.first);
+  EXPECT_EQ(2, *result.first);
+
+  PrefixMap<char, int> moved = std::move(copy);
+  result = moved.findPrefix(asArray("abdxyz"));
+  ASSERT_TRUE((bool) result.first);
+  EXPECT_EQ(3, *result.first);
+}
@@ -221,3 +221,21 @@ TEST(ToSentencecaseTest, Words) {
   EXPECT_EQ(camel_case::toSentencecase("", scratch), "");
 }
 
+
+TEST(PartsOfSpeechTest, Classification) {
+  // Dictionary words, matched without regard to the case produced by
+  // camelCase splitting.
+  EXPECT_EQ(getPartOfSpeech("with"), PartOfSpeech::Preposition);
+  EXPECT_EQ(getPartOfSpeech("With"), PartOfSpeech::Preposition);
+  EXPECT_EQ(getPartOfSpeech("move"), PartOfSpeech::Verb);
+  EXPECT_EQ(getPartOfSpeech("Move"), PartOfSpeech::Verb);
+  EXPECT_EQ(getPartOfSpeech("fridge"), PartOfSpeech::Unknown);
+
+  // Gerunds and verb prefixes are derived from the dictionary verbs.
+  EXPECT_EQ(getPartOfSpeech("moving"), PartOfSpeech::Gerund);
+  EXPECT_EQ(getPartOfSpeech("removing"), PartOfSpeech::Gerund);
+
+  EXPECT_EQ(getPrepositionKind("above"), PK_Directional);
+  EXPECT_EQ(getPrepositionKind("with"), PK_Nondirectional);
+  EXPECT_EQ(getPrepositionKind("move"), PK_None);
+}
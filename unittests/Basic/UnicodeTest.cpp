@@ -25,3 +25,26 @@ TEST(IsSingleExtendedGraphemeCluster, Test1) {
   EXPECT_EQ(false, isSingleExtendedGraphemeCluster(""));
   EXPECT_EQ(true, isSingleExtendedGraphemeCluster("a"));
 }
+
+TEST(GetUTF16Length, Test1) {
+  EXPECT_EQ(0u, getUTF16Length(""));
+  EXPECT_EQ(3u, getUTF16Length("abc"));
+  // Two- and three-byte sequences are single UTF-16 code units.
+  EXPECT_EQ(1u, getUTF16Length("é"));
+  EXPECT_EQ(1u, getUTF16Length("€"));
+  // Four-byte sequences transcode to surrogate pairs.
+  EXPECT_EQ(2u, getUTF16Length("\U0001f600"));
+  EXPECT_EQ(4u, getUTF16Length("a\U0001f600b"));
+}
+
+TEST(GetUTF16Length, LongStrings) {
+  // Cross word-at-a-time boundaries: lengths around multiples of 8 and 16
+  // with multi-byte sequences straddling them.
+  std::string ascii(37, 'x');
+  EXPECT_EQ(37u, getUTF16Length(ascii));
+
+  std::string mixed;
+  for (unsigned i = 0; i != 7; ++i)
+    mixed += "abé€\U0001f600";
+  EXPECT_EQ(7u * 5u, getUTF16Length(mixed));
+}
@@ -790,3 +790,45 @@ TEST(DependencyGraph, ChainedExternalPreMarked) {
   EXPECT_TRUE(graph.isMarked(0));
   EXPECT_FALSE(graph.isMarked(1));
 }
+
+TEST(DependencyGraph, BlockStyleLoad) {
+  // The block-mapping, quoted-scalar shape the frontend emitter produces is
+  // handled by the fast scanning path; check it loads just like flow style.
+  DependencyGraph<uintptr_t> graph;
+
+  EXPECT_EQ(graph.loadFromString(0,
+                                 "provides-top-level:\n"
+                                 "- \"a\"\n"
+                                 "- \"b\"\n"
+                                 "provides-member:\n"
+                                 "- [\"1ModuleX\", \"member\"]\n"
+                                 "depends-external:\n"
+                                 "- \"/foo\"\n"
+                                 "interface-hash: \"abc123\"\n"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(1,
+                                 "depends-top-level:\n"
+                                 "- !private \"a\"\n"
+                                 "- \"b\"\n"
+                                 "depends-member:\n"
+                                 "- !private [\"1ModuleX\", \"member\"]\n"),
+            LoadResult::UpToDate);
+
+  SmallVector<uintptr_t, 4> marked;
+  graph.markTransitive(marked, 0);
+  EXPECT_EQ(1u, marked.size());
+  EXPECT_EQ(1u, marked.front());
+  EXPECT_TRUE(graph.isMarked(0));
+  EXPECT_TRUE(graph.isMarked(1));
+}
+
+TEST(DependencyGraph, BlockStyleInterfaceHash) {
+  DependencyGraph<uintptr_t> graph;
+
+  EXPECT_EQ(graph.loadFromString(0, "interface-hash: \"abc\"\n"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(0, "interface-hash: \"abc\"\n"),
+            LoadResult::UpToDate);
+  EXPECT_EQ(graph.loadFromString(0, "interface-hash: \"def\"\n"),
+            LoadResult::AffectsDownstream);
+}